@@ -2,6 +2,7 @@
 #include "DebugText.h"
 #include "GameScene.h"
 #include "ImGuiManager.h"
+#include "MathUtility.h"
 #include "Matrix4x4.h"
 #include "TextureManager.h"
 #include "Vector2.h"
@@ -1216,19 +1217,8 @@ Matrix4x4 NoviceSystem::Matrix4Orthographic(
 	assert(fabsf(viewTop - viewBottom) > 0.00001f);
 	assert(fabsf(farZ - nearZ) > 0.00001f);
 
-	float width = 1.0f / (viewRight - viewLeft);
-	float height = 1.0f / (viewTop - viewBottom);
-	float fRange = 1.0f / (farZ - nearZ);
-	float sx = width * 2.0f;
-	float sy = height * 2.0f;
-	float sz = fRange;
-	float tx = -(viewLeft + viewRight) * width;
-	float ty = -(viewTop + viewBottom) * height;
-	float tz = -fRange * nearZ;
-
-	Matrix4x4 m{sx, 0.0f, 0.0f, 0.0f, 0.0f, sy, 0.0f, 0.0f, 0.0f, 0.0f, sz, 0.0f, tx, ty, tz, 1.0f};
-
-	return m;
+	return MathUtility::MakeOrthographicMatrix(
+	    viewLeft, viewTop, viewRight, viewBottom, nearZ, farZ);
 }
 
 HWND NoviceSystem::GetWindowHandle() { return winApp_->GetHwnd(); }
@@ -0,0 +1,433 @@
+#include "BVH.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+// SAHのビン数
+const uint32_t kBinCount = 12;
+// 葉に入れる物体の最大数（これ以下ならSAHで葉の方が安い場合に葉にする）
+const uint32_t kMaxLeafSize = 4;
+// 節点をたどるコストと物体を判定するコストの比
+const float kTraversalCost = 1.0f;
+// これより少ない物体の部分木は並列に分けない
+const uint32_t kParallelThreshold = 1024;
+// 1スレッドあたりの並列構築の部分木数
+const size_t kTasksPerThread = 4;
+
+/// <summary>
+/// AABBの中心の指定軸成分
+/// </summary>
+float CenterOf(const AABB& aabb, int axis) {
+	return ((&aabb.min.x)[axis] + (&aabb.max.x)[axis]) * 0.5f;
+}
+
+/// <summary>
+/// 視錐台に対するAABBの位置
+/// </summary>
+enum class Containment {
+	kOutside,    // 外側
+	kIntersect,  // 交差
+	kInside,     // 完全に内側
+};
+
+/// <summary>
+/// 視錐台に対するAABBの位置を判定
+/// </summary>
+Containment Classify(const Frustum& frustum, const AABB& aabb) {
+	Vector3 center = MathUtility::GetCenter(aabb);
+	Vector3 extents = MathUtility::GetExtents(aabb);
+	Containment result = Containment::kInside;
+	for (const Plane& plane : frustum.planes) {
+		float radius = extents.x * std::abs(plane.normal.x) +
+		               extents.y * std::abs(plane.normal.y) +
+		               extents.z * std::abs(plane.normal.z);
+		float distance = MathUtility::SignedDistance(plane, center);
+		if (distance < -radius) {
+			return Containment::kOutside;
+		}
+		if (distance < radius) {
+			result = Containment::kIntersect;
+		}
+	}
+	return result;
+}
+
+} // namespace
+
+void BVH::Build(std::span<const AABB> bounds) {
+	Clear();
+	if (bounds.empty()) {
+		return;
+	}
+
+	uint32_t count = static_cast<uint32_t>(bounds.size());
+	bounds_.assign(bounds.begin(), bounds.end());
+	objectIndices_.resize(count);
+	std::iota(objectIndices_.begin(), objectIndices_.end(), 0);
+	nodes_.reserve(size_t(count) * 2);
+	nodes_.push_back({CalculateBounds(0, count), 0, count});
+
+	// 大きい部分木から順に分割し、並列に構築する部分木を用意する
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	size_t taskTarget = jobSystem->GetConcurrency() * kTasksPerThread;
+	std::vector<BuildTask> tasks = {{0, 0, count}};
+	while (tasks.size() < taskTarget) {
+		auto largest = std::max_element(
+		    tasks.begin(), tasks.end(), [](const BuildTask& a, const BuildTask& b) {
+			    return a.end - a.begin < b.end - b.begin;
+		    });
+		if (largest->end - largest->begin < kParallelThreshold) {
+			break;
+		}
+		BuildTask task = *largest;
+		tasks.erase(largest);
+		uint32_t mid = 0;
+		if (Split(nodes_, task.node, task.begin, task.end, mid)) {
+			uint32_t left = nodes_[task.node].first;
+			tasks.push_back({left, task.begin, mid});
+			tasks.push_back({left + 1, mid, task.end});
+		}
+	}
+
+	// 部分木ごとに別の配列へ構築する（物体の並びの範囲は重ならない）
+	std::vector<std::vector<Node>> subtrees(tasks.size());
+	jobSystem->ParallelFor(tasks.size(), 1, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			const BuildTask& task = tasks[i];
+			std::vector<Node>& subtree = subtrees[i];
+			subtree.reserve(size_t(task.end - task.begin) * 2);
+			subtree.push_back(nodes_[task.node]);
+			BuildRecursive(subtree, 0, task.begin, task.end);
+		}
+	});
+
+	// 部分木をつなげる。部分木の根は元の節点に置き、残りは末尾に追加する
+	for (size_t i = 0; i < tasks.size(); i++) {
+		std::vector<Node>& subtree = subtrees[i];
+		uint32_t base = static_cast<uint32_t>(nodes_.size());
+		for (Node& node : subtree) {
+			if (node.count == 0) {
+				node.first = node.first - 1 + base;
+			}
+		}
+		nodes_[tasks[i].node] = subtree[0];
+		nodes_.insert(nodes_.end(), subtree.begin() + 1, subtree.end());
+	}
+
+	BuildLinks();
+}
+
+void BVH::Clear() {
+	nodes_.clear();
+	objectIndices_.clear();
+	bounds_.clear();
+	parents_.clear();
+	leaves_.clear();
+	dirtyNodes_.clear();
+	nodeDirty_.clear();
+}
+
+void BVH::UpdateBounds(uint32_t index, const AABB& bounds) {
+	assert(index < bounds_.size());
+	bounds_[index] = bounds;
+
+	// 葉から根まで予約する。予約済みの節点に着いたら、その先も予約済み
+	for (uint32_t node = leaves_[index]; node != UINT32_MAX && !nodeDirty_[node];
+	     node = parents_[node]) {
+		nodeDirty_[node] = 1;
+		dirtyNodes_.push_back(node);
+	}
+}
+
+void BVH::Refit() {
+	// 子は親より後ろにあるので、番号の大きい順に更新すれば子が先に終わる
+	std::sort(dirtyNodes_.begin(), dirtyNodes_.end(), std::greater<uint32_t>());
+	for (uint32_t index : dirtyNodes_) {
+		Node& node = nodes_[index];
+		if (node.count > 0) {
+			node.bounds = CalculateBounds(node.first, node.first + node.count);
+		} else {
+			node.bounds =
+			    MathUtility::Merge(nodes_[node.first].bounds, nodes_[node.first + 1].bounds);
+		}
+		nodeDirty_[index] = 0;
+	}
+	dirtyNodes_.clear();
+}
+
+void BVH::Query(const Frustum& frustum, std::vector<uint32_t>& result) const {
+	if (nodes_.empty()) {
+		return;
+	}
+
+	// 完全に内側の節点以下は判定せずに全て追加する
+	std::vector<std::pair<uint32_t, bool>> stack = {{0, false}};
+	while (!stack.empty()) {
+		auto [index, inside] = stack.back();
+		stack.pop_back();
+		const Node& node = nodes_[index];
+
+		if (!inside) {
+			Containment containment = Classify(frustum, node.bounds);
+			if (containment == Containment::kOutside) {
+				continue;
+			}
+			inside = containment == Containment::kInside;
+		}
+
+		if (node.count > 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				uint32_t object = objectIndices_[i];
+				if (inside || MathUtility::IsIntersect(frustum, bounds_[object])) {
+					result.push_back(object);
+				}
+			}
+		} else {
+			stack.push_back({node.first, inside});
+			stack.push_back({node.first + 1, inside});
+		}
+	}
+}
+
+void BVH::Query(const Sphere& sphere, std::vector<uint32_t>& result) const {
+	if (nodes_.empty()) {
+		return;
+	}
+
+	std::vector<uint32_t> stack = {0};
+	while (!stack.empty()) {
+		const Node& node = nodes_[stack.back()];
+		stack.pop_back();
+		if (!MathUtility::IsIntersect(sphere, node.bounds)) {
+			continue;
+		}
+
+		if (node.count > 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				uint32_t object = objectIndices_[i];
+				if (MathUtility::IsIntersect(sphere, bounds_[object])) {
+					result.push_back(object);
+				}
+			}
+		} else {
+			stack.push_back(node.first);
+			stack.push_back(node.first + 1);
+		}
+	}
+}
+
+bool BVH::Raycast(
+    const Ray& ray, RaycastHit& hit, float maxDistance, const RaycastFunc& narrowPhase) const {
+	hit = {};
+	hit.distance = maxDistance;
+	if (nodes_.empty()) {
+		return false;
+	}
+
+	Vector3 inverseDirection = MathUtility::MakeInverseDirection(ray.direction);
+
+	float rootDistance = 0.0f;
+	if (!MathUtility::IsIntersect(
+	        ray, inverseDirection, nodes_[0].bounds, hit.distance, rootDistance)) {
+		return false;
+	}
+
+	// 節点と入る点までの距離
+	std::vector<std::pair<uint32_t, float>> stack = {{0, rootDistance}};
+	while (!stack.empty()) {
+		auto [index, nodeDistance] = stack.back();
+		stack.pop_back();
+		// 既に見つかった交差より遠い
+		if (hit.distance < nodeDistance) {
+			continue;
+		}
+
+		const Node& node = nodes_[index];
+		if (node.count > 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				uint32_t object = objectIndices_[i];
+				float distance = 0.0f;
+				bool isHit = narrowPhase ? narrowPhase(object, hit.distance, distance)
+				                         : MathUtility::IsIntersect(
+				                               ray, inverseDirection, bounds_[object],
+				                               hit.distance, distance);
+				if (isHit && distance <= hit.distance) {
+					hit.index = object;
+					hit.distance = distance;
+				}
+			}
+			continue;
+		}
+
+		// 近い子を先に調べるよう、遠い子から積む
+		float leftDistance = 0.0f, rightDistance = 0.0f;
+		bool isLeftHit = MathUtility::IsIntersect(
+		    ray, inverseDirection, nodes_[node.first].bounds, hit.distance, leftDistance);
+		bool isRightHit = MathUtility::IsIntersect(
+		    ray, inverseDirection, nodes_[node.first + 1].bounds, hit.distance, rightDistance);
+		if (isLeftHit && isRightHit) {
+			if (leftDistance < rightDistance) {
+				stack.push_back({node.first + 1, rightDistance});
+				stack.push_back({node.first, leftDistance});
+			} else {
+				stack.push_back({node.first, leftDistance});
+				stack.push_back({node.first + 1, rightDistance});
+			}
+		} else if (isLeftHit) {
+			stack.push_back({node.first, leftDistance});
+		} else if (isRightHit) {
+			stack.push_back({node.first + 1, rightDistance});
+		}
+	}
+
+	return hit.index != UINT32_MAX;
+}
+
+bool BVH::Split(
+    std::vector<Node>& nodes, uint32_t nodeIndex, uint32_t begin, uint32_t end, uint32_t& mid) {
+	uint32_t count = end - begin;
+	if (count <= 1) {
+		return false;
+	}
+
+	// 中心の範囲
+	AABB centerBounds = MathUtility::MakeEmptyAABB();
+	for (uint32_t i = begin; i < end; i++) {
+		centerBounds =
+		    MathUtility::Merge(centerBounds, MathUtility::GetCenter(bounds_[objectIndices_[i]]));
+	}
+
+	// 各軸をビンに分け、境界ごとのSAHコストを求める
+	int bestAxis = -1;
+	uint32_t bestBin = 0;
+	float bestCost = FLT_MAX;
+	for (int axis = 0; axis < 3; axis++) {
+		float minCenter = (&centerBounds.min.x)[axis];
+		float extent = (&centerBounds.max.x)[axis] - minCenter;
+		if (extent <= 0.0f) {
+			continue;
+		}
+
+		struct Bin {
+			AABB bounds = MathUtility::MakeEmptyAABB();
+			uint32_t count = 0;
+		};
+		Bin bins[kBinCount];
+		float scale = float(kBinCount) / extent;
+		for (uint32_t i = begin; i < end; i++) {
+			const AABB& aabb = bounds_[objectIndices_[i]];
+			uint32_t bin = std::min(
+			    kBinCount - 1, static_cast<uint32_t>((CenterOf(aabb, axis) - minCenter) * scale));
+			bins[bin].bounds = MathUtility::Merge(bins[bin].bounds, aabb);
+			bins[bin].count++;
+		}
+
+		// 右側の累積
+		float rightAreas[kBinCount - 1];
+		uint32_t rightCounts[kBinCount - 1];
+		AABB accumulated = MathUtility::MakeEmptyAABB();
+		uint32_t accumulatedCount = 0;
+		for (uint32_t bin = kBinCount - 1; bin > 0; bin--) {
+			accumulated = MathUtility::Merge(accumulated, bins[bin].bounds);
+			accumulatedCount += bins[bin].count;
+			rightAreas[bin - 1] =
+			    accumulatedCount > 0 ? MathUtility::GetSurfaceArea(accumulated) : 0.0f;
+			rightCounts[bin - 1] = accumulatedCount;
+		}
+
+		// 左側を累積しながら評価
+		accumulated = MathUtility::MakeEmptyAABB();
+		accumulatedCount = 0;
+		for (uint32_t bin = 0; bin < kBinCount - 1; bin++) {
+			accumulated = MathUtility::Merge(accumulated, bins[bin].bounds);
+			accumulatedCount += bins[bin].count;
+			if (accumulatedCount == 0 || rightCounts[bin] == 0) {
+				continue;
+			}
+			float cost = MathUtility::GetSurfaceArea(accumulated) * accumulatedCount +
+			             rightAreas[bin] * rightCounts[bin];
+			if (cost < bestCost) {
+				bestAxis = axis;
+				bestBin = bin;
+				bestCost = cost;
+			}
+		}
+	}
+
+	if (bestAxis < 0) {
+		// 中心が全て重なっている。多すぎる場合は半分に分ける
+		if (count <= kMaxLeafSize) {
+			return false;
+		}
+		mid = begin + count / 2;
+	} else {
+		float parentArea = MathUtility::GetSurfaceArea(nodes[nodeIndex].bounds);
+		float splitCost =
+		    kTraversalCost + (parentArea > 0.0f ? bestCost / parentArea : float(count));
+		if (count <= kMaxLeafSize && float(count) <= splitCost) {
+			return false;
+		}
+
+		float minCenter = (&centerBounds.min.x)[bestAxis];
+		float scale = float(kBinCount) / ((&centerBounds.max.x)[bestAxis] - minCenter);
+		auto first = objectIndices_.begin();
+		auto it = std::partition(first + begin, first + end, [&](uint32_t object) {
+			uint32_t bin = std::min(
+			    kBinCount - 1,
+			    static_cast<uint32_t>((CenterOf(bounds_[object], bestAxis) - minCenter) * scale));
+			return bin <= bestBin;
+		});
+		mid = static_cast<uint32_t>(it - first);
+		if (mid == begin || mid == end) {
+			mid = begin + count / 2;
+		}
+	}
+
+	// 子は隣り合わせに置く
+	uint32_t left = static_cast<uint32_t>(nodes.size());
+	nodes.push_back({CalculateBounds(begin, mid), begin, mid - begin});
+	nodes.push_back({CalculateBounds(mid, end), mid, end - mid});
+	nodes[nodeIndex].first = left;
+	nodes[nodeIndex].count = 0;
+	return true;
+}
+
+void BVH::BuildRecursive(
+    std::vector<Node>& nodes, uint32_t nodeIndex, uint32_t begin, uint32_t end) {
+	uint32_t mid = 0;
+	if (!Split(nodes, nodeIndex, begin, end, mid)) {
+		return;
+	}
+	uint32_t left = nodes[nodeIndex].first;
+	BuildRecursive(nodes, left, begin, mid);
+	BuildRecursive(nodes, left + 1, mid, end);
+}
+
+AABB BVH::CalculateBounds(uint32_t begin, uint32_t end) const {
+	AABB aabb = MathUtility::MakeEmptyAABB();
+	for (uint32_t i = begin; i < end; i++) {
+		aabb = MathUtility::Merge(aabb, bounds_[objectIndices_[i]]);
+	}
+	return aabb;
+}
+
+void BVH::BuildLinks() {
+	parents_.assign(nodes_.size(), UINT32_MAX);
+	leaves_.assign(bounds_.size(), UINT32_MAX);
+	nodeDirty_.assign(nodes_.size(), 0);
+	for (uint32_t index = 0; index < nodes_.size(); index++) {
+		const Node& node = nodes_[index];
+		if (node.count > 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				leaves_[objectIndices_[i]] = index;
+			}
+		} else {
+			parents_[node.first] = index;
+			parents_[node.first + 1] = index;
+		}
+	}
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "Shapes.h"
+#include <cfloat>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+/// <summary>
+/// 境界ボリューム階層（ワールド座標系のAABBの集合）
+/// </summary>
+/// <remarks>
+/// SAH（表面積ヒューリスティック）をビンで近似して分割する。上位の分割を終えた後、
+/// 残りの部分木をジョブシステムで並列に構築する。
+/// 少数の物体が動いた場合はUpdateBoundsとRefitで変化した枝だけを更新する。
+/// </remarks>
+class BVH {
+public: // サブクラス
+	/// <summary>
+	/// 半直線判定の結果
+	/// </summary>
+	struct RaycastHit {
+		uint32_t index = UINT32_MAX; // 物体の番号
+		float distance = FLT_MAX;    // 始点からの距離
+	};
+
+	/// <summary>
+	/// 物体単位の半直線判定（物体の番号、判定する最大距離、交差した距離の出力）
+	/// </summary>
+	using RaycastFunc = std::function<bool(uint32_t, float, float&)>;
+
+public: // メンバ関数
+	/// <summary>
+	/// 構築
+	/// </summary>
+	/// <param name="bounds">物体のAABB（番号がそのまま物体の番号になる）</param>
+	void Build(std::span<const AABB> bounds);
+
+	/// <summary>
+	/// 全て削除
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// 物体のAABBを変更する。Refitを呼ぶまで木には反映されない
+	/// </summary>
+	/// <param name="index">物体の番号</param>
+	/// <param name="bounds">新しいAABB</param>
+	void UpdateBounds(uint32_t index, const AABB& bounds);
+
+	/// <summary>
+	/// UpdateBoundsで変更した物体を含む節点の境界だけを更新する
+	/// </summary>
+	/// <remarks>木の形は変えないので、大きく動いた場合は再構築した方が判定は速い</remarks>
+	void Refit();
+
+	/// <summary>
+	/// 視錐台と交差する物体の列挙
+	/// </summary>
+	/// <param name="frustum">視錐台</param>
+	/// <param name="result">物体の番号（末尾に追加する）</param>
+	void Query(const Frustum& frustum, std::vector<uint32_t>& result) const;
+
+	/// <summary>
+	/// 球と交差する物体の列挙
+	/// </summary>
+	/// <param name="sphere">球</param>
+	/// <param name="result">物体の番号（末尾に追加する）</param>
+	void Query(const Sphere& sphere, std::vector<uint32_t>& result) const;
+
+	/// <summary>
+	/// 半直線と最も近くで交差する物体を求める
+	/// </summary>
+	/// <param name="ray">半直線</param>
+	/// <param name="hit">結果</param>
+	/// <param name="maxDistance">判定する最大距離</param>
+	/// <param name="narrowPhase">物体単位の判定（nullならAABBとの交差を結果とする）</param>
+	/// <returns>交差したか</returns>
+	bool Raycast(
+	    const Ray& ray, RaycastHit& hit, float maxDistance = FLT_MAX,
+	    const RaycastFunc& narrowPhase = nullptr) const;
+
+	/// <summary>
+	/// 物体数の取得
+	/// </summary>
+	size_t GetObjectCount() const { return bounds_.size(); }
+
+	/// <summary>
+	/// 節点数の取得
+	/// </summary>
+	size_t GetNodeCount() const { return nodes_.size(); }
+
+	/// <summary>
+	/// 全体を囲むAABBの取得
+	/// </summary>
+	AABB GetBounds() const { return nodes_.empty() ? AABB{} : nodes_[0].bounds; }
+
+private: // サブクラス
+	// 節点（葉ならcount > 0で、firstから物体の並びを指す。内部節点なら子はfirstとfirst+1）
+	struct Node {
+		AABB bounds;
+		uint32_t first;
+		uint32_t count;
+	};
+
+	// 並列構築を待つ部分木
+	struct BuildTask {
+		uint32_t node;
+		uint32_t begin;
+		uint32_t end;
+	};
+
+private: // メンバ関数
+	/// <summary>
+	/// 節点を分割する。分割しない場合はfalse
+	/// </summary>
+	/// <param name="nodes">節点配列</param>
+	/// <param name="nodeIndex">分割する節点</param>
+	/// <param name="begin">物体の並びの先頭</param>
+	/// <param name="end">物体の並びの終端</param>
+	/// <param name="mid">分割位置の出力</param>
+	bool Split(
+	    std::vector<Node>& nodes, uint32_t nodeIndex, uint32_t begin, uint32_t end,
+	    uint32_t& mid);
+
+	/// <summary>
+	/// 部分木を再帰的に構築する
+	/// </summary>
+	void BuildRecursive(std::vector<Node>& nodes, uint32_t nodeIndex, uint32_t begin, uint32_t end);
+
+	/// <summary>
+	/// 物体の並びを囲むAABB
+	/// </summary>
+	AABB CalculateBounds(uint32_t begin, uint32_t end) const;
+
+	/// <summary>
+	/// 節点の親と物体の葉を記録する
+	/// </summary>
+	void BuildLinks();
+
+private: // メンバ変数
+	// 節点（親は子より前にある）
+	std::vector<Node> nodes_;
+	// 葉から参照する物体の並び
+	std::vector<uint32_t> objectIndices_;
+	// 物体のAABB
+	std::vector<AABB> bounds_;
+	// 節点の親（根はUINT32_MAX）
+	std::vector<uint32_t> parents_;
+	// 物体が入っている葉
+	std::vector<uint32_t> leaves_;
+	// Refitで更新する節点
+	std::vector<uint32_t> dirtyNodes_;
+	// 節点ごとの更新予約
+	std::vector<uint8_t> nodeDirty_;
+};
@@ -0,0 +1,478 @@
+#include "ChunkedTerrain.h"
+#include "DirectXCommon.h"
+#include "FrustumCuller.h"
+#include "JobSystem.h"
+#include "MathUtility.h"
+#include "TerrainGrid.h"
+#include "TextureManager.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+
+size_t ChunkedTerrain::NodeKeyHash::operator()(const NodeKey& key) const {
+	uint64_t value = (uint64_t(uint32_t(key.x)) << 32) | uint32_t(key.z);
+	return std::hash<uint64_t>()(value ^ (uint64_t(key.level) * 0x9E3779B97F4A7C15ull));
+}
+
+ChunkedTerrain::HeightSource ChunkedTerrain::CreateNoiseSource(
+    const PerlinNoise& noise, const PerlinNoise::Fractal& fractal, float noiseScale,
+    float height) {
+	assert(0.0f < noiseScale);
+	float scale = 1.0f / noiseScale;
+	return [noise, fractal, scale, height](float x0, float dx, float z, std::span<float> result) {
+		noise.FbmRow(x0 * scale, dx * scale, z * scale, fractal, result);
+		for (float& value : result) {
+			value = (value * 0.5f + 0.5f) * height;
+		}
+	};
+}
+
+void ChunkedTerrain::Initialize(const Config& config, HeightSource heightSource) {
+	assert(heightSource);
+	assert(0.0f < config.chunkSize);
+	// 継ぎ目で奇数番目の頂点を飛ばすので偶数。頂点数は16ビットインデックスに収める
+	assert(2 <= config.chunkCellCount && config.chunkCellCount % 2 == 0);
+	assert(config.chunkCellCount <= 254);
+	assert(1 <= config.levelCount && config.levelCount <= 16);
+	// 1倍未満だと隣とのレベル差が2以上になりうる
+	assert(1.0f <= config.splitDistance);
+	assert(1.0f <= config.evictHysteresis);
+
+	Finalize();
+	config_ = config;
+	heightSource_ = std::move(heightSource);
+	rootLevel_ = config_.levelCount - 1;
+	uint32_t rowLength = config_.chunkCellCount + 1;
+	vertexBufferSize_ = static_cast<UINT>(sizeof(VertexPosNormalUv) * rowLength * rowLength);
+
+	CreateIndexBuffer();
+}
+
+void ChunkedTerrain::Finalize() {
+	// ジョブはthisを参照するので、生成中のものは終わるまで待つ
+	for (auto& [key, chunk] : chunks_) {
+		if (chunk.mesh.valid()) {
+			chunk.mesh.wait();
+		}
+	}
+	// 転送中のバッファを解放しないよう完了を待つ
+	CopyQueue::Ticket ticket = 0;
+	for (auto& [key, chunk] : chunks_) {
+		ticket = std::max(ticket, chunk.ticket);
+	}
+	if (0 < ticket) {
+		CopyQueue::GetInstance()->Wait(ticket);
+	}
+
+	chunks_.clear();
+	leaves_.clear();
+	drawList_.clear();
+	requests_.clear();
+	freeBuffers_.clear();
+	indexBuff_.Reset();
+	ibView_ = {};
+	statistics_ = {};
+}
+
+void ChunkedTerrain::Update(const Vector3& cameraPosition) {
+	assert(indexBuff_);
+	cameraPosition_ = cameraPosition;
+	statistics_.requestCount = 0;
+	statistics_.evictCount = 0;
+
+	UpdateChunks();
+
+	// 読み込み半径にかかる最も粗いノードから選ぶ
+	leaves_.clear();
+	requests_.clear();
+	float rootSize = GetNodeSize(rootLevel_);
+	auto toRoot = [rootSize](float position) {
+		return static_cast<int32_t>(std::floor(position / rootSize));
+	};
+	int32_t minX = toRoot(cameraPosition_.x - config_.loadRadius);
+	int32_t maxX = toRoot(cameraPosition_.x + config_.loadRadius);
+	int32_t minZ = toRoot(cameraPosition_.z - config_.loadRadius);
+	int32_t maxZ = toRoot(cameraPosition_.z + config_.loadRadius);
+	for (int32_t z = minZ; z <= maxZ; z++) {
+		for (int32_t x = minX; x <= maxX; x++) {
+			NodeKey root{x, z, rootLevel_};
+			if (Distance(root) < config_.loadRadius) {
+				Select(root);
+			}
+		}
+	}
+
+	Balance();
+	BuildDrawList();
+	IssueRequests();
+	Evict();
+
+	statistics_.leafCount = static_cast<uint32_t>(leaves_.size());
+	statistics_.residentCount = 0;
+	statistics_.pendingCount = 0;
+	for (const auto& [key, chunk] : chunks_) {
+		if (chunk.state == Chunk::State::kResident) {
+			statistics_.residentCount++;
+		} else {
+			statistics_.pendingCount++;
+		}
+	}
+}
+
+void ChunkedTerrain::Draw(
+    const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+    uint32_t textureHadle, FrustumCuller* culler) {
+	TerrainCommon* terrainCommon = TerrainGrid::GetTerrainCommon();
+	assert(terrainCommon);
+	statistics_.drawCount = 0;
+	statistics_.triangleCount = 0;
+	if (drawList_.empty()) {
+		return;
+	}
+
+	ID3D12GraphicsCommandList* commandList = DirectXCommon::GetInstance()->GetCommandList();
+
+	// パイプラインはTerrainと共通。インデックスと定数は全チャンクで共有する
+	terrainCommon->PreDraw();
+	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	commandList->IASetIndexBuffer(&ibView_);
+	commandList->SetGraphicsRootConstantBufferView(
+	    static_cast<UINT>(TerrainCommon::RoomParameter::kWorldTransform),
+	    worldTransform.GetConstBuffer()->GetGPUVirtualAddress());
+	commandList->SetGraphicsRootConstantBufferView(
+	    static_cast<UINT>(TerrainCommon::RoomParameter::kViewProjection),
+	    viewProjection.GetConstBuffer()->GetGPUVirtualAddress());
+	TextureManager::GetInstance()->SetGraphicsRootDescriptorTable(
+	    commandList, static_cast<UINT>(TerrainCommon::RoomParameter::kTexture), textureHadle);
+
+	// 近い順に描画する
+	for (const DrawItem& item : drawList_) {
+		const Chunk& chunk = chunks_.at(item.key);
+		if (culler &&
+		    !culler->IsVisible(MathUtility::Transform(chunk.bounds, worldTransform.matWorld_))) {
+			continue;
+		}
+		commandList->IASetVertexBuffers(0, 1, &chunk.vbView);
+		commandList->DrawIndexedInstanced(
+		    indexCounts_[item.stitchMask], 1, startIndices_[item.stitchMask], 0, 0);
+		statistics_.drawCount++;
+		statistics_.triangleCount += indexCounts_[item.stitchMask] / 3;
+	}
+}
+
+void ChunkedTerrain::UpdateChunks() {
+	CopyQueue* copyQueue = CopyQueue::GetInstance();
+	for (auto& [key, chunk] : chunks_) {
+		if (chunk.state == Chunk::State::kGenerating &&
+		    chunk.mesh.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+			// 生成が済んだら転送する（バッファは破棄したチャンクのものを使い回す）
+			ChunkMesh mesh = chunk.mesh.get();
+			if (freeBuffers_.empty()) {
+				chunk.vertBuff = copyQueue->CreateBuffer(vertexBufferSize_);
+			} else {
+				chunk.vertBuff = std::move(freeBuffers_.back());
+				freeBuffers_.pop_back();
+			}
+			chunk.ticket = copyQueue->UploadBuffer(
+			    chunk.vertBuff.Get(), mesh.vertices.data(), vertexBufferSize_);
+			chunk.vbView.BufferLocation = chunk.vertBuff->GetGPUVirtualAddress();
+			chunk.vbView.SizeInBytes = vertexBufferSize_;
+			chunk.vbView.StrideInBytes = sizeof(VertexPosNormalUv);
+
+			float size = GetNodeSize(key.level);
+			chunk.bounds.min = {float(key.x) * size, mesh.minHeight, float(key.z) * size};
+			chunk.bounds.max = {float(key.x + 1) * size, mesh.maxHeight, float(key.z + 1) * size};
+			chunk.state = Chunk::State::kUploading;
+		}
+		if (chunk.state == Chunk::State::kUploading && copyQueue->IsCompleted(chunk.ticket)) {
+			chunk.state = Chunk::State::kResident;
+		}
+	}
+}
+
+void ChunkedTerrain::Select(const NodeKey& key) {
+	if (!IsResident(key)) {
+		// 最も粗いノードが無ければ、その範囲は描画しない
+		Request(key);
+		return;
+	}
+
+	// 近ければ分割する。子が全て揃うまでは自身を描画する
+	if (0 < key.level && Distance(key) < config_.splitDistance * GetNodeSize(key.level)) {
+		NodeKey children[4];
+		bool isReady = true;
+		for (int32_t i = 0; i < 4; i++) {
+			children[i] = {key.x * 2 + (i & 1), key.z * 2 + (i >> 1), key.level - 1};
+			if (!IsResident(children[i])) {
+				Request(children[i]);
+				isReady = false;
+			}
+		}
+		if (isReady) {
+			for (const NodeKey& child : children) {
+				Select(child);
+			}
+			return;
+		}
+	}
+
+	leaves_.insert(key);
+}
+
+void ChunkedTerrain::Balance() {
+	// 距離だけで選べば隣とのレベル差は1以下だが、子の生成待ちで分割を見送ると崩れることがある。
+	// 崩れた所は細かい側を親にまとめる（親は分割時に描画可能なので必ず描ける）
+	for (bool isChanged = true; isChanged;) {
+		isChanged = false;
+		for (const NodeKey& leaf : leaves_) {
+			uint32_t neighborLevel = std::max(
+			    std::max(GetNeighborLevel(leaf, -1, 0), GetNeighborLevel(leaf, 1, 0)),
+			    std::max(GetNeighborLevel(leaf, 0, -1), GetNeighborLevel(leaf, 0, 1)));
+			if (neighborLevel < leaf.level + 2) {
+				continue;
+			}
+
+			NodeKey parent{leaf.x >> 1, leaf.z >> 1, leaf.level + 1};
+			std::erase_if(leaves_, [&parent](const NodeKey& key) {
+				uint32_t shift = parent.level - key.level;
+				return key.level < parent.level && (key.x >> shift) == parent.x &&
+				       (key.z >> shift) == parent.z;
+			});
+			leaves_.insert(parent);
+			isChanged = true;
+			break;
+		}
+	}
+}
+
+void ChunkedTerrain::BuildDrawList() {
+	drawList_.clear();
+	for (const NodeKey& leaf : leaves_) {
+		DrawItem item;
+		item.key = leaf;
+		item.distance = Distance(leaf);
+		// 1つ粗いノードと接する辺を継ぎ目にする
+		if (leaf.level < GetNeighborLevel(leaf, -1, 0)) {
+			item.stitchMask |= kEdgeLeft;
+		}
+		if (leaf.level < GetNeighborLevel(leaf, 1, 0)) {
+			item.stitchMask |= kEdgeRight;
+		}
+		if (leaf.level < GetNeighborLevel(leaf, 0, -1)) {
+			item.stitchMask |= kEdgeBottom;
+		}
+		if (leaf.level < GetNeighborLevel(leaf, 0, 1)) {
+			item.stitchMask |= kEdgeTop;
+		}
+		drawList_.push_back(item);
+	}
+	std::sort(drawList_.begin(), drawList_.end(), [](const DrawItem& a, const DrawItem& b) {
+		return a.distance < b.distance;
+	});
+}
+
+void ChunkedTerrain::IssueRequests() {
+	// 穴を先に埋めるため粗いノードを優先し、同じレベルなら近い順
+	std::sort(requests_.begin(), requests_.end(), [](const LoadRequest& a, const LoadRequest& b) {
+		if (a.key.level != b.key.level) {
+			return a.key.level > b.key.level;
+		}
+		return a.distance < b.distance;
+	});
+
+	uint32_t pendingCount = 0;
+	for (const auto& [key, chunk] : chunks_) {
+		if (chunk.state != Chunk::State::kResident) {
+			pendingCount++;
+		}
+	}
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	for (const LoadRequest& request : requests_) {
+		if (config_.maxRequestsPerFrame <= statistics_.requestCount ||
+		    config_.maxPendingCount <= pendingCount) {
+			break;
+		}
+		// 同じノードが複数回要求されることがある
+		if (chunks_.contains(request.key)) {
+			continue;
+		}
+		Chunk& chunk = chunks_[request.key];
+		NodeKey key = request.key;
+		chunk.mesh = jobSystem->Submit([this, key]() { return Generate(key); });
+		statistics_.requestCount++;
+		pendingCount++;
+	}
+}
+
+void ChunkedTerrain::Evict() {
+	// 破棄の距離は読み込みより遠くして、境目での読み込みと破棄の繰り返しを防ぐ
+	for (auto it = chunks_.begin(); it != chunks_.end();) {
+		Chunk& chunk = it->second;
+		if (chunk.state != Chunk::State::kResident ||
+		    IsNeeded(it->first, config_.evictHysteresis)) {
+			++it;
+			continue;
+		}
+		if (freeBuffers_.size() < kMaxFreeBufferCount) {
+			freeBuffers_.push_back(std::move(chunk.vertBuff));
+		}
+		it = chunks_.erase(it);
+		statistics_.evictCount++;
+	}
+}
+
+void ChunkedTerrain::Request(const NodeKey& key) {
+	if (!chunks_.contains(key)) {
+		requests_.push_back({key, Distance(key)});
+	}
+}
+
+ChunkedTerrain::ChunkMesh ChunkedTerrain::Generate(const NodeKey& key) const {
+	const uint32_t cellCount = config_.chunkCellCount;
+	const uint32_t rowLength = cellCount + 1;
+	// 法線の差分に要る外周1頂点を含めた高さ
+	const uint32_t haloLength = cellCount + 3;
+
+	// 座標は最も細かい頂点間隔を単位とした整数から求める。共有する頂点の水平座標は
+	// 隣のチャンクとビット単位で一致し、高さも同じ座標で引くので丸め誤差の範囲で一致する
+	const float unit = config_.chunkSize / float(cellCount);
+	const int64_t step = int64_t(1) << key.level;
+	const int64_t originX = int64_t(key.x) * cellCount * step;
+	const int64_t originZ = int64_t(key.z) * cellCount * step;
+
+	std::vector<float> heights(size_t(haloLength) * haloLength);
+	for (uint32_t j = 0; j < haloLength; j++) {
+		std::span<float> row(heights.data() + size_t(j) * haloLength, haloLength);
+		float z = float(originZ + (int64_t(j) - 1) * step) * unit;
+		heightSource_(float(originX - step) * unit, float(step) * unit, z, row);
+	}
+	auto height = [&](uint32_t x, uint32_t z) { return heights[size_t(z) * haloLength + x]; };
+
+	ChunkMesh mesh;
+	mesh.vertices.resize(size_t(rowLength) * rowLength);
+	mesh.minHeight = height(1, 1);
+	mesh.maxHeight = height(1, 1);
+	const float distance = 2.0f * float(step) * unit;
+	for (uint32_t z = 0; z < rowLength; z++) {
+		for (uint32_t x = 0; x < rowLength; x++) {
+			// 外周の分だけずらして引く
+			float y = height(x + 1, z + 1);
+			float slopeX = (height(x + 2, z + 1) - height(x, z + 1)) / distance;
+			float slopeZ = (height(x + 1, z + 2) - height(x + 1, z)) / distance;
+
+			VertexPosNormalUv& vertex = mesh.vertices[size_t(z) * rowLength + x];
+			vertex.pos = {
+			    float(originX + int64_t(x) * step) * unit, y,
+			    float(originZ + int64_t(z) * step) * unit};
+			vertex.normal = MathUtility::Normalize(Vector3{-slopeX, 1.0f, -slopeZ});
+			// テクスチャは最も細かいチャンク1つ分で繰り返す
+			vertex.uv = {vertex.pos.x / config_.chunkSize, vertex.pos.z / config_.chunkSize};
+
+			mesh.minHeight = std::min(mesh.minHeight, y);
+			mesh.maxHeight = std::max(mesh.maxHeight, y);
+		}
+	}
+	return mesh;
+}
+
+void ChunkedTerrain::BuildIndices(
+    uint32_t cellCount, uint32_t stitchMask, std::vector<uint16_t>& indices) {
+	struct Point {
+		int32_t x;
+		int32_t z;
+	};
+	// 粗い隣と接する辺では奇数番目の頂点を1つ手前の偶数番目に寄せる。寄せた頂点は
+	// 粗い側の頂点と同じ位置なので、辺は粗い側の頂点だけでつながりT字の隙間ができない
+	auto snap = [&](uint32_t x, uint32_t z) {
+		if ((stitchMask & kEdgeLeft) && x == 0 && z % 2 == 1) {
+			z--;
+		}
+		if ((stitchMask & kEdgeRight) && x == cellCount && z % 2 == 1) {
+			z--;
+		}
+		if ((stitchMask & kEdgeBottom) && z == 0 && x % 2 == 1) {
+			x--;
+		}
+		if ((stitchMask & kEdgeTop) && z == cellCount && x % 2 == 1) {
+			x--;
+		}
+		return Point{int32_t(x), int32_t(z)};
+	};
+	// 寄せた結果つぶれた三角形は出力しない
+	auto triangle = [&](const Point& a, const Point& b, const Point& c) {
+		int32_t cross = (b.x - a.x) * (c.z - a.z) - (b.z - a.z) * (c.x - a.x);
+		if (cross == 0) {
+			return;
+		}
+		for (const Point& point : {a, b, c}) {
+			indices.push_back(static_cast<uint16_t>(point.z * int32_t(cellCount + 1) + point.x));
+		}
+	};
+
+	// 格子1つを時計回りの三角形2つに分ける（TerrainGridと同じ）
+	for (uint32_t z = 0; z < cellCount; z++) {
+		for (uint32_t x = 0; x < cellCount; x++) {
+			triangle(snap(x, z), snap(x, z + 1), snap(x + 1, z));
+			triangle(snap(x + 1, z), snap(x, z + 1), snap(x + 1, z + 1));
+		}
+	}
+}
+
+void ChunkedTerrain::CreateIndexBuffer() {
+	// 辺の組み合わせごとのインデックスを1つのバッファに並べる
+	std::vector<uint16_t> indices;
+	for (uint32_t mask = 0; mask < kStitchVariantCount; mask++) {
+		startIndices_[mask] = static_cast<uint32_t>(indices.size());
+		BuildIndices(config_.chunkCellCount, mask, indices);
+		indexCounts_[mask] = static_cast<uint32_t>(indices.size()) - startIndices_[mask];
+	}
+
+	UINT sizeIB = static_cast<UINT>(sizeof(uint16_t) * indices.size());
+	CopyQueue* copyQueue = CopyQueue::GetInstance();
+	indexBuff_ = copyQueue->CreateBuffer(sizeIB);
+	copyQueue->Wait(copyQueue->UploadBuffer(indexBuff_.Get(), indices.data(), sizeIB));
+
+	ibView_.BufferLocation = indexBuff_->GetGPUVirtualAddress();
+	ibView_.Format = DXGI_FORMAT_R16_UINT;
+	ibView_.SizeInBytes = sizeIB;
+}
+
+float ChunkedTerrain::Distance(const NodeKey& key) const {
+	float size = GetNodeSize(key.level);
+	float minX = float(key.x) * size;
+	float minZ = float(key.z) * size;
+	float dx = std::max({minX - cameraPosition_.x, 0.0f, cameraPosition_.x - (minX + size)});
+	float dz = std::max({minZ - cameraPosition_.z, 0.0f, cameraPosition_.z - (minZ + size)});
+	return std::sqrt(dx * dx + dz * dz);
+}
+
+bool ChunkedTerrain::IsNeeded(const NodeKey& key, float scale) const {
+	if (key.level == rootLevel_) {
+		return Distance(key) < config_.loadRadius * scale;
+	}
+	// 親が分割される距離にあれば必要
+	NodeKey parent{key.x >> 1, key.z >> 1, key.level + 1};
+	return Distance(parent) < config_.splitDistance * GetNodeSize(parent.level) * scale &&
+	       IsNeeded(parent, scale);
+}
+
+uint32_t ChunkedTerrain::GetNeighborLevel(const NodeKey& key, int32_t dx, int32_t dz) const {
+	// 隣の位置を含むノードを自身のレベルから粗い方へ探す
+	int32_t x = key.x + dx;
+	int32_t z = key.z + dz;
+	for (uint32_t level = key.level; level <= rootLevel_; level++) {
+		uint32_t shift = level - key.level;
+		if (leaves_.contains({x >> shift, z >> shift, level})) {
+			return level;
+		}
+	}
+	// 細かいノードか、読み込み範囲の外
+	return key.level;
+}
+
+bool ChunkedTerrain::IsResident(const NodeKey& key) const {
+	auto it = chunks_.find(key);
+	return it != chunks_.end() && it->second.state == Chunk::State::kResident;
+}
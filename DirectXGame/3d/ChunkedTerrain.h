@@ -0,0 +1,334 @@
+#pragma once
+
+#include "CopyQueue.h"
+#include "PerlinNoise.h"
+#include "Shapes.h"
+#include "Terrain.h"
+#include <cstdint>
+#include <d3d12.h>
+#include <functional>
+#include <future>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <wrl.h>
+
+class FrustumCuller;
+
+/// <summary>
+/// チャンク分割・四分木LODの地形
+/// </summary>
+/// <remarks>
+/// 地形を一辺が chunkSize * 2^level の正方形（ノード）に区切り、カメラに近いノードほど
+/// 細かいレベルに分割する。どのレベルのチャンクも同じ頂点数なので、遠くほど粗くなる。
+/// 分割の距離をノードの一辺の1倍以上にすると隣り合うチャンクのレベル差は1以下になり、
+/// 粗い側と接する辺は奇数番目の頂点を飛ばしたインデックスで描いて隙間をなくす。
+/// チャンクの頂点はワーカースレッドで生成し、コピーキューで転送する。
+/// 遠ざかったチャンクは破棄し、頂点バッファは次のチャンクに使い回す。
+/// 描画はTerrainGridと同じパイプラインを使うので、TerrainGrid::StaticInitializeが必要。
+/// </remarks>
+class ChunkedTerrain {
+public: // サブクラス
+	// 頂点データ構造体（Terrainと同じ）
+	using VertexPosNormalUv = Terrain::VertexPosNormalUv;
+
+	/// <summary>
+	/// 高さの供給元。result[i]に座標(x0 + i * dx, z)の高さを書き込む
+	/// </summary>
+	/// <remarks>ワーカースレッドから同時に呼ばれるので、スレッドセーフにすること</remarks>
+	using HeightSource =
+	    std::function<void(float x0, float dx, float z, std::span<float> result)>;
+
+	/// <summary>
+	/// 設定
+	/// </summary>
+	struct Config {
+		float chunkSize = 32.0f;          // 最も細かいチャンクの一辺
+		uint32_t chunkCellCount = 32;     // チャンク一辺のセル数（偶数）
+		uint32_t levelCount = 5;          // LODのレベル数
+		float splitDistance = 2.0f;       // ノードの一辺の何倍より近ければ分割するか（1以上）
+		float loadRadius = 1024.0f;       // 最も粗いノードを読み込む半径
+		float evictHysteresis = 1.25f;    // 破棄する距離の倍率（読み込みとの往復を防ぐ）
+		uint32_t maxRequestsPerFrame = 8; // 1フレームに発行する生成の最大数
+		uint32_t maxPendingCount = 32;    // 生成・転送中のチャンクの最大数
+	};
+
+	/// <summary>
+	/// ノードの識別子。levelは0が最も細かく、(x, z)はそのレベルの一辺で区切った格子の番号
+	/// </summary>
+	struct NodeKey {
+		int32_t x = 0;
+		int32_t z = 0;
+		uint32_t level = 0;
+
+		bool operator==(const NodeKey&) const = default;
+	};
+
+	/// <summary>
+	/// NodeKeyのハッシュ
+	/// </summary>
+	struct NodeKeyHash {
+		size_t operator()(const NodeKey& key) const;
+	};
+
+	/// <summary>
+	/// フレームごとの統計
+	/// </summary>
+	struct Statistics {
+		uint32_t residentCount = 0; // 描画可能なチャンク数
+		uint32_t pendingCount = 0;  // 生成・転送中のチャンク数
+		uint32_t leafCount = 0;     // 選ばれたノード数
+		uint32_t requestCount = 0;  // 今フレームに発行した生成数
+		uint32_t evictCount = 0;    // 今フレームに破棄したチャンク数
+		uint32_t drawCount = 0;     // 描画したチャンク数
+		uint32_t triangleCount = 0; // 描画した三角形数
+	};
+
+public: // 静的メンバ関数
+	/// <summary>
+	/// パーリンノイズによる高さの供給元を作る。高さは[0, height]になる
+	/// </summary>
+	/// <param name="noise">ノイズ（複製して持つ）</param>
+	/// <param name="fractal">オクターブの設定</param>
+	/// <param name="noiseScale">ノイズの格子1つ分の距離</param>
+	/// <param name="height">高さ</param>
+	/// <returns>高さの供給元</returns>
+	static HeightSource CreateNoiseSource(
+	    const PerlinNoise& noise, const PerlinNoise::Fractal& fractal = {},
+	    float noiseScale = 64.0f, float height = 32.0f);
+
+public: // メンバ関数
+	ChunkedTerrain() = default;
+	~ChunkedTerrain() { Finalize(); }
+	// コピー禁止（生成中のジョブが自身を参照する）
+	ChunkedTerrain(const ChunkedTerrain&) = delete;
+	ChunkedTerrain& operator=(const ChunkedTerrain&) = delete;
+
+	/// <summary>
+	/// 初期化（共有のインデックスバッファを作る）
+	/// </summary>
+	/// <param name="config">設定</param>
+	/// <param name="heightSource">高さの供給元</param>
+	void Initialize(const Config& config, HeightSource heightSource);
+
+	/// <summary>
+	/// 終了処理。生成中のチャンクを待ってから全て解放する
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// 毎フレーム処理。生成の済んだチャンクを転送し、描画するノードを選び、
+	/// 足りないチャンクの生成と遠いチャンクの破棄を行う
+	/// </summary>
+	/// <remarks>
+	/// 破棄したバッファはすぐに使い回すので、前フレームの描画が終わった後に呼ぶこと
+	/// （DirectXCommon::PostDrawはGPUの完了を待つので、Updateで呼べばよい）
+	/// </remarks>
+	/// <param name="cameraPosition">地形のローカル座標系でのカメラ位置</param>
+	void Update(const Vector3& cameraPosition);
+
+	/// <summary>
+	/// 描画
+	/// </summary>
+	/// <param name="worldTransform">ワールドトランスフォーム</param>
+	/// <param name="viewProjection">ビュープロジェクション</param>
+	/// <param name="textureHadle">テクスチャハンドル</param>
+	/// <param name="culler">視錐台カリング（nullptrなら全て描画する）</param>
+	void Draw(
+	    const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+	    uint32_t textureHadle, FrustumCuller* culler = nullptr);
+
+	/// <summary>
+	/// ノードの一辺の取得
+	/// </summary>
+	/// <param name="level">レベル</param>
+	float GetNodeSize(uint32_t level) const { return config_.chunkSize * float(1u << level); }
+
+	/// <summary>
+	/// 設定の取得
+	/// </summary>
+	const Config& GetConfig() const { return config_; }
+
+	/// <summary>
+	/// 統計の取得
+	/// </summary>
+	const Statistics& GetStatistics() const { return statistics_; }
+
+private: // サブクラス
+	/// <summary>
+	/// 生成したチャンクの頂点
+	/// </summary>
+	struct ChunkMesh {
+		std::vector<VertexPosNormalUv> vertices;
+		float minHeight = 0.0f;
+		float maxHeight = 0.0f;
+	};
+
+	/// <summary>
+	/// チャンク
+	/// </summary>
+	struct Chunk {
+		enum class State {
+			kGenerating, // ワーカースレッドで頂点を生成中
+			kUploading,  // コピーキューで転送中
+			kResident,   // 描画可能
+		};
+		State state = State::kGenerating;
+		// 生成結果
+		std::future<ChunkMesh> mesh;
+		// 頂点バッファ
+		Microsoft::WRL::ComPtr<ID3D12Resource> vertBuff;
+		// 頂点バッファビュー
+		D3D12_VERTEX_BUFFER_VIEW vbView = {};
+		// 転送完了のチケット
+		CopyQueue::Ticket ticket = 0;
+		// ローカル座標系の境界
+		AABB bounds = {};
+	};
+
+	/// <summary>
+	/// 描画するノード
+	/// </summary>
+	struct DrawItem {
+		NodeKey key;
+		// 粗い隣と接する辺（EdgeFlagの組み合わせ）
+		uint32_t stitchMask = 0;
+		// カメラとの距離
+		float distance = 0.0f;
+	};
+
+	/// <summary>
+	/// 生成の要求
+	/// </summary>
+	struct LoadRequest {
+		NodeKey key;
+		// カメラとの距離
+		float distance = 0.0f;
+	};
+
+	/// <summary>
+	/// 辺
+	/// </summary>
+	enum EdgeFlag : uint32_t {
+		kEdgeLeft = 1 << 0,   // -x
+		kEdgeRight = 1 << 1,  // +x
+		kEdgeBottom = 1 << 2, // -z
+		kEdgeTop = 1 << 3,    // +z
+	};
+
+	// 辺の組み合わせの数（インデックスの種類）
+	static constexpr uint32_t kStitchVariantCount = 16;
+	// 使い回す頂点バッファの最大数
+	static constexpr size_t kMaxFreeBufferCount = 64;
+
+private: // 静的メンバ関数
+	/// <summary>
+	/// 辺の組み合わせごとのインデックス生成
+	/// </summary>
+	/// <param name="cellCount">一辺のセル数</param>
+	/// <param name="stitchMask">粗い隣と接する辺</param>
+	/// <param name="indices">インデックス（末尾に追加する）</param>
+	static void BuildIndices(
+	    uint32_t cellCount, uint32_t stitchMask, std::vector<uint16_t>& indices);
+
+private: // メンバ関数
+	/// <summary>
+	/// 生成・転送の進行
+	/// </summary>
+	void UpdateChunks();
+
+	/// <summary>
+	/// ノードを選ぶ。描画するノードはleaves_に、足りないチャンクはrequests_に加える
+	/// </summary>
+	void Select(const NodeKey& key);
+
+	/// <summary>
+	/// 隣とのレベル差が2以上になったノードを親にまとめる
+	/// </summary>
+	void Balance();
+
+	/// <summary>
+	/// 描画するノードの一覧を作る
+	/// </summary>
+	void BuildDrawList();
+
+	/// <summary>
+	/// 生成の発行
+	/// </summary>
+	void IssueRequests();
+
+	/// <summary>
+	/// 遠いチャンクの破棄
+	/// </summary>
+	void Evict();
+
+	/// <summary>
+	/// 生成を要求する
+	/// </summary>
+	void Request(const NodeKey& key);
+
+	/// <summary>
+	/// チャンクの頂点の生成（ワーカースレッドで実行する）
+	/// </summary>
+	ChunkMesh Generate(const NodeKey& key) const;
+
+	/// <summary>
+	/// 共有のインデックスバッファ生成
+	/// </summary>
+	void CreateIndexBuffer();
+
+	/// <summary>
+	/// カメラからノードまでの水平距離
+	/// </summary>
+	float Distance(const NodeKey& key) const;
+
+	/// <summary>
+	/// ノードが必要か（破棄の判定）
+	/// </summary>
+	/// <param name="key">ノード</param>
+	/// <param name="scale">距離の倍率</param>
+	bool IsNeeded(const NodeKey& key, float scale) const;
+
+	/// <summary>
+	/// 辺の向こうにある選ばれたノードのレベル（同じか粗いものが無ければ自身のレベル）
+	/// </summary>
+	uint32_t GetNeighborLevel(const NodeKey& key, int32_t dx, int32_t dz) const;
+
+	/// <summary>
+	/// チャンクが描画可能か
+	/// </summary>
+	bool IsResident(const NodeKey& key) const;
+
+private: // メンバ変数
+	// 設定
+	Config config_;
+	// 高さの供給元
+	HeightSource heightSource_;
+	// 最も粗いレベル
+	uint32_t rootLevel_ = 0;
+	// 1チャンクの頂点バッファのサイズ
+	UINT vertexBufferSize_ = 0;
+	// カメラ位置
+	Vector3 cameraPosition_ = {};
+	// チャンク
+	std::unordered_map<NodeKey, Chunk, NodeKeyHash> chunks_;
+	// 選ばれたノード
+	std::unordered_set<NodeKey, NodeKeyHash> leaves_;
+	// 描画するノード（近い順）
+	std::vector<DrawItem> drawList_;
+	// 生成を要求されたノード
+	std::vector<LoadRequest> requests_;
+	// 使い回す頂点バッファ
+	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> freeBuffers_;
+	// インデックスバッファ（辺の組み合わせごとのインデックスを並べたもの）
+	Microsoft::WRL::ComPtr<ID3D12Resource> indexBuff_;
+	// インデックスバッファビュー
+	D3D12_INDEX_BUFFER_VIEW ibView_ = {};
+	// 辺の組み合わせごとのインデックスの開始位置
+	uint32_t startIndices_[kStitchVariantCount] = {};
+	// 辺の組み合わせごとのインデックス数
+	uint32_t indexCounts_[kStitchVariantCount] = {};
+	// 統計
+	Statistics statistics_;
+};
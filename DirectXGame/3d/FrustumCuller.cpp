@@ -0,0 +1,141 @@
+#include "FrustumCuller.h"
+#include "MathUtility.h"
+
+namespace {
+
+#if defined(MATH_ENABLE_SSE)
+/// <summary>
+/// 4個分の中心と投影半径が全平面の内側にあるか
+/// </summary>
+/// <param name="radiusOf">平面の法線の絶対値から投影半径を求める処理</param>
+template<class RadiusFunc>
+int TestPlanes(
+    const Frustum& frustum, __m128 centerX, __m128 centerY, __m128 centerZ, RadiusFunc radiusOf) {
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	__m128 outside = _mm_setzero_ps();
+	for (const Plane& plane : frustum.planes) {
+		__m128 nx = _mm_set1_ps(plane.normal.x);
+		__m128 ny = _mm_set1_ps(plane.normal.y);
+		__m128 nz = _mm_set1_ps(plane.normal.z);
+		__m128 distance = _mm_mul_ps(nx, centerX);
+		distance = _mm_add_ps(distance, _mm_mul_ps(ny, centerY));
+		distance = _mm_add_ps(distance, _mm_mul_ps(nz, centerZ));
+		distance = _mm_sub_ps(distance, _mm_set1_ps(plane.distance));
+		__m128 radius = radiusOf(
+		    _mm_andnot_ps(signMask, nx), _mm_andnot_ps(signMask, ny),
+		    _mm_andnot_ps(signMask, nz));
+		// distance < -radius なら外側
+		outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+	}
+	// 見えているレーンのビットを立てる
+	return ~_mm_movemask_ps(outside) & 0xf;
+}
+
+/// <summary>
+/// ビットの立っている番号を追加
+/// </summary>
+size_t PushVisible(int mask, size_t base, size_t count, std::vector<uint32_t>& visibleIndices) {
+	size_t visible = 0;
+	for (size_t i = 0; i < count; i++) {
+		if (mask & (1 << i)) {
+			visibleIndices.push_back(static_cast<uint32_t>(base + i));
+			visible++;
+		}
+	}
+	return visible;
+}
+#endif
+
+} // namespace
+
+void FrustumCuller::BeginFrame(const ViewProjection& viewProjection) {
+	frustum_ = viewProjection.GetFrustum();
+	statistics_ = {};
+}
+
+bool FrustumCuller::IsVisible(const Sphere& sphere) {
+	bool visible = MathUtility::IsIntersect(frustum_, sphere);
+	Count(1, visible ? 1 : 0);
+	return visible;
+}
+
+bool FrustumCuller::IsVisible(const AABB& aabb) {
+	bool visible = MathUtility::IsIntersect(frustum_, aabb);
+	Count(1, visible ? 1 : 0);
+	return visible;
+}
+
+size_t FrustumCuller::Cull(std::span<const Sphere> spheres, std::vector<uint32_t>& visibleIndices) {
+	size_t visible = 0;
+	size_t i = 0;
+#if defined(MATH_ENABLE_SSE)
+	for (; i + 4 <= spheres.size(); i += 4) {
+		// 4個の球を転置して x, y, z, 半径 の並びにする
+		__m128 x = _mm_loadu_ps(&spheres[i].center.x);
+		__m128 y = _mm_loadu_ps(&spheres[i + 1].center.x);
+		__m128 z = _mm_loadu_ps(&spheres[i + 2].center.x);
+		__m128 r = _mm_loadu_ps(&spheres[i + 3].center.x);
+		_MM_TRANSPOSE4_PS(x, y, z, r);
+		int mask = TestPlanes(frustum_, x, y, z, [r](__m128, __m128, __m128) { return r; });
+		visible += PushVisible(mask, i, 4, visibleIndices);
+	}
+#endif
+	// 端数
+	for (; i < spheres.size(); i++) {
+		if (MathUtility::IsIntersect(frustum_, spheres[i])) {
+			visibleIndices.push_back(static_cast<uint32_t>(i));
+			visible++;
+		}
+	}
+
+	Count(spheres.size(), visible);
+	return visible;
+}
+
+size_t FrustumCuller::Cull(std::span<const AABB> aabbs, std::vector<uint32_t>& visibleIndices) {
+	size_t visible = 0;
+	size_t i = 0;
+#if defined(MATH_ENABLE_SSE)
+	for (; i + 4 <= aabbs.size(); i += 4) {
+		const AABB* a = &aabbs[i];
+		__m128 minX = _mm_setr_ps(a[0].min.x, a[1].min.x, a[2].min.x, a[3].min.x);
+		__m128 minY = _mm_setr_ps(a[0].min.y, a[1].min.y, a[2].min.y, a[3].min.y);
+		__m128 minZ = _mm_setr_ps(a[0].min.z, a[1].min.z, a[2].min.z, a[3].min.z);
+		__m128 maxX = _mm_setr_ps(a[0].max.x, a[1].max.x, a[2].max.x, a[3].max.x);
+		__m128 maxY = _mm_setr_ps(a[0].max.y, a[1].max.y, a[2].max.y, a[3].max.y);
+		__m128 maxZ = _mm_setr_ps(a[0].max.z, a[1].max.z, a[2].max.z, a[3].max.z);
+		// 中心と中心から各面までの距離
+		__m128 half = _mm_set1_ps(0.5f);
+		__m128 centerX = _mm_mul_ps(_mm_add_ps(minX, maxX), half);
+		__m128 centerY = _mm_mul_ps(_mm_add_ps(minY, maxY), half);
+		__m128 centerZ = _mm_mul_ps(_mm_add_ps(minZ, maxZ), half);
+		__m128 extentX = _mm_mul_ps(_mm_sub_ps(maxX, minX), half);
+		__m128 extentY = _mm_mul_ps(_mm_sub_ps(maxY, minY), half);
+		__m128 extentZ = _mm_mul_ps(_mm_sub_ps(maxZ, minZ), half);
+		int mask = TestPlanes(
+		    frustum_, centerX, centerY, centerZ,
+		    [extentX, extentY, extentZ](__m128 nx, __m128 ny, __m128 nz) {
+			    __m128 radius = _mm_mul_ps(extentX, nx);
+			    radius = _mm_add_ps(radius, _mm_mul_ps(extentY, ny));
+			    return _mm_add_ps(radius, _mm_mul_ps(extentZ, nz));
+		    });
+		visible += PushVisible(mask, i, 4, visibleIndices);
+	}
+#endif
+	// 端数
+	for (; i < aabbs.size(); i++) {
+		if (MathUtility::IsIntersect(frustum_, aabbs[i])) {
+			visibleIndices.push_back(static_cast<uint32_t>(i));
+			visible++;
+		}
+	}
+
+	Count(aabbs.size(), visible);
+	return visible;
+}
+
+void FrustumCuller::Count(size_t tested, size_t visible) {
+	statistics_.tested += static_cast<uint32_t>(tested);
+	statistics_.visible += static_cast<uint32_t>(visible);
+	statistics_.culled += static_cast<uint32_t>(tested - visible);
+}
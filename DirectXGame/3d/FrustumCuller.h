@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Shapes.h"
+#include "ViewProjection.h"
+#include "WorldTransform.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/// <summary>
+/// 視錐台カリング
+/// </summary>
+/// <remarks>
+/// BeginFrameでViewProjectionから視錐台を取り出し、そのフレームの判定に使う。
+/// 配列版はSIMDで4個ずつ判定し、見えているものの番号だけを返す。
+/// </remarks>
+class FrustumCuller {
+public: // サブクラス
+	/// <summary>
+	/// フレームごとの統計
+	/// </summary>
+	struct Statistics {
+		uint32_t tested = 0;  // 判定した数
+		uint32_t visible = 0; // 見えている数
+		uint32_t culled = 0;  // 除外した数
+	};
+
+public: // メンバ関数
+	/// <summary>
+	/// フレーム開始処理。視錐台を更新し、統計をリセットする
+	/// </summary>
+	/// <param name="viewProjection">UpdateMatrix済みのビュープロジェクション</param>
+	void BeginFrame(const ViewProjection& viewProjection);
+
+	/// <summary>
+	/// 視錐台の取得
+	/// </summary>
+	const Frustum& GetFrustum() const { return frustum_; }
+
+	/// <summary>
+	/// 球が見えているか
+	/// </summary>
+	/// <param name="sphere">ワールド座標系の球</param>
+	bool IsVisible(const Sphere& sphere);
+
+	/// <summary>
+	/// AABBが見えているか
+	/// </summary>
+	/// <param name="aabb">ワールド座標系のAABB</param>
+	bool IsVisible(const AABB& aabb);
+
+	/// <summary>
+	/// モデルが見えているか
+	/// </summary>
+	/// <param name="localBounds">モデル座標系の境界球（Model::CalculateBoundingSphere）</param>
+	/// <param name="worldTransform">ワールドトランスフォーム</param>
+	bool IsVisible(const Sphere& localBounds, const WorldTransform& worldTransform) {
+		return IsVisible(MathUtility::Transform(localBounds, worldTransform.matWorld_));
+	}
+
+	/// <summary>
+	/// 球の一括判定
+	/// </summary>
+	/// <param name="spheres">ワールド座標系の球</param>
+	/// <param name="visibleIndices">見えている球の番号（末尾に追加する）</param>
+	/// <returns>見えている数</returns>
+	size_t Cull(std::span<const Sphere> spheres, std::vector<uint32_t>& visibleIndices);
+
+	/// <summary>
+	/// AABBの一括判定
+	/// </summary>
+	/// <param name="aabbs">ワールド座標系のAABB</param>
+	/// <param name="visibleIndices">見えているAABBの番号（末尾に追加する）</param>
+	/// <returns>見えている数</returns>
+	size_t Cull(std::span<const AABB> aabbs, std::vector<uint32_t>& visibleIndices);
+
+	/// <summary>
+	/// 今フレームの統計を取得
+	/// </summary>
+	/// <returns>統計</returns>
+	const Statistics& GetStatistics() const { return statistics_; }
+
+private: // メンバ関数
+	/// <summary>
+	/// 統計へ加算
+	/// </summary>
+	void Count(size_t tested, size_t visible);
+
+private: // メンバ変数
+	// 視錐台
+	Frustum frustum_{};
+	// 統計
+	Statistics statistics_;
+};
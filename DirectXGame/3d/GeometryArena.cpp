@@ -0,0 +1,247 @@
+#include "GeometryArena.h"
+#include "MeshOptimizer.h"
+#include "Model.h"
+#include <algorithm>
+#include <cassert>
+
+namespace {
+
+/// <summary>
+/// alignmentの倍数に切り上げ
+/// </summary>
+uint64_t AlignUp(uint64_t size, uint64_t alignment) {
+	return (size + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+void Mesh::SetBuffers(
+    ID3D12Resource* buffer, const D3D12_VERTEX_BUFFER_VIEW& vbView,
+    const D3D12_INDEX_BUFFER_VIEW& ibView) {
+	// 頂点とインデックスは同じバッファを参照する
+	vertBuff_ = buffer;
+	indexBuff_ = buffer;
+	vbView_ = vbView;
+	ibView_ = ibView;
+}
+
+GeometryArena* GeometryArena::GetInstance() {
+	static GeometryArena instance;
+	return &instance;
+}
+
+void GeometryArena::Initialize(uint64_t pageSize) {
+	// 多重初期化禁止
+	assert(!IsInitialized());
+	assert(0 < pageSize);
+
+	pageSize_ = AlignUp(pageSize, kAlignment);
+}
+
+void GeometryArena::Finalize() {
+	pages_.clear();
+	ranges_.clear();
+	pageSize_ = 0;
+}
+
+CopyQueue::Ticket GeometryArena::Upload(Mesh* mesh) {
+	assert(IsInitialized());
+	assert(mesh);
+	auto it = ranges_.find(mesh);
+	if (it != ranges_.end()) {
+		// 配置済みのメッシュは一度Releaseすること
+		assert(!IsOwnedBy(it->second, mesh));
+		// 解放されずに破棄されたメッシュの配置が残っているので回収する
+		Free(it->second.page, it->second.offset, it->second.size);
+		ranges_.erase(it);
+	}
+
+	const std::vector<Mesh::VertexPosNormalUv>& vertices = mesh->GetVertices();
+	const std::vector<uint32_t>& indices = mesh->GetIndices();
+
+	// 頂点数が収まれば16ビットインデックスにして転送量を半分にする
+	bool is16Bit = MeshOptimizer::CanUse16BitIndices(vertices.size());
+	std::vector<uint16_t> indices16;
+	if (is16Bit) {
+		indices16.reserve(indices.size());
+		for (uint32_t index : indices) {
+			indices16.push_back(static_cast<uint16_t>(index));
+		}
+	}
+
+	uint64_t indexStride = is16Bit ? sizeof(uint16_t) : sizeof(uint32_t);
+	uint64_t sizeVB = sizeof(Mesh::VertexPosNormalUv) * vertices.size();
+	uint64_t sizeIB = indexStride * indices.size();
+	assert(0 < sizeVB && 0 < sizeIB);
+
+	// 頂点の直後にインデックスを置き、1回の確保で同じページにそろえる
+	uint64_t offsetIB = AlignUp(sizeVB, kAlignment);
+	MeshRange range{};
+	range.size = AlignUp(offsetIB + sizeIB, kAlignment);
+	Allocate(range.size, range.page, range.offset);
+	offsetIB += range.offset;
+
+	Page& page = pages_[range.page];
+	D3D12_GPU_VIRTUAL_ADDRESS address = page.buffer->GetGPUVirtualAddress();
+
+	// 転送（バッファは同時アクセス可能なので、描画中の他の範囲と並行して書き込める）
+	CopyQueue* copyQueue = CopyQueue::GetInstance();
+	copyQueue->UploadBuffer(page.buffer.Get(), range.offset, vertices.data(), sizeVB);
+	const void* indexData = is16Bit ? static_cast<const void*>(indices16.data()) : indices.data();
+	CopyQueue::Ticket ticket =
+	    copyQueue->UploadBuffer(page.buffer.Get(), offsetIB, indexData, sizeIB);
+
+	// ページ全体のビュー（オフセットは描画時に指定する）
+	range.vbView.BufferLocation = address;
+	range.vbView.SizeInBytes = static_cast<UINT>(page.size);
+	range.vbView.StrideInBytes = sizeof(Mesh::VertexPosNormalUv);
+	range.ibView.BufferLocation = address;
+	range.ibView.Format = is16Bit ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+	range.ibView.SizeInBytes = static_cast<UINT>(page.size);
+	range.baseVertex = static_cast<uint32_t>(range.offset / kAlignment);
+	range.startIndex = static_cast<uint32_t>(offsetIB / indexStride);
+	range.indexCount = static_cast<uint32_t>(indices.size());
+
+	// メッシュ自身のビューは切り出した範囲だけを指す
+	D3D12_VERTEX_BUFFER_VIEW vbView{};
+	vbView.BufferLocation = address + range.offset;
+	vbView.SizeInBytes = static_cast<UINT>(sizeVB);
+	vbView.StrideInBytes = sizeof(Mesh::VertexPosNormalUv);
+	D3D12_INDEX_BUFFER_VIEW ibView{};
+	ibView.BufferLocation = address + offsetIB;
+	ibView.Format = range.ibView.Format;
+	ibView.SizeInBytes = static_cast<UINT>(sizeIB);
+	mesh->SetBuffers(page.buffer.Get(), vbView, ibView);
+
+	range.location = vbView.BufferLocation;
+	ranges_.emplace(mesh, range);
+	return ticket;
+}
+
+CopyQueue::Ticket GeometryArena::Upload(Model* model) {
+	assert(model);
+	CopyQueue::Ticket ticket = 0;
+	for (auto& mesh : model->GetMeshes()) {
+		ticket = Upload(mesh.get());
+	}
+	return ticket;
+}
+
+void GeometryArena::Release(Mesh* mesh) {
+	auto it = ranges_.find(mesh);
+	if (it == ranges_.end()) {
+		return;
+	}
+	bool isOwned = IsOwnedBy(it->second, mesh);
+	Free(it->second.page, it->second.offset, it->second.size);
+	ranges_.erase(it);
+	// 古い配置だった場合、今のメッシュは自分のバッファを持っているので触らない
+	if (isOwned) {
+		mesh->SetBuffers(nullptr, {}, {});
+	}
+}
+
+void GeometryArena::Release(Model* model) {
+	assert(model);
+	for (auto& mesh : model->GetMeshes()) {
+		Release(mesh.get());
+	}
+}
+
+void GeometryArena::ModelDeleter::operator()(Model* model) const {
+	GeometryArena* geometryArena = GeometryArena::GetInstance();
+	if (geometryArena->IsInitialized()) {
+		geometryArena->Release(model);
+	}
+	delete model;
+}
+
+const GeometryArena::MeshRange* GeometryArena::Find(const Mesh* mesh) const {
+	auto it = ranges_.find(mesh);
+	return it != ranges_.end() && IsOwnedBy(it->second, mesh) ? &it->second : nullptr;
+}
+
+GeometryArena::Statistics GeometryArena::GetStatistics() const {
+	Statistics statistics;
+	statistics.pageCount = static_cast<uint32_t>(pages_.size());
+	statistics.meshCount = static_cast<uint32_t>(ranges_.size());
+	uint64_t freeSize = 0;
+	for (const Page& page : pages_) {
+		statistics.capacity += page.size;
+		for (const auto& [offset, size] : page.freeBlocks) {
+			freeSize += size;
+			statistics.largestFreeBlock = std::max(statistics.largestFreeBlock, size);
+			statistics.freeBlockCount++;
+		}
+	}
+	statistics.usedSize = statistics.capacity - freeSize;
+	if (0 < statistics.capacity) {
+		statistics.occupancy = float(statistics.usedSize) / float(statistics.capacity);
+	}
+	if (0 < freeSize) {
+		statistics.fragmentation = 1.0f - float(statistics.largestFreeBlock) / float(freeSize);
+	}
+	return statistics;
+}
+
+void GeometryArena::Allocate(uint64_t size, uint32_t& page, uint64_t& offset) {
+	// 全ページから最もぴったりの空き領域を探す
+	uint32_t bestPage = UINT32_MAX;
+	uint64_t bestOffset = 0;
+	uint64_t bestSize = UINT64_MAX;
+	for (uint32_t i = 0; i < pages_.size(); i++) {
+		for (const auto& [blockOffset, blockSize] : pages_[i].freeBlocks) {
+			if (size <= blockSize && blockSize < bestSize) {
+				bestPage = i;
+				bestOffset = blockOffset;
+				bestSize = blockSize;
+			}
+		}
+	}
+
+	// 足りなければページを追加（大きいメッシュは専用のページにする）
+	if (bestPage == UINT32_MAX) {
+		Page& newPage = pages_.emplace_back();
+		newPage.size = std::max(pageSize_, size);
+		newPage.buffer = CopyQueue::GetInstance()->CreateBuffer(newPage.size);
+		newPage.freeBlocks.emplace(0, newPage.size);
+		bestPage = static_cast<uint32_t>(pages_.size() - 1);
+		bestOffset = 0;
+		bestSize = newPage.size;
+	}
+
+	// 先頭から切り出し、残りを空き領域に戻す
+	std::map<uint64_t, uint64_t>& freeBlocks = pages_[bestPage].freeBlocks;
+	freeBlocks.erase(bestOffset);
+	if (size < bestSize) {
+		freeBlocks.emplace(bestOffset + size, bestSize - size);
+	}
+	page = bestPage;
+	offset = bestOffset;
+}
+
+bool GeometryArena::IsOwnedBy(const MeshRange& range, const Mesh* mesh) {
+	// 配置した領域は解放するまで他に使われないので、先頭のアドレスで持ち主が決まる
+	return mesh->GetVBView().BufferLocation == range.location;
+}
+
+void GeometryArena::Free(uint32_t page, uint64_t offset, uint64_t size) {
+	assert(page < pages_.size());
+	std::map<uint64_t, uint64_t>& freeBlocks = pages_[page].freeBlocks;
+
+	// 後ろの空き領域と結合
+	auto next = freeBlocks.lower_bound(offset);
+	if (next != freeBlocks.end() && next->first == offset + size) {
+		size += next->second;
+		next = freeBlocks.erase(next);
+	}
+	// 前の空き領域と結合
+	if (next != freeBlocks.begin()) {
+		auto prev = std::prev(next);
+		if (prev->first + prev->second == offset) {
+			prev->second += size;
+			return;
+		}
+	}
+	freeBlocks.emplace_hint(next, offset, size);
+}
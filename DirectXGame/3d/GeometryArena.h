@@ -0,0 +1,181 @@
+#pragma once
+
+#include "CopyQueue.h"
+#include "Mesh.h"
+#include <cstdint>
+#include <d3d12.h>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <wrl.h>
+
+class Model;
+
+/// <summary>
+/// 静的メッシュの頂点・インデックスをまとめて置く大きなバッファ
+/// </summary>
+/// <remarks>
+/// メッシュごとにバッファを作る代わりに、数枚の大きなバッファ（ページ）から切り出して使う。
+/// メッシュの頂点・インデックスバッファビューは切り出した範囲を指すので、Mesh::Drawはそのまま
+/// 使える。RenderQueueはページ全体のビューを1度設定し、描画ごとにオフセットだけを変える。
+/// 確保・解放・検索はメインスレッドで、コマンドの記録と並行しないように行うこと。
+/// ModelやMeshのデストラクタは領域を解放しないので、破棄する前にReleaseを呼ぶか、
+/// ModelDeleterを持つunique_ptrで持つこと。解放し忘れた配置は検索ではビューの照合で無視し、
+/// 同じアドレスのメッシュを配置・解放するときに回収する。
+/// </remarks>
+class GeometryArena {
+public: // サブクラス
+	/// <summary>
+	/// メッシュの配置
+	/// </summary>
+	struct MeshRange {
+		D3D12_VERTEX_BUFFER_VIEW vbView;    // ページ全体の頂点バッファビュー
+		D3D12_INDEX_BUFFER_VIEW ibView;     // ページ全体のインデックスバッファビュー
+		uint32_t baseVertex;                // ページ先頭からの頂点番号
+		uint32_t startIndex;                // ページ先頭からのインデックス番号
+		uint32_t indexCount;                // インデックス数
+		uint32_t page;                      // ページ番号
+		uint64_t offset;                    // ページ内の先頭
+		uint64_t size;                      // 確保したサイズ
+		D3D12_GPU_VIRTUAL_ADDRESS location; // メッシュの頂点バッファビューの先頭（照合用）
+	};
+
+	/// <summary>
+	/// モデルの領域を解放してから破棄するデリーター
+	/// </summary>
+	struct ModelDeleter {
+		void operator()(Model* model) const;
+	};
+
+	/// <summary>
+	/// 使用状況
+	/// </summary>
+	struct Statistics {
+		uint32_t pageCount = 0;        // ページ数
+		uint32_t meshCount = 0;        // 配置したメッシュ数
+		uint64_t capacity = 0;         // 全ページの容量
+		uint64_t usedSize = 0;         // 使用中のサイズ
+		uint32_t freeBlockCount = 0;   // 空き領域の数
+		uint64_t largestFreeBlock = 0; // 最大の空き領域
+		float occupancy = 0.0f;        // 使用率（usedSize / capacity）
+		float fragmentation = 0.0f;    // 断片化率（1 - 最大の空き領域 / 空き容量の合計）
+	};
+
+	// ページの既定の大きさ
+	static constexpr uint64_t kDefaultPageSize = 32ull << 20;
+	// 切り出しの単位（頂点の大きさにそろえ、ページ先頭からの頂点番号で描けるようにする）
+	static constexpr uint64_t kAlignment = sizeof(Mesh::VertexPosNormalUv);
+
+public: // 静的メンバ関数
+	/// <summary>
+	/// シングルトンインスタンスの取得
+	/// </summary>
+	/// <returns>シングルトンインスタンス</returns>
+	static GeometryArena* GetInstance();
+
+public: // メンバ関数
+	/// <summary>
+	/// 初期化。以降Model::CreateFromOBJFast/CreateFromOBJBatchのメッシュはここに置かれる
+	/// </summary>
+	/// <param name="pageSize">ページの大きさ（これより大きいメッシュは専用のページになる）</param>
+	void Initialize(uint64_t pageSize = kDefaultPageSize);
+
+	/// <summary>
+	/// 終了処理。全てのページを解放する
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// 初期化済みか
+	/// </summary>
+	bool IsInitialized() const { return pageSize_ != 0; }
+
+	/// <summary>
+	/// メッシュの頂点とインデックスを切り出した領域へ転送し、メッシュのビューを差し替える
+	/// </summary>
+	/// <remarks>頂点数が65536以下なら16ビットインデックスにする</remarks>
+	/// <param name="mesh">メッシュ</param>
+	/// <returns>チケット。完了するまで描画に使わないこと</returns>
+	CopyQueue::Ticket Upload(Mesh* mesh);
+
+	/// <summary>
+	/// モデルの全メッシュを転送する
+	/// </summary>
+	/// <param name="model">モデル</param>
+	/// <returns>最後の転送のチケット</returns>
+	CopyQueue::Ticket Upload(Model* model);
+
+	/// <summary>
+	/// メッシュの領域を解放する。GPUが描画に使い終わってから、メッシュを破棄する前に呼ぶこと
+	/// </summary>
+	/// <param name="mesh">メッシュ</param>
+	void Release(Mesh* mesh);
+
+	/// <summary>
+	/// モデルの全メッシュの領域を解放する
+	/// </summary>
+	/// <param name="model">モデル</param>
+	void Release(Model* model);
+
+	/// <summary>
+	/// メッシュの配置を検索
+	/// </summary>
+	/// <remarks>
+	/// メッシュの頂点バッファビューが配置した領域を指していなければ、解放されずに破棄された
+	/// 別のメッシュの配置なのでnullptrを返す
+	/// </remarks>
+	/// <param name="mesh">メッシュ</param>
+	/// <returns>配置（アリーナになければnullptr）</returns>
+	const MeshRange* Find(const Mesh* mesh) const;
+
+	/// <summary>
+	/// 使用状況の取得
+	/// </summary>
+	/// <returns>使用状況</returns>
+	Statistics GetStatistics() const;
+
+private: // サブクラス
+	// ページ
+	struct Page {
+		Microsoft::WRL::ComPtr<ID3D12Resource> buffer;
+		uint64_t size = 0;
+		// 空き領域（先頭→大きさ）。隣接する空き領域は常に結合しておく
+		std::map<uint64_t, uint64_t> freeBlocks;
+	};
+
+private: // メンバ関数
+	GeometryArena() = default;
+	~GeometryArena() = default;
+	// コピー禁止
+	GeometryArena(const GeometryArena&) = delete;
+	GeometryArena& operator=(const GeometryArena&) = delete;
+
+	/// <summary>
+	/// 領域の確保（最もぴったりの空き領域から切り出す）
+	/// </summary>
+	/// <param name="size">大きさ（kAlignmentの倍数）</param>
+	/// <param name="page">確保したページ番号</param>
+	/// <param name="offset">確保したページ内の先頭</param>
+	void Allocate(uint64_t size, uint32_t& page, uint64_t& offset);
+
+	/// <summary>
+	/// 配置がメッシュのものか（メッシュのビューが配置した領域を指しているか）
+	/// </summary>
+	static bool IsOwnedBy(const MeshRange& range, const Mesh* mesh);
+
+	/// <summary>
+	/// 領域の解放
+	/// </summary>
+	/// <param name="page">ページ番号</param>
+	/// <param name="offset">ページ内の先頭</param>
+	/// <param name="size">大きさ</param>
+	void Free(uint32_t page, uint64_t offset, uint64_t size);
+
+private: // メンバ変数
+	// ページの既定の大きさ（0なら未初期化）
+	uint64_t pageSize_ = 0;
+	// ページ
+	std::vector<Page> pages_;
+	// メッシュごとの配置
+	std::unordered_map<const Mesh*, MeshRange> ranges_;
+};
@@ -0,0 +1,152 @@
+#include "LodModel.h"
+#include "CopyQueue.h"
+#include "MathUtility.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "Model.h"
+#include "ViewProjection.h"
+#include "WorldTransform.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+void LodModel::Initialize(Model* model, uint32_t lodCount, float reduction) {
+	assert(model);
+	assert(0 < lodCount && lodCount <= kMaxLodCount);
+	assert(0.0f < reduction && reduction < 1.0f);
+
+	model_ = model;
+	lodCount_ = lodCount;
+	bounds_ = model->CalculateBoundingSphere();
+	triangleCounts_ = {};
+
+	CopyQueue* copyQueue = CopyQueue::GetInstance();
+	CopyQueue::Ticket ticket = 0;
+
+	const auto& meshes = model->GetMeshes();
+	meshLods_.assign(meshes.size(), {});
+	std::vector<uint32_t> indices;
+	std::vector<uint16_t> indices16;
+	for (size_t i = 0; i < meshes.size(); i++) {
+		Mesh* mesh = meshes[i].get();
+		const std::vector<Mesh::VertexPosNormalUv>& vertices = mesh->GetVertices();
+		const std::vector<uint32_t>& fullIndices = mesh->GetIndices();
+
+		// LOD0は元のメッシュのインデックスバッファをそのまま使う
+		meshLods_[i][0].ibView = mesh->GetIBView();
+		meshLods_[i][0].indexCount = static_cast<uint32_t>(fullIndices.size());
+		triangleCounts_[0] += meshLods_[i][0].indexCount / 3;
+
+		float ratio = 1.0f;
+		for (uint32_t lod = 1; lod < lodCount_; lod++) {
+			ratio *= reduction;
+			uint32_t target = static_cast<uint32_t>(fullIndices.size() / 3 * ratio);
+			MeshSimplifier::Simplify(vertices, fullIndices, target, indices);
+			// 簡略化で順序が崩れるので頂点キャッシュ向けに並べ直す
+			MeshOptimizer::OptimizeVertexCache(indices, static_cast<uint32_t>(vertices.size()));
+
+			MeshLod& meshLod = meshLods_[i][lod];
+			meshLod.indexCount = static_cast<uint32_t>(indices.size());
+			triangleCounts_[lod] += meshLod.indexCount / 3;
+			if (indices.empty()) {
+				continue;
+			}
+
+			// インデックスバッファ生成・転送（元のメッシュと同じ幅にする）
+			bool is16Bit = meshLods_[i][0].ibView.Format == DXGI_FORMAT_R16_UINT;
+			const void* data = indices.data();
+			size_t size = sizeof(uint32_t) * indices.size();
+			if (is16Bit) {
+				indices16.assign(indices.size(), 0);
+				for (size_t j = 0; j < indices.size(); j++) {
+					indices16[j] = static_cast<uint16_t>(indices[j]);
+				}
+				data = indices16.data();
+				size = sizeof(uint16_t) * indices16.size();
+			}
+			meshLod.indexBuffer = copyQueue->CreateBuffer(size);
+			ticket = copyQueue->UploadBuffer(meshLod.indexBuffer.Get(), data, size);
+
+			meshLod.ibView.BufferLocation = meshLod.indexBuffer->GetGPUVirtualAddress();
+			meshLod.ibView.Format = is16Bit ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+			meshLod.ibView.SizeInBytes = static_cast<UINT>(size);
+		}
+	}
+
+	// チケットは発行順に完了するので最後のものを待てば全て揃う
+	copyQueue->Wait(ticket);
+}
+
+uint32_t LodModel::SelectLod(
+    const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+    State& state) const {
+	// 画面の高さに対する境界球の直径の比率
+	Sphere sphere = MathUtility::Transform(bounds_, worldTransform.matWorld_);
+	float distance =
+	    MathUtility::Length(MathUtility::Subtract(sphere.center, viewProjection.translation_));
+	if (distance <= sphere.radius) {
+		state.lod = 0;
+		return state.lod;
+	}
+	float screenSize = sphere.radius / (distance * std::tan(viewProjection.fovAngleY * 0.5f));
+
+	// 切り替えるには、しきい値を履歴の幅だけ越える必要がある
+	uint32_t lod = std::min(state.lod, lodCount_ - 1);
+	while (lod + 1 < lodCount_ &&
+	       screenSize < screenSizeThresholds_[lod + 1] * (1.0f - hysteresis_)) {
+		lod++;
+	}
+	while (0 < lod && screenSizeThresholds_[lod] * (1.0f + hysteresis_) < screenSize) {
+		lod--;
+	}
+	state.lod = lod;
+	return lod;
+}
+
+void LodModel::Draw(
+    const WorldTransform& worldTransform, const ViewProjection& viewProjection, State& state,
+    const ObjectColor* objectColor) {
+	assert(model_);
+	uint32_t lod = SelectLod(worldTransform, viewProjection, state);
+
+	ModelCommon* modelCommon = ModelCommon::GetInstance();
+	ID3D12GraphicsCommandList* commandList = modelCommon->GetCommandList();
+	// PreDrawとPostDrawの間で呼ぶこと
+	assert(commandList);
+
+	// ライトの描画
+	modelCommon->LightCommand(model_->GetLightGroup());
+	// ワールド行列・ビュープロジェクション行列
+	modelCommon->TransformCommand(worldTransform, viewProjection);
+	// オブジェクトカラー
+	if (!objectColor) {
+		objectColor = modelCommon->GetObjectColor();
+	}
+	objectColor->SetGraphicsCommand(
+	    commandList, static_cast<UINT>(Model::RoomParameter::kObjectColor));
+
+	const auto& meshes = model_->GetMeshes();
+	for (size_t i = 0; i < meshes.size(); i++) {
+		const MeshLod& meshLod = meshLods_[i][lod];
+		if (meshLod.indexCount == 0) {
+			continue;
+		}
+		Mesh* mesh = meshes[i].get();
+		mesh->GetMaterial()->SetGraphicsCommand(
+		    commandList, static_cast<UINT>(Model::RoomParameter::kMaterial),
+		    static_cast<UINT>(Model::RoomParameter::kTexture));
+		commandList->IASetVertexBuffers(0, 1, &mesh->GetVBView());
+		commandList->IASetIndexBuffer(&meshLod.ibView);
+		commandList->DrawIndexedInstanced(meshLod.indexCount, 1, 0, 0, 0);
+	}
+
+	statistics_.drawCount++;
+	statistics_.triangleCount += triangleCounts_[lod];
+	statistics_.fullTriangleCount += triangleCounts_[0];
+	statistics_.lodCounts[lod]++;
+}
+
+void LodModel::SetScreenSizeThreshold(uint32_t lod, float screenSize) {
+	assert(0 < lod && lod < kMaxLodCount);
+	screenSizeThresholds_[lod] = screenSize;
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "Shapes.h"
+#include <array>
+#include <cstdint>
+#include <d3d12.h>
+#include <vector>
+#include <wrl.h>
+
+class Model;
+class ObjectColor;
+class ViewProjection;
+class WorldTransform;
+
+/// <summary>
+/// 詳細度（LOD）付きモデル
+/// </summary>
+/// <remarks>
+/// 読み込み済みのModelの各メッシュからMeshSimplifierで粗いLODを作り、
+/// 画面上の大きさに応じて描き分ける。LODはインデックスバッファだけを持ち、
+/// 頂点バッファは元のメッシュと共有する。
+/// 切り替えのちらつきを防ぐため、しきい値には履歴（ヒステリシス）を持たせる。
+/// </remarks>
+class LodModel {
+public: // サブクラス
+	// LODの最大数（0が元のメッシュ）
+	static constexpr uint32_t kMaxLodCount = 4;
+
+	/// <summary>
+	/// インスタンスごとの選択状態。描画する物体ごとに1つ持つ
+	/// </summary>
+	struct State {
+		uint32_t lod = 0;
+	};
+
+	/// <summary>
+	/// フレームごとの統計
+	/// </summary>
+	struct Statistics {
+		uint32_t drawCount = 0;                         // 描画した物体の数
+		uint32_t triangleCount = 0;                     // 描画した三角形数
+		uint32_t fullTriangleCount = 0;                 // 全て元のメッシュで描いた場合の三角形数
+		std::array<uint32_t, kMaxLodCount> lodCounts{}; // LODごとの描画数
+	};
+
+public: // メンバ関数
+	/// <summary>
+	/// 初期化。各メッシュのLODを作る
+	/// </summary>
+	/// <param name="model">モデル（LodModelより長く生存すること）</param>
+	/// <param name="lodCount">LODの数（元のメッシュを含む。kMaxLodCount以下）</param>
+	/// <param name="reduction">1段ごとの三角形数の比率</param>
+	void Initialize(Model* model, uint32_t lodCount = kMaxLodCount, float reduction = 0.5f);
+
+	/// <summary>
+	/// フレーム開始処理。統計をリセットする
+	/// </summary>
+	void BeginFrame() { statistics_ = {}; }
+
+	/// <summary>
+	/// 画面上の大きさからLODを選ぶ
+	/// </summary>
+	/// <param name="worldTransform">ワールドトランスフォーム</param>
+	/// <param name="viewProjection">ビュープロジェクション</param>
+	/// <param name="state">インスタンスの選択状態（更新する）</param>
+	/// <returns>LOD番号</returns>
+	uint32_t SelectLod(
+	    const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+	    State& state) const;
+
+	/// <summary>
+	/// LODを選んで描画する。Model::PreDrawとPostDrawの間で呼ぶこと
+	/// </summary>
+	/// <param name="worldTransform">ワールドトランスフォーム</param>
+	/// <param name="viewProjection">ビュープロジェクション</param>
+	/// <param name="state">インスタンスの選択状態（更新する）</param>
+	/// <param name="objectColor">オブジェクトカラー</param>
+	void Draw(
+	    const WorldTransform& worldTransform, const ViewProjection& viewProjection, State& state,
+	    const ObjectColor* objectColor = nullptr);
+
+	/// <summary>
+	/// 切り替えの画面上の大きさの設定
+	/// </summary>
+	/// <param name="lod">粗い側のLOD番号（1以上）</param>
+	/// <param name="screenSize">画面の高さに対する境界球の直径の比率。下回るとlodになる</param>
+	void SetScreenSizeThreshold(uint32_t lod, float screenSize);
+
+	/// <summary>
+	/// 履歴の幅の設定（しきい値に対する比率）
+	/// </summary>
+	void SetHysteresis(float hysteresis) { hysteresis_ = hysteresis; }
+
+	/// <summary>
+	/// LODの数の取得
+	/// </summary>
+	uint32_t GetLodCount() const { return lodCount_; }
+
+	/// <summary>
+	/// LODの三角形数の取得
+	/// </summary>
+	uint32_t GetTriangleCount(uint32_t lod) const { return triangleCounts_[lod]; }
+
+	/// <summary>
+	/// 統計の取得
+	/// </summary>
+	const Statistics& GetStatistics() const { return statistics_; }
+
+private: // サブクラス
+	// メッシュ1つのLOD1つ分
+	struct MeshLod {
+		Microsoft::WRL::ComPtr<ID3D12Resource> indexBuffer; // LOD0は元のメッシュを使う
+		D3D12_INDEX_BUFFER_VIEW ibView{};
+		uint32_t indexCount = 0;
+	};
+
+private: // メンバ変数
+	// モデル
+	Model* model_ = nullptr;
+	// メッシュごと・LODごとのインデックス
+	std::vector<std::array<MeshLod, kMaxLodCount>> meshLods_;
+	// LODの数
+	uint32_t lodCount_ = 1;
+	// LODごとのモデル全体の三角形数
+	std::array<uint32_t, kMaxLodCount> triangleCounts_{};
+	// モデル座標系の境界球
+	Sphere bounds_{};
+	// LOD i-1からiへ切り替える画面上の大きさ（[0]は未使用）
+	std::array<float, kMaxLodCount> screenSizeThresholds_ = {0.0f, 0.25f, 0.12f, 0.06f};
+	// 履歴の幅
+	float hysteresis_ = 0.1f;
+	// 統計
+	Statistics statistics_;
+};
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "ConstBufferAllocator.h"
 #include "Vector3.h"
+#include <cstddef>
 #include <d3d12.h>
 #include <memory>
 #include <string>
@@ -20,6 +22,7 @@ public: // サブクラス
 		Vector3 specular; // スペキュラー係数
 		float alpha;      // アルファ
 		Vector3 uvScale;  // UVスケール
+		float pad3;       // パディング
 		Vector3 uvOffset; // UVオフセット
 	};
 
@@ -65,6 +68,22 @@ public:
 	/// </summary>
 	void Update();
 
+	/// <summary>
+	/// フレーム用定数バッファへ転送する
+	/// </summary>
+	/// <param name="allocator">定数バッファアロケータ</param>
+	/// <returns>転送先のGPU仮想アドレス</returns>
+	D3D12_GPU_VIRTUAL_ADDRESS Update(ConstBufferAllocator& allocator) const {
+		ConstBufferData data{};
+		data.ambient = ambient_;
+		data.diffuse = diffuse_;
+		data.specular = specular_;
+		data.alpha = alpha_;
+		data.uvScale = uvScale_;
+		data.uvOffset = uvOffset_;
+		return allocator.Push(data);
+	}
+
 	/// <summary>
 	/// グラフィックスコマンドのセット
 	/// </summary>
@@ -108,3 +127,9 @@ private:
 	/// </summary>
 	void CreateConstantBuffer();
 };
+// Obj.hlsliのcbuffer Materialのpackoffsetと一致すること
+static_assert(offsetof(Material::ConstBufferData, diffuse) == 16);
+static_assert(offsetof(Material::ConstBufferData, specular) == 32);
+static_assert(offsetof(Material::ConstBufferData, alpha) == 44);
+static_assert(offsetof(Material::ConstBufferData, uvScale) == 48);
+static_assert(offsetof(Material::ConstBufferData, uvOffset) == 64);
@@ -1,10 +1,13 @@
 #pragma once
 
+#include "CopyQueue.h"
+#include "Shapes.h"
 #include "Vector2.h"
 #include "Vector3.h"
 #include <Windows.h>
 #include <cstdint>
 #include <d3d12.h>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -50,6 +53,14 @@ public: // メンバ関数
 	/// <param name="index">インデックス</param>
 	void AddIndex(uint32_t index);
 
+	/// <summary>
+	/// 頂点データとインデックスをまとめて設定（既存の内容と平滑化データは破棄する）
+	/// </summary>
+	/// <param name="vertices">頂点データ</param>
+	/// <param name="indices">インデックス</param>
+	void SetGeometry(
+	    std::span<const VertexPosNormalUv> vertices, std::span<const uint32_t> indices);
+
 	/// <summary>
 	/// 頂点データの数を取得
 	/// </summary>
@@ -85,6 +96,26 @@ public: // メンバ関数
 	/// </summary>
 	void CreateBuffers();
 
+	/// <summary>
+	/// バッファの生成（DEFAULTヒープへコピーキューで非同期に転送）
+	/// </summary>
+	/// <remarks>
+	/// 頂点数が65536以下なら16ビットインデックスにする。
+	/// 既存のバッファを置き換えるので、描画に使う前に呼ぶこと。
+	/// </remarks>
+	/// <returns>チケット。完了するまで描画に使わないこと</returns>
+	CopyQueue::Ticket CreateBuffersAsync();
+
+	/// <summary>
+	/// 外部で確保したバッファの範囲を頂点・インデックスバッファとして設定する（GeometryArena用）
+	/// </summary>
+	/// <param name="buffer">バッファ（参照を保持する。nullptrなら解除）</param>
+	/// <param name="vbView">頂点バッファビュー</param>
+	/// <param name="ibView">インデックスバッファビュー</param>
+	void SetBuffers(
+	    ID3D12Resource* buffer, const D3D12_VERTEX_BUFFER_VIEW& vbView,
+	    const D3D12_INDEX_BUFFER_VIEW& ibView);
+
 	/// <summary>
 	/// 頂点バッファ取得
 	/// </summary>
@@ -130,6 +161,12 @@ public: // メンバ関数
 	/// <returns>インデックス配列</returns>
 	inline const std::vector<uint32_t>& GetIndices() { return indices_; }
 
+	/// <summary>
+	/// 頂点を囲むAABBを計算
+	/// </summary>
+	/// <returns>モデル座標系のAABB（頂点がなければ空）</returns>
+	AABB CalculateBoundingBox() const;
+
 private: // メンバ変数
 	// 名前
 	std::string name_;
@@ -0,0 +1,44 @@
+#include "Mesh.h"
+#include "MeshOptimizer.h"
+#include <cassert>
+
+CopyQueue::Ticket Mesh::CreateBuffersAsync() {
+	CopyQueue* copyQueue = CopyQueue::GetInstance();
+
+	// 頂点数が収まれば16ビットインデックスにして転送量を半分にする
+	bool is16Bit = MeshOptimizer::CanUse16BitIndices(vertices_.size());
+	std::vector<uint16_t> indices16;
+	if (is16Bit) {
+		indices16.reserve(indices_.size());
+		for (uint32_t index : indices_) {
+			indices16.push_back(static_cast<uint16_t>(index));
+		}
+	}
+
+	UINT sizeVB = static_cast<UINT>(sizeof(VertexPosNormalUv) * vertices_.size());
+	UINT sizeIB =
+	    static_cast<UINT>((is16Bit ? sizeof(uint16_t) : sizeof(uint32_t)) * indices_.size());
+	assert(0 < sizeVB && 0 < sizeIB);
+
+	// 頂点バッファ生成・転送
+	vertBuff_ = copyQueue->CreateBuffer(sizeVB);
+	copyQueue->UploadBuffer(vertBuff_.Get(), vertices_.data(), sizeVB);
+
+	// インデックスバッファ生成・転送
+	indexBuff_ = copyQueue->CreateBuffer(sizeIB);
+	// チケットは発行順に完了するので後の方を待てば両方揃う
+	const void* indexData = is16Bit ? static_cast<const void*>(indices16.data()) : indices_.data();
+	CopyQueue::Ticket ticket = copyQueue->UploadBuffer(indexBuff_.Get(), indexData, sizeIB);
+
+	// 頂点バッファビューの作成
+	vbView_.BufferLocation = vertBuff_->GetGPUVirtualAddress();
+	vbView_.SizeInBytes = sizeVB;
+	vbView_.StrideInBytes = sizeof(vertices_[0]);
+
+	// インデックスバッファビューの作成
+	ibView_.BufferLocation = indexBuff_->GetGPUVirtualAddress();
+	ibView_.Format = is16Bit ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+	ibView_.SizeInBytes = sizeIB;
+
+	return ticket;
+}
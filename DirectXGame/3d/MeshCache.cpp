@@ -0,0 +1,435 @@
+#include "MeshCache.h"
+#include "MathUtility.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace {
+
+// ファイル先頭の識別子（"KMSH"）
+constexpr uint32_t kMagic = 'K' | ('M' << 8) | ('S' << 16) | ('H' << 24);
+
+// FNV-1aの定数
+constexpr uint64_t kFnvOffset = 14695981039346656037ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+/// <summary>
+/// 8バイトずつFNV-1aを進める（端数は1バイトずつ）
+/// </summary>
+uint64_t HashBytes(uint64_t hash, const char* data, size_t size) {
+	size_t i = 0;
+	for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+		uint64_t word;
+		std::memcpy(&word, data + i, sizeof(word));
+		hash = (hash ^ word) * kFnvPrime;
+	}
+	for (; i < size; i++) {
+		hash = (hash ^ static_cast<uint8_t>(data[i])) * kFnvPrime;
+	}
+	return hash;
+}
+
+/// <summary>
+/// サイズと更新日時の取得（取得できなければUINT64_MAXと0）
+/// </summary>
+MeshCache::FileStamp GetFileStamp(const std::string& filePath) {
+	std::error_code error;
+	uint64_t size = std::filesystem::file_size(filePath, error);
+	if (error) {
+		return {UINT64_MAX, 0};
+	}
+	auto writeTime = std::filesystem::last_write_time(filePath, error);
+	if (error) {
+		return {UINT64_MAX, 0};
+	}
+	return {size, static_cast<int64_t>(writeTime.time_since_epoch().count())};
+}
+
+} // namespace
+
+struct MeshCache::StringRef {
+	uint32_t offset; // 文字列表の先頭からのバイト数
+	uint32_t length;
+};
+
+struct MeshCache::SourceRecord {
+	StringRef name;
+	FileStamp stamp; // 書き込み時のサイズと更新日時
+};
+
+struct MeshCache::Header {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t sourceHash;
+	uint64_t seed; // 元ファイルのハッシュの初期値
+	uint32_t submeshCount;
+	uint32_t materialCount;
+	uint32_t sourceCount;
+	uint32_t vertexCount;
+	uint32_t indexCount;
+	uint32_t stringSize;
+	uint32_t vertexStride; // 頂点構造体が変わったことを検出する
+	uint32_t reserved;
+	AABB bounds;
+	MeshOptimizer::Statistics statistics; // 書き込み時の最適化の結果
+};
+
+struct MeshCache::SubmeshRecord {
+	StringRef name;
+	StringRef material;
+	uint32_t firstVertex;
+	uint32_t vertexCount;
+	uint32_t firstIndex;
+	uint32_t indexCount;
+	AABB bounds;
+};
+
+struct MeshCache::MaterialRecord {
+	StringRef name;
+	StringRef textureFilename;
+	Vector3 ambient;
+	Vector3 diffuse;
+	Vector3 specular;
+	float alpha;
+};
+
+// ヘッダに続く各表のファイル先頭からの位置（この順に並ぶ）
+struct MeshCache::Layout {
+	size_t submeshes;
+	size_t materials;
+	size_t sources;
+	size_t vertices;
+	size_t indices;
+	size_t strings;
+	size_t total;
+
+	explicit Layout(const Header& header) {
+		submeshes = sizeof(Header);
+		materials = submeshes + sizeof(SubmeshRecord) * header.submeshCount;
+		sources = materials + sizeof(MaterialRecord) * header.materialCount;
+		vertices = sources + sizeof(SourceRecord) * header.sourceCount;
+		indices = vertices + sizeof(Mesh::VertexPosNormalUv) * header.vertexCount;
+		strings = indices + sizeof(uint32_t) * header.indexCount;
+		total = strings + header.stringSize;
+	}
+};
+
+bool MeshCache::Write(
+    const std::string& filePath, const std::string& directoryPath, uint64_t seed,
+    std::span<const SubmeshData> submeshes, std::span<const ObjParser::MaterialData> materials,
+    std::span<const std::string> sources, const MeshOptimizer::Statistics& statistics) {
+	std::string strings;
+	auto addString = [&strings](std::string_view string) {
+		StringRef ref{static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(string.size())};
+		strings.append(string);
+		return ref;
+	};
+
+	Header header{};
+	header.magic = kMagic;
+	header.version = kVersion;
+	header.seed = seed;
+	header.submeshCount = static_cast<uint32_t>(submeshes.size());
+	header.materialCount = static_cast<uint32_t>(materials.size());
+	header.sourceCount = static_cast<uint32_t>(sources.size());
+	header.vertexStride = sizeof(Mesh::VertexPosNormalUv);
+	header.bounds = MathUtility::MakeEmptyAABB();
+	header.statistics = statistics;
+
+	std::vector<SubmeshRecord> submeshRecords;
+	submeshRecords.reserve(submeshes.size());
+	for (const SubmeshData& submesh : submeshes) {
+		SubmeshRecord& record = submeshRecords.emplace_back();
+		record.name = addString(submesh.name);
+		record.material = addString(submesh.material);
+		record.firstVertex = header.vertexCount;
+		record.vertexCount = static_cast<uint32_t>(submesh.vertices.size());
+		record.firstIndex = header.indexCount;
+		record.indexCount = static_cast<uint32_t>(submesh.indices.size());
+		record.bounds = MathUtility::MakeEmptyAABB();
+		for (const Mesh::VertexPosNormalUv& vertex : submesh.vertices) {
+			record.bounds = MathUtility::Merge(record.bounds, vertex.pos);
+		}
+		header.bounds = MathUtility::Merge(header.bounds, record.bounds);
+		header.vertexCount += record.vertexCount;
+		header.indexCount += record.indexCount;
+	}
+
+	std::vector<MaterialRecord> materialRecords;
+	materialRecords.reserve(materials.size());
+	for (const ObjParser::MaterialData& material : materials) {
+		MaterialRecord& record = materialRecords.emplace_back();
+		record.name = addString(material.name);
+		record.textureFilename = addString(material.textureFilename);
+		record.ambient = material.ambient;
+		record.diffuse = material.diffuse;
+		record.specular = material.specular;
+		record.alpha = material.alpha;
+	}
+
+	// サイズと更新日時をハッシュより先に取る。計算中に書き換えられても次回は日時が違うので、
+	// 内容のハッシュを比べ直すことになる
+	std::vector<SourceRecord> sourceRecords;
+	sourceRecords.reserve(sources.size());
+	for (const std::string& source : sources) {
+		sourceRecords.push_back({addString(source), GetFileStamp(directoryPath + source)});
+	}
+	header.sourceHash = HashFiles(directoryPath, sources, seed);
+	header.stringSize = static_cast<uint32_t>(strings.size());
+
+	// 書き込み途中のファイルを読まないよう、一時ファイルに書いてから置き換える。
+	// 同じキャッシュを複数のスレッドが同時に書いても混ざらないよう、一時ファイル名は
+	// スレッドと呼び出しごとに変える
+	static std::atomic<uint32_t> tempCount = 0;
+	const std::string tempPath =
+	    filePath + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) +
+	    "." + std::to_string(tempCount++) + ".tmp";
+	bool isWritten = false;
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			return false;
+		}
+		auto write = [&file](const void* data, size_t size) {
+			file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+		};
+		write(&header, sizeof(header));
+		write(submeshRecords.data(), sizeof(SubmeshRecord) * submeshRecords.size());
+		write(materialRecords.data(), sizeof(MaterialRecord) * materialRecords.size());
+		write(sourceRecords.data(), sizeof(SourceRecord) * sourceRecords.size());
+		for (const SubmeshData& submesh : submeshes) {
+			write(submesh.vertices.data(), submesh.vertices.size_bytes());
+		}
+		for (const SubmeshData& submesh : submeshes) {
+			write(submesh.indices.data(), submesh.indices.size_bytes());
+		}
+		write(strings.data(), strings.size());
+		file.close();
+		isWritten = !file.fail();
+	}
+
+	std::error_code error;
+	if (isWritten) {
+		std::filesystem::rename(tempPath, filePath, error);
+	}
+	if (!isWritten || error) {
+		// 置き換えられなかった一時ファイルは残さない
+		std::filesystem::remove(tempPath, error);
+		return false;
+	}
+	return true;
+}
+
+uint64_t MeshCache::HashFiles(
+    const std::string& directoryPath, std::span<const std::string> fileNames, uint64_t seed) {
+	uint64_t hash = HashBytes(kFnvOffset, reinterpret_cast<const char*>(&seed), sizeof(seed));
+	for (const std::string& fileName : fileNames) {
+		hash = HashBytes(hash, fileName.data(), fileName.size());
+		MappedFile file;
+		if (!file.Open(directoryPath + fileName)) {
+			// 開けないことも内容の一種として扱う
+			hash = (hash ^ UINT64_MAX) * kFnvPrime;
+			continue;
+		}
+		uint64_t size = file.GetSize();
+		hash = HashBytes(hash, reinterpret_cast<const char*>(&size), sizeof(size));
+		hash = HashBytes(hash, file.GetData(), file.GetSize());
+	}
+	return hash;
+}
+
+bool MeshCache::Open(const std::string& filePath) {
+	if (!file_.Open(filePath)) {
+		return false;
+	}
+
+	// ヘッダ
+	if (file_.GetSize() < sizeof(Header)) {
+		Close();
+		return false;
+	}
+	const Header& header = GetHeader();
+	if (header.magic != kMagic || header.version != kVersion ||
+	    header.vertexStride != sizeof(Mesh::VertexPosNormalUv)) {
+		Close();
+		return false;
+	}
+	Layout layout(header);
+	if (layout.total != file_.GetSize()) {
+		Close();
+		return false;
+	}
+
+	// 各表の範囲
+	auto isValidString = [&header](const StringRef& ref) {
+		return uint64_t(ref.offset) + ref.length <= header.stringSize;
+	};
+	const SubmeshRecord* submeshes =
+	    reinterpret_cast<const SubmeshRecord*>(file_.GetData() + layout.submeshes);
+	const uint32_t* indices = reinterpret_cast<const uint32_t*>(file_.GetData() + layout.indices);
+	for (uint32_t i = 0; i < header.submeshCount; i++) {
+		const SubmeshRecord& record = submeshes[i];
+		if (!isValidString(record.name) || !isValidString(record.material) ||
+		    header.vertexCount < uint64_t(record.firstVertex) + record.vertexCount ||
+		    header.indexCount < uint64_t(record.firstIndex) + record.indexCount ||
+		    record.indexCount % 3 != 0) {
+			Close();
+			return false;
+		}
+		// 範囲外の頂点を指すインデックスはGPUで読み込み違反になるので開く時点で弾く
+		// （分岐のない最大値の計算にしてベクトル化させる）
+		uint32_t maxIndex = 0;
+		for (uint32_t j = record.firstIndex; j < record.firstIndex + record.indexCount; j++) {
+			maxIndex = std::max(maxIndex, indices[j]);
+		}
+		if (0 < record.indexCount && record.vertexCount <= maxIndex) {
+			Close();
+			return false;
+		}
+	}
+	const MaterialRecord* materials =
+	    reinterpret_cast<const MaterialRecord*>(file_.GetData() + layout.materials);
+	for (uint32_t i = 0; i < header.materialCount; i++) {
+		if (!isValidString(materials[i].name) || !isValidString(materials[i].textureFilename)) {
+			Close();
+			return false;
+		}
+	}
+	const SourceRecord* sources =
+	    reinterpret_cast<const SourceRecord*>(file_.GetData() + layout.sources);
+	for (uint32_t i = 0; i < header.sourceCount; i++) {
+		if (!isValidString(sources[i].name)) {
+			Close();
+			return false;
+		}
+	}
+	return true;
+}
+
+bool MeshCache::IsUpToDate(
+    const std::string& directoryPath, uint64_t seed, std::vector<FileStamp>* staleStamps) const {
+	if (staleStamps) {
+		staleStamps->clear();
+	}
+	const Header& header = GetHeader();
+	if (header.seed != seed) {
+		return false;
+	}
+
+	// サイズと更新日時が全て同じなら内容は読まない
+	// （Writeと同じくハッシュより先に取るので、計算中の書き換えは次回に検出される）
+	const SourceRecord* sources =
+	    reinterpret_cast<const SourceRecord*>(file_.GetData() + GetLayout().sources);
+	std::vector<FileStamp> stamps(header.sourceCount);
+	bool isSameStamp = true;
+	for (uint32_t i = 0; i < header.sourceCount; i++) {
+		stamps[i] = GetFileStamp(directoryPath + std::string(GetString(sources[i].name)));
+		isSameStamp = isSameStamp && sources[i].stamp == stamps[i];
+	}
+	if (isSameStamp) {
+		return true;
+	}
+
+	// 更新日時だけが変わった（コピーし直したなど）場合もあるので内容で比べる
+	if (HashFiles(directoryPath, GetSources(), seed) != header.sourceHash) {
+		return false;
+	}
+	if (staleStamps) {
+		*staleStamps = std::move(stamps);
+	}
+	return true;
+}
+
+bool MeshCache::UpdateStamps(const std::string& filePath, std::span<const FileStamp> stamps) {
+	std::fstream file(filePath, std::ios::binary | std::ios::in | std::ios::out);
+	if (!file) {
+		return false;
+	}
+	Header header{};
+	file.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (!file || header.magic != kMagic || header.version != kVersion ||
+	    header.sourceCount != stamps.size()) {
+		return false;
+	}
+
+	// 元ファイル表の各レコードのサイズと更新日時だけをその場で書き換える
+	Layout layout(header);
+	for (size_t i = 0; i < stamps.size(); i++) {
+		file.seekp(static_cast<std::streamoff>(
+		    layout.sources + sizeof(SourceRecord) * i + offsetof(SourceRecord, stamp)));
+		file.write(reinterpret_cast<const char*>(&stamps[i]), sizeof(FileStamp));
+	}
+	file.close();
+	return !file.fail();
+}
+
+uint64_t MeshCache::GetSourceHash() const { return GetHeader().sourceHash; }
+
+std::vector<std::string> MeshCache::GetSources() const {
+	const SourceRecord* sources =
+	    reinterpret_cast<const SourceRecord*>(file_.GetData() + GetLayout().sources);
+	std::vector<std::string> result;
+	for (uint32_t i = 0; i < GetHeader().sourceCount; i++) {
+		result.emplace_back(GetString(sources[i].name));
+	}
+	return result;
+}
+
+AABB MeshCache::GetBounds() const { return GetHeader().bounds; }
+
+MeshOptimizer::Statistics MeshCache::GetStatistics() const { return GetHeader().statistics; }
+
+uint32_t MeshCache::GetSubmeshCount() const { return GetHeader().submeshCount; }
+
+MeshCache::Submesh MeshCache::GetSubmesh(uint32_t index) const {
+	assert(index < GetSubmeshCount());
+	const SubmeshRecord& record =
+	    reinterpret_cast<const SubmeshRecord*>(file_.GetData() + GetLayout().submeshes)[index];
+	return {GetString(record.name), GetString(record.material), record.firstVertex,
+	        record.vertexCount,      record.firstIndex,           record.indexCount,
+	        record.bounds};
+}
+
+uint32_t MeshCache::GetMaterialCount() const { return GetHeader().materialCount; }
+
+ObjParser::MaterialData MeshCache::GetMaterial(uint32_t index) const {
+	assert(index < GetMaterialCount());
+	const MaterialRecord& record =
+	    reinterpret_cast<const MaterialRecord*>(file_.GetData() + GetLayout().materials)[index];
+	ObjParser::MaterialData material;
+	material.name = GetString(record.name);
+	material.ambient = record.ambient;
+	material.diffuse = record.diffuse;
+	material.specular = record.specular;
+	material.alpha = record.alpha;
+	material.textureFilename = GetString(record.textureFilename);
+	return material;
+}
+
+std::span<const Mesh::VertexPosNormalUv> MeshCache::GetVertices() const {
+	return {
+	    reinterpret_cast<const Mesh::VertexPosNormalUv*>(file_.GetData() + GetLayout().vertices),
+	    GetHeader().vertexCount};
+}
+
+std::span<const uint32_t> MeshCache::GetIndices() const {
+	return {
+	    reinterpret_cast<const uint32_t*>(file_.GetData() + GetLayout().indices),
+	    GetHeader().indexCount};
+}
+
+const MeshCache::Header& MeshCache::GetHeader() const {
+	assert(file_.GetData());
+	return *reinterpret_cast<const Header*>(file_.GetData());
+}
+
+MeshCache::Layout MeshCache::GetLayout() const { return Layout(GetHeader()); }
+
+std::string_view MeshCache::GetString(const StringRef& ref) const {
+	return {file_.GetData() + GetLayout().strings + ref.offset, ref.length};
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "Mesh.h"
+#include "MeshOptimizer.h"
+#include "ObjParser.h"
+#include "Shapes.h"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// <summary>
+/// メッシュのバイナリキャッシュ
+/// </summary>
+/// <remarks>
+/// 頂点・インデックスの塊、サブメッシュ表、マテリアル表、AABB、最適化の結果、
+/// 元ファイルのハッシュとサイズ・更新日時を1ファイルにまとめる。
+/// 読み込みはメモリマップで、頂点とインデックスは解析せずにそのまま参照できる。
+/// 形式が変わったらkVersionを上げる。古い版やIsUpToDateがfalseのキャッシュは作り直すこと。
+/// </remarks>
+class MeshCache {
+public: // サブクラス
+	// 形式の版
+	static constexpr uint32_t kVersion = 4;
+
+	// 元ファイルのサイズと更新日時
+	struct FileStamp {
+		uint64_t size;
+		int64_t writeTime;
+
+		bool operator==(const FileStamp&) const = default;
+	};
+
+	// 書き込むサブメッシュ
+	struct SubmeshData {
+		std::string_view name;
+		std::string_view material; // マテリアル名（なければ空）
+		std::span<const Mesh::VertexPosNormalUv> vertices;
+		std::span<const uint32_t> indices;
+	};
+
+	// 読み込んだサブメッシュ（文字列はキャッシュを指す）
+	struct Submesh {
+		std::string_view name;
+		std::string_view material;
+		uint32_t firstVertex;
+		uint32_t vertexCount;
+		uint32_t firstIndex; // インデックスはサブメッシュ内の頂点番号
+		uint32_t indexCount;
+		AABB bounds;
+	};
+
+public: // 静的メンバ関数
+	/// <summary>
+	/// キャッシュを書き込む。書き込むスレッドごとに別の一時ファイルに書いてから置き換える
+	/// </summary>
+	/// <param name="filePath">ファイルパス</param>
+	/// <param name="directoryPath">元ファイルのディレクトリパス</param>
+	/// <param name="seed">元ファイルのハッシュの初期値（読み込み設定などを混ぜる）</param>
+	/// <param name="submeshes">サブメッシュ</param>
+	/// <param name="materials">マテリアル</param>
+	/// <param name="sources">元ファイル名（OBJとMTL。更新の検出に使う）</param>
+	/// <param name="statistics">全サブメッシュの最適化の結果</param>
+	/// <returns>成否</returns>
+	static bool Write(
+	    const std::string& filePath, const std::string& directoryPath, uint64_t seed,
+	    std::span<const SubmeshData> submeshes, std::span<const ObjParser::MaterialData> materials,
+	    std::span<const std::string> sources, const MeshOptimizer::Statistics& statistics);
+
+	/// <summary>
+	/// ファイルの内容のハッシュ（FNV-1a）。開けないファイルもその旨をハッシュに含める
+	/// </summary>
+	/// <param name="directoryPath">ディレクトリパス</param>
+	/// <param name="fileNames">ファイル名</param>
+	/// <param name="seed">初期値（読み込み設定などを混ぜる）</param>
+	/// <returns>ハッシュ</returns>
+	static uint64_t HashFiles(
+	    const std::string& directoryPath, std::span<const std::string> fileNames,
+	    uint64_t seed = 0);
+
+	/// <summary>
+	/// 元ファイルのサイズと更新日時を書き換える。開いていないキャッシュに対して呼ぶこと
+	/// </summary>
+	/// <param name="filePath">ファイルパス</param>
+	/// <param name="stamps">元ファイルごとのサイズと更新日時（IsUpToDateで得たもの）</param>
+	/// <returns>成否（形式か元ファイルの数が違えばfalse）</returns>
+	static bool UpdateStamps(const std::string& filePath, std::span<const FileStamp> stamps);
+
+public: // メンバ関数
+	/// <summary>
+	/// キャッシュを開く。形式と版、各表の範囲、インデックスが三角形リストとして
+	/// サブメッシュの頂点を指しているかを検証する
+	/// </summary>
+	/// <param name="filePath">ファイルパス</param>
+	/// <returns>成否（ないか壊れていればfalse）</returns>
+	bool Open(const std::string& filePath);
+
+	/// <summary>
+	/// 閉じる。取得したspanや文字列は無効になる
+	/// </summary>
+	void Close() { file_.Close(); }
+
+	/// <summary>
+	/// 元ファイルから作り直す必要がないか
+	/// </summary>
+	/// <remarks>
+	/// 元ファイルのサイズと更新日時が書き込み時と同じならハッシュは計算しない。
+	/// 違うときだけ内容のハッシュを比べる。内容が同じならstaleStampsに今のサイズと
+	/// 更新日時を返すので、閉じた後にUpdateStampsで書き換えると次回はハッシュを計算しない。
+	/// </remarks>
+	/// <param name="directoryPath">元ファイルのディレクトリパス</param>
+	/// <param name="seed">元ファイルのハッシュの初期値（Writeと同じ値）</param>
+	/// <param name="staleStamps">
+	/// 内容は同じでサイズか更新日時が変わっていたときの今の値の出力先（それ以外は空）
+	/// </param>
+	/// <returns>元ファイルと読み込み設定が書き込み時と同じならtrue</returns>
+	bool IsUpToDate(
+	    const std::string& directoryPath, uint64_t seed,
+	    std::vector<FileStamp>* staleStamps = nullptr) const;
+
+	/// <summary>
+	/// 元ファイルのハッシュの取得
+	/// </summary>
+	uint64_t GetSourceHash() const;
+
+	/// <summary>
+	/// 元ファイル名の取得
+	/// </summary>
+	std::vector<std::string> GetSources() const;
+
+	/// <summary>
+	/// 全体のAABBの取得
+	/// </summary>
+	AABB GetBounds() const;
+
+	/// <summary>
+	/// 書き込み時の最適化の結果の取得
+	/// </summary>
+	MeshOptimizer::Statistics GetStatistics() const;
+
+	/// <summary>
+	/// サブメッシュ数の取得
+	/// </summary>
+	uint32_t GetSubmeshCount() const;
+
+	/// <summary>
+	/// サブメッシュの取得
+	/// </summary>
+	Submesh GetSubmesh(uint32_t index) const;
+
+	/// <summary>
+	/// マテリアル数の取得
+	/// </summary>
+	uint32_t GetMaterialCount() const;
+
+	/// <summary>
+	/// マテリアルの取得
+	/// </summary>
+	ObjParser::MaterialData GetMaterial(uint32_t index) const;
+
+	/// <summary>
+	/// 全サブメッシュの頂点の取得
+	/// </summary>
+	std::span<const Mesh::VertexPosNormalUv> GetVertices() const;
+
+	/// <summary>
+	/// 全サブメッシュのインデックスの取得
+	/// </summary>
+	std::span<const uint32_t> GetIndices() const;
+
+private: // サブクラス
+	struct Header;
+	struct StringRef;
+	struct SourceRecord;
+	struct SubmeshRecord;
+	struct MaterialRecord;
+	struct Layout;
+
+private: // メンバ関数
+	/// <summary>
+	/// ヘッダの取得
+	/// </summary>
+	const Header& GetHeader() const;
+
+	/// <summary>
+	/// 各表の位置の取得
+	/// </summary>
+	Layout GetLayout() const;
+
+	/// <summary>
+	/// 文字列表の文字列を取得
+	/// </summary>
+	std::string_view GetString(const StringRef& ref) const;
+
+private: // メンバ変数
+	// キャッシュファイル
+	MappedFile file_;
+};
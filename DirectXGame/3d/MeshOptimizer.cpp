@@ -0,0 +1,408 @@
+#include "MeshOptimizer.h"
+#include "JobSystem.h"
+#include "MathUtility.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+using Vertex = Mesh::VertexPosNormalUv;
+
+// ハッシュ表の空きを表す値
+constexpr uint32_t kEmpty = UINT32_MAX;
+
+/// <summary>
+/// 頂点のハッシュ（FNV-1a）
+/// </summary>
+uint32_t HashVertex(const Vertex& vertex) {
+	uint32_t words[sizeof(Vertex) / sizeof(uint32_t)];
+	std::memcpy(words, &vertex, sizeof(Vertex));
+	uint32_t hash = 2166136261u;
+	for (uint32_t word : words) {
+		hash = (hash ^ word) * 16777619u;
+	}
+	return hash;
+}
+
+bool IsSameVertex(const Vertex& a, const Vertex& b) {
+	return std::memcmp(&a, &b, sizeof(Vertex)) == 0;
+}
+
+#pragma region Forsyth法の得点
+
+// 最後に使った三角形の頂点への得点（三角形の3頂点で差を付けない）
+constexpr float kLastTriangleScore = 0.75f;
+// キャッシュ内の位置による得点の減衰
+constexpr float kCacheDecayPower = 1.5f;
+// 残りの三角形が少ない頂点を優先する得点
+constexpr float kValenceBoostScale = 2.0f;
+constexpr float kValenceBoostPower = 0.5f;
+// 得点を表引きする残り三角形数の上限
+constexpr uint32_t kMaxValence = 32;
+
+// キャッシュ内の位置ごとの得点
+const std::array<float, MeshOptimizer::kCacheSize> kCacheScores = []() {
+	std::array<float, MeshOptimizer::kCacheSize> scores{};
+	for (uint32_t i = 0; i < MeshOptimizer::kCacheSize; i++) {
+		if (i < 3) {
+			scores[i] = kLastTriangleScore;
+		} else {
+			float scale = 1.0f / (MeshOptimizer::kCacheSize - 3);
+			scores[i] = std::pow(1.0f - (i - 3) * scale, kCacheDecayPower);
+		}
+	}
+	return scores;
+}();
+
+// 残り三角形数ごとの得点
+const std::array<float, kMaxValence> kValenceScores = []() {
+	std::array<float, kMaxValence> scores{};
+	for (uint32_t i = 1; i < kMaxValence; i++) {
+		scores[i] = kValenceBoostScale * std::pow(float(i), -kValenceBoostPower);
+	}
+	return scores;
+}();
+
+/// <summary>
+/// 頂点の得点
+/// </summary>
+/// <param name="cachePosition">キャッシュ内の位置（なければ-1）</param>
+/// <param name="liveTriangles">まだ出力していない隣接三角形の数</param>
+float VertexScore(int32_t cachePosition, uint32_t liveTriangles) {
+	if (liveTriangles == 0) {
+		return -1.0f;
+	}
+	float score = 0 <= cachePosition ? kCacheScores[cachePosition] : 0.0f;
+	score += liveTriangles < kMaxValence
+	             ? kValenceScores[liveTriangles]
+	             : kValenceBoostScale * std::pow(float(liveTriangles), -kValenceBoostPower);
+	return score;
+}
+
+#pragma endregion
+
+} // namespace
+
+void Mesh::SetGeometry(
+    std::span<const VertexPosNormalUv> vertices, std::span<const uint32_t> indices) {
+	vertices_.assign(vertices.begin(), vertices.end());
+	indices_.assign(indices.begin(), indices.end());
+	smoothData_.clear();
+}
+
+MeshOptimizer::Statistics MeshOptimizer::Optimize(Mesh& mesh) {
+	std::vector<Vertex> vertices = mesh.GetVertices();
+	std::vector<uint32_t> indices = mesh.GetIndices();
+	Statistics statistics = Optimize(vertices, indices);
+	mesh.SetGeometry(vertices, indices);
+	return statistics;
+}
+
+MeshOptimizer::Statistics MeshOptimizer::Optimize(
+    std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+	assert(indices.size() % 3 == 0);
+
+	Statistics statistics{};
+	statistics.vertexCountBefore = static_cast<uint32_t>(vertices.size());
+	statistics.triangleCount = static_cast<uint32_t>(indices.size() / 3);
+	statistics.acmrBefore =
+	    CalculateACMR(indices, static_cast<uint32_t>(vertices.size()), kFifoCacheSize);
+
+	uint32_t vertexCount = WeldVertices(vertices, indices);
+	OptimizeVertexCache(indices, vertexCount);
+	OptimizeVertexFetch(vertices, indices);
+
+	statistics.vertexCountAfter = static_cast<uint32_t>(vertices.size());
+	statistics.acmrAfter =
+	    CalculateACMR(indices, static_cast<uint32_t>(vertices.size()), kFifoCacheSize);
+	return statistics;
+}
+
+void MeshOptimizer::Accumulate(Statistics& total, const Statistics& statistics) {
+	uint32_t triangleCount = total.triangleCount + statistics.triangleCount;
+	if (0 < triangleCount) {
+		// ミスの総数を足してから三角形数で割り直す
+		total.acmrBefore = (total.acmrBefore * float(total.triangleCount) +
+		                    statistics.acmrBefore * float(statistics.triangleCount)) /
+		                   float(triangleCount);
+		total.acmrAfter = (total.acmrAfter * float(total.triangleCount) +
+		                   statistics.acmrAfter * float(statistics.triangleCount)) /
+		                  float(triangleCount);
+	}
+	total.vertexCountBefore += statistics.vertexCountBefore;
+	total.vertexCountAfter += statistics.vertexCountAfter;
+	total.triangleCount = triangleCount;
+}
+
+void MeshOptimizer::CalculateSmoothedNormals(
+    std::span<Vertex> vertices, std::span<const uint32_t> positionIndices, uint32_t positionCount) {
+	assert(vertices.size() == positionIndices.size());
+
+	// 座標ごとの頂点番号（頂点番号の昇順に並ぶので、和を取る順序も元の実装と同じ）
+	std::vector<uint32_t> offsets(positionCount + 1, 0);
+	for (uint32_t position : positionIndices) {
+		assert(position < positionCount);
+		offsets[position + 1]++;
+	}
+	for (uint32_t i = 0; i < positionCount; i++) {
+		offsets[i + 1] += offsets[i];
+	}
+	std::vector<uint32_t> sharedVertices(vertices.size());
+	for (uint32_t vertex = 0; vertex < vertices.size(); vertex++) {
+		sharedVertices[offsets[positionIndices[vertex]]++] = vertex;
+	}
+	// 詰めるときに進めた開始位置を戻す
+	for (uint32_t i = positionCount; 0 < i; i--) {
+		offsets[i] = offsets[i - 1];
+	}
+	offsets[0] = 0;
+
+	// 座標ごとの法線の和（成分ごとの配列）
+	std::vector<float> sums(size_t(positionCount) * 3);
+	float* sumX = sums.data();
+	float* sumY = sumX + positionCount;
+	float* sumZ = sumY + positionCount;
+
+	JobSystem::GetInstance()->ParallelFor(
+	    positionCount, kSmoothingGrainSize, [&](size_t begin, size_t end) {
+		    // 和（座標ごとに独立なので排他は不要）。頂点数が座標ごとに違うのでスカラーで集める
+		    for (size_t position = begin; position < end; position++) {
+			    float x = 0.0f, y = 0.0f, z = 0.0f;
+			    for (uint32_t i = offsets[position]; i < offsets[position + 1]; i++) {
+				    const Vector3& normal = vertices[sharedVertices[i]].normal;
+				    x += normal.x;
+				    y += normal.y;
+				    z += normal.z;
+			    }
+			    sumX[position] = x;
+			    sumY[position] = y;
+			    sumZ[position] = z;
+		    }
+
+		    // 正規化（長さ0はそのまま）。成分ごとの配列なので4座標ずつ計算する
+		    size_t position = begin;
+#if defined(MATH_ENABLE_SSE)
+		    const __m128 zero = _mm_setzero_ps();
+		    for (; position + 4 <= end; position += 4) {
+			    __m128 x = _mm_loadu_ps(sumX + position);
+			    __m128 y = _mm_loadu_ps(sumY + position);
+			    __m128 z = _mm_loadu_ps(sumZ + position);
+			    __m128 length = _mm_sqrt_ps(_mm_add_ps(
+			        _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+			    __m128 mask = _mm_cmpgt_ps(length, zero);
+			    _mm_storeu_ps(sumX + position, _mm_and_ps(_mm_div_ps(x, length), mask));
+			    _mm_storeu_ps(sumY + position, _mm_and_ps(_mm_div_ps(y, length), mask));
+			    _mm_storeu_ps(sumZ + position, _mm_and_ps(_mm_div_ps(z, length), mask));
+		    }
+#endif
+		    for (; position < end; position++) {
+			    float length = std::sqrt(
+			        sumX[position] * sumX[position] + sumY[position] * sumY[position] +
+			        sumZ[position] * sumZ[position]);
+			    if (0.0f < length) {
+				    sumX[position] /= length;
+				    sumY[position] /= length;
+				    sumZ[position] /= length;
+			    }
+		    }
+
+		    // 書き戻し
+		    for (size_t p = begin; p < end; p++) {
+			    for (uint32_t i = offsets[p]; i < offsets[p + 1]; i++) {
+				    vertices[sharedVertices[i]].normal = {sumX[p], sumY[p], sumZ[p]};
+			    }
+		    }
+	    });
+}
+
+uint32_t MeshOptimizer::WeldVertices(std::vector<Vertex>& vertices, std::span<uint32_t> indices) {
+	// 開番地法のハッシュ表（大きさは頂点数の2倍以上の2の冪）
+	size_t tableSize = std::bit_ceil(std::max<size_t>(vertices.size() * 2, 16));
+	size_t mask = tableSize - 1;
+	std::vector<uint32_t> table(tableSize, kEmpty);
+	std::vector<uint32_t> remap(vertices.size());
+
+	uint32_t uniqueCount = 0;
+	for (uint32_t i = 0; i < vertices.size(); i++) {
+		const Vertex& vertex = vertices[i];
+		size_t slot = HashVertex(vertex) & mask;
+		while (table[slot] != kEmpty && !IsSameVertex(vertices[table[slot]], vertex)) {
+			slot = (slot + 1) & mask;
+		}
+		if (table[slot] == kEmpty) {
+			// 初めての頂点は前へ詰める（詰めた先はiより前なので未処理の頂点を壊さない）
+			vertices[uniqueCount] = vertex;
+			table[slot] = uniqueCount;
+			uniqueCount++;
+		}
+		remap[i] = table[slot];
+	}
+
+	vertices.resize(uniqueCount);
+	for (uint32_t& index : indices) {
+		index = remap[index];
+	}
+	return uniqueCount;
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::span<uint32_t> indices, uint32_t vertexCount) {
+	const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+	if (triangleCount == 0) {
+		return;
+	}
+
+	// 頂点ごとの隣接三角形（オフセット＋三角形番号の平坦な配列）
+	std::vector<uint32_t> offsets(vertexCount + 1, 0);
+	for (uint32_t index : indices) {
+		offsets[index + 1]++;
+	}
+	for (uint32_t i = 0; i < vertexCount; i++) {
+		offsets[i + 1] += offsets[i];
+	}
+	std::vector<uint32_t> liveTriangles(vertexCount);
+	std::vector<uint32_t> adjacency(indices.size());
+	for (uint32_t triangle = 0; triangle < triangleCount; triangle++) {
+		for (uint32_t k = 0; k < 3; k++) {
+			uint32_t vertex = indices[triangle * 3 + k];
+			adjacency[offsets[vertex] + liveTriangles[vertex]++] = triangle;
+		}
+	}
+
+	// 得点の初期値
+	std::vector<int32_t> cachePositions(vertexCount, -1);
+	std::vector<float> vertexScores(vertexCount);
+	for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+		vertexScores[vertex] = VertexScore(-1, liveTriangles[vertex]);
+	}
+	std::vector<float> triangleScores(triangleCount);
+	std::vector<uint8_t> isEmitted(triangleCount, 0);
+	for (uint32_t triangle = 0; triangle < triangleCount; triangle++) {
+		const uint32_t* triangleIndices = &indices[triangle * 3];
+		triangleScores[triangle] = vertexScores[triangleIndices[0]] +
+		                           vertexScores[triangleIndices[1]] +
+		                           vertexScores[triangleIndices[2]];
+	}
+
+	std::vector<uint32_t> output;
+	output.reserve(indices.size());
+
+	// LRUキャッシュ（追い出された頂点の得点更新のため3つ多く持つ）
+	std::array<uint32_t, kCacheSize + 3> cache;
+	std::array<uint32_t, kCacheSize + 3> newCache;
+	uint32_t cacheCount = 0;
+
+	uint32_t best = static_cast<uint32_t>(
+	    std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin());
+	uint32_t scanCursor = 0;
+
+	while (best != kEmpty) {
+		isEmitted[best] = 1;
+		const uint32_t triangleIndices[3] = {
+		    indices[best * 3], indices[best * 3 + 1], indices[best * 3 + 2]};
+		output.insert(output.end(), triangleIndices, triangleIndices + 3);
+
+		// 出力した三角形を各頂点の隣接から外す
+		for (uint32_t vertex : triangleIndices) {
+			uint32_t* begin = &adjacency[offsets[vertex]];
+			uint32_t* end = begin + liveTriangles[vertex];
+			uint32_t* found = std::find(begin, end, best);
+			if (found != end) {
+				std::swap(*found, *(end - 1));
+				liveTriangles[vertex]--;
+			}
+		}
+
+		// 三角形の頂点を先頭に、残りをその後ろに並べてキャッシュを更新
+		uint32_t newCount = 0;
+		for (uint32_t vertex : triangleIndices) {
+			if (std::find(newCache.begin(), newCache.begin() + newCount, vertex) ==
+			    newCache.begin() + newCount) {
+				newCache[newCount++] = vertex;
+			}
+		}
+		for (uint32_t i = 0; i < cacheCount; i++) {
+			uint32_t vertex = cache[i];
+			if (vertex != triangleIndices[0] && vertex != triangleIndices[1] &&
+			    vertex != triangleIndices[2]) {
+				newCache[newCount++] = vertex;
+			}
+		}
+
+		// キャッシュ内（と追い出された）頂点の得点を更新
+		for (uint32_t i = 0; i < newCount; i++) {
+			uint32_t vertex = newCache[i];
+			cachePositions[vertex] = i < kCacheSize ? static_cast<int32_t>(i) : -1;
+			vertexScores[vertex] = VertexScore(cachePositions[vertex], liveTriangles[vertex]);
+		}
+
+		// 得点が変わった頂点に隣接する三角形から次を選ぶ
+		best = kEmpty;
+		float bestScore = -1.0f;
+		for (uint32_t i = 0; i < newCount; i++) {
+			uint32_t vertex = newCache[i];
+			for (uint32_t j = 0; j < liveTriangles[vertex]; j++) {
+				uint32_t triangle = adjacency[offsets[vertex] + j];
+				const uint32_t* adjacentIndices = &indices[triangle * 3];
+				float score = vertexScores[adjacentIndices[0]] + vertexScores[adjacentIndices[1]] +
+				              vertexScores[adjacentIndices[2]];
+				triangleScores[triangle] = score;
+				if (bestScore < score) {
+					bestScore = score;
+					best = triangle;
+				}
+			}
+		}
+
+		cacheCount = std::min(newCount, kCacheSize);
+		std::copy(newCache.begin(), newCache.begin() + cacheCount, cache.begin());
+
+		// キャッシュから続けられなければ、まだ出力していない三角形を先頭から探す
+		if (best == kEmpty) {
+			while (scanCursor < triangleCount && isEmitted[scanCursor]) {
+				scanCursor++;
+			}
+			if (scanCursor < triangleCount) {
+				best = scanCursor;
+			}
+		}
+	}
+
+	std::copy(output.begin(), output.end(), indices.begin());
+}
+
+void MeshOptimizer::OptimizeVertexFetch(
+    std::vector<Vertex>& vertices, std::span<uint32_t> indices) {
+	std::vector<uint32_t> remap(vertices.size(), kEmpty);
+	std::vector<Vertex> reordered;
+	reordered.reserve(vertices.size());
+	for (uint32_t& index : indices) {
+		if (remap[index] == kEmpty) {
+			remap[index] = static_cast<uint32_t>(reordered.size());
+			reordered.push_back(vertices[index]);
+		}
+		index = remap[index];
+	}
+	vertices = std::move(reordered);
+}
+
+float MeshOptimizer::CalculateACMR(
+    std::span<const uint32_t> indices, uint32_t vertexCount, uint32_t cacheSize) {
+	if (indices.size() < 3) {
+		return 0.0f;
+	}
+	// 頂点ごとにキャッシュへ入った時刻を持ち、cacheSize回より前ならミスとする
+	std::vector<uint32_t> timestamps(vertexCount, 0);
+	uint32_t time = cacheSize + 1;
+	uint32_t misses = 0;
+	for (uint32_t index : indices) {
+		if (time - timestamps[index] > cacheSize) {
+			timestamps[index] = time++;
+			misses++;
+		}
+	}
+	return float(misses) / float(indices.size() / 3);
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Mesh.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/// <summary>
+/// 読み込み時のメッシュ最適化
+/// </summary>
+/// <remarks>
+/// 同一頂点の統合、頂点キャッシュのための三角形の並べ替え（Forsyth法）、
+/// 頂点フェッチのための頂点の並べ替えを行う。描画結果は変わらない。
+/// 座標を共有する頂点の法線の平滑化もここで行う。
+/// </remarks>
+class MeshOptimizer {
+public: // サブクラス
+	// 最適化の結果
+	struct Statistics {
+		uint32_t vertexCountBefore; // 最適化前の頂点数
+		uint32_t vertexCountAfter;  // 最適化後の頂点数
+		uint32_t triangleCount;     // 三角形数
+		float acmrBefore;           // 最適化前の三角形あたりの頂点キャッシュミス数
+		float acmrAfter;            // 最適化後の三角形あたりの頂点キャッシュミス数
+	};
+
+	// 並べ替えで想定する頂点キャッシュの大きさ
+	static constexpr uint32_t kCacheSize = 32;
+	// ACMRの計算に使うFIFOキャッシュの大きさ
+	static constexpr uint32_t kFifoCacheSize = 16;
+	// 法線の平滑化で1回の並列処理が受け持つ座標の数
+	static constexpr size_t kSmoothingGrainSize = 4096;
+
+public: // 静的メンバ関数
+	/// <summary>
+	/// メッシュの頂点とインデックスを最適化する。平滑化の後に呼ぶこと
+	/// </summary>
+	/// <param name="mesh">メッシュ（バッファ生成前）</param>
+	/// <returns>最適化の結果</returns>
+	static Statistics Optimize(Mesh& mesh);
+
+	/// <summary>
+	/// 頂点とインデックスを最適化する（統合→三角形の並べ替え→頂点の並べ替え）
+	/// </summary>
+	/// <param name="vertices">頂点</param>
+	/// <param name="indices">インデックス（三角形リスト）</param>
+	/// <returns>最適化の結果</returns>
+	static Statistics Optimize(
+	    std::vector<Mesh::VertexPosNormalUv>& vertices, std::vector<uint32_t>& indices);
+
+	/// <summary>
+	/// 複数のメッシュの結果を合計する（ACMRは三角形数で重み付けした平均）
+	/// </summary>
+	/// <param name="total">合計（0で初期化したものから足していく）</param>
+	/// <param name="statistics">足すメッシュの結果</param>
+	static void Accumulate(Statistics& total, const Statistics& statistics);
+
+	/// <summary>
+	/// 同じ座標を参照する頂点の法線を、それらの和を正規化したものにそろえる
+	/// </summary>
+	/// <remarks>
+	/// Mesh::AddSmoothData/CalculateSmoothedVertexNormalsと同じ結果になる。
+	/// 座標ごとの頂点は平坦な配列（オフセット＋頂点番号）で持つので、
+	/// 確保は要素数によらず数回で済む。
+	/// SIMDで計算するのは正規化だけで、法線の和は頂点番号をたどるスカラーの集計になる
+	/// （座標ごとに頂点数がばらばらで、4個ずつにまとめられないため）。
+	/// </remarks>
+	/// <param name="vertices">頂点</param>
+	/// <param name="positionIndices">頂点ごとの座標インデックス</param>
+	/// <param name="positionCount">座標の数</param>
+	static void CalculateSmoothedNormals(
+	    std::span<Mesh::VertexPosNormalUv> vertices, std::span<const uint32_t> positionIndices,
+	    uint32_t positionCount);
+
+	/// <summary>
+	/// 全成分がビット単位で等しい頂点を1つにまとめる
+	/// </summary>
+	/// <param name="vertices">頂点（詰めて縮める）</param>
+	/// <param name="indices">インデックス（まとめた頂点を指すよう書き換える）</param>
+	/// <returns>まとめた後の頂点数</returns>
+	static uint32_t WeldVertices(
+	    std::vector<Mesh::VertexPosNormalUv>& vertices, std::span<uint32_t> indices);
+
+	/// <summary>
+	/// 頂点キャッシュの再利用が増えるよう三角形を並べ替える（Forsyth法）
+	/// </summary>
+	/// <param name="indices">インデックス（三角形リスト）</param>
+	/// <param name="vertexCount">頂点数</param>
+	static void OptimizeVertexCache(std::span<uint32_t> indices, uint32_t vertexCount);
+
+	/// <summary>
+	/// インデックスで初めて参照される順に頂点を並べ替える。参照されない頂点は取り除く
+	/// </summary>
+	/// <param name="vertices">頂点</param>
+	/// <param name="indices">インデックス（並べ替え後の頂点を指すよう書き換える）</param>
+	static void OptimizeVertexFetch(
+	    std::vector<Mesh::VertexPosNormalUv>& vertices, std::span<uint32_t> indices);
+
+	/// <summary>
+	/// FIFOキャッシュを仮定した三角形あたりの頂点キャッシュミス数（ACMR）。最良0.5、最悪3
+	/// </summary>
+	/// <param name="indices">インデックス（三角形リスト）</param>
+	/// <param name="vertexCount">頂点数</param>
+	/// <param name="cacheSize">キャッシュの大きさ</param>
+	/// <returns>ACMR（三角形がなければ0）</returns>
+	static float CalculateACMR(
+	    std::span<const uint32_t> indices, uint32_t vertexCount,
+	    uint32_t cacheSize = kFifoCacheSize);
+
+	/// <summary>
+	/// 16ビットインデックスで足りるか
+	/// </summary>
+	/// <param name="vertexCount">頂点数</param>
+	static constexpr bool CanUse16BitIndices(size_t vertexCount) {
+		return vertexCount <= size_t(UINT16_MAX) + 1;
+	}
+};
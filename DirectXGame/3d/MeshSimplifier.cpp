@@ -0,0 +1,395 @@
+#include "MeshSimplifier.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <queue>
+
+namespace {
+
+// 倍精度の3次元ベクトル（二次誤差の計算で桁落ちしないように）
+struct Double3 {
+	double x, y, z;
+};
+
+Double3 ToDouble3(const Vector3& v) { return {v.x, v.y, v.z}; }
+Double3 Subtract(const Double3& a, const Double3& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+double Dot(const Double3& a, const Double3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+Double3 Cross(const Double3& a, const Double3& b) {
+	return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+// 二次誤差（対称4x4行列の上三角）
+struct Quadric {
+	double a00, a01, a02, a03;
+	double a11, a12, a13;
+	double a22, a23;
+	double a33;
+};
+
+/// <summary>
+/// 平面 dot(n, p) + d = 0 までの距離の2乗に重みを掛けた二次誤差
+/// </summary>
+Quadric MakePlaneQuadric(const Double3& n, double d, double weight) {
+	return {
+	    n.x * n.x * weight, n.x * n.y * weight, n.x * n.z * weight, n.x * d * weight,
+	    n.y * n.y * weight, n.y * n.z * weight, n.y * d * weight,   n.z * n.z * weight,
+	    n.z * d * weight,   d * d * weight};
+}
+
+void Add(Quadric& q, const Quadric& r) {
+	q.a00 += r.a00, q.a01 += r.a01, q.a02 += r.a02, q.a03 += r.a03;
+	q.a11 += r.a11, q.a12 += r.a12, q.a13 += r.a13;
+	q.a22 += r.a22, q.a23 += r.a23;
+	q.a33 += r.a33;
+}
+
+/// <summary>
+/// 点での誤差
+/// </summary>
+double Evaluate(const Quadric& q, const Double3& p) {
+	return q.a00 * p.x * p.x + 2.0 * q.a01 * p.x * p.y + 2.0 * q.a02 * p.x * p.z +
+	       2.0 * q.a03 * p.x + q.a11 * p.y * p.y + 2.0 * q.a12 * p.y * p.z + 2.0 * q.a13 * p.y +
+	       q.a22 * p.z * p.z + 2.0 * q.a23 * p.z + q.a33;
+}
+
+// 縮約の候補（fromをtoへまとめる）
+struct Collapse {
+	double cost;
+	uint32_t from;
+	uint32_t to;
+
+	// priority_queueで誤差の小さい順に取り出す
+	bool operator<(const Collapse& other) const { return other.cost < cost; }
+};
+
+// 辺と、その辺を持つ三角形
+struct Edge {
+	uint64_t key; // 小さい方の座標番号を上位に
+	uint32_t triangle;
+};
+
+/// <summary>
+/// バイト列のハッシュ（4バイト単位のFNV-1a）
+/// </summary>
+template<typename T> uint32_t HashWords(const T& value) {
+	static_assert(sizeof(T) % sizeof(uint32_t) == 0);
+	uint32_t words[sizeof(T) / sizeof(uint32_t)];
+	std::memcpy(words, &value, sizeof(words));
+	uint32_t hash = 2166136261u;
+	for (uint32_t word : words) {
+		hash = (hash ^ word) * 16777619u;
+	}
+	return hash;
+}
+
+/// <summary>
+/// 同じ値に同じ番号を振る（開番地法）。ids[i]は最初にその値を持つ要素の番号
+/// </summary>
+template<typename T, typename Project>
+void AssignIds(
+    std::span<const Mesh::VertexPosNormalUv> vertices, Project project, std::vector<uint32_t>& ids,
+    std::vector<uint32_t>& firsts) {
+	ids.resize(vertices.size());
+	size_t tableSize = std::bit_ceil(std::max<size_t>(vertices.size() * 2, 16));
+	std::vector<uint32_t> table(tableSize, UINT32_MAX);
+	for (uint32_t vertex = 0; vertex < vertices.size(); vertex++) {
+		const T& value = project(vertices[vertex]);
+		size_t slot = HashWords(value) & (tableSize - 1);
+		while (table[slot] != UINT32_MAX &&
+		       std::memcmp(&project(vertices[firsts[table[slot]]]), &value, sizeof(T)) != 0) {
+			slot = (slot + 1) & (tableSize - 1);
+		}
+		if (table[slot] == UINT32_MAX) {
+			table[slot] = static_cast<uint32_t>(firsts.size());
+			firsts.push_back(vertex);
+		}
+		ids[vertex] = table[slot];
+	}
+}
+
+} // namespace
+
+float MeshSimplifier::Simplify(
+    std::span<const Mesh::VertexPosNormalUv> vertices, std::span<const uint32_t> indices,
+    uint32_t targetTriangleCount, std::vector<uint32_t>& result) {
+	assert(indices.size() % 3 == 0);
+	result.clear();
+	const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+
+	// 座標が同じ頂点に同じ番号（座標番号）を振る
+	std::vector<uint32_t> positionIds;
+	std::vector<uint32_t> representatives; // 座標番号ごとの代表頂点
+	AssignIds<Vector3>(
+	    vertices, [](const Mesh::VertexPosNormalUv& v) -> const Vector3& { return v.pos; },
+	    positionIds, representatives);
+	const uint32_t idCount = static_cast<uint32_t>(representatives.size());
+	std::vector<Double3> points(idCount);
+	for (uint32_t id = 0; id < idCount; id++) {
+		points[id] = ToDouble3(vertices[representatives[id]].pos);
+	}
+
+	// 座標・法線・UVが全て同じ頂点は同じウェッジ（属性の組）として扱う
+	std::vector<uint32_t> wedgeIds;
+	std::vector<uint32_t> wedges; // ウェッジごとの代表頂点
+	AssignIds<Mesh::VertexPosNormalUv>(
+	    vertices, [](const Mesh::VertexPosNormalUv& v) -> const auto& { return v; }, wedgeIds,
+	    wedges);
+
+	// 三角形（座標番号）と、各角のウェッジの代表頂点。面積0の三角形は最初から除く
+	std::vector<uint32_t> triangles(indices.size());
+	std::vector<uint32_t> corners(indices.size());
+	std::vector<uint8_t> isAlive(triangleCount, 1);
+	uint32_t liveCount = triangleCount;
+	for (uint32_t triangle = 0; triangle < triangleCount; triangle++) {
+		uint32_t* ids = &triangles[triangle * 3];
+		for (uint32_t k = 0; k < 3; k++) {
+			uint32_t vertex = indices[triangle * 3 + k];
+			ids[k] = positionIds[vertex];
+			corners[triangle * 3 + k] = wedges[wedgeIds[vertex]];
+		}
+		if (ids[0] == ids[1] || ids[1] == ids[2] || ids[2] == ids[0]) {
+			isAlive[triangle] = 0;
+			liveCount--;
+		}
+	}
+
+	auto faceNormal = [&points](uint32_t id0, uint32_t id1, uint32_t id2) {
+		return Cross(Subtract(points[id1], points[id0]), Subtract(points[id2], points[id0]));
+	};
+
+	// 面の平面の二次誤差（面積で重み付け）
+	std::vector<Quadric> quadrics(idCount, Quadric{});
+	std::vector<Edge> edges;
+	edges.reserve(size_t(liveCount) * 3);
+	for (uint32_t triangle = 0; triangle < triangleCount; triangle++) {
+		if (!isAlive[triangle]) {
+			continue;
+		}
+		const uint32_t* ids = &triangles[triangle * 3];
+		Double3 normal = faceNormal(ids[0], ids[1], ids[2]);
+		double area2 = std::sqrt(Dot(normal, normal));
+		if (0.0 < area2) {
+			normal = {normal.x / area2, normal.y / area2, normal.z / area2};
+			Quadric quadric = MakePlaneQuadric(normal, -Dot(normal, points[ids[0]]), area2 * 0.5);
+			for (uint32_t k = 0; k < 3; k++) {
+				Add(quadrics[ids[k]], quadric);
+			}
+		}
+		for (uint32_t k = 0; k < 3; k++) {
+			uint32_t a = ids[k], b = ids[(k + 1) % 3];
+			edges.push_back({(uint64_t(std::min(a, b)) << 32) | std::max(a, b), triangle});
+		}
+	}
+	std::sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b) {
+		return a.key < b.key;
+	});
+
+	// 境界の辺（1つの三角形にしか使われない辺）は、辺を含み面に垂直な平面で拘束する
+	for (size_t i = 0; i < edges.size();) {
+		size_t end = i + 1;
+		while (end < edges.size() && edges[end].key == edges[i].key) {
+			end++;
+		}
+		if (end - i == 1) {
+			uint32_t a = uint32_t(edges[i].key >> 32), b = uint32_t(edges[i].key);
+			const uint32_t* ids = &triangles[edges[i].triangle * 3];
+			Double3 edge = Subtract(points[b], points[a]);
+			Double3 normal = Cross(edge, faceNormal(ids[0], ids[1], ids[2]));
+			double length = std::sqrt(Dot(normal, normal));
+			if (0.0 < length) {
+				normal = {normal.x / length, normal.y / length, normal.z / length};
+				Quadric quadric = MakePlaneQuadric(
+				    normal, -Dot(normal, points[a]), kBorderWeight * Dot(edge, edge));
+				Add(quadrics[a], quadric);
+				Add(quadrics[b], quadric);
+			}
+		}
+		i = end;
+	}
+
+	// 座標番号ごとの隣接三角形
+	std::vector<std::vector<uint32_t>> adjacency(idCount);
+	for (uint32_t triangle = 0; triangle < triangleCount; triangle++) {
+		if (isAlive[triangle]) {
+			for (uint32_t k = 0; k < 3; k++) {
+				adjacency[triangles[triangle * 3 + k]].push_back(triangle);
+			}
+		}
+	}
+
+	// 縮約先（自分自身なら未縮約）
+	std::vector<uint32_t> parents(idCount);
+	std::iota(parents.begin(), parents.end(), 0);
+	auto find = [&parents](uint32_t id) {
+		while (parents[id] != id) {
+			parents[id] = parents[parents[id]];
+			id = parents[id];
+		}
+		return id;
+	};
+
+	auto cost = [&](uint32_t from, uint32_t to) {
+		Quadric quadric = quadrics[from];
+		Add(quadric, quadrics[to]);
+		return Evaluate(quadric, points[to]);
+	};
+
+	std::priority_queue<Collapse> queue;
+	auto pushEdge = [&](uint32_t a, uint32_t b) {
+		double costAB = cost(a, b);
+		double costBA = cost(b, a);
+		queue.push(costAB <= costBA ? Collapse{costAB, a, b} : Collapse{costBA, b, a});
+	};
+	for (size_t i = 0; i < edges.size(); i++) {
+		if (i == 0 || edges[i].key != edges[i - 1].key) {
+			pushEdge(uint32_t(edges[i].key >> 32), uint32_t(edges[i].key));
+		}
+	}
+
+	// fromをtoへ動かすと裏返る三角形があるか
+	auto isFlipped = [&](uint32_t from, uint32_t to) {
+		for (uint32_t triangle : adjacency[from]) {
+			const uint32_t* ids = &triangles[triangle * 3];
+			if (!isAlive[triangle] || ids[0] == to || ids[1] == to || ids[2] == to) {
+				continue;
+			}
+			Double3 before = faceNormal(ids[0], ids[1], ids[2]);
+			uint32_t moved[3] = {ids[0], ids[1], ids[2]};
+			for (uint32_t& id : moved) {
+				id = id == from ? to : id;
+			}
+			if (Dot(before, faceNormal(moved[0], moved[1], moved[2])) <= 0.0) {
+				return true;
+			}
+		}
+		return false;
+	};
+
+	// fromの角のウェッジを、縮約する辺の三角形でtoの角と対応付ける。
+	// fromの全てのウェッジがtoのウェッジと1対1に対応しなければ、継ぎ目をまたぐので縮約しない
+	std::vector<std::pair<uint32_t, uint32_t>> wedgeMap; // fromのウェッジ→toのウェッジ
+	auto mapWedges = [&](uint32_t from, uint32_t to) {
+		wedgeMap.clear();
+		for (uint32_t triangle : adjacency[from]) {
+			const uint32_t* ids = &triangles[triangle * 3];
+			if (!isAlive[triangle] || (ids[0] != to && ids[1] != to && ids[2] != to)) {
+				continue;
+			}
+			uint32_t wedgeFrom = UINT32_MAX, wedgeTo = UINT32_MAX;
+			for (uint32_t k = 0; k < 3; k++) {
+				wedgeFrom = ids[k] == from ? corners[triangle * 3 + k] : wedgeFrom;
+				wedgeTo = ids[k] == to ? corners[triangle * 3 + k] : wedgeTo;
+			}
+			// 1対1に対応しなければ継ぎ目が途切れる
+			for (const auto& [mappedFrom, mappedTo] : wedgeMap) {
+				if ((mappedFrom == wedgeFrom) != (mappedTo == wedgeTo)) {
+					return false;
+				}
+			}
+			wedgeMap.emplace_back(wedgeFrom, wedgeTo);
+		}
+		for (uint32_t triangle : adjacency[from]) {
+			if (!isAlive[triangle]) {
+				continue;
+			}
+			for (uint32_t k = 0; k < 3; k++) {
+				if (triangles[triangle * 3 + k] != from) {
+					continue;
+				}
+				uint32_t corner = corners[triangle * 3 + k];
+				auto isSame = [corner](const auto& m) { return m.first == corner; };
+				if (std::none_of(wedgeMap.begin(), wedgeMap.end(), isSame)) {
+					return false;
+				}
+			}
+		}
+		return true;
+	};
+
+	double maxError = 0.0;
+	std::vector<uint32_t> neighbors;
+	while (targetTriangleCount < liveCount && !queue.empty()) {
+		Collapse collapse = queue.top();
+		queue.pop();
+
+		uint32_t from = find(collapse.from);
+		uint32_t to = find(collapse.to);
+		if (from == to) {
+			continue;
+		}
+		// 他の縮約で端点や誤差が変わっていたら評価し直して積み直す
+		double current = cost(from, to);
+		if (from != collapse.from || to != collapse.to || collapse.cost < current) {
+			pushEdge(from, to);
+			continue;
+		}
+		// 裏返る・継ぎ目をまたぐ縮約はしない（周りの縮約で誤差が更新されたら積み直される）
+		if (isFlipped(from, to) || !mapWedges(from, to)) {
+			continue;
+		}
+
+		// 縮約
+		parents[from] = to;
+		Add(quadrics[to], quadrics[from]);
+		for (uint32_t triangle : adjacency[from]) {
+			if (!isAlive[triangle]) {
+				continue;
+			}
+			uint32_t* ids = &triangles[triangle * 3];
+			for (uint32_t k = 0; k < 3; k++) {
+				if (ids[k] != from) {
+					continue;
+				}
+				// 角の属性は対応するtoのウェッジに置き換える
+				ids[k] = to;
+				uint32_t& corner = corners[triangle * 3 + k];
+				for (const auto& [mappedFrom, mappedTo] : wedgeMap) {
+					if (mappedFrom == corner) {
+						corner = mappedTo;
+						break;
+					}
+				}
+			}
+			if (ids[0] == ids[1] || ids[1] == ids[2] || ids[2] == ids[0]) {
+				isAlive[triangle] = 0;
+				liveCount--;
+			} else {
+				adjacency[to].push_back(triangle);
+			}
+		}
+		adjacency[from].clear();
+		adjacency[from].shrink_to_fit();
+		maxError = std::max(maxError, current);
+
+		// toの周りの辺は誤差が変わったので積み直す（以前に見送った縮約もここで評価し直す）
+		std::vector<uint32_t>& around = adjacency[to];
+		std::erase_if(around, [&isAlive](uint32_t triangle) { return !isAlive[triangle]; });
+		neighbors.clear();
+		for (uint32_t triangle : around) {
+			for (uint32_t k = 0; k < 3; k++) {
+				uint32_t id = triangles[triangle * 3 + k];
+				if (id != to) {
+					neighbors.push_back(id);
+				}
+			}
+		}
+		std::sort(neighbors.begin(), neighbors.end());
+		neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+		for (uint32_t neighbor : neighbors) {
+			pushEdge(neighbor, to);
+		}
+	}
+
+	// 残った三角形を角のウェッジの代表頂点で出力する
+	result.reserve(size_t(liveCount) * 3);
+	for (uint32_t triangle = 0; triangle < triangleCount; triangle++) {
+		if (isAlive[triangle]) {
+			result.insert(
+			    result.end(), corners.begin() + triangle * 3, corners.begin() + triangle * 3 + 3);
+		}
+	}
+	return static_cast<float>(maxError);
+}
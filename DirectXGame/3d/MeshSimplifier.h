@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Mesh.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/// <summary>
+/// 二次誤差（QEM）による辺の縮約でメッシュを簡略化する
+/// </summary>
+/// <remarks>
+/// 座標が同じ頂点をまとめて1点として縮約するので、UVや法線の継ぎ目で穴が開かない。
+/// 継ぎ目上の点は継ぎ目に沿ってだけ縮約し、三角形の角は縮約先でも同じ側の属性の頂点を使う。
+/// 縮約先は既存の頂点に限るため、結果は元の頂点配列を指すインデックスだけになり、
+/// LODごとに頂点バッファを持たなくてよい。境界の辺は拘束平面で形を保つ。
+/// </remarks>
+class MeshSimplifier {
+public: // 静的メンバ関数
+	/// <summary>
+	/// 三角形数が目標以下になるまで簡略化する
+	/// </summary>
+	/// <param name="vertices">頂点</param>
+	/// <param name="indices">インデックス（三角形リスト）</param>
+	/// <param name="targetTriangleCount">目標の三角形数</param>
+	/// <param name="result">簡略化後のインデックス（verticesを指す）</param>
+	/// <returns>縮約した中で最大の誤差（距離の2乗）</returns>
+	/// <remarks>裏返る・継ぎ目をまたぐ縮約はしないので、目標まで減らないことがある</remarks>
+	static float Simplify(
+	    std::span<const Mesh::VertexPosNormalUv> vertices, std::span<const uint32_t> indices,
+	    uint32_t targetTriangleCount, std::vector<uint32_t>& result);
+
+	/// <summary>
+	/// 境界の辺の拘束平面の重み
+	/// </summary>
+	static constexpr double kBorderWeight = 10.0;
+};
@@ -3,7 +3,9 @@
 #include "LightGroup.h"
 #include "Material.h"
 #include "Mesh.h"
+#include "MeshOptimizer.h"
 #include "ObjectColor.h"
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -128,6 +130,44 @@ public: // 静的メンバ関数
 	/// <returns>生成されたモデル</returns>
 	static Model* CreateFromOBJ(const std::string& modelname, bool smoothing = false);
 
+	/// <summary>
+	/// OBJファイルからメッシュ生成（ObjParserによる高速読み込み）
+	/// </summary>
+	/// <remarks>
+	/// 初回はOBJを解析してモデル名.meshcacheを書き出し、以降はそれを読む。
+	/// OBJ/MTLの内容が変わると作り直す。
+	/// GeometryArenaが初期化済みならメッシュはそこに置かれるので、破棄する前に
+	/// GeometryArena::Releaseを呼ぶか、GeometryArena::ModelDeleterで破棄すること。
+	/// </remarks>
+	/// <param name="modelname">モデル名</param>
+	/// <param name="smoothing">エッジ平滑化フラグ</param>
+	/// <param name="statistics">
+	/// 全メッシュの最適化の結果の出力先（キャッシュから読んだときは書き込み時の結果）
+	/// </param>
+	/// <returns>生成されたモデル</returns>
+	static Model* CreateFromOBJFast(
+	    const std::string& modelname, bool smoothing = false,
+	    MeshOptimizer::Statistics* statistics = nullptr);
+
+	/// <summary>
+	/// 複数のOBJファイルからまとめてメッシュ生成（メッシュとマテリアルの解析を並列化した
+	/// CreateFromOBJFastの一括版）
+	/// </summary>
+	/// <remarks>
+	/// メッシュとマテリアルの解析はモデル単位でワーカースレッドに割り当てて並列に行い、
+	/// GPUバッファの生成と転送の発行は呼び出し元のスレッドで行う。
+	/// マテリアルはTextureManagerのテクスチャで描画されるため、テクスチャは呼び出し元の
+	/// スレッドでTextureManagerに読み込む（複数のモデルが使うものは1度だけ）。
+	/// 戻る時点で全ての転送が完了している。
+	/// </remarks>
+	/// <param name="modelnames">モデル名の配列</param>
+	/// <param name="smoothing">エッジ平滑化フラグ</param>
+	/// <param name="statistics">モデルごとの最適化の結果の出力先（modelnamesと同じ順）</param>
+	/// <returns>生成されたモデル（modelnamesと同じ順）</returns>
+	static std::vector<Model*> CreateFromOBJBatch(
+	    std::span<const std::string> modelnames, bool smoothing = false,
+	    std::vector<MeshOptimizer::Statistics>* statistics = nullptr);
+
 	/// <summary>
 	/// 球モデル生成
 	/// </summary>
@@ -147,6 +187,12 @@ public: // 静的メンバ関数
 	/// </summary>
 	static void PostDraw();
 
+	/// <summary>
+	/// 並列記録用コマンドリストの描画前処理。メインスレッドでまとめて呼ぶ
+	/// </summary>
+	/// <param name="commandLists">DirectXCommon::BeginParallelRecordingで得たコマンドリスト</param>
+	static void PreDrawParallel(std::span<ID3D12GraphicsCommandList* const> commandLists);
+
 public: // メンバ関数
 	~Model() = default;
 
@@ -171,6 +217,41 @@ public: // メンバ関数
 	    const WorldTransform& worldTransform, const ViewProjection& viewProjection,
 	    uint32_t textureHadle, const ObjectColor* objectColor = nullptr);
 
+	/// <summary>
+	/// 描画（フレーム用定数バッファ版）
+	/// </summary>
+	/// <remarks>
+	/// マテリアルも描画ごとにConstBufferAllocatorへ書き込むので、マテリアル自身の定数バッファは
+	/// 更新しなくてよい。
+	/// </remarks>
+	/// <param name="worldTransform">ワールド変換行列のGPU仮想アドレス</param>
+	/// <param name="viewProjection">ビュープロジェクションのGPU仮想アドレス</param>
+	/// <param name="objectColor">オブジェクトカラーのGPU仮想アドレス（0ならデフォルト）</param>
+	void Draw(
+	    D3D12_GPU_VIRTUAL_ADDRESS worldTransform, D3D12_GPU_VIRTUAL_ADDRESS viewProjection,
+	    D3D12_GPU_VIRTUAL_ADDRESS objectColor = 0);
+
+	/// <summary>
+	/// 描画（コマンドリスト指定）。PreDrawParallel済みのコマンドリストへ別スレッドから記録できる
+	/// </summary>
+	/// <param name="commandList">記録先のコマンドリスト</param>
+	/// <param name="worldTransform">ワールドトランスフォーム</param>
+	/// <param name="viewProjection">ビュープロジェクション</param>
+	/// <param name="objectColor">オブジェクトカラー</param>
+	void Draw(
+	    ID3D12GraphicsCommandList* commandList, const WorldTransform& worldTransform,
+	    const ViewProjection& viewProjection, const ObjectColor* objectColor = nullptr);
+
+	/// <summary>
+	/// インスタンシング描画。メッシュごとに1回の描画コマンドで全インスタンスを描く
+	/// </summary>
+	/// <param name="worldTransforms">ワールドトランスフォームの配列</param>
+	/// <param name="viewProjection">ビュープロジェクション</param>
+	/// <param name="colors">インスタンスごとの色（空なら白）</param>
+	void DrawInstanced(
+	    std::span<const WorldTransform* const> worldTransforms,
+	    const ViewProjection& viewProjection, std::span<const Vector4> colors = {});
+
 	/// <summary>
 	/// メッシュコンテナを取得
 	/// </summary>
@@ -189,6 +270,24 @@ public: // メンバ関数
 	/// <param name="lightGroup">ライトグループ</param>
 	void SetLightGroup(const LightGroup* lightGroup) { lightGroup_ = lightGroup; }
 
+	/// <summary>
+	/// ライトグループを取得する
+	/// </summary>
+	/// <returns>ライトグループ（nullptrならデフォルト）</returns>
+	const LightGroup* GetLightGroup() const { return lightGroup_; }
+
+	/// <summary>
+	/// 全メッシュを囲むAABBを計算する。読み込み後に一度計算して保持すること
+	/// </summary>
+	/// <returns>モデル座標系のAABB</returns>
+	AABB CalculateBoundingBox() const;
+
+	/// <summary>
+	/// 全メッシュを囲む球を計算する。読み込み後に一度計算して保持すること
+	/// </summary>
+	/// <returns>モデル座標系の球</returns>
+	Sphere CalculateBoundingSphere() const;
+
 private: // メンバ変数
 	// 名前
 	std::string name_;
@@ -224,6 +323,47 @@ private: // メンバ関数
 	/// <param name="modelname">エッジ平滑化フラグ</param>
 	void LoadModel(const std::string& modelname, bool smoothing);
 
+	/// <summary>
+	/// ObjParserでファイルを読み込んで初期化
+	/// </summary>
+	/// <param name="modelname">モデル名</param>
+	/// <param name="smoothing">エッジ平滑化フラグ</param>
+	/// <returns>全メッシュの最適化の結果</returns>
+	MeshOptimizer::Statistics InitializeFromFileFast(const std::string& modelname, bool smoothing);
+
+	/// <summary>
+	/// ObjParserでメッシュとマテリアルを読み込む（GPUへの転送はしない）。
+	/// モデルごとに別スレッドから呼べる
+	/// </summary>
+	/// <param name="modelname">モデル名</param>
+	/// <param name="smoothing">エッジ平滑化フラグ</param>
+	/// <returns>全メッシュの最適化の結果</returns>
+	MeshOptimizer::Statistics LoadFromFileFast(const std::string& modelname, bool smoothing);
+
+	/// <summary>
+	/// 全メッシュのバッファ生成と転送の発行、マテリアルの更新
+	/// </summary>
+	/// <returns>最後の転送のチケット</returns>
+	CopyQueue::Ticket CreateBuffersFast();
+
+	/// <summary>
+	/// ObjParserでモデル読み込み。読み込んだ内容はメッシュキャッシュに書き出す
+	/// </summary>
+	/// <param name="directoryPath">読み込みディレクトリパス</param>
+	/// <param name="smoothing">エッジ平滑化フラグ</param>
+	/// <returns>全メッシュの最適化の結果</returns>
+	MeshOptimizer::Statistics LoadModelFast(const std::string& directoryPath, bool smoothing);
+
+	/// <summary>
+	/// メッシュキャッシュからモデル読み込み
+	/// </summary>
+	/// <param name="directoryPath">読み込みディレクトリパス</param>
+	/// <param name="smoothing">エッジ平滑化フラグ</param>
+	/// <param name="statistics">キャッシュ書き込み時の最適化の結果の出力先</param>
+	/// <returns>成否（ないか元ファイルが更新されていればfalse）</returns>
+	bool LoadMeshCache(
+	    const std::string& directoryPath, bool smoothing, MeshOptimizer::Statistics& statistics);
+
 	/// <summary>
 	/// マテリアル読み込み
 	/// </summary>
@@ -0,0 +1,37 @@
+#include "MathUtility.h"
+#include "Model.h"
+#include <algorithm>
+#include <cmath>
+
+AABB Mesh::CalculateBoundingBox() const {
+	AABB aabb = MathUtility::MakeEmptyAABB();
+	for (const VertexPosNormalUv& vertex : vertices_) {
+		aabb = MathUtility::Merge(aabb, vertex.pos);
+	}
+	return aabb;
+}
+
+AABB Model::CalculateBoundingBox() const {
+	AABB aabb = MathUtility::MakeEmptyAABB();
+	for (const auto& mesh : meshes_) {
+		aabb = MathUtility::Merge(aabb, mesh->CalculateBoundingBox());
+	}
+	// 頂点がなければ原点の点とする
+	if (MathUtility::IsEmpty(aabb)) {
+		aabb = {};
+	}
+	return aabb;
+}
+
+Sphere Model::CalculateBoundingSphere() const {
+	// AABBの中心から最も遠い頂点までを半径とする（AABBの外接球より小さくなる）
+	Vector3 center = MathUtility::GetCenter(CalculateBoundingBox());
+	float radiusSq = 0.0f;
+	for (const auto& mesh : meshes_) {
+		for (const auto& vertex : mesh->GetVertices()) {
+			Vector3 diff = MathUtility::Subtract(vertex.pos, center);
+			radiusSq = std::max(radiusSq, MathUtility::Dot(diff, diff));
+		}
+	}
+	return {center, std::sqrt(radiusSq)};
+}
@@ -0,0 +1,214 @@
+#include "ModelInstancing.h"
+#include "ConstBufferAllocator.h"
+#include "DirectXCommon.h"
+#include "Model.h"
+#include "ViewProjection.h"
+#include "WorldTransform.h"
+#include <cassert>
+#include <d3dcompiler.h>
+#include <d3dx12.h>
+
+#pragma comment(lib, "d3dcompiler.lib")
+
+ModelInstancingCommon* ModelInstancingCommon::GetInstance() {
+	static ModelInstancingCommon instance;
+	return &instance;
+}
+
+void ModelInstancingCommon::Initialize() {
+	// パイプライン初期化
+	InitializeGraphicsPipeline();
+
+	// デフォルトライト
+	defaultLightGroup_.reset(LightGroup::Create());
+}
+
+void ModelInstancingCommon::PreDraw(ID3D12GraphicsCommandList* commandList) {
+	assert(commandList);
+	assert(pipelineState_);
+
+	// パイプラインステートの設定
+	commandList->SetPipelineState(pipelineState_.Get());
+	// ルートシグネチャの設定
+	commandList->SetGraphicsRootSignature(rootSignature_.Get());
+	// プリミティブ形状を設定
+	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+}
+
+void ModelInstancingCommon::LightCommand(
+    ID3D12GraphicsCommandList* commandList, const LightGroup* lightGroup) {
+	if (!lightGroup) {
+		lightGroup = defaultLightGroup_.get();
+	}
+	lightGroup->Draw(commandList, static_cast<UINT>(RoomParameter::kLight));
+}
+
+void ModelInstancingCommon::InitializeGraphicsPipeline() {
+	HRESULT result = S_FALSE;
+	Microsoft::WRL::ComPtr<ID3DBlob> vsBlob;    // 頂点シェーダオブジェクト
+	Microsoft::WRL::ComPtr<ID3DBlob> psBlob;    // ピクセルシェーダオブジェクト
+	Microsoft::WRL::ComPtr<ID3DBlob> errorBlob; // エラーオブジェクト
+
+	// 頂点シェーダの読み込みとコンパイル
+	result = D3DCompileFromFile(
+	    L"Resources/shaders/ObjInstancedVS.hlsl", // シェーダファイル名
+	    nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main", "vs_5_0", 0, 0, &vsBlob, &errorBlob);
+	assert(SUCCEEDED(result));
+
+	// ピクセルシェーダの読み込みとコンパイル
+	result = D3DCompileFromFile(
+	    L"Resources/shaders/ObjInstancedPS.hlsl", // シェーダファイル名
+	    nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main", "ps_5_0", 0, 0, &psBlob, &errorBlob);
+	assert(SUCCEEDED(result));
+
+	// 頂点レイアウト
+	D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
+	    {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT,
+	     D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"NORMAL",   0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT,
+	     D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,    0, D3D12_APPEND_ALIGNED_ELEMENT,
+	     D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	};
+
+	// グラフィックスパイプラインの流れを設定
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC gpipeline{};
+	gpipeline.VS = CD3DX12_SHADER_BYTECODE(vsBlob.Get());
+	gpipeline.PS = CD3DX12_SHADER_BYTECODE(psBlob.Get());
+
+	// サンプルマスク
+	gpipeline.SampleMask = D3D12_DEFAULT_SAMPLE_MASK; // 標準設定
+	// ラスタライザステート
+	gpipeline.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+	// デプスステンシルステート
+	gpipeline.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
+
+	// レンダーターゲットのブレンド設定
+	D3D12_RENDER_TARGET_BLEND_DESC blenddesc{};
+	blenddesc.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL; // RBGA全てのチャンネルを描画
+	blenddesc.BlendEnable = true;
+	blenddesc.BlendOp = D3D12_BLEND_OP_ADD;
+	blenddesc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+	blenddesc.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+	blenddesc.BlendOpAlpha = D3D12_BLEND_OP_ADD;
+	blenddesc.SrcBlendAlpha = D3D12_BLEND_ONE;
+	blenddesc.DestBlendAlpha = D3D12_BLEND_ZERO;
+
+	// ブレンドステートの設定
+	gpipeline.BlendState.RenderTarget[0] = blenddesc;
+
+	// 深度バッファのフォーマット
+	gpipeline.DSVFormat = DXGI_FORMAT_D32_FLOAT;
+
+	// 頂点レイアウトの設定
+	gpipeline.InputLayout.pInputElementDescs = inputLayout;
+	gpipeline.InputLayout.NumElements = _countof(inputLayout);
+
+	// 図形の形状設定（三角形）
+	gpipeline.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+
+	gpipeline.NumRenderTargets = 1;                            // 描画対象は1つ
+	gpipeline.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB; // 0～255指定のRGBA
+	gpipeline.SampleDesc.Count = 1; // 1ピクセルにつき1回サンプリング
+
+	// デスクリプタレンジ
+	CD3DX12_DESCRIPTOR_RANGE descRangeSRV;
+	descRangeSRV.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0); // t0 レジスタ
+
+	// ルートパラメータ
+	CD3DX12_ROOT_PARAMETER rootparams[5] = {};
+	rootparams[static_cast<size_t>(RoomParameter::kInstanceData)].InitAsShaderResourceView(
+	    1, 0, D3D12_SHADER_VISIBILITY_VERTEX);
+	rootparams[static_cast<size_t>(RoomParameter::kViewProjection)].InitAsConstantBufferView(
+	    1, 0, D3D12_SHADER_VISIBILITY_ALL);
+	rootparams[static_cast<size_t>(RoomParameter::kMaterial)].InitAsConstantBufferView(
+	    2, 0, D3D12_SHADER_VISIBILITY_ALL);
+	rootparams[static_cast<size_t>(RoomParameter::kTexture)].InitAsDescriptorTable(
+	    1, &descRangeSRV, D3D12_SHADER_VISIBILITY_ALL);
+	rootparams[static_cast<size_t>(RoomParameter::kLight)].InitAsConstantBufferView(
+	    3, 0, D3D12_SHADER_VISIBILITY_ALL);
+
+	// スタティックサンプラー
+	CD3DX12_STATIC_SAMPLER_DESC samplerDesc = CD3DX12_STATIC_SAMPLER_DESC(0);
+
+	// ルートシグネチャの設定
+	CD3DX12_VERSIONED_ROOT_SIGNATURE_DESC rootSignatureDesc;
+	rootSignatureDesc.Init_1_0(
+	    _countof(rootparams), rootparams, 1, &samplerDesc,
+	    D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT);
+
+	Microsoft::WRL::ComPtr<ID3DBlob> rootSigBlob;
+	// バージョン自動判定のシリアライズ
+	result = D3DX12SerializeVersionedRootSignature(
+	    &rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1_0, &rootSigBlob, &errorBlob);
+	assert(SUCCEEDED(result));
+	// ルートシグネチャの生成
+	ID3D12Device* device = DirectXCommon::GetInstance()->GetDevice();
+	result = device->CreateRootSignature(
+	    0, rootSigBlob->GetBufferPointer(), rootSigBlob->GetBufferSize(),
+	    IID_PPV_ARGS(&rootSignature_));
+	assert(SUCCEEDED(result));
+
+	gpipeline.pRootSignature = rootSignature_.Get();
+
+	// グラフィックスパイプラインの生成
+	result = device->CreateGraphicsPipelineState(&gpipeline, IID_PPV_ARGS(&pipelineState_));
+	assert(SUCCEEDED(result));
+}
+
+void Model::DrawInstanced(
+    std::span<const WorldTransform* const> worldTransforms, const ViewProjection& viewProjection,
+    std::span<const Vector4> colors) {
+	// 色を指定する場合はインスタンス数と揃える
+	assert(colors.empty() || colors.size() == worldTransforms.size());
+
+	if (worldTransforms.empty()) {
+		return;
+	}
+
+	using RoomParameter = ModelInstancingCommon::RoomParameter;
+	using InstanceData = ModelInstancingCommon::InstanceData;
+
+	ID3D12GraphicsCommandList* commandList = ModelCommon::GetInstance()->GetCommandList();
+	// PreDrawとPostDrawの間で呼ぶこと
+	assert(commandList);
+
+	// インスタンスデータをフレーム用バッファへ書き込む
+	UINT instanceCount = static_cast<UINT>(worldTransforms.size());
+	ConstBufferAllocator::Allocation allocation =
+	    ConstBufferAllocator::GetInstance()->Allocate(sizeof(InstanceData) * instanceCount);
+	InstanceData* instanceMap = static_cast<InstanceData*>(allocation.cpuAddress);
+	for (UINT i = 0; i < instanceCount; i++) {
+		instanceMap[i].world = worldTransforms[i]->matWorld_;
+		instanceMap[i].color = colors.empty() ? Vector4{1, 1, 1, 1} : colors[i];
+	}
+
+	// インスタンシング用パイプラインに切り替え
+	ModelInstancingCommon* instancingCommon = ModelInstancingCommon::GetInstance();
+	instancingCommon->PreDraw(commandList);
+	instancingCommon->LightCommand(commandList, lightGroup_);
+
+	// SRVをセット（インスタンスデータ）
+	commandList->SetGraphicsRootShaderResourceView(
+	    static_cast<UINT>(RoomParameter::kInstanceData), allocation.gpuAddress);
+	// CBVをセット（ビュープロジェクション行列）
+	commandList->SetGraphicsRootConstantBufferView(
+	    static_cast<UINT>(RoomParameter::kViewProjection),
+	    viewProjection.GetConstBuffer()->GetGPUVirtualAddress());
+
+	// メッシュごとに1回だけ描画
+	for (auto& mesh : meshes_) {
+		mesh->GetMaterial()->SetGraphicsCommand(
+		    commandList, static_cast<UINT>(RoomParameter::kMaterial),
+		    static_cast<UINT>(RoomParameter::kTexture));
+
+		commandList->IASetVertexBuffers(0, 1, &mesh->GetVBView());
+		commandList->IASetIndexBuffer(&mesh->GetIBView());
+		commandList->DrawIndexedInstanced(
+		    static_cast<UINT>(mesh->GetIndices().size()), instanceCount, 0, 0, 0);
+	}
+
+	// 通常のモデル描画用パイプラインに戻す
+	Model::PostDraw();
+	Model::PreDraw(commandList);
+}
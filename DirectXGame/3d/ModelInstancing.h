@@ -0,0 +1,74 @@
+#pragma once
+
+#include "LightGroup.h"
+#include "Matrix4x4.h"
+#include "Vector4.h"
+#include <cstddef>
+#include <d3d12.h>
+#include <memory>
+#include <wrl.h>
+
+/// <summary>
+/// インスタンシング描画共通データ
+/// </summary>
+class ModelInstancingCommon {
+public: // サブクラス
+	// インスタンスごとのデータ（ObjInstanced.hlsliと一致させること）
+	struct InstanceData {
+		Matrix4x4 world; // ワールド行列
+		Vector4 color;   // オブジェクトカラー
+	};
+
+	/// <summary>
+	/// ルートパラメータ番号
+	/// </summary>
+	enum class RoomParameter {
+		kInstanceData,   // インスタンスデータ
+		kViewProjection, // ビュープロジェクション変換行列
+		kMaterial,       // マテリアル
+		kTexture,        // テクスチャ
+		kLight,          // ライト
+	};
+
+public:
+	static ModelInstancingCommon* GetInstance();
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	void Initialize();
+
+	/// <summary>
+	/// 描画前処理
+	/// </summary>
+	/// <param name="commandList">コマンドリスト</param>
+	void PreDraw(ID3D12GraphicsCommandList* commandList);
+
+	/// <summary>
+	/// ライトコマンドを積む
+	/// </summary>
+	/// <param name="commandList">コマンドリスト</param>
+	/// <param name="lightGroup">ライトグループ（nullptrならデフォルト）</param>
+	void LightCommand(ID3D12GraphicsCommandList* commandList, const LightGroup* lightGroup);
+
+private:
+	ModelInstancingCommon() = default;
+	~ModelInstancingCommon() = default;
+	ModelInstancingCommon(const ModelInstancingCommon&) = delete;
+	ModelInstancingCommon& operator=(const ModelInstancingCommon&) = delete;
+
+	/// <summary>
+	/// グラフィックスパイプラインの初期化
+	/// </summary>
+	void InitializeGraphicsPipeline();
+
+	// ルートシグネチャ
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_;
+	// パイプラインステートオブジェクト
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState_;
+	// デフォルトライト
+	std::unique_ptr<LightGroup> defaultLightGroup_;
+};
+// ObjInstanced.hlsliのInstanceData（StructuredBufferなので詰めて並ぶ）と一致すること
+static_assert(offsetof(ModelInstancingCommon::InstanceData, color) == 64);
+static_assert(sizeof(ModelInstancingCommon::InstanceData) == 80);
@@ -0,0 +1,232 @@
+#include "GeometryArena.h"
+#include "JobSystem.h"
+#include "MeshCache.h"
+#include "Model.h"
+#include "ObjMeshBuilder.h"
+#include "ObjParser.h"
+#include <algorithm>
+#include <cassert>
+#include <filesystem>
+
+namespace {
+
+/// <summary>
+/// 解析したマテリアルからマテリアルを生成
+/// </summary>
+std::unique_ptr<Material> CreateMaterial(const ObjParser::MaterialData& data) {
+	std::unique_ptr<Material> material = Material::Create();
+	material->name_ = data.name;
+	material->ambient_ = data.ambient;
+	material->diffuse_ = data.diffuse;
+	material->specular_ = data.specular;
+	material->alpha_ = data.alpha;
+	material->textureFilename_ = data.textureFilename;
+	return material;
+}
+
+} // namespace
+
+Model* Model::CreateFromOBJFast(
+    const std::string& modelname, bool smoothing, MeshOptimizer::Statistics* statistics) {
+	Model* instance = new Model;
+	MeshOptimizer::Statistics result = instance->InitializeFromFileFast(modelname, smoothing);
+	if (statistics) {
+		*statistics = result;
+	}
+	return instance;
+}
+
+std::vector<Model*> Model::CreateFromOBJBatch(
+    std::span<const std::string> modelnames, bool smoothing,
+    std::vector<MeshOptimizer::Statistics>* statistics) {
+	std::vector<Model*> models(modelnames.size());
+	std::vector<MeshOptimizer::Statistics> results(modelnames.size());
+	for (Model*& model : models) {
+		model = new Model;
+	}
+
+	// 大きいOBJから割り当てると、最後に1つだけ残って待つ時間が短くなる
+	std::vector<size_t> order(modelnames.size());
+	std::vector<uintmax_t> fileSizes(modelnames.size());
+	for (size_t i = 0; i < modelnames.size(); i++) {
+		std::error_code errorCode;
+		const std::string& modelname = modelnames[i];
+		fileSizes[i] = std::filesystem::file_size(
+		    std::string(kBaseDirectory) + modelname + "/" + modelname + ".obj", errorCode);
+		fileSizes[i] = errorCode ? 0 : fileSizes[i];
+		order[i] = i;
+	}
+	std::stable_sort(order.begin(), order.end(), [&fileSizes](size_t a, size_t b) {
+		return fileSizes[b] < fileSizes[a];
+	});
+
+	// メッシュとマテリアルはモデルごとに並列に読み込む（解析自体も内部で並列化される）
+	JobSystem::GetInstance()->ParallelFor(order.size(), 1, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			results[order[i]] = models[order[i]]->LoadFromFileFast(modelnames[order[i]], smoothing);
+		}
+	});
+
+	// GPUバッファの生成と転送の発行はこのスレッドで行い、最後にまとめて待つ
+	// マテリアルはTextureManagerのデスクリプタヒープで描画されるので、テクスチャもそこへ
+	// 読み込む。共有されるテクスチャはファイル名で引かれ、2回目以降はデコードしない
+	CopyQueue::Ticket ticket = 0;
+	for (Model* model : models) {
+		ticket = std::max(ticket, model->CreateBuffersFast());
+		model->LoadTextures();
+	}
+	CopyQueue::GetInstance()->Wait(ticket);
+	if (statistics) {
+		*statistics = std::move(results);
+	}
+	return models;
+}
+
+MeshOptimizer::Statistics Model::InitializeFromFileFast(
+    const std::string& modelname, bool smoothing) {
+	MeshOptimizer::Statistics statistics = LoadFromFileFast(modelname, smoothing);
+	CopyQueue::GetInstance()->Wait(CreateBuffersFast());
+	LoadTextures();
+	return statistics;
+}
+
+MeshOptimizer::Statistics Model::LoadFromFileFast(const std::string& modelname, bool smoothing) {
+	name_ = modelname;
+	const std::string directoryPath = std::string(kBaseDirectory) + modelname + "/";
+
+	// キャッシュが最新ならそれを使い、なければOBJを解析してキャッシュを作る
+	MeshOptimizer::Statistics statistics{};
+	if (!LoadMeshCache(directoryPath, smoothing, statistics)) {
+		statistics = LoadModelFast(directoryPath, smoothing);
+	}
+
+	// マテリアルの割り当てがないメッシュにはデフォルトマテリアルを割り当てる
+	for (auto& mesh : meshes_) {
+		if (mesh->GetMaterial() == nullptr) {
+			if (defaultMaterial_ == nullptr) {
+				defaultMaterial_ = Material::Create();
+				defaultMaterial_->name_ = "no material";
+			}
+			mesh->SetMaterial(defaultMaterial_.get());
+		}
+	}
+	return statistics;
+}
+
+CopyQueue::Ticket Model::CreateBuffersFast() {
+	// 全メッシュの転送をまとめて積み、最後のチケットだけを返す
+	// ジオメトリアリーナがあれば個別のバッファを作らずにそこへ置く
+	CopyQueue::Ticket ticket = 0;
+	GeometryArena* geometryArena = GeometryArena::GetInstance();
+	for (auto& mesh : meshes_) {
+		ticket = geometryArena->IsInitialized() ? geometryArena->Upload(mesh.get())
+		                                        : mesh->CreateBuffersAsync();
+	}
+	for (auto& material : materials_) {
+		material.second->Update();
+	}
+	if (defaultMaterial_) {
+		defaultMaterial_->Update();
+	}
+	return ticket;
+}
+
+MeshOptimizer::Statistics Model::LoadModelFast(
+    const std::string& directoryPath, bool smoothing) {
+	ObjParser::ObjData obj;
+	const std::string objFilename = name_ + ".obj";
+	[[maybe_unused]] bool result = ObjParser::ParseObjFile(directoryPath + objFilename, obj);
+	assert(result);
+
+	// マテリアル
+	std::vector<ObjParser::MaterialData> materialData;
+	for (const std::string& library : obj.materialLibraries) {
+		result = ObjParser::ParseMtlFile(directoryPath + library, materialData);
+		assert(result);
+	}
+	for (const ObjParser::MaterialData& data : materialData) {
+		std::unique_ptr<Material> material = CreateMaterial(data);
+		AddMaterial(material);
+	}
+
+	// メッシュ（グループごとに頂点を作り、平滑化と最適化を行う）
+	MeshOptimizer::Statistics statistics{};
+	ObjMeshBuilder builder(obj, smoothing);
+	for (const ObjParser::Group& group : obj.groups) {
+		if (group.faceCount == 0) {
+			continue;
+		}
+		MeshOptimizer::Accumulate(statistics, builder.Build(group));
+
+		std::unique_ptr<Mesh> mesh = std::make_unique<Mesh>();
+		mesh->SetName(group.name);
+		mesh->SetGeometry(builder.GetVertices(), builder.GetIndices());
+		auto it = materials_.find(group.material);
+		if (it != materials_.end()) {
+			mesh->SetMaterial(it->second.get());
+		}
+		meshes_.emplace_back(std::move(mesh));
+	}
+
+	// メッシュキャッシュの書き出し（失敗しても次回また解析するだけ）
+	std::vector<std::string> sources = {objFilename};
+	sources.insert(sources.end(), obj.materialLibraries.begin(), obj.materialLibraries.end());
+	std::vector<MeshCache::SubmeshData> submeshes;
+	for (auto& mesh : meshes_) {
+		Material* material = mesh->GetMaterial();
+		submeshes.push_back(
+		    {mesh->GetName(), material ? std::string_view(material->name_) : std::string_view(),
+		     mesh->GetVertices(), mesh->GetIndices()});
+	}
+	MeshCache::Write(
+	    directoryPath + name_ + ".meshcache", directoryPath, smoothing, submeshes, materialData,
+	    sources, statistics);
+	return statistics;
+}
+
+bool Model::LoadMeshCache(
+    const std::string& directoryPath, bool smoothing, MeshOptimizer::Statistics& statistics) {
+	MeshCache cache;
+	const std::string cachePath = directoryPath + name_ + ".meshcache";
+	if (!cache.Open(cachePath)) {
+		return false;
+	}
+	// 元ファイル（OBJと参照しているMTL）と読み込み設定が同じか
+	std::vector<std::string> sources = cache.GetSources();
+	std::vector<MeshCache::FileStamp> staleStamps;
+	if (sources.empty() || sources[0] != name_ + ".obj" ||
+	    !cache.IsUpToDate(directoryPath, smoothing, &staleStamps)) {
+		return false;
+	}
+
+	for (uint32_t i = 0; i < cache.GetMaterialCount(); i++) {
+		std::unique_ptr<Material> material = CreateMaterial(cache.GetMaterial(i));
+		AddMaterial(material);
+	}
+
+	// 頂点とインデックスは解析せずにそのまま渡す（平滑化と最適化も済んでいる）
+	std::span<const Mesh::VertexPosNormalUv> vertices = cache.GetVertices();
+	std::span<const uint32_t> indices = cache.GetIndices();
+	for (uint32_t i = 0; i < cache.GetSubmeshCount(); i++) {
+		MeshCache::Submesh submesh = cache.GetSubmesh(i);
+		std::unique_ptr<Mesh> mesh = std::make_unique<Mesh>();
+		mesh->SetName(std::string(submesh.name));
+		mesh->SetGeometry(
+		    vertices.subspan(submesh.firstVertex, submesh.vertexCount),
+		    indices.subspan(submesh.firstIndex, submesh.indexCount));
+		auto it = materials_.find(std::string(submesh.material));
+		if (it != materials_.end()) {
+			mesh->SetMaterial(it->second.get());
+		}
+		meshes_.emplace_back(std::move(mesh));
+	}
+	statistics = cache.GetStatistics();
+
+	// 内容は同じで更新日時だけが変わっていた場合は、次回ハッシュを計算し直さないよう
+	// キャッシュの日時を書き換える（失敗しても次回また内容を比べるだけ）
+	if (!staleStamps.empty()) {
+		cache.Close();
+		MeshCache::UpdateStamps(cachePath, staleStamps);
+	}
+	return true;
+}
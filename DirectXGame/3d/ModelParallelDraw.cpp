@@ -0,0 +1,58 @@
+#include "Model.h"
+#include "ViewProjection.h"
+#include "WorldTransform.h"
+#include <cassert>
+
+namespace {
+
+// 並列記録用のデフォルトライト（ModelCommonのものは非公開のため別に持つ）
+std::unique_ptr<LightGroup> sDefaultLightGroup;
+
+} // namespace
+
+void Model::PreDrawParallel(std::span<ID3D12GraphicsCommandList* const> commandLists) {
+	if (!sDefaultLightGroup) {
+		sDefaultLightGroup.reset(LightGroup::Create());
+	}
+
+	// ルートシグネチャ・パイプラインステート・プリミティブ形状を各コマンドリストに積む
+	for (ID3D12GraphicsCommandList* commandList : commandLists) {
+		assert(commandList);
+		Model::PreDraw(commandList);
+		Model::PostDraw();
+	}
+}
+
+void Model::Draw(
+    ID3D12GraphicsCommandList* commandList, const WorldTransform& worldTransform,
+    const ViewProjection& viewProjection, const ObjectColor* objectColor) {
+	assert(commandList);
+	// PreDrawParallelで用意しておくこと
+	assert(sDefaultLightGroup);
+
+	// ライトの描画。直前のモデルのライトが残っている可能性があるので毎回積む
+	const LightGroup* lightGroup = lightGroup_ ? lightGroup_ : sDefaultLightGroup.get();
+	lightGroup->Draw(commandList, static_cast<UINT>(RoomParameter::kLight));
+
+	// CBVをセット（ワールド行列）
+	commandList->SetGraphicsRootConstantBufferView(
+	    static_cast<UINT>(RoomParameter::kWorldTransform),
+	    worldTransform.GetConstBuffer()->GetGPUVirtualAddress());
+	// CBVをセット（ビュープロジェクション行列）
+	commandList->SetGraphicsRootConstantBufferView(
+	    static_cast<UINT>(RoomParameter::kViewProjection),
+	    viewProjection.GetConstBuffer()->GetGPUVirtualAddress());
+
+	// CBVをセット（オブジェクトカラー）
+	if (!objectColor) {
+		objectColor = ModelCommon::GetInstance()->GetObjectColor();
+	}
+	objectColor->SetGraphicsCommand(commandList, static_cast<UINT>(RoomParameter::kObjectColor));
+
+	// 全メッシュを描画
+	for (auto& mesh : meshes_) {
+		mesh->Draw(
+		    commandList, static_cast<UINT>(RoomParameter::kMaterial),
+		    static_cast<UINT>(RoomParameter::kTexture));
+	}
+}
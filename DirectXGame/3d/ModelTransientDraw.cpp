@@ -0,0 +1,57 @@
+#include "ConstBufferAllocator.h"
+#include "Model.h"
+#include "TextureManager.h"
+#include <cassert>
+
+void Model::Draw(
+    D3D12_GPU_VIRTUAL_ADDRESS worldTransform, D3D12_GPU_VIRTUAL_ADDRESS viewProjection,
+    D3D12_GPU_VIRTUAL_ADDRESS objectColor) {
+	assert(worldTransform);
+	assert(viewProjection);
+
+	ModelCommon* modelCommon = ModelCommon::GetInstance();
+	ID3D12GraphicsCommandList* commandList = modelCommon->GetCommandList();
+	// PreDrawとPostDrawの間で呼ぶこと
+	assert(commandList);
+
+	// ライトの描画
+	modelCommon->LightCommand(lightGroup_);
+
+	// CBVをセット（ワールド行列）
+	commandList->SetGraphicsRootConstantBufferView(
+	    static_cast<UINT>(RoomParameter::kWorldTransform), worldTransform);
+	// CBVをセット（ビュープロジェクション行列）
+	commandList->SetGraphicsRootConstantBufferView(
+	    static_cast<UINT>(RoomParameter::kViewProjection), viewProjection);
+
+	// CBVをセット（オブジェクトカラー）
+	if (objectColor) {
+		commandList->SetGraphicsRootConstantBufferView(
+		    static_cast<UINT>(RoomParameter::kObjectColor), objectColor);
+	} else {
+		modelCommon->GetObjectColor()->SetGraphicsCommand(
+		    commandList, static_cast<UINT>(RoomParameter::kObjectColor));
+	}
+
+	// 全メッシュを描画。マテリアルもフレーム用定数バッファへ書き込み、
+	// マテリアル自身の定数バッファ（全描画で共有される）は使わない
+	ConstBufferAllocator* allocator = ConstBufferAllocator::GetInstance();
+	TextureManager* textureManager = TextureManager::GetInstance();
+	for (auto& mesh : meshes_) {
+		const Material* material = mesh->GetMaterial();
+		assert(material);
+
+		// CBVをセット（マテリアル）
+		commandList->SetGraphicsRootConstantBufferView(
+		    static_cast<UINT>(RoomParameter::kMaterial), material->Update(*allocator));
+		// SRVをセット
+		textureManager->SetGraphicsRootDescriptorTable(
+		    commandList, static_cast<UINT>(RoomParameter::kTexture),
+		    material->GetTextureHadle());
+
+		commandList->IASetVertexBuffers(0, 1, &mesh->GetVBView());
+		commandList->IASetIndexBuffer(&mesh->GetIBView());
+		commandList->DrawIndexedInstanced(
+		    static_cast<UINT>(mesh->GetIndices().size()), 1, 0, 0, 0);
+	}
+}
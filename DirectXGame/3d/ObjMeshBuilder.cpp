@@ -0,0 +1,61 @@
+#include "ObjMeshBuilder.h"
+
+ObjMeshBuilder::ObjMeshBuilder(const ObjParser::ObjData& obj, bool smoothing)
+    : obj_(obj), smoothing_(smoothing) {
+	if (smoothing_) {
+		localPositions_.assign(obj_.positions.size(), ObjParser::kNone);
+	}
+}
+
+MeshOptimizer::Statistics ObjMeshBuilder::Build(const ObjParser::Group& group) {
+	vertices_.clear();
+	indices_.clear();
+	positionIndices_.clear();
+
+	for (uint32_t face = group.firstFace; face < group.firstFace + group.faceCount; face++) {
+		uint32_t base = static_cast<uint32_t>(vertices_.size());
+		uint32_t begin = obj_.faceOffsets[face];
+		uint32_t end = obj_.faceOffsets[face + 1];
+		for (uint32_t i = begin; i < end; i++) {
+			const ObjParser::Corner& corner = obj_.corners[i];
+			Mesh::VertexPosNormalUv& vertex = vertices_.emplace_back();
+			vertex.pos = obj_.positions[corner.position];
+			if (corner.normal != ObjParser::kNone) {
+				vertex.normal = obj_.normals[corner.normal];
+			}
+			if (corner.texcoord != ObjParser::kNone) {
+				vertex.uv = obj_.texcoords[corner.texcoord];
+				vertex.uv.y = 1.0f - vertex.uv.y;
+			}
+			if (smoothing_) {
+				uint32_t& local = localPositions_[corner.position];
+				if (local == ObjParser::kNone) {
+					local = static_cast<uint32_t>(usedPositions_.size());
+					usedPositions_.push_back(corner.position);
+				}
+				positionIndices_.push_back(local);
+			}
+
+			uint32_t index = base + (i - begin);
+			if (i - begin < 3) {
+				indices_.push_back(index);
+			} else {
+				indices_.push_back(index - 1);
+				indices_.push_back(index);
+				indices_.push_back(base);
+			}
+		}
+	}
+
+	if (smoothing_) {
+		MeshOptimizer::CalculateSmoothedNormals(
+		    vertices_, positionIndices_, static_cast<uint32_t>(usedPositions_.size()));
+		// 次のグループのために使った分だけ戻す
+		for (uint32_t position : usedPositions_) {
+			localPositions_[position] = ObjParser::kNone;
+		}
+		usedPositions_.clear();
+	}
+	// 面の頂点ごとに作った頂点を統合し、キャッシュ効率のよい順に並べ替える
+	return MeshOptimizer::Optimize(vertices_, indices_);
+}
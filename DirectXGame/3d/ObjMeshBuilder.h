@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Mesh.h"
+#include "MeshOptimizer.h"
+#include "ObjParser.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// OBJの解析結果からグループごとの頂点とインデックスを作る
+/// </summary>
+/// <remarks>
+/// 面の頂点ごとに頂点を作り、多角形は扇状に三角形へ分割する。
+/// 平滑化（指定時）と最適化まで行うので、結果はそのままメッシュに設定できる。
+/// 作業用の配列はグループ間で使い回す。1つのインスタンスは1つのスレッドから使うこと。
+/// </remarks>
+class ObjMeshBuilder {
+public: // メンバ関数
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	/// <param name="obj">OBJの解析結果（このインスタンスより長く生きること）</param>
+	/// <param name="smoothing">エッジ平滑化フラグ</param>
+	ObjMeshBuilder(const ObjParser::ObjData& obj, bool smoothing);
+
+	/// <summary>
+	/// グループの頂点とインデックスを作る
+	/// </summary>
+	/// <param name="group">グループ</param>
+	/// <returns>最適化の結果</returns>
+	MeshOptimizer::Statistics Build(const ObjParser::Group& group);
+
+	/// <summary>
+	/// 直前に作った頂点の取得
+	/// </summary>
+	const std::vector<Mesh::VertexPosNormalUv>& GetVertices() const { return vertices_; }
+
+	/// <summary>
+	/// 直前に作ったインデックスの取得
+	/// </summary>
+	const std::vector<uint32_t>& GetIndices() const { return indices_; }
+
+private: // メンバ変数
+	// OBJの解析結果
+	const ObjParser::ObjData& obj_;
+	// エッジ平滑化フラグ
+	bool smoothing_;
+	// 頂点
+	std::vector<Mesh::VertexPosNormalUv> vertices_;
+	// インデックス
+	std::vector<uint32_t> indices_;
+	// 頂点ごとの座標番号（グループ内で詰めた番号）
+	std::vector<uint32_t> positionIndices_;
+	// 平滑化はグループの中で閉じるので、グループが使う位置だけに詰めた番号を振る
+	// （ファイル全体の位置数で作業領域を作るとグループ数に比例して遅くなる）
+	std::vector<uint32_t> localPositions_;
+	// グループが使った位置（次のグループのためにlocalPositions_を戻す）
+	std::vector<uint32_t> usedPositions_;
+};
@@ -0,0 +1,422 @@
+#include "ObjParser.h"
+#include "JobSystem.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace {
+
+// o/g/usemtl/mtllibの出現
+struct Event {
+	enum class Type {
+		kGroup,
+		kMaterial,
+		kLibrary,
+	};
+	Type type;
+	std::string_view name; // テキストを直接指す
+	uint32_t face;         // 出現位置の面番号
+};
+
+// 並列に解析する1区間
+struct Chunk {
+	const char* begin = nullptr;
+	const char* end = nullptr;
+	// 区間内の要素数
+	uint32_t positionCount = 0;
+	uint32_t texcoordCount = 0;
+	uint32_t normalCount = 0;
+	uint32_t faceCount = 0;
+	uint32_t cornerCount = 0;
+	// 書き込み先の開始位置
+	uint32_t positionOffset = 0;
+	uint32_t texcoordOffset = 0;
+	uint32_t normalOffset = 0;
+	uint32_t faceOffset = 0;
+	uint32_t cornerOffset = 0;
+	// o/g/usemtl/mtllib
+	std::vector<Event> events;
+	// インデックスが範囲内だったか
+	bool isValid = true;
+};
+
+// 行の種類
+enum class LineType {
+	kOther,
+	kPosition,
+	kTexcoord,
+	kNormal,
+	kFace,
+	kGroup,
+	kMaterial,
+	kLibrary,
+};
+
+bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+const char* SkipSpace(const char* p, const char* end) {
+	while (p < end && IsSpace(*p)) {
+		p++;
+	}
+	return p;
+}
+
+const char* SkipToken(const char* p, const char* end) {
+	while (p < end && !IsSpace(*p)) {
+		p++;
+	}
+	return p;
+}
+
+/// <summary>
+/// 行末（改行の位置かend）を探す
+/// </summary>
+const char* FindLineEnd(const char* p, const char* end) {
+	const void* found = std::memchr(p, '\n', end - p);
+	return found ? static_cast<const char*>(found) : end;
+}
+
+/// <summary>
+/// 行頭のキーワードを判定し、pをキーワードの後ろへ進める
+/// </summary>
+LineType ReadLineType(const char*& p, const char* end) {
+	p = SkipSpace(p, end);
+	const char* keyEnd = SkipToken(p, end);
+	std::string_view key(p, keyEnd - p);
+	p = keyEnd;
+	if (key == "v") {
+		return LineType::kPosition;
+	}
+	if (key == "vt") {
+		return LineType::kTexcoord;
+	}
+	if (key == "vn") {
+		return LineType::kNormal;
+	}
+	if (key == "f") {
+		return LineType::kFace;
+	}
+	if (key == "o" || key == "g") {
+		return LineType::kGroup;
+	}
+	if (key == "usemtl") {
+		return LineType::kMaterial;
+	}
+	if (key == "mtllib") {
+		return LineType::kLibrary;
+	}
+	return LineType::kOther;
+}
+
+/// <summary>
+/// 次のトークンを取得
+/// </summary>
+std::string_view ReadToken(const char*& p, const char* end) {
+	p = SkipSpace(p, end);
+	const char* tokenEnd = SkipToken(p, end);
+	std::string_view token(p, tokenEnd - p);
+	p = tokenEnd;
+	return token;
+}
+
+/// <summary>
+/// 浮動小数点数を読む（読めなければ0）
+/// </summary>
+float ReadFloat(const char*& p, const char* end) {
+	p = SkipSpace(p, end);
+	// from_charsは先頭の+を受け付けない
+	if (p < end && *p == '+') {
+		p++;
+	}
+	float value = 0.0f;
+	auto [next, error] = std::from_chars(p, end, value);
+	if (error != std::errc()) {
+		return 0.0f;
+	}
+	p = next;
+	return value;
+}
+
+/// <summary>
+/// 面の1頂点分のインデックス（v/vt/vn）を0始まりへ解決する
+/// </summary>
+/// <param name="count">その行までに出現した要素数（負の相対指定の基準）</param>
+/// <returns>解決したインデックス。省略か不正ならkNone</returns>
+uint32_t ResolveIndex(std::string_view token, uint32_t count, bool& isValid) {
+	if (token.empty()) {
+		return ObjParser::kNone;
+	}
+	int64_t index = 0;
+	auto [next, error] = std::from_chars(token.data(), token.data() + token.size(), index);
+	if (error != std::errc() || index == 0) {
+		isValid = false;
+		return ObjParser::kNone;
+	}
+	// 正なら1始まりの絶対指定、負なら直前からの相対指定
+	int64_t resolved = 0 < index ? index - 1 : int64_t(count) + index;
+	if (resolved < 0) {
+		isValid = false;
+		return ObjParser::kNone;
+	}
+	return static_cast<uint32_t>(resolved);
+}
+
+/// <summary>
+/// 区間内の要素数を数える（1パス目）
+/// </summary>
+void CountChunk(Chunk& chunk) {
+	for (const char* line = chunk.begin; line < chunk.end;) {
+		const char* lineEnd = FindLineEnd(line, chunk.end);
+		const char* p = line;
+		switch (ReadLineType(p, lineEnd)) {
+		case LineType::kPosition:
+			chunk.positionCount++;
+			break;
+		case LineType::kTexcoord:
+			chunk.texcoordCount++;
+			break;
+		case LineType::kNormal:
+			chunk.normalCount++;
+			break;
+		case LineType::kFace:
+			chunk.faceCount++;
+			while (!ReadToken(p, lineEnd).empty()) {
+				chunk.cornerCount++;
+			}
+			break;
+		default:
+			break;
+		}
+		line = lineEnd + 1;
+	}
+}
+
+/// <summary>
+/// 区間を解析して結果の配列へ直接書き込む（2パス目）
+/// </summary>
+void ParseChunk(Chunk& chunk, ObjParser::ObjData& data) {
+	Vector3* position = data.positions.data() + chunk.positionOffset;
+	Vector2* texcoord = data.texcoords.data() + chunk.texcoordOffset;
+	Vector3* normal = data.normals.data() + chunk.normalOffset;
+	uint32_t* faceOffset = data.faceOffsets.data() + chunk.faceOffset;
+	ObjParser::Corner* corner = data.corners.data() + chunk.cornerOffset;
+
+	// 負の相対指定の基準とするため、ファイル先頭からの要素数を数えながら進む
+	uint32_t positionCount = chunk.positionOffset;
+	uint32_t texcoordCount = chunk.texcoordOffset;
+	uint32_t normalCount = chunk.normalOffset;
+	uint32_t cornerCount = chunk.cornerOffset;
+	uint32_t faceCount = chunk.faceOffset;
+
+	const uint32_t totalPositions = static_cast<uint32_t>(data.positions.size());
+	const uint32_t totalTexcoords = static_cast<uint32_t>(data.texcoords.size());
+	const uint32_t totalNormals = static_cast<uint32_t>(data.normals.size());
+
+	for (const char* line = chunk.begin; line < chunk.end;) {
+		const char* lineEnd = FindLineEnd(line, chunk.end);
+		const char* p = line;
+		switch (ReadLineType(p, lineEnd)) {
+		case LineType::kPosition:
+			position->x = ReadFloat(p, lineEnd);
+			position->y = ReadFloat(p, lineEnd);
+			position->z = ReadFloat(p, lineEnd);
+			position++;
+			positionCount++;
+			break;
+		case LineType::kTexcoord:
+			texcoord->x = ReadFloat(p, lineEnd);
+			texcoord->y = ReadFloat(p, lineEnd);
+			texcoord++;
+			texcoordCount++;
+			break;
+		case LineType::kNormal:
+			normal->x = ReadFloat(p, lineEnd);
+			normal->y = ReadFloat(p, lineEnd);
+			normal->z = ReadFloat(p, lineEnd);
+			normal++;
+			normalCount++;
+			break;
+		case LineType::kFace:
+			*faceOffset++ = cornerCount;
+			faceCount++;
+			for (std::string_view token = ReadToken(p, lineEnd); !token.empty();
+			     token = ReadToken(p, lineEnd)) {
+				// v、v/vt、v//vn、v/vt/vn
+				size_t slash1 = token.find('/');
+				size_t slash2 =
+				    slash1 == std::string_view::npos ? slash1 : token.find('/', slash1 + 1);
+				std::string_view v = token.substr(0, slash1);
+				std::string_view vt, vn;
+				if (slash1 != std::string_view::npos) {
+					vt = token.substr(slash1 + 1, slash2 - slash1 - 1);
+					if (slash2 != std::string_view::npos) {
+						vn = token.substr(slash2 + 1);
+					}
+				}
+				corner->position = ResolveIndex(v, positionCount, chunk.isValid);
+				corner->texcoord = ResolveIndex(vt, texcoordCount, chunk.isValid);
+				corner->normal = ResolveIndex(vn, normalCount, chunk.isValid);
+				if (corner->position == ObjParser::kNone || totalPositions <= corner->position ||
+				    (corner->texcoord != ObjParser::kNone && totalTexcoords <= corner->texcoord) ||
+				    (corner->normal != ObjParser::kNone && totalNormals <= corner->normal)) {
+					chunk.isValid = false;
+				}
+				corner++;
+				cornerCount++;
+			}
+			break;
+		case LineType::kGroup:
+			chunk.events.push_back({Event::Type::kGroup, ReadToken(p, lineEnd), faceCount});
+			break;
+		case LineType::kMaterial:
+			chunk.events.push_back({Event::Type::kMaterial, ReadToken(p, lineEnd), faceCount});
+			break;
+		case LineType::kLibrary:
+			chunk.events.push_back({Event::Type::kLibrary, ReadToken(p, lineEnd), faceCount});
+			break;
+		default:
+			break;
+		}
+		line = lineEnd + 1;
+	}
+}
+
+} // namespace
+
+bool ObjParser::ParseObjFile(const std::string& filePath, ObjData& data) {
+	MappedFile file;
+	if (!file.Open(filePath)) {
+		return false;
+	}
+	return ParseObj(file.GetText(), data);
+}
+
+bool ObjParser::ParseObj(std::string_view text, ObjData& data) {
+	data = {};
+
+	// 行境界で区間に分ける
+	std::vector<Chunk> chunks;
+	const char* end = text.data() + text.size();
+	for (const char* begin = text.data(); begin < end;) {
+		const char* chunkEnd = begin + std::min(kChunkSize, size_t(end - begin));
+		chunkEnd = chunkEnd < end ? FindLineEnd(chunkEnd, end) : end;
+		chunkEnd = chunkEnd < end ? chunkEnd + 1 : end;
+		Chunk& chunk = chunks.emplace_back();
+		chunk.begin = begin;
+		chunk.end = chunkEnd;
+		begin = chunkEnd;
+	}
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+
+	// 1パス目：区間ごとの要素数を数える
+	jobSystem->ParallelFor(chunks.size(), 1, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			CountChunk(chunks[i]);
+		}
+	});
+
+	// 書き込み先を決めて結果の配列を一度だけ確保する
+	uint32_t positionCount = 0, texcoordCount = 0, normalCount = 0, faceCount = 0,
+	         cornerCount = 0;
+	for (Chunk& chunk : chunks) {
+		chunk.positionOffset = positionCount;
+		chunk.texcoordOffset = texcoordCount;
+		chunk.normalOffset = normalCount;
+		chunk.faceOffset = faceCount;
+		chunk.cornerOffset = cornerCount;
+		positionCount += chunk.positionCount;
+		texcoordCount += chunk.texcoordCount;
+		normalCount += chunk.normalCount;
+		faceCount += chunk.faceCount;
+		cornerCount += chunk.cornerCount;
+	}
+	data.positions.resize(positionCount);
+	data.texcoords.resize(texcoordCount);
+	data.normals.resize(normalCount);
+	data.faceOffsets.resize(faceCount + 1);
+	data.faceOffsets[faceCount] = cornerCount;
+	data.corners.resize(cornerCount);
+
+	// 2パス目：解析して直接書き込む
+	jobSystem->ParallelFor(chunks.size(), 1, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			ParseChunk(chunks[i], data);
+		}
+	});
+
+	// o/g/usemtl/mtllibを出現順にたどってグループを作る
+	data.groups.push_back({"", "", 0, 0});
+	bool isValid = true;
+	for (const Chunk& chunk : chunks) {
+		isValid = isValid && chunk.isValid;
+		for (const Event& event : chunk.events) {
+			Group* group = &data.groups.back();
+			switch (event.type) {
+			case Event::Type::kGroup:
+				// 名前のないグループには名前を付けるだけにする
+				if (!group->name.empty()) {
+					group->faceCount = event.face - group->firstFace;
+					data.groups.push_back({"", "", event.face, 0});
+					group = &data.groups.back();
+				}
+				group->name = event.name;
+				break;
+			case Event::Type::kMaterial:
+				if (group->material.empty()) {
+					group->material = event.name;
+				}
+				break;
+			case Event::Type::kLibrary:
+				data.materialLibraries.emplace_back(event.name);
+				break;
+			}
+		}
+	}
+	data.groups.back().faceCount = faceCount - data.groups.back().firstFace;
+
+	return isValid;
+}
+
+bool ObjParser::ParseMtlFile(const std::string& filePath, std::vector<MaterialData>& materials) {
+	MappedFile file;
+	if (!file.Open(filePath)) {
+		return false;
+	}
+	ParseMtl(file.GetText(), materials);
+	return true;
+}
+
+void ObjParser::ParseMtl(std::string_view text, std::vector<MaterialData>& materials) {
+	MaterialData* material = nullptr;
+	const char* end = text.data() + text.size();
+	for (const char* line = text.data(); line < end;) {
+		const char* lineEnd = FindLineEnd(line, end);
+		const char* p = line;
+		std::string_view key = ReadToken(p, lineEnd);
+		if (key == "newmtl") {
+			material = &materials.emplace_back();
+			material->name = ReadToken(p, lineEnd);
+		} else if (material) {
+			if (key == "Ka") {
+				material->ambient.x = ReadFloat(p, lineEnd);
+				material->ambient.y = ReadFloat(p, lineEnd);
+				material->ambient.z = ReadFloat(p, lineEnd);
+			} else if (key == "Kd") {
+				material->diffuse.x = ReadFloat(p, lineEnd);
+				material->diffuse.y = ReadFloat(p, lineEnd);
+				material->diffuse.z = ReadFloat(p, lineEnd);
+			} else if (key == "Ks") {
+				material->specular.x = ReadFloat(p, lineEnd);
+				material->specular.y = ReadFloat(p, lineEnd);
+				material->specular.z = ReadFloat(p, lineEnd);
+			} else if (key == "d") {
+				material->alpha = ReadFloat(p, lineEnd);
+			} else if (key == "map_Kd") {
+				material->textureFilename = ReadToken(p, lineEnd);
+			}
+		}
+		line = lineEnd + 1;
+	}
+}
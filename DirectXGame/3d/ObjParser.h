@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Vector2.h"
+#include "Vector3.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// <summary>
+/// OBJ/MTLファイルの高速パーサー
+/// </summary>
+/// <remarks>
+/// ファイルはメモリマップで読み、数値はstd::from_charsで変換する。行ごとの動的確保はない。
+/// 大きなファイルは行境界で分割してJobSystemで並列に解析し、最後に連結する。
+/// </remarks>
+class ObjParser {
+public: // サブクラス
+	// 要素がないことを表すインデックス
+	static constexpr uint32_t kNone = UINT32_MAX;
+
+	// 面の頂点（0始まりのインデックス）
+	struct Corner {
+		uint32_t position;
+		uint32_t texcoord; // なければkNone
+		uint32_t normal;   // なければkNone
+	};
+
+	// o/gで区切られた面のまとまり
+	struct Group {
+		std::string name;     // 名前
+		std::string material; // usemtlで指定されたマテリアル名（最初の1つ）
+		uint32_t firstFace;   // 最初の面番号
+		uint32_t faceCount;   // 面の数
+	};
+
+	// OBJの解析結果
+	struct ObjData {
+		std::vector<Vector3> positions;
+		std::vector<Vector3> normals;
+		std::vector<Vector2> texcoords; // ファイルの値のまま（vは反転しない）
+		std::vector<Corner> corners;
+		// 面ごとのcornersの開始位置（末尾に総数を含むので面の数+1個）
+		std::vector<uint32_t> faceOffsets;
+		std::vector<Group> groups;
+		std::vector<std::string> materialLibraries;
+
+		/// <summary>
+		/// 面の数
+		/// </summary>
+		uint32_t GetFaceCount() const {
+			return faceOffsets.empty() ? 0 : static_cast<uint32_t>(faceOffsets.size() - 1);
+		}
+	};
+
+	// MTLのマテリアル
+	struct MaterialData {
+		std::string name;
+		Vector3 ambient = {0.3f, 0.3f, 0.3f};
+		Vector3 diffuse = {0.8f, 0.8f, 0.8f};
+		Vector3 specular = {0.0f, 0.0f, 0.0f};
+		float alpha = 1.0f;
+		std::string textureFilename;
+	};
+
+public: // 静的メンバ関数
+	/// <summary>
+	/// OBJファイルを解析する
+	/// </summary>
+	/// <param name="filePath">ファイルパス</param>
+	/// <param name="data">解析結果</param>
+	/// <returns>成否（開けない、インデックスが範囲外など）</returns>
+	static bool ParseObjFile(const std::string& filePath, ObjData& data);
+
+	/// <summary>
+	/// OBJのテキストを解析する
+	/// </summary>
+	/// <param name="text">テキスト</param>
+	/// <param name="data">解析結果</param>
+	/// <returns>成否</returns>
+	static bool ParseObj(std::string_view text, ObjData& data);
+
+	/// <summary>
+	/// MTLファイルを解析する
+	/// </summary>
+	/// <param name="filePath">ファイルパス</param>
+	/// <param name="materials">マテリアル（末尾に追加する）</param>
+	/// <returns>成否</returns>
+	static bool ParseMtlFile(const std::string& filePath, std::vector<MaterialData>& materials);
+
+	/// <summary>
+	/// MTLのテキストを解析する
+	/// </summary>
+	/// <param name="text">テキスト</param>
+	/// <param name="materials">マテリアル（末尾に追加する）</param>
+	static void ParseMtl(std::string_view text, std::vector<MaterialData>& materials);
+
+	/// <summary>
+	/// 並列に解析する1区間の最小バイト数
+	/// </summary>
+	static constexpr size_t kChunkSize = 1 << 20;
+};
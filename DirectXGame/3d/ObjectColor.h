@@ -1,4 +1,5 @@
 #pragma once
+#include "ConstBufferAllocator.h"
 #include "Vector4.h"
 #include <d3d12.h>
 #include <wrl.h>
@@ -7,6 +8,8 @@
 struct ConstBufferDataObjectColor {
 	Vector4 color_;
 };
+// Obj.hlsliのcbuffer ObjectColor（float4 1つ）と同じ大きさであること
+static_assert(sizeof(ConstBufferDataObjectColor) == 16);
 
 // オブジェクト個別のカラー指定
 class ObjectColor {
@@ -21,6 +24,15 @@ public:
 	/// </summary>
 	void TransferMatrix();
 
+	/// <summary>
+	/// 色をフレーム用定数バッファへ転送する
+	/// </summary>
+	/// <param name="allocator">定数バッファアロケータ</param>
+	/// <returns>転送先のGPU仮想アドレス</returns>
+	D3D12_GPU_VIRTUAL_ADDRESS TransferMatrix(ConstBufferAllocator& allocator) const {
+		return allocator.Push(ConstBufferDataObjectColor{color_});
+	}
+
 	/// <summary>
 	/// グラフィックスコマンドを積む
 	/// </summary>
@@ -0,0 +1,331 @@
+#include "RenderQueue.h"
+#include "DirectXCommon.h"
+#include "GeometryArena.h"
+#include "TextureManager.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+namespace {
+
+// ソートキーのビット配置（上位ほど優先）
+const uint32_t kPassShift = 60; // 描画パス 4bit
+const uint64_t kMaterialMask = 0xffff;
+const uint64_t kTextureMask = 0xfff;
+const uint64_t kDepthMask = 0xffffff;
+const uint64_t kLayerMask = 0xff;
+
+// 不透明: パス | 予約 4bit | マテリアル 16bit | テクスチャ 12bit | 深度 24bit
+const uint32_t kOpaqueMaterialShift = 40;
+const uint32_t kOpaqueTextureShift = 28;
+const uint32_t kOpaqueDepthShift = 4;
+// 半透明: パス | 予約 4bit | 深度(反転) 24bit | マテリアル 16bit | テクスチャ 12bit
+const uint32_t kTransparentDepthShift = 32;
+const uint32_t kTransparentMaterialShift = 16;
+const uint32_t kTransparentTextureShift = 4;
+// スプライト: パス | レイヤー 8bit | ブレンド 4bit | テクスチャ 12bit | 登録順 32bit
+const uint32_t kSpriteLayerShift = 52;
+const uint32_t kSpriteBlendShift = 48;
+const uint32_t kSpriteTextureShift = 36;
+
+// 基数ソートの1桁のビット数
+const uint32_t kRadixBits = 8;
+const size_t kRadixSize = size_t(1) << kRadixBits;
+
+/// <summary>
+/// ビュー空間での深度を[0, kDepthMask]に量子化する
+/// </summary>
+uint64_t QuantizeDepth(const WorldTransform& worldTransform, const ViewProjection& viewProjection) {
+	const Matrix4x4& world = worldTransform.matWorld_;
+	const Matrix4x4& view = viewProjection.matView;
+	// ワールド原点のビュー空間Z
+	float z = world.m[3][0] * view.m[0][2] + world.m[3][1] * view.m[1][2] +
+	          world.m[3][2] * view.m[2][2] + view.m[3][2];
+	float depth = std::clamp(z / viewProjection.farZ, 0.0f, 1.0f);
+	return static_cast<uint64_t>(depth * float(kDepthMask));
+}
+
+} // namespace
+
+void RenderQueue::Submit(
+    Model* model, const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+    const ObjectColor* objectColor, Pass pass) {
+	assert(model);
+	assert(pass == Pass::kOpaque || pass == Pass::kTransparent);
+
+	uint64_t depth = QuantizeDepth(worldTransform, viewProjection);
+
+	// マテリアルごとに分けるためメッシュ単位で登録
+	for (auto& mesh : model->GetMeshes()) {
+		const Material* material = mesh->GetMaterial();
+		uint64_t materialId = GetMaterialId(material);
+		uint64_t texture = material->GetTextureHadle() & kTextureMask;
+
+		uint64_t key = uint64_t(pass) << kPassShift;
+		if (pass == Pass::kOpaque) {
+			key |= materialId << kOpaqueMaterialShift;
+			key |= texture << kOpaqueTextureShift;
+			key |= depth << kOpaqueDepthShift;
+		} else {
+			key |= (kDepthMask - depth) << kTransparentDepthShift;
+			key |= materialId << kTransparentMaterialShift;
+			key |= texture << kTransparentTextureShift;
+		}
+
+		Packet packet{};
+		packet.type = PacketType::kMesh;
+		packet.pass = pass;
+		packet.mesh = mesh.get();
+		packet.lightGroup = model->GetLightGroup();
+		packet.worldTransform = &worldTransform;
+		packet.viewProjection = &viewProjection;
+		packet.objectColor = objectColor;
+
+		entries_.push_back({key, static_cast<uint32_t>(packets_.size())});
+		packets_.push_back(packet);
+	}
+}
+
+void RenderQueue::Submit(Sprite* sprite, Pass pass, Sprite::BlendMode blendMode, uint8_t layer) {
+	assert(sprite);
+	assert(pass == Pass::kBackground || pass == Pass::kForeground);
+
+	uint64_t key = uint64_t(pass) << kPassShift;
+	key |= (uint64_t(layer) & kLayerMask) << kSpriteLayerShift;
+	key |= uint64_t(blendMode) << kSpriteBlendShift;
+	key |= (uint64_t(sprite->GetTextureHandle()) & kTextureMask) << kSpriteTextureShift;
+	// 同じステートの中では登録順を保つ
+	key |= spriteSequence_++;
+
+	Packet packet{};
+	packet.type = PacketType::kSprite;
+	packet.pass = pass;
+	packet.sprite = sprite;
+	packet.blendMode = blendMode;
+
+	entries_.push_back({key, static_cast<uint32_t>(packets_.size())});
+	packets_.push_back(packet);
+}
+
+void RenderQueue::Flush(ID3D12GraphicsCommandList* commandList) {
+	assert(commandList);
+
+	statistics_ = {};
+	ResetBoundState();
+
+	SortEntries();
+
+	// 発行中のパイプライン
+	bool isModelPipeline = false;
+	bool isSpritePipeline = false;
+	Sprite::BlendMode currentBlendMode = Sprite::BlendMode::kNormal;
+	bool isBackground = false;
+
+	// パイプラインを閉じる
+	auto endPipeline = [&]() {
+		if (isModelPipeline) {
+			Model::PostDraw();
+			isModelPipeline = false;
+		}
+		if (isSpritePipeline) {
+			Sprite::PostDraw();
+			isSpritePipeline = false;
+		}
+	};
+
+	for (const SortEntry& entry : entries_) {
+		const Packet& packet = packets_[entry.index];
+
+		// 背景パスを抜けたら深度バッファをクリア
+		if (isBackground && packet.pass != Pass::kBackground) {
+			endPipeline();
+			DirectXCommon::GetInstance()->ClearDepthBuffer();
+		}
+		isBackground = packet.pass == Pass::kBackground;
+
+		if (packet.type == PacketType::kMesh) {
+			if (!isModelPipeline) {
+				endPipeline();
+				Model::PreDraw(commandList);
+				isModelPipeline = true;
+				statistics_.pipeline.applied++;
+				// ルートシグネチャを設定し直すとルート引数は無効になる
+				ResetBoundState();
+			} else {
+				statistics_.pipeline.skipped++;
+			}
+			ExecuteMesh(commandList, packet);
+		} else {
+			if (!isSpritePipeline || currentBlendMode != packet.blendMode) {
+				endPipeline();
+				Sprite::PreDraw(commandList, packet.blendMode);
+				isSpritePipeline = true;
+				currentBlendMode = packet.blendMode;
+				statistics_.pipeline.applied++;
+			} else {
+				statistics_.pipeline.skipped++;
+			}
+			packet.sprite->Draw();
+			// スプライトは自前の頂点バッファをセットする
+			currentVBView_ = {};
+			currentIBView_ = {};
+			statistics_.drawCount++;
+		}
+	}
+	endPipeline();
+
+	// 背景しか無かった場合も深度バッファのクリアは行う
+	if (isBackground) {
+		DirectXCommon::GetInstance()->ClearDepthBuffer();
+	}
+
+	packets_.clear();
+	entries_.clear();
+	spriteSequence_ = 0;
+	// 番号はフレームごとに振り直す。累積すると16bitを使い切った後は全て重複し、
+	// 解放されたマテリアルのアドレスも残り続ける
+	materialIds_.clear();
+}
+
+void RenderQueue::ResetBoundState() {
+	isLightGroupBound_ = false;
+	currentLightGroup_ = nullptr;
+	currentViewProjection_ = nullptr;
+	currentObjectColor_ = nullptr;
+	currentMaterial_ = nullptr;
+	currentVBView_ = {};
+	currentIBView_ = {};
+}
+
+uint64_t RenderQueue::GetMaterialId(const Material* material) {
+	auto it = materialIds_.find(material);
+	if (it != materialIds_.end()) {
+		return it->second;
+	}
+	// 1フレームで16bitを超える種類が登録された場合は番号が重複するが、
+	// まとめ方が甘くなるだけで描画結果は変わらない
+	uint64_t id = materialIds_.size() & kMaterialMask;
+	materialIds_.emplace(material, id);
+	return id;
+}
+
+void RenderQueue::SortEntries() {
+	size_t count = entries_.size();
+	sortBuffer_.resize(count);
+
+	// 下位桁からの LSD 基数ソート（安定）
+	for (uint32_t shift = 0; shift < 64; shift += kRadixBits) {
+		std::array<size_t, kRadixSize> histogram{};
+		for (const SortEntry& entry : entries_) {
+			histogram[(entry.key >> shift) & (kRadixSize - 1)]++;
+		}
+		// 全要素がこの桁で同じなら並べ替え不要
+		if (count == 0 || histogram[(entries_[0].key >> shift) & (kRadixSize - 1)] == count) {
+			continue;
+		}
+
+		size_t offset = 0;
+		for (size_t& bucket : histogram) {
+			size_t size = bucket;
+			bucket = offset;
+			offset += size;
+		}
+		for (const SortEntry& entry : entries_) {
+			sortBuffer_[histogram[(entry.key >> shift) & (kRadixSize - 1)]++] = entry;
+		}
+		entries_.swap(sortBuffer_);
+	}
+}
+
+void RenderQueue::ExecuteMesh(ID3D12GraphicsCommandList* commandList, const Packet& packet) {
+	using RoomParameter = Model::RoomParameter;
+
+	// ライト
+	if (!isLightGroupBound_ || currentLightGroup_ != packet.lightGroup) {
+		ModelCommon::GetInstance()->LightCommand(packet.lightGroup);
+		isLightGroupBound_ = true;
+		currentLightGroup_ = packet.lightGroup;
+		statistics_.light.applied++;
+	} else {
+		statistics_.light.skipped++;
+	}
+
+	// ビュープロジェクション
+	if (currentViewProjection_ != packet.viewProjection) {
+		commandList->SetGraphicsRootConstantBufferView(
+		    static_cast<UINT>(RoomParameter::kViewProjection),
+		    packet.viewProjection->GetConstBuffer()->GetGPUVirtualAddress());
+		currentViewProjection_ = packet.viewProjection;
+		statistics_.viewProjection.applied++;
+	} else {
+		statistics_.viewProjection.skipped++;
+	}
+
+	// ワールド行列は毎回異なる
+	commandList->SetGraphicsRootConstantBufferView(
+	    static_cast<UINT>(RoomParameter::kWorldTransform),
+	    packet.worldTransform->GetConstBuffer()->GetGPUVirtualAddress());
+
+	// オブジェクトカラー
+	const ObjectColor* objectColor =
+	    packet.objectColor ? packet.objectColor : ModelCommon::GetInstance()->GetObjectColor();
+	if (currentObjectColor_ != objectColor) {
+		objectColor->SetGraphicsCommand(
+		    commandList, static_cast<UINT>(RoomParameter::kObjectColor));
+		currentObjectColor_ = objectColor;
+		statistics_.objectColor.applied++;
+	} else {
+		statistics_.objectColor.skipped++;
+	}
+
+	// マテリアル
+	const Material* material = packet.mesh->GetMaterial();
+	if (currentMaterial_ != material) {
+		commandList->SetGraphicsRootConstantBufferView(
+		    static_cast<UINT>(RoomParameter::kMaterial),
+		    material->GetConstantBuffer()->GetGPUVirtualAddress());
+		statistics_.material.applied++;
+
+		// テクスチャ
+		uint32_t texture = material->GetTextureHadle();
+		if (!currentMaterial_ || currentTexture_ != texture) {
+			TextureManager::GetInstance()->SetGraphicsRootDescriptorTable(
+			    commandList, static_cast<UINT>(RoomParameter::kTexture), texture);
+			currentTexture_ = texture;
+			statistics_.texture.applied++;
+		} else {
+			statistics_.texture.skipped++;
+		}
+		currentMaterial_ = material;
+	} else {
+		statistics_.material.skipped++;
+		statistics_.texture.skipped++;
+	}
+
+	// 頂点・インデックスバッファ
+	// ジオメトリアリーナのメッシュはページ全体のビューを設定し、オフセットで描き分ける
+	const GeometryArena::MeshRange* range = GeometryArena::GetInstance()->Find(packet.mesh);
+	const D3D12_VERTEX_BUFFER_VIEW& vbView = range ? range->vbView : packet.mesh->GetVBView();
+	const D3D12_INDEX_BUFFER_VIEW& ibView = range ? range->ibView : packet.mesh->GetIBView();
+	bool isVertexBufferChanged = currentVBView_.BufferLocation != vbView.BufferLocation;
+	bool isIndexBufferChanged = currentIBView_.BufferLocation != ibView.BufferLocation ||
+	                            currentIBView_.Format != ibView.Format;
+	if (isVertexBufferChanged || isIndexBufferChanged) {
+		if (isVertexBufferChanged) {
+			commandList->IASetVertexBuffers(0, 1, &vbView);
+			currentVBView_ = vbView;
+		}
+		if (isIndexBufferChanged) {
+			commandList->IASetIndexBuffer(&ibView);
+			currentIBView_ = ibView;
+		}
+		statistics_.vertexBuffer.applied++;
+	} else {
+		statistics_.vertexBuffer.skipped++;
+	}
+
+	commandList->DrawIndexedInstanced(
+	    static_cast<UINT>(packet.mesh->GetIndices().size()), 1, range ? range->startIndex : 0,
+	    range ? range->baseVertex : 0, 0);
+	statistics_.drawCount++;
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "Model.h"
+#include "Sprite.h"
+#include "ViewProjection.h"
+#include "WorldTransform.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// 描画キュー
+/// </summary>
+/// <remarks>
+/// 描画要求をソートキー付きのパケットとして溜めておき、Flushでまとめてソートして発行する。
+/// 直前と同じステートの再設定は省略する。
+/// </remarks>
+class RenderQueue {
+public: // 列挙子
+	/// <summary>
+	/// 描画パス（値の小さい順に描画される）
+	/// </summary>
+	enum class Pass {
+		kBackground,  // 背景スプライト（終了時に深度バッファをクリア）
+		kOpaque,      // 不透明3Dオブジェクト（手前から奥）
+		kTransparent, // 半透明3Dオブジェクト（奥から手前）
+		kForeground,  // 前景スプライト
+	};
+
+public: // サブクラス
+	/// <summary>
+	/// ステート変更の統計
+	/// </summary>
+	struct StateCounter {
+		uint32_t applied = 0; // 実際に設定した回数
+		uint32_t skipped = 0; // 直前と同じため省略した回数
+	};
+
+	/// <summary>
+	/// フレームごとの統計
+	/// </summary>
+	struct Statistics {
+		uint32_t drawCount = 0;      // 描画コマンド数
+		StateCounter pipeline;       // ルートシグネチャ・PSO
+		StateCounter light;          // ライト
+		StateCounter viewProjection; // ビュープロジェクション
+		StateCounter objectColor;    // オブジェクトカラー
+		StateCounter material;       // マテリアル
+		StateCounter texture;        // テクスチャ
+		StateCounter vertexBuffer;   // 頂点・インデックスバッファ
+	};
+
+public: // メンバ関数
+	/// <summary>
+	/// モデル描画の登録
+	/// </summary>
+	/// <param name="model">モデル</param>
+	/// <param name="worldTransform">ワールドトランスフォーム</param>
+	/// <param name="viewProjection">ビュープロジェクション</param>
+	/// <param name="objectColor">オブジェクトカラー</param>
+	/// <param name="pass">描画パス</param>
+	void Submit(
+	    Model* model, const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+	    const ObjectColor* objectColor = nullptr, Pass pass = Pass::kOpaque);
+
+	/// <summary>
+	/// スプライト描画の登録
+	/// </summary>
+	/// <param name="sprite">スプライト</param>
+	/// <param name="pass">描画パス</param>
+	/// <param name="blendMode">ブレンドモード</param>
+	/// <param name="layer">レイヤー（レイヤー内はブレンドモードとテクスチャでまとめる）</param>
+	void Submit(
+	    Sprite* sprite, Pass pass = Pass::kForeground,
+	    Sprite::BlendMode blendMode = Sprite::BlendMode::kNormal, uint8_t layer = 0);
+
+	/// <summary>
+	/// ソートして全パケットを描画し、キューを空にする
+	/// </summary>
+	/// <param name="commandList">コマンドリスト</param>
+	void Flush(ID3D12GraphicsCommandList* commandList);
+
+	/// <summary>
+	/// 直前のFlushの統計を取得
+	/// </summary>
+	/// <returns>統計</returns>
+	const Statistics& GetStatistics() const { return statistics_; }
+
+private: // サブクラス
+	// パケットの種類
+	enum class PacketType {
+		kMesh,
+		kSprite,
+	};
+
+	// 描画パケット
+	struct Packet {
+		PacketType type;
+		Pass pass;
+		// メッシュ用
+		Mesh* mesh;
+		const LightGroup* lightGroup;
+		const WorldTransform* worldTransform;
+		const ViewProjection* viewProjection;
+		const ObjectColor* objectColor;
+		// スプライト用
+		Sprite* sprite;
+		Sprite::BlendMode blendMode;
+	};
+
+	// ソート用要素
+	struct SortEntry {
+		uint64_t key;
+		uint32_t index;
+	};
+
+private: // メンバ関数
+	/// <summary>
+	/// マテリアルのソート用番号を取得（そのフレームで初めて登録された順）
+	/// </summary>
+	uint64_t GetMaterialId(const Material* material);
+
+	/// <summary>
+	/// ソートキーの基数ソート
+	/// </summary>
+	void SortEntries();
+
+	/// <summary>
+	/// 発行中のステートを未設定に戻す
+	/// </summary>
+	void ResetBoundState();
+
+	/// <summary>
+	/// メッシュパケットの発行
+	/// </summary>
+	void ExecuteMesh(ID3D12GraphicsCommandList* commandList, const Packet& packet);
+
+private: // メンバ変数
+	// パケット
+	std::vector<Packet> packets_;
+	// ソート対象
+	std::vector<SortEntry> entries_;
+	// ソート作業領域
+	std::vector<SortEntry> sortBuffer_;
+	// マテリアルのソート用番号（Flushのたびに作り直す）
+	std::unordered_map<const Material*, uint64_t> materialIds_;
+	// スプライトの登録順
+	uint32_t spriteSequence_ = 0;
+	// 統計
+	Statistics statistics_;
+
+	// 発行中のステート
+	bool isLightGroupBound_ = false;
+	const LightGroup* currentLightGroup_ = nullptr;
+	const ViewProjection* currentViewProjection_ = nullptr;
+	const ObjectColor* currentObjectColor_ = nullptr;
+	const Material* currentMaterial_ = nullptr;
+	uint32_t currentTexture_ = 0;
+	D3D12_VERTEX_BUFFER_VIEW currentVBView_{};
+	D3D12_INDEX_BUFFER_VIEW currentIBView_{};
+};
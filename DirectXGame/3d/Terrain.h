@@ -1,5 +1,6 @@
 #pragma once
 
+#include "PerlinNoise.h"
 #include "Vector2.h"
 #include "Vector3.h"
 #include "ViewProjection.h"
@@ -59,6 +60,18 @@ public:
 	/// <param name="gridSize">1グリッドがまたぐ頂点数</param>
 	void DeformRandom(uint32_t gridSize = 5);
 
+	/// <summary>
+	/// 複数オクターブのパーリンノイズによる地形変動
+	/// </summary>
+	/// <remarks>
+	/// 行ごとに並列に高さを求め、同じ処理の中で法線も計算し直す。高さは[0, modelHeight]になる
+	/// </remarks>
+	/// <param name="noise">ノイズ</param>
+	/// <param name="gridSize">1グリッドがまたぐ頂点数</param>
+	/// <param name="fractal">オクターブの設定</param>
+	void DeformNoise(
+	    const PerlinNoise& noise, uint32_t gridSize = 5, const PerlinNoise::Fractal& fractal = {});
+
 	/// <summary>
 	/// 頂点配列の取得
 	/// </summary>
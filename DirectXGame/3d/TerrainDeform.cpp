@@ -0,0 +1,68 @@
+#include "JobSystem.h"
+#include "MathUtility.h"
+#include "Terrain.h"
+#include <algorithm>
+#include <cassert>
+
+namespace {
+
+// 1回の並列処理が受け持つ行数（前後1行は隣の範囲と重複して計算する）
+const size_t kDeformGrainRows = 32;
+
+} // namespace
+
+void Terrain::DeformNoise(
+    const PerlinNoise& noise, uint32_t gridSize, const PerlinNoise::Fractal& fractal) {
+	assert(0 < gridSize);
+	const size_t rowCount = vertices_.size();
+	if (rowCount == 0 || vertices_[0].empty()) {
+		return;
+	}
+	const size_t columnCount = vertices_[0].size();
+
+	// 隣の頂点との間隔。並び順によらないよう実際の座標から求める
+	float stepX = 1 < columnCount ? vertices_[0][1].pos.x - vertices_[0][0].pos.x : 1.0f;
+	float stepZ = 1 < rowCount ? vertices_[1][0].pos.z - vertices_[0][0].pos.z : 1.0f;
+	float scale = 1.0f / float(gridSize);
+
+	JobSystem::GetInstance()->ParallelFor(
+	    rowCount, kDeformGrainRows, [&](size_t begin, size_t end) {
+		    // 法線の差分に要る前後1行も含めて高さを求める
+		    size_t first = begin == 0 ? 0 : begin - 1;
+		    size_t last = std::min(end + 1, rowCount);
+		    std::vector<float> heights((last - first) * columnCount);
+		    for (size_t z = first; z < last; z++) {
+			    std::span<float> row(heights.data() + (z - first) * columnCount, columnCount);
+			    noise.FbmRow(0.0f, scale, float(z) * scale, fractal, row);
+			    for (float& height : row) {
+				    height = (height * 0.5f + 0.5f) * modelHeight_;
+			    }
+		    }
+		    auto height = [&](size_t x, size_t z) {
+			    return heights[(z - first) * columnCount + x];
+		    };
+
+		    // 高さと、中央差分（端は片側差分）による法線を書き込む
+		    for (size_t z = begin; z < end; z++) {
+			    size_t z0 = z == 0 ? 0 : z - 1;
+			    size_t z1 = std::min(z + 1, rowCount - 1);
+			    for (size_t x = 0; x < columnCount; x++) {
+				    size_t x0 = x == 0 ? 0 : x - 1;
+				    size_t x1 = std::min(x + 1, columnCount - 1);
+				    float slopeX = 0.0f;
+				    float slopeZ = 0.0f;
+				    if (x0 != x1) {
+					    slopeX = (height(x1, z) - height(x0, z)) / (float(x1 - x0) * stepX);
+				    }
+				    if (z0 != z1) {
+					    slopeZ = (height(x, z1) - height(x, z0)) / (float(z1 - z0) * stepZ);
+				    }
+				    VertexPosNormalUv& vertex = vertices_[z][x];
+				    vertex.pos.y = height(x, z);
+				    vertex.normal = MathUtility::Normalize(Vector3{-slopeX, 1.0f, -slopeZ});
+			    }
+		    }
+	    });
+
+	TransferBuffers();
+}
@@ -0,0 +1,241 @@
+#include "TerrainGrid.h"
+#include "CopyQueue.h"
+#include "DirectXCommon.h"
+#include "JobSystem.h"
+#include "MathUtility.h"
+#include "MeshOptimizer.h"
+#include "TextureManager.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <d3dx12.h>
+
+namespace {
+
+// 1回の並列処理が受け持つ行数
+const size_t kGrainRows = 32;
+
+} // namespace
+
+std::unique_ptr<TerrainCommon> TerrainGrid::sTerrainCommon_;
+
+void TerrainGrid::StaticInitialize() {
+	sTerrainCommon_ = std::make_unique<TerrainCommon>();
+	sTerrainCommon_->Initialize();
+}
+
+void TerrainGrid::StaticFinalize() { sTerrainCommon_.reset(); }
+
+void TerrainGrid::Initialize(
+    float modelWidth, float modelDepth, float modelHeight, uint32_t vertexCountHorizontal,
+    uint32_t vertexCountVertical) {
+	assert(1 < vertexCountHorizontal && 1 < vertexCountVertical);
+
+	modelWidth_ = modelWidth;
+	modelDepth_ = modelDepth;
+	modelHeight_ = modelHeight;
+	vertexCountHorizontal_ = vertexCountHorizontal;
+	vertexCountVertical_ = vertexCountVertical;
+	stride_ = vertexCountHorizontal;
+
+	// 中心を原点とした平らな格子（1回の確保で全頂点）
+	vertices_.assign(size_t(stride_) * vertexCountVertical_, {});
+	float stepX = modelWidth_ / float(vertexCountHorizontal_ - 1);
+	float stepZ = modelDepth_ / float(vertexCountVertical_ - 1);
+	for (uint32_t z = 0; z < vertexCountVertical_; z++) {
+		for (uint32_t x = 0; x < vertexCountHorizontal_; x++) {
+			VertexPosNormalUv& vertex = At(x, z);
+			vertex.pos = {-modelWidth_ * 0.5f + stepX * x, 0.0f, -modelDepth_ * 0.5f + stepZ * z};
+			vertex.normal = {0.0f, 1.0f, 0.0f};
+			vertex.uv = {
+			    float(x) / float(vertexCountHorizontal_ - 1),
+			    float(z) / float(vertexCountVertical_ - 1)};
+		}
+	}
+
+	CreateBuffers();
+	MarkDirty({0, 0, vertexCountHorizontal_, vertexCountVertical_});
+	TransferBuffers();
+}
+
+void TerrainGrid::Draw(
+    const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+    uint32_t textureHadle) {
+	assert(sTerrainCommon_);
+	ID3D12GraphicsCommandList* commandList = DirectXCommon::GetInstance()->GetCommandList();
+
+	// パイプラインはTerrainと共通
+	sTerrainCommon_->PreDraw();
+	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	commandList->IASetVertexBuffers(0, 1, &vbView_);
+	commandList->IASetIndexBuffer(&ibView_);
+
+	commandList->SetGraphicsRootConstantBufferView(
+	    static_cast<UINT>(TerrainCommon::RoomParameter::kWorldTransform),
+	    worldTransform.GetConstBuffer()->GetGPUVirtualAddress());
+	commandList->SetGraphicsRootConstantBufferView(
+	    static_cast<UINT>(TerrainCommon::RoomParameter::kViewProjection),
+	    viewProjection.GetConstBuffer()->GetGPUVirtualAddress());
+	TextureManager::GetInstance()->SetGraphicsRootDescriptorTable(
+	    commandList, static_cast<UINT>(TerrainCommon::RoomParameter::kTexture), textureHadle);
+
+	commandList->DrawIndexedInstanced(indexCount_, 1, 0, 0, 0);
+}
+
+void TerrainGrid::DeformNoise(
+    const PerlinNoise& noise, uint32_t gridSize, const PerlinNoise::Fractal& fractal) {
+	assert(0 < gridSize);
+	float scale = 1.0f / float(gridSize);
+
+	// 行ごとに並列に高さを求める（行は連続しているので作業用の配列は1行分で足りる）
+	JobSystem::GetInstance()->ParallelFor(
+	    vertexCountVertical_, kGrainRows, [&](size_t begin, size_t end) {
+		    std::vector<float> heights(vertexCountHorizontal_);
+		    for (size_t z = begin; z < end; z++) {
+			    noise.FbmRow(0.0f, scale, float(z) * scale, fractal, heights);
+			    std::span<VertexPosNormalUv> row = GetRow(static_cast<uint32_t>(z));
+			    for (size_t x = 0; x < row.size(); x++) {
+				    row[x].pos.y = (heights[x] * 0.5f + 0.5f) * modelHeight_;
+			    }
+		    }
+	    });
+
+	RecalculateNormals({0, 0, vertexCountHorizontal_, vertexCountVertical_});
+}
+
+void TerrainGrid::SetHeight(uint32_t x, uint32_t z, float height) {
+	assert(x < vertexCountHorizontal_ && z < vertexCountVertical_);
+	At(x, z).pos.y = height;
+	MarkDirty({x, z, x + 1, z + 1});
+}
+
+void TerrainGrid::RecalculateNormals(const Rect& rect) {
+	// 高さが変わった頂点の隣の法線も変わるので1頂点広げる
+	Rect expanded;
+	expanded.left = rect.left == 0 ? 0 : rect.left - 1;
+	expanded.top = rect.top == 0 ? 0 : rect.top - 1;
+	expanded.right = std::min(rect.right + 1, vertexCountHorizontal_);
+	expanded.bottom = std::min(rect.bottom + 1, vertexCountVertical_);
+	if (expanded.IsEmpty()) {
+		return;
+	}
+
+	float stepX = modelWidth_ / float(vertexCountHorizontal_ - 1);
+	float stepZ = modelDepth_ / float(vertexCountVertical_ - 1);
+
+	// 中央差分（端は片側差分）。高さは読むだけなので行ごとに独立して書ける
+	JobSystem::GetInstance()->ParallelFor(
+	    expanded.bottom - expanded.top, kGrainRows, [&](size_t begin, size_t end) {
+		    for (uint32_t z = expanded.top + uint32_t(begin); z < expanded.top + end; z++) {
+			    uint32_t z0 = z == 0 ? 0 : z - 1;
+			    uint32_t z1 = std::min(z + 1, vertexCountVertical_ - 1);
+			    for (uint32_t x = expanded.left; x < expanded.right; x++) {
+				    uint32_t x0 = x == 0 ? 0 : x - 1;
+				    uint32_t x1 = std::min(x + 1, vertexCountHorizontal_ - 1);
+				    float slopeX =
+				        (At(x1, z).pos.y - At(x0, z).pos.y) / (float(x1 - x0) * stepX);
+				    float slopeZ =
+				        (At(x, z1).pos.y - At(x, z0).pos.y) / (float(z1 - z0) * stepZ);
+				    At(x, z).normal = MathUtility::Normalize(Vector3{-slopeX, 1.0f, -slopeZ});
+			    }
+		    }
+	    });
+
+	MarkDirty(expanded);
+}
+
+void TerrainGrid::MarkDirty(const Rect& rect) {
+	if (rect.IsEmpty()) {
+		return;
+	}
+	if (dirtyRect_.IsEmpty()) {
+		dirtyRect_ = rect;
+	} else {
+		dirtyRect_.left = std::min(dirtyRect_.left, rect.left);
+		dirtyRect_.top = std::min(dirtyRect_.top, rect.top);
+		dirtyRect_.right = std::max(dirtyRect_.right, rect.right);
+		dirtyRect_.bottom = std::max(dirtyRect_.bottom, rect.bottom);
+	}
+	dirtyRect_.right = std::min(dirtyRect_.right, vertexCountHorizontal_);
+	dirtyRect_.bottom = std::min(dirtyRect_.bottom, vertexCountVertical_);
+}
+
+size_t TerrainGrid::TransferBuffers() {
+	assert(vertMap_);
+	if (dirtyRect_.IsEmpty()) {
+		return 0;
+	}
+
+	size_t size = 0;
+	const Rect& rect = dirtyRect_;
+	size_t first = size_t(rect.top) * stride_;
+	if (rect.left == 0 && rect.right == vertexCountHorizontal_) {
+		// 行全体なら連続しているので1回で書き込む
+		size = sizeof(VertexPosNormalUv) * size_t(stride_) * (rect.bottom - rect.top);
+		std::memcpy(vertMap_ + first, vertices_.data() + first, size);
+	} else {
+		// 行ごとに編集した列だけを書き込む
+		size_t rowSize = sizeof(VertexPosNormalUv) * (rect.right - rect.left);
+		for (uint32_t z = rect.top; z < rect.bottom; z++) {
+			size_t offset = size_t(z) * stride_ + rect.left;
+			std::memcpy(vertMap_ + offset, vertices_.data() + offset, rowSize);
+			size += rowSize;
+		}
+	}
+
+	dirtyRect_ = {};
+	return size;
+}
+
+void TerrainGrid::CreateBuffers() {
+	HRESULT result = S_FALSE;
+	ID3D12Device* device = DirectXCommon::GetInstance()->GetDevice();
+
+	// インデックス（格子1つを時計回りの三角形2つに分ける）
+	std::vector<uint32_t> indices;
+	indices.reserve(size_t(vertexCountHorizontal_ - 1) * (vertexCountVertical_ - 1) * 6);
+	for (uint32_t z = 0; z + 1 < vertexCountVertical_; z++) {
+		for (uint32_t x = 0; x + 1 < vertexCountHorizontal_; x++) {
+			uint32_t index = z * stride_ + x;
+			indices.push_back(index);
+			indices.push_back(index + stride_);
+			indices.push_back(index + 1);
+			indices.push_back(index + 1);
+			indices.push_back(index + stride_);
+			indices.push_back(index + stride_ + 1);
+		}
+	}
+	indexCount_ = static_cast<uint32_t>(indices.size());
+
+	// 頂点バッファは書き換えるのでUPLOADヒープに置き、マップしたままにする
+	UINT sizeVB = static_cast<UINT>(sizeof(VertexPosNormalUv) * vertices_.size());
+	CD3DX12_HEAP_PROPERTIES heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+	CD3DX12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(sizeVB);
+	result = device->CreateCommittedResource(
+	    &heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ,
+	    nullptr, IID_PPV_ARGS(&vertBuff_));
+	assert(SUCCEEDED(result));
+	result = vertBuff_->Map(0, nullptr, reinterpret_cast<void**>(&vertMap_));
+	assert(SUCCEEDED(result));
+
+	vbView_.BufferLocation = vertBuff_->GetGPUVirtualAddress();
+	vbView_.SizeInBytes = sizeVB;
+	vbView_.StrideInBytes = sizeof(VertexPosNormalUv);
+
+	// インデックスは変わらないのでDEFAULTヒープへ転送する
+	bool is16Bit = MeshOptimizer::CanUse16BitIndices(vertices_.size());
+	std::vector<uint16_t> indices16;
+	if (is16Bit) {
+		indices16.assign(indices.begin(), indices.end());
+	}
+	UINT sizeIB = static_cast<UINT>(
+	    (is16Bit ? sizeof(uint16_t) : sizeof(uint32_t)) * indices.size());
+	const void* indexData = is16Bit ? static_cast<const void*>(indices16.data()) : indices.data();
+	CopyQueue* copyQueue = CopyQueue::GetInstance();
+	indexBuff_ = copyQueue->CreateBuffer(sizeIB);
+	copyQueue->Wait(copyQueue->UploadBuffer(indexBuff_.Get(), indexData, sizeIB));
+
+	ibView_.BufferLocation = indexBuff_->GetGPUVirtualAddress();
+	ibView_.Format = is16Bit ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+	ibView_.SizeInBytes = sizeIB;
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "PerlinNoise.h"
+#include "Terrain.h"
+#include "TerrainCommon.h"
+#include <cstdint>
+#include <d3d12.h>
+#include <memory>
+#include <span>
+#include <vector>
+#include <wrl.h>
+
+/// <summary>
+/// 頂点を1本の配列に持つ地形
+/// </summary>
+/// <remarks>
+/// Terrainと同じ頂点形式・パイプラインで描画する。頂点は行優先（z行ごとにx列が並ぶ）で
+/// 連続しているので、全体の転送は1回のmemcpyで済む。編集した範囲は転送対象の矩形として
+/// 記録しておき、TransferBuffersではその範囲の行だけを書き込む。
+/// </remarks>
+class TerrainGrid {
+public: // サブクラス
+	// 頂点データ構造体（Terrainと同じ）
+	using VertexPosNormalUv = Terrain::VertexPosNormalUv;
+
+	/// <summary>
+	/// 頂点の矩形範囲。列[left, right)・行[top, bottom)
+	/// </summary>
+	struct Rect {
+		uint32_t left = 0;
+		uint32_t top = 0;
+		uint32_t right = 0;
+		uint32_t bottom = 0;
+
+		/// <summary>
+		/// 空か
+		/// </summary>
+		bool IsEmpty() const { return right <= left || bottom <= top; }
+	};
+
+public: // 静的メンバ関数
+	/// <summary>
+	/// 静的初期化（パイプライン生成）
+	/// </summary>
+	static void StaticInitialize();
+
+	/// <summary>
+	/// 静的終了処理
+	/// </summary>
+	static void StaticFinalize();
+
+	/// <summary>
+	/// 地形共用部の取得（同じパイプラインで描画する他の地形と共有する）
+	/// </summary>
+	static TerrainCommon* GetTerrainCommon() { return sTerrainCommon_.get(); }
+
+public: // メンバ関数
+	/// <summary>
+	/// 初期化。平らな格子を作り、全体を転送する
+	/// </summary>
+	/// <param name="modelWidth">左右幅</param>
+	/// <param name="modelDepth">奥行幅</param>
+	/// <param name="modelHeight">高さ</param>
+	/// <param name="vertexCountHorizontal">横方向頂点数</param>
+	/// <param name="vertexCountVertical">縦方向頂点数</param>
+	void Initialize(
+	    float modelWidth = Terrain::kDefaultModelWidth,
+	    float modelDepth = Terrain::kDefaultModelWidth, float modelHeight = Terrain::kDefaultHeight,
+	    uint32_t vertexCountHorizontal = Terrain::kDefaultVertexCountHorizontal,
+	    uint32_t vertexCountVertical = Terrain::kDefaultVertexCountHorizontal);
+
+	/// <summary>
+	/// 描画
+	/// </summary>
+	/// <param name="worldTransform">ワールドトランスフォーム</param>
+	/// <param name="viewProjection">ビュープロジェクション</param>
+	/// <param name="textureHadle">テクスチャハンドル</param>
+	void Draw(
+	    const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+	    uint32_t textureHadle);
+
+	/// <summary>
+	/// 複数オクターブのパーリンノイズによる地形変動（全体を転送対象にする）
+	/// </summary>
+	/// <param name="noise">ノイズ</param>
+	/// <param name="gridSize">1グリッドがまたぐ頂点数</param>
+	/// <param name="fractal">オクターブの設定</param>
+	void DeformNoise(
+	    const PerlinNoise& noise, uint32_t gridSize = 5, const PerlinNoise::Fractal& fractal = {});
+
+	/// <summary>
+	/// 高さの設定。法線は再計算しないので、まとめて編集した後にRecalculateNormalsを呼ぶこと
+	/// </summary>
+	/// <param name="x">列</param>
+	/// <param name="z">行</param>
+	/// <param name="height">高さ</param>
+	void SetHeight(uint32_t x, uint32_t z, float height);
+
+	/// <summary>
+	/// 範囲内の法線を高さの差分から計算し直し、転送対象にする
+	/// </summary>
+	/// <remarks>高さを変えた範囲を渡せば、その周囲1頂点も含めて計算し直す</remarks>
+	/// <param name="rect">範囲</param>
+	void RecalculateNormals(const Rect& rect);
+
+	/// <summary>
+	/// 範囲を転送対象に加える（頂点を直接書き換えた場合に呼ぶ）
+	/// </summary>
+	/// <param name="rect">範囲</param>
+	void MarkDirty(const Rect& rect);
+
+	/// <summary>
+	/// 転送対象の範囲を頂点バッファへ書き込む
+	/// </summary>
+	/// <returns>書き込んだバイト数</returns>
+	size_t TransferBuffers();
+
+	/// <summary>
+	/// 頂点の取得
+	/// </summary>
+	/// <param name="x">列</param>
+	/// <param name="z">行</param>
+	VertexPosNormalUv& At(uint32_t x, uint32_t z) { return vertices_[size_t(z) * stride_ + x]; }
+	const VertexPosNormalUv& At(uint32_t x, uint32_t z) const {
+		return vertices_[size_t(z) * stride_ + x];
+	}
+
+	/// <summary>
+	/// 1行分の頂点の取得
+	/// </summary>
+	/// <param name="z">行</param>
+	std::span<VertexPosNormalUv> GetRow(uint32_t z) {
+		return std::span(vertices_).subspan(size_t(z) * stride_, vertexCountHorizontal_);
+	}
+
+	/// <summary>
+	/// 頂点配列の取得（行優先。行の間隔はGetStride）
+	/// </summary>
+	std::span<const VertexPosNormalUv> GetVertices() const { return vertices_; }
+
+	/// <summary>
+	/// 行の間隔（頂点数）の取得
+	/// </summary>
+	uint32_t GetStride() const { return stride_; }
+
+	/// <summary>
+	/// 横方向頂点数の取得
+	/// </summary>
+	uint32_t GetVertexCountHorizontal() const { return vertexCountHorizontal_; }
+
+	/// <summary>
+	/// 縦方向頂点数の取得
+	/// </summary>
+	uint32_t GetVertexCountVertical() const { return vertexCountVertical_; }
+
+	/// <summary>
+	/// 転送対象の範囲の取得
+	/// </summary>
+	const Rect& GetDirtyRect() const { return dirtyRect_; }
+
+private: // メンバ関数
+	/// <summary>
+	/// バッファ生成
+	/// </summary>
+	void CreateBuffers();
+
+private: // 静的メンバ変数
+	// 地形共用部
+	static std::unique_ptr<TerrainCommon> sTerrainCommon_;
+
+private: // メンバ変数
+	// 横方向頂点数
+	uint32_t vertexCountHorizontal_ = 0;
+	// 縦方向頂点数
+	uint32_t vertexCountVertical_ = 0;
+	// 行の間隔（頂点数）
+	uint32_t stride_ = 0;
+	// モデル左右幅
+	float modelWidth_ = 0.0f;
+	// モデル奥行幅
+	float modelDepth_ = 0.0f;
+	// モデル高さ
+	float modelHeight_ = 0.0f;
+	// 頂点配列（行優先）
+	std::vector<VertexPosNormalUv> vertices_;
+	// インデックス数
+	uint32_t indexCount_ = 0;
+	// 頂点バッファ（UPLOADヒープ）
+	Microsoft::WRL::ComPtr<ID3D12Resource> vertBuff_;
+	// インデックスバッファ
+	Microsoft::WRL::ComPtr<ID3D12Resource> indexBuff_;
+	// 頂点バッファビュー
+	D3D12_VERTEX_BUFFER_VIEW vbView_ = {};
+	// インデックスバッファビュー
+	D3D12_INDEX_BUFFER_VIEW ibView_ = {};
+	// 頂点バッファマップ
+	VertexPosNormalUv* vertMap_ = nullptr;
+	// 転送対象の範囲
+	Rect dirtyRect_;
+};
@@ -0,0 +1,229 @@
+#include "TransformHierarchy.h"
+#include "MathUtility.h"
+#include <algorithm>
+#include <cassert>
+
+TransformHierarchy::Node TransformHierarchy::AddNode(Node parent, WorldTransform* target) {
+	assert(parent == kInvalidNode || parent < slots_.size());
+
+	Node node = static_cast<Node>(slots_.size());
+	uint32_t slot = static_cast<uint32_t>(parents_.size());
+	slots_.push_back(slot);
+	parentNodes_.push_back(parent);
+
+	// 一旦末尾に置く。親は必ず先に追加されているので順序は保たれるが、
+	// 兄弟の部分木の間に入らないため並べ直しは必要
+	parents_.push_back(parent == kInvalidNode ? kInvalidNode : slots_[parent]);
+	subtreeEnds_.push_back(slot + 1);
+	scales_.push_back({1.0f, 1.0f, 1.0f});
+	rotations_.push_back(MathUtility::IdentityQuaternion());
+	translations_.push_back({0.0f, 0.0f, 0.0f});
+	locals_.push_back(MathUtility::MakeIdentity4x4());
+	worlds_.push_back(MathUtility::MakeIdentity4x4());
+	targets_.push_back(target);
+	localDirty_.push_back(0);
+
+	if (parent != kInvalidNode) {
+		structureChanged_ = true;
+	}
+	MarkDirty(node);
+	return node;
+}
+
+void TransformHierarchy::SetParent(Node node, Node parent) {
+	assert(node < slots_.size());
+	assert(parent == kInvalidNode || parent < slots_.size());
+	assert(parent != node);
+
+#ifdef _DEBUG
+	// 循環の検出
+	for (Node ancestor = parent; ancestor != kInvalidNode; ancestor = parentNodes_[ancestor]) {
+		assert(ancestor != node);
+	}
+#endif
+
+	parentNodes_[node] = parent;
+	structureChanged_ = true;
+	MarkDirty(node);
+}
+
+void TransformHierarchy::Clear() {
+	slots_.clear();
+	parentNodes_.clear();
+	parents_.clear();
+	subtreeEnds_.clear();
+	scales_.clear();
+	rotations_.clear();
+	translations_.clear();
+	locals_.clear();
+	worlds_.clear();
+	targets_.clear();
+	localDirty_.clear();
+	dirtyNodes_.clear();
+	updated_.clear();
+	structureChanged_ = false;
+}
+
+void TransformHierarchy::SetLocal(
+    Node node, const Vector3& scale, const Quaternion& rotation, const Vector3& translation) {
+	uint32_t slot = slots_[node];
+	scales_[slot] = scale;
+	rotations_[slot] = rotation;
+	translations_[slot] = translation;
+	MarkDirty(node);
+}
+
+void TransformHierarchy::SetScale(Node node, const Vector3& scale) {
+	scales_[slots_[node]] = scale;
+	MarkDirty(node);
+}
+
+void TransformHierarchy::SetRotation(Node node, const Quaternion& rotation) {
+	rotations_[slots_[node]] = rotation;
+	MarkDirty(node);
+}
+
+void TransformHierarchy::SetTranslation(Node node, const Vector3& translation) {
+	translations_[slots_[node]] = translation;
+	MarkDirty(node);
+}
+
+void TransformHierarchy::Update() {
+	if (structureChanged_) {
+		Rebuild();
+	}
+
+	updated_.clear();
+	if (dirtyNodes_.empty()) {
+		return;
+	}
+
+	// 位置の昇順に並べると、部分木は必ず先に現れる祖先の範囲に含まれる
+	dirtySlots_.clear();
+	for (Node node : dirtyNodes_) {
+		dirtySlots_.push_back(slots_[node]);
+	}
+	dirtyNodes_.clear();
+	std::sort(dirtySlots_.begin(), dirtySlots_.end());
+
+	uint32_t coveredEnd = 0;
+	for (uint32_t root : dirtySlots_) {
+		// 祖先の部分木として計算済み
+		if (root < coveredEnd) {
+			continue;
+		}
+
+		for (uint32_t slot = root; slot < subtreeEnds_[root]; slot++) {
+			if (localDirty_[slot]) {
+				locals_[slot] = MathUtility::MakeAffineMatrix(
+				    scales_[slot], rotations_[slot], translations_[slot]);
+				localDirty_[slot] = 0;
+			}
+			uint32_t parent = parents_[slot];
+			worlds_[slot] = parent == kInvalidNode
+			                    ? locals_[slot]
+			                    : MathUtility::Multiply(locals_[slot], worlds_[parent]);
+			updated_.push_back(slot);
+		}
+		coveredEnd = subtreeEnds_[root];
+	}
+
+	// 計算が終わってからまとめて転送する
+	for (uint32_t slot : updated_) {
+		WorldTransform* target = targets_[slot];
+		if (target) {
+			target->matWorld_ = worlds_[slot];
+			target->TransferMatrix();
+		}
+	}
+}
+
+void TransformHierarchy::MarkDirty(Node node) {
+	assert(node < slots_.size());
+
+	uint8_t& dirty = localDirty_[slots_[node]];
+	if (!dirty) {
+		dirty = 1;
+		dirtyNodes_.push_back(node);
+	}
+}
+
+void TransformHierarchy::Rebuild() {
+	size_t count = slots_.size();
+
+	// 子の一覧（ハンドル順なので兄弟の並びは追加順になる）
+	std::vector<uint32_t> childOffsets(count + 1, 0);
+	for (Node node = 0; node < count; node++) {
+		if (parentNodes_[node] != kInvalidNode) {
+			childOffsets[parentNodes_[node] + 1]++;
+		}
+	}
+	for (size_t i = 0; i < count; i++) {
+		childOffsets[i + 1] += childOffsets[i];
+	}
+	std::vector<Node> children(childOffsets[count]);
+	std::vector<uint32_t> cursors(childOffsets.begin(), childOffsets.end() - 1);
+	for (Node node = 0; node < count; node++) {
+		if (parentNodes_[node] != kInvalidNode) {
+			children[cursors[parentNodes_[node]]++] = node;
+		}
+	}
+
+	// 深さ優先の行きがけ順で新しい位置を決める
+	std::vector<Node> order;
+	order.reserve(count);
+	std::vector<Node> stack;
+	for (Node root = 0; root < count; root++) {
+		if (parentNodes_[root] != kInvalidNode) {
+			continue;
+		}
+		stack.push_back(root);
+		while (!stack.empty()) {
+			Node node = stack.back();
+			stack.pop_back();
+			order.push_back(node);
+			// 追加順に訪れるよう逆順に積む
+			for (uint32_t i = childOffsets[node + 1]; i > childOffsets[node]; i--) {
+				stack.push_back(children[i - 1]);
+			}
+		}
+	}
+	assert(order.size() == count);
+
+	// 新しい位置で配列を組み直す
+	auto permute = [&](auto& values) {
+		std::remove_reference_t<decltype(values)> sorted(count);
+		for (uint32_t slot = 0; slot < count; slot++) {
+			sorted[slot] = values[slots_[order[slot]]];
+		}
+		values.swap(sorted);
+	};
+	permute(scales_);
+	permute(rotations_);
+	permute(translations_);
+	permute(locals_);
+	permute(worlds_);
+	permute(targets_);
+	permute(localDirty_);
+
+	for (uint32_t slot = 0; slot < count; slot++) {
+		slots_[order[slot]] = slot;
+	}
+	for (uint32_t slot = 0; slot < count; slot++) {
+		Node parent = parentNodes_[order[slot]];
+		parents_[slot] = parent == kInvalidNode ? kInvalidNode : slots_[parent];
+	}
+
+	// 部分木の終端は子孫の終端の最大値。後ろから求める
+	for (uint32_t slot = 0; slot < count; slot++) {
+		subtreeEnds_[slot] = slot + 1;
+	}
+	for (uint32_t slot = static_cast<uint32_t>(count); slot-- > 0;) {
+		if (parents_[slot] != kInvalidNode) {
+			uint32_t& parentEnd = subtreeEnds_[parents_[slot]];
+			parentEnd = std::max(parentEnd, subtreeEnds_[slot]);
+		}
+	}
+
+	structureChanged_ = false;
+}
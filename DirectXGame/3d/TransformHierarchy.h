@@ -0,0 +1,135 @@
+#pragma once
+
+#include "Matrix4x4.h"
+#include "Quaternion.h"
+#include "Vector3.h"
+#include "WorldTransform.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 変更のあったノードだけを更新するトランスフォーム階層
+/// </summary>
+/// <remarks>
+/// ノードは親→子の深さ優先順で平坦な配列に並べ、各ノードの子孫は連続した範囲に収める。
+/// 変更されたノードの部分木だけを順に計算するので、更新量は変更のあったノード数に比例する。
+/// 対応付けたWorldTransformへの転送は計算の後にまとめて行う。
+/// </remarks>
+class TransformHierarchy {
+public: // サブクラス
+	// ノードハンドル（追加順に振られ、並び替えの影響を受けない）
+	using Node = uint32_t;
+	// 無効なノード
+	static constexpr Node kInvalidNode = UINT32_MAX;
+
+public: // メンバ関数
+	/// <summary>
+	/// ノードの追加
+	/// </summary>
+	/// <param name="parent">親ノード（なければkInvalidNode）</param>
+	/// <param name="target">ワールド行列の転送先（なければnullptr）</param>
+	/// <returns>ノードハンドル</returns>
+	Node AddNode(Node parent = kInvalidNode, WorldTransform* target = nullptr);
+
+	/// <summary>
+	/// 親ノードの変更
+	/// </summary>
+	/// <param name="node">ノード</param>
+	/// <param name="parent">新しい親ノード（なければkInvalidNode）</param>
+	void SetParent(Node node, Node parent);
+
+	/// <summary>
+	/// 全ノードの削除
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// ローカル変換の設定
+	/// </summary>
+	/// <param name="node">ノード</param>
+	/// <param name="scale">拡大縮小</param>
+	/// <param name="rotation">回転（単位クォータニオン）</param>
+	/// <param name="translation">平行移動</param>
+	void SetLocal(
+	    Node node, const Vector3& scale, const Quaternion& rotation, const Vector3& translation);
+	/// <summary>
+	/// 拡大縮小の設定
+	/// </summary>
+	void SetScale(Node node, const Vector3& scale);
+	/// <summary>
+	/// 回転の設定
+	/// </summary>
+	void SetRotation(Node node, const Quaternion& rotation);
+	/// <summary>
+	/// 回転の設定（オイラー角）
+	/// </summary>
+	void SetRotation(Node node, const Vector3& rotation) {
+		SetRotation(node, MathUtility::MakeRotateQuaternion(rotation));
+	}
+	/// <summary>
+	/// 平行移動の設定
+	/// </summary>
+	void SetTranslation(Node node, const Vector3& translation);
+
+	/// <summary>
+	/// 変更のあったノードと子孫の行列を計算し、WorldTransformへ転送する
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// ワールド行列の取得（直前のUpdateの結果）
+	/// </summary>
+	const Matrix4x4& GetWorldMatrix(Node node) const { return worlds_[slots_[node]]; }
+	/// <summary>
+	/// ローカル行列の取得（直前のUpdateの結果）
+	/// </summary>
+	const Matrix4x4& GetLocalMatrix(Node node) const { return locals_[slots_[node]]; }
+	/// <summary>
+	/// ノード数の取得
+	/// </summary>
+	size_t GetNodeCount() const { return slots_.size(); }
+	/// <summary>
+	/// 直前のUpdateで計算したノード数の取得
+	/// </summary>
+	size_t GetUpdatedCount() const { return updated_.size(); }
+
+private: // メンバ関数
+	/// <summary>
+	/// ノードに変更ありの印を付ける
+	/// </summary>
+	void MarkDirty(Node node);
+
+	/// <summary>
+	/// 深さ優先順に並べ直す
+	/// </summary>
+	void Rebuild();
+
+private: // メンバ変数
+	// ハンドル → 配列上の位置
+	std::vector<uint32_t> slots_;
+	// ハンドル → 親ハンドル（並べ直しの入力）
+	std::vector<Node> parentNodes_;
+
+	// 以下は配列上の位置で引く（深さ優先順）
+	// 親の位置（なければkInvalidNode。常に自身より前）
+	std::vector<uint32_t> parents_;
+	// 部分木の終端（この位置の手前までが子孫）
+	std::vector<uint32_t> subtreeEnds_;
+	std::vector<Vector3> scales_;
+	std::vector<Quaternion> rotations_;
+	std::vector<Vector3> translations_;
+	std::vector<Matrix4x4> locals_;
+	std::vector<Matrix4x4> worlds_;
+	std::vector<WorldTransform*> targets_;
+	// ローカル行列の再計算が必要か
+	std::vector<uint8_t> localDirty_;
+
+	// 変更のあったノード
+	std::vector<Node> dirtyNodes_;
+	// 作業用: 変更のあった位置
+	std::vector<uint32_t> dirtySlots_;
+	// 直前のUpdateで計算した位置
+	std::vector<uint32_t> updated_;
+	// 親子関係が変わり並べ直しが必要か
+	bool structureChanged_ = false;
+};
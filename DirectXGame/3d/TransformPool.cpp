@@ -0,0 +1,141 @@
+#include "TransformPool.h"
+#include "JobSystem.h"
+#include "MathUtility.h"
+#include "WorldTransform.h"
+#include <cassert>
+#include <cstring>
+#include <d3dx12.h>
+
+namespace {
+
+// 1要素あたりの定数バッファサイズ
+const size_t kElementSize = (sizeof(ConstBufferDataWorldTransform) +
+                             D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT - 1) &
+                            ~size_t(D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT - 1);
+// 並列処理の分割単位
+const size_t kGrainSize = 1024;
+
+} // namespace
+
+void TransformPool::Initialize(ID3D12Device* device, uint32_t capacity, uint32_t frameCount) {
+	assert(device);
+	assert(0 < capacity);
+	assert(0 < frameCount);
+
+	HRESULT result = S_FALSE;
+
+	Clear();
+	capacity_ = capacity;
+	frameCount_ = frameCount;
+	frameIndex_ = 0;
+
+	scales_.reserve(capacity_);
+	rotations_.reserve(capacity_);
+	translations_.reserve(capacity_);
+	worlds_.reserve(capacity_);
+	handles_.reserve(capacity_);
+
+	// ヒーププロパティ
+	CD3DX12_HEAP_PROPERTIES heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+	// リソース設定
+	CD3DX12_RESOURCE_DESC resourceDesc =
+	    CD3DX12_RESOURCE_DESC::Buffer(kElementSize * capacity_ * frameCount_);
+
+	// 全要素・全フレーム分をまとめて1つのリソースとして生成
+	result = device->CreateCommittedResource(
+	    &heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr,
+	    IID_PPV_ARGS(&constBuffer_));
+	assert(SUCCEEDED(result));
+
+	// 永続的にマッピングしておく
+	result = constBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&constMap_));
+	assert(SUCCEEDED(result));
+	gpuBase_ = constBuffer_->GetGPUVirtualAddress();
+}
+
+TransformPool::Handle
+    TransformPool::Add(const Vector3& scale, const Vector3& rotation, const Vector3& translation) {
+	// 容量不足。Initializeのcapacityを見直すこと
+	assert(handles_.size() < capacity_);
+
+	Handle handle;
+	if (!freeHandles_.empty()) {
+		handle = freeHandles_.back();
+		freeHandles_.pop_back();
+	} else {
+		handle = static_cast<Handle>(indices_.size());
+		indices_.push_back(kInvalidHandle);
+	}
+
+	indices_[handle] = static_cast<uint32_t>(handles_.size());
+	handles_.push_back(handle);
+	scales_.push_back(scale);
+	rotations_.push_back(rotation);
+	translations_.push_back(translation);
+	worlds_.push_back(MathUtility::MakeAffineMatrix(scale, rotation, translation));
+	return handle;
+}
+
+void TransformPool::Remove(Handle handle) {
+	uint32_t index = Index(handle);
+	uint32_t last = static_cast<uint32_t>(handles_.size()) - 1;
+
+	// 末尾の要素で穴を埋める
+	if (index != last) {
+		Handle moved = handles_[last];
+		scales_[index] = scales_[last];
+		rotations_[index] = rotations_[last];
+		translations_[index] = translations_[last];
+		worlds_[index] = worlds_[last];
+		handles_[index] = moved;
+		indices_[moved] = index;
+	}
+	scales_.pop_back();
+	rotations_.pop_back();
+	translations_.pop_back();
+	worlds_.pop_back();
+	handles_.pop_back();
+
+	indices_[handle] = kInvalidHandle;
+	freeHandles_.push_back(handle);
+}
+
+void TransformPool::Clear() {
+	scales_.clear();
+	rotations_.clear();
+	translations_.clear();
+	worlds_.clear();
+	handles_.clear();
+	indices_.clear();
+	freeHandles_.clear();
+}
+
+void TransformPool::Update() {
+	assert(constMap_);
+
+	frameIndex_ = (frameIndex_ + 1) % frameCount_;
+	uint8_t* frameMap = constMap_ + kElementSize * capacity_ * frameIndex_;
+
+	JobSystem::GetInstance()->ParallelFor(
+	    handles_.size(), kGrainSize, [this, frameMap](size_t begin, size_t end) {
+		    for (size_t i = begin; i < end; i++) {
+			    worlds_[i] =
+			        MathUtility::MakeAffineMatrix(scales_[i], rotations_[i], translations_[i]);
+			    ConstBufferDataWorldTransform data{worlds_[i]};
+			    std::memcpy(frameMap + kElementSize * i, &data, sizeof(data));
+		    }
+	    });
+}
+
+D3D12_GPU_VIRTUAL_ADDRESS TransformPool::GetGpuAddress(Handle handle) const {
+	assert(gpuBase_);
+	return gpuBase_ + kElementSize * (capacity_ * frameIndex_ + Index(handle));
+}
+
+uint32_t TransformPool::Index(Handle handle) const {
+	assert(handle < indices_.size());
+	uint32_t index = indices_[handle];
+	// 削除済みのハンドル
+	assert(index != kInvalidHandle);
+	return index;
+}
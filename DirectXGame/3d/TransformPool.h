@@ -0,0 +1,140 @@
+#pragma once
+
+#include "Matrix4x4.h"
+#include "Vector3.h"
+#include <cstdint>
+#include <d3d12.h>
+#include <vector>
+#include <wrl.h>
+
+/// <summary>
+/// 大量のワールド変換をまとめて管理するプール
+/// </summary>
+/// <remarks>
+/// スケール・回転・座標・ワールド行列を要素ごとの連続した配列で持ち、Updateでジョブシステムにより
+/// 並列に行列を計算して、永続マッピングした1つの定数バッファへ直接書き込む。
+/// 削除時は末尾の要素で穴を埋めるため配列は常に詰まっており、ハンドルは削除されるまで変わらない。
+/// </remarks>
+class TransformPool {
+public: // サブクラス
+	// ハンドル
+	using Handle = uint32_t;
+	// 無効なハンドル
+	static constexpr Handle kInvalidHandle = UINT32_MAX;
+
+public: // メンバ関数
+	TransformPool() = default;
+	~TransformPool() = default;
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="device">デバイス</param>
+	/// <param name="capacity">最大要素数</param>
+	/// <param name="frameCount">同時に使用されうるフレーム数</param>
+	void Initialize(ID3D12Device* device, uint32_t capacity, uint32_t frameCount = 2);
+
+	/// <summary>
+	/// 要素の追加
+	/// </summary>
+	/// <param name="scale">拡大縮小</param>
+	/// <param name="rotation">回転（オイラー角）</param>
+	/// <param name="translation">平行移動</param>
+	/// <returns>ハンドル</returns>
+	Handle Add(
+	    const Vector3& scale = {1.0f, 1.0f, 1.0f}, const Vector3& rotation = {},
+	    const Vector3& translation = {});
+
+	/// <summary>
+	/// 要素の削除
+	/// </summary>
+	/// <param name="handle">ハンドル</param>
+	void Remove(Handle handle);
+
+	/// <summary>
+	/// 全要素の削除
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// 全要素のワールド行列を並列に計算し、定数バッファへ書き込む。描画前に1フレーム1回呼ぶ
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// 拡大縮小の参照
+	/// </summary>
+	Vector3& Scale(Handle handle) { return scales_[Index(handle)]; }
+	/// <summary>
+	/// 回転（オイラー角）の参照
+	/// </summary>
+	Vector3& Rotation(Handle handle) { return rotations_[Index(handle)]; }
+	/// <summary>
+	/// 平行移動の参照
+	/// </summary>
+	Vector3& Translation(Handle handle) { return translations_[Index(handle)]; }
+	/// <summary>
+	/// ワールド行列の取得（直前のUpdateの結果）
+	/// </summary>
+	const Matrix4x4& GetWorldMatrix(Handle handle) const { return worlds_[Index(handle)]; }
+
+	/// <summary>
+	/// 直前のUpdateで書き込んだ定数バッファのGPU仮想アドレスを取得
+	/// </summary>
+	/// <param name="handle">ハンドル</param>
+	/// <returns>Model::Drawに渡せるワールド変換のアドレス</returns>
+	D3D12_GPU_VIRTUAL_ADDRESS GetGpuAddress(Handle handle) const;
+
+	/// <summary>
+	/// 要素数の取得
+	/// </summary>
+	uint32_t GetCount() const { return static_cast<uint32_t>(handles_.size()); }
+
+	/// <summary>
+	/// 最大要素数の取得
+	/// </summary>
+	uint32_t GetCapacity() const { return capacity_; }
+
+	/// <summary>
+	/// 配列上の位置で直接アクセスする（一括処理用。位置は削除で変わる）
+	/// </summary>
+	Vector3* GetScales() { return scales_.data(); }
+	Vector3* GetRotations() { return rotations_.data(); }
+	Vector3* GetTranslations() { return translations_.data(); }
+
+private: // メンバ関数
+	/// <summary>
+	/// ハンドルから配列上の位置を取得
+	/// </summary>
+	uint32_t Index(Handle handle) const;
+
+	// コピー禁止
+	TransformPool(const TransformPool&) = delete;
+	TransformPool& operator=(const TransformPool&) = delete;
+
+private: // メンバ変数
+	// 要素ごとの配列（位置で引く）
+	std::vector<Vector3> scales_;
+	std::vector<Vector3> rotations_;
+	std::vector<Vector3> translations_;
+	std::vector<Matrix4x4> worlds_;
+	// 位置 → ハンドル
+	std::vector<Handle> handles_;
+	// ハンドル → 位置
+	std::vector<uint32_t> indices_;
+	// 再利用できるハンドル
+	std::vector<Handle> freeHandles_;
+
+	// 定数バッファ（1要素256バイト×最大要素数×フレーム数）
+	Microsoft::WRL::ComPtr<ID3D12Resource> constBuffer_;
+	// マッピング済みアドレス
+	uint8_t* constMap_ = nullptr;
+	// GPU仮想アドレスの先頭
+	D3D12_GPU_VIRTUAL_ADDRESS gpuBase_ = 0;
+	// 最大要素数
+	uint32_t capacity_ = 0;
+	// フレーム数
+	uint32_t frameCount_ = 0;
+	// 直前のUpdateで書き込んだ区画
+	uint32_t frameIndex_ = 0;
+};
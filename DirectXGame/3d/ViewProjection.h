@@ -1,7 +1,11 @@
 #pragma once
 
+#include "ConstBufferAllocator.h"
+#include "MathUtility.h"
 #include "Matrix4x4.h"
+#include "Shapes.h"
 #include "Vector3.h"
+#include <cstddef>
 #include <d3d12.h>
 #include <type_traits>
 #include <wrl.h>
@@ -12,6 +16,9 @@ struct ConstBufferDataViewProjection {
 	Matrix4x4 projection; // ビュー → プロジェクション変換行列
 	Vector3 cameraPos;    // カメラ座標（ワールド座標）
 };
+// Obj.hlsli・Terrain.hlsliのcbuffer ViewProjectionと同じオフセットであること
+static_assert(offsetof(ConstBufferDataViewProjection, projection) == 64);
+static_assert(offsetof(ConstBufferDataViewProjection, cameraPos) == 128);
 
 /// <summary>
 /// ビュープロジェクション変換データ
@@ -65,6 +72,14 @@ public:
 	/// </summary>
 	void TransferMatrix();
 	/// <summary>
+	/// 行列をフレーム用定数バッファへ転送する
+	/// </summary>
+	/// <param name="allocator">定数バッファアロケータ</param>
+	/// <returns>転送先のGPU仮想アドレス</returns>
+	D3D12_GPU_VIRTUAL_ADDRESS TransferMatrix(ConstBufferAllocator& allocator) const {
+		return allocator.Push(ConstBufferDataViewProjection{matView, matProjection, translation_});
+	}
+	/// <summary>
 	/// ビュー行列を更新する
 	/// </summary>
 	void UpdateViewMatrix();
@@ -73,6 +88,24 @@ public:
 	/// </summary>
 	void UpdateProjectionMatrix();
 	/// <summary>
+	/// 視錐台を取得する（UpdateMatrix後の行列から求める）
+	/// </summary>
+	/// <returns>ワールド座標系の視錐台</returns>
+	Frustum GetFrustum() const {
+		return MathUtility::MakeFrustum(MathUtility::Multiply(matView, matProjection));
+	}
+	/// <summary>
+	/// スクリーン座標を通る半直線を取得する（マウスピッキング用）
+	/// </summary>
+	/// <param name="screenPosition">スクリーン座標（Input::GetMousePositionなど）</param>
+	/// <param name="width">スクリーンの幅</param>
+	/// <param name="height">スクリーンの高さ</param>
+	/// <returns>ワールド座標系の半直線</returns>
+	Ray GetScreenRay(const Vector2& screenPosition, float width, float height) const {
+		return MathUtility::MakeScreenRay(
+		    screenPosition, MathUtility::Multiply(matView, matProjection), width, height);
+	}
+	/// <summary>
 	/// 定数バッファの取得
 	/// </summary>
 	/// <returns>定数バッファ</returns>
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "ConstBufferAllocator.h"
 #include "Matrix4x4.h"
+#include "Quaternion.h"
 #include "Vector3.h"
 #include <d3d12.h>
 #include <type_traits>
@@ -10,6 +12,8 @@
 struct ConstBufferDataWorldTransform {
 	Matrix4x4 matWorld; // ローカル → ワールド変換行列
 };
+// Obj.hlsli・Terrain.hlsliのcbuffer WorldTransform（matrix 1つ）と同じ大きさであること
+static_assert(sizeof(ConstBufferDataWorldTransform) == 64);
 
 /// <summary>
 /// ワールド変換データ
@@ -47,6 +51,23 @@ public:
 	/// </summary>
 	void TransferMatrix();
 	/// <summary>
+	/// スケール・回転角・座標から行列を更新して転送する
+	/// </summary>
+	void UpdateMatrix();
+	/// <summary>
+	/// 回転をクォータニオンで指定して行列を更新して転送する（rotation_は使わない）
+	/// </summary>
+	/// <param name="rotation">回転（単位クォータニオン）</param>
+	void UpdateMatrix(const Quaternion& rotation);
+	/// <summary>
+	/// 行列をフレーム用定数バッファへ転送する
+	/// </summary>
+	/// <param name="allocator">定数バッファアロケータ</param>
+	/// <returns>転送先のGPU仮想アドレス</returns>
+	D3D12_GPU_VIRTUAL_ADDRESS TransferMatrix(ConstBufferAllocator& allocator) const {
+		return allocator.Push(ConstBufferDataWorldTransform{matWorld_});
+	}
+	/// <summary>
 	/// 定数バッファの取得
 	/// </summary>
 	/// <returns>定数バッファ</returns>
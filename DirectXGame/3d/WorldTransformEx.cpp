@@ -0,0 +1,18 @@
+#include "MathUtility.h"
+#include "WorldTransform.h"
+
+void WorldTransform::UpdateMatrix() {
+	matWorld_ = MathUtility::MakeAffineMatrix(scale_, rotation_, translation_);
+	if (parent_) {
+		matWorld_ = MathUtility::Multiply(matWorld_, parent_->matWorld_);
+	}
+	TransferMatrix();
+}
+
+void WorldTransform::UpdateMatrix(const Quaternion& rotation) {
+	matWorld_ = MathUtility::MakeAffineMatrix(scale_, rotation, translation_);
+	if (parent_) {
+		matWorld_ = MathUtility::Multiply(matWorld_, parent_->matWorld_);
+	}
+	TransferMatrix();
+}
@@ -0,0 +1,18 @@
+#include "ObjShading.hlsli"
+
+// インスタンスごとのデータ
+struct InstanceData {
+	matrix world; // ワールド行列
+	float4 color; // オブジェクトカラー
+};
+
+StructuredBuffer<InstanceData> instances : register(t1);
+
+// 頂点シェーダーからピクセルシェーダーへのやり取りに使用する構造体
+struct VSOutputInstanced {
+	float4 svpos : SV_POSITION; // システム用頂点座標
+	float4 worldpos : POSITION; // ワールド座標
+	float3 normal : NORMAL;     // 法線
+	float2 uv : TEXCOORD;       // uv値
+	float4 color : COLOR;       // オブジェクトカラー
+};
@@ -0,0 +1,18 @@
+#include "ObjInstanced.hlsli"
+
+Texture2D<float4> tex : register(t0); // 0番スロットに設定されたテクスチャ
+SamplerState smp : register(s0);      // 0番スロットに設定されたサンプラー
+
+float4 main(VSOutputInstanced input) : SV_TARGET {
+	// UV変換
+	float2 uv = float2(
+	    input.uv.x * m_uv_scale.x + m_uv_offset.x, input.uv.y * m_uv_scale.y + m_uv_offset.y);
+	// テクスチャマッピング
+	float4 texcolor = tex.Sample(smp, uv);
+
+	// シェーディングによる色
+	float4 shadecolor = ComputeShadeColor(input.worldpos, input.normal);
+
+	// シェーディングによる色で描画
+	return shadecolor * texcolor * input.color;
+}
@@ -0,0 +1,61 @@
+#include "ConstBufferAllocator.h"
+#include <cassert>
+#include <d3dx12.h>
+
+ConstBufferAllocator* ConstBufferAllocator::GetInstance() {
+	static ConstBufferAllocator instance;
+	return &instance;
+}
+
+void ConstBufferAllocator::Initialize(
+    ID3D12Device* device, size_t frameCount, size_t capacityPerFrame) {
+	assert(device);
+	assert(0 < frameCount);
+
+	HRESULT result = S_FALSE;
+
+	frameCount_ = frameCount;
+	// 区画の境界もアライメントに揃える
+	capacityPerFrame_ = (capacityPerFrame + kAlignment - 1) & ~(kAlignment - 1);
+	frameIndex_ = 0;
+	offset_ = 0;
+
+	// ヒーププロパティ
+	CD3DX12_HEAP_PROPERTIES heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+	// リソース設定
+	CD3DX12_RESOURCE_DESC resourceDesc =
+	    CD3DX12_RESOURCE_DESC::Buffer(capacityPerFrame_ * frameCount_);
+
+	// 全フレーム分をまとめて1つのリソースとして生成
+	result = device->CreateCommittedResource(
+	    &heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr,
+	    IID_PPV_ARGS(&buffer_));
+	assert(SUCCEEDED(result));
+
+	// 永続的にマッピングしておく
+	result = buffer_->Map(0, nullptr, reinterpret_cast<void**>(&cpuBase_));
+	assert(SUCCEEDED(result));
+	gpuBase_ = buffer_->GetGPUVirtualAddress();
+}
+
+void ConstBufferAllocator::BeginFrame() {
+	frameIndex_ = (frameIndex_ + 1) % frameCount_;
+	offset_.store(0, std::memory_order_relaxed);
+}
+
+ConstBufferAllocator::Allocation ConstBufferAllocator::Allocate(size_t size) {
+	assert(cpuBase_);
+
+	// 全ての確保をアライメント単位にすることで、先頭オフセットも常に揃う
+	size_t alignedSize = (size + kAlignment - 1) & ~(kAlignment - 1);
+	size_t offset = offset_.fetch_add(alignedSize, std::memory_order_relaxed);
+	// 容量不足。kDefaultCapacityPerFrameを見直すこと
+	assert(offset + alignedSize <= capacityPerFrame_);
+
+	size_t base = frameIndex_ * capacityPerFrame_ + offset;
+
+	Allocation allocation;
+	allocation.cpuAddress = cpuBase_ + base;
+	allocation.gpuAddress = gpuBase_ + base;
+	return allocation;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <d3d12.h>
+#include <wrl.h>
+
+/// <summary>
+/// フレーム単位の定数バッファアロケータ
+/// </summary>
+/// <remarks>
+/// 大きなアップロードバッファをフレーム数分に区切り、先頭から線形に切り出す。
+/// 確保した領域はそのフレームの描画が終わるまで有効で、BeginFrameでまとめて解放される。
+/// </remarks>
+class ConstBufferAllocator {
+public:
+	// 1フレームあたりのデフォルト容量
+	static const size_t kDefaultCapacityPerFrame = 8 * 1024 * 1024;
+	// 定数バッファのアライメント
+	static const size_t kAlignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT;
+
+	/// <summary>
+	/// 確保した領域
+	/// </summary>
+	struct Allocation {
+		// 書き込み先アドレス(CPU)
+		void* cpuAddress = nullptr;
+		// GPU仮想アドレス
+		D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = 0;
+	};
+
+	/// <summary>
+	/// シングルトンインスタンスの取得
+	/// </summary>
+	/// <returns>シングルトンインスタンス</returns>
+	static ConstBufferAllocator* GetInstance();
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="device">デバイス</param>
+	/// <param name="frameCount">同時に使用されうるフレーム数</param>
+	/// <param name="capacityPerFrame">1フレームあたりの容量</param>
+	void Initialize(
+	    ID3D12Device* device, size_t frameCount = 2,
+	    size_t capacityPerFrame = kDefaultCapacityPerFrame);
+
+	/// <summary>
+	/// フレーム開始処理。前回同じ区画を使ったフレームの確保分を全て解放する
+	/// </summary>
+	void BeginFrame();
+
+	/// <summary>
+	/// 領域の確保（スレッドセーフ）
+	/// </summary>
+	/// <param name="size">サイズ</param>
+	/// <returns>確保した領域</returns>
+	Allocation Allocate(size_t size);
+
+	/// <summary>
+	/// データを確保した領域へ書き込む
+	/// </summary>
+	/// <param name="data">書き込むデータ</param>
+	/// <returns>GPU仮想アドレス</returns>
+	template<class T> D3D12_GPU_VIRTUAL_ADDRESS Push(const T& data) {
+		Allocation allocation = Allocate(sizeof(T));
+		std::memcpy(allocation.cpuAddress, &data, sizeof(T));
+		return allocation.gpuAddress;
+	}
+
+	/// <summary>
+	/// 今フレームの使用量を取得
+	/// </summary>
+	/// <returns>使用量（バイト）</returns>
+	size_t GetUsedSize() const { return offset_.load(std::memory_order_relaxed); }
+
+	/// <summary>
+	/// 1フレームあたりの容量を取得
+	/// </summary>
+	/// <returns>容量（バイト）</returns>
+	size_t GetCapacityPerFrame() const { return capacityPerFrame_; }
+
+private:
+	ConstBufferAllocator() = default;
+	~ConstBufferAllocator() = default;
+	ConstBufferAllocator(const ConstBufferAllocator&) = delete;
+	ConstBufferAllocator& operator=(const ConstBufferAllocator&) = delete;
+
+	// アップロードバッファ
+	Microsoft::WRL::ComPtr<ID3D12Resource> buffer_;
+	// マッピング済みアドレス
+	uint8_t* cpuBase_ = nullptr;
+	// GPU仮想アドレスの先頭
+	D3D12_GPU_VIRTUAL_ADDRESS gpuBase_ = 0;
+	// フレーム数
+	size_t frameCount_ = 0;
+	// 1フレームあたりの容量
+	size_t capacityPerFrame_ = 0;
+	// 現在のフレーム区画番号
+	size_t frameIndex_ = 0;
+	// 区画内の使用済みオフセット
+	std::atomic<size_t> offset_ = 0;
+};
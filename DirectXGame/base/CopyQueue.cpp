@@ -0,0 +1,224 @@
+#include "CopyQueue.h"
+#include <cassert>
+#include <cstring>
+#include <d3dx12.h>
+
+using namespace Microsoft::WRL;
+
+CopyQueue* CopyQueue::GetInstance() {
+	static CopyQueue instance;
+	return &instance;
+}
+
+void CopyQueue::Initialize(ID3D12Device* device) {
+	assert(device);
+
+	HRESULT result = S_FALSE;
+
+	device_ = device;
+
+	// コピー専用のコマンドキューを生成
+	D3D12_COMMAND_QUEUE_DESC queueDesc{};
+	queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+	result = device_->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&commandQueue_));
+	assert(SUCCEEDED(result));
+
+	// フェンスを生成
+	lastTicket_ = 0;
+	result = device_->CreateFence(lastTicket_, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence_));
+	assert(SUCCEEDED(result));
+}
+
+void CopyQueue::Finalize() {
+	Wait(lastTicket_);
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	inFlight_.clear();
+	freeSubmissions_.clear();
+}
+
+ComPtr<ID3D12Resource> CopyQueue::CreateBuffer(size_t size) {
+	ComPtr<ID3D12Resource> buffer;
+
+	// ヒーププロパティ
+	CD3DX12_HEAP_PROPERTIES heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+	// リソース設定
+	CD3DX12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+
+	// コピーキューで扱えるようCOMMON状態で生成
+	HRESULT result = device_->CreateCommittedResource(
+	    &heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_COMMON, nullptr,
+	    IID_PPV_ARGS(&buffer));
+	assert(SUCCEEDED(result));
+
+	return buffer;
+}
+
+CopyQueue::Ticket
+    CopyQueue::UploadBuffer(ID3D12Resource* destination, const void* data, size_t size) {
+	return UploadBuffer(destination, 0, data, size);
+}
+
+CopyQueue::Ticket CopyQueue::UploadBuffer(
+    ID3D12Resource* destination, uint64_t destinationOffset, const void* data, size_t size) {
+	assert(destination);
+	assert(data);
+
+	if (size == 0) {
+		return 0;
+	}
+
+	Submission submission = BeginSubmission(size);
+
+	// 中間バッファへ複製
+	void* map = nullptr;
+	HRESULT result = submission.uploadBuffer->Map(0, nullptr, &map);
+	assert(SUCCEEDED(result));
+	std::memcpy(map, data, size);
+	submission.uploadBuffer->Unmap(0, nullptr);
+
+	submission.commandList->CopyBufferRegion(
+	    destination, destinationOffset, submission.uploadBuffer.Get(), 0, size);
+
+	return EndSubmission(std::move(submission));
+}
+
+CopyQueue::Ticket CopyQueue::UploadTexture(
+    ID3D12Resource* destination, std::span<const D3D12_SUBRESOURCE_DATA> subresources) {
+	assert(destination);
+
+	if (subresources.empty()) {
+		return 0;
+	}
+
+	UINT subresourceCount = static_cast<UINT>(subresources.size());
+	UINT64 uploadSize = GetRequiredIntermediateSize(destination, 0, subresourceCount);
+
+	Submission submission = BeginSubmission(static_cast<size_t>(uploadSize));
+
+	// フットプリントに合わせて中間バッファへ複製し、コピー命令を積む
+	[[maybe_unused]] UINT64 copiedSize = UpdateSubresources(
+	    submission.commandList.Get(), destination, submission.uploadBuffer.Get(), 0, 0,
+	    subresourceCount, subresources.data());
+	assert(copiedSize != 0);
+
+	return EndSubmission(std::move(submission));
+}
+
+bool CopyQueue::IsCompleted(Ticket ticket) const {
+	// 0は転送なし
+	return ticket == 0 || ticket <= fence_->GetCompletedValue();
+}
+
+void CopyQueue::Wait(Ticket ticket) {
+	if (ticket == 0) {
+		return;
+	}
+
+	if (!IsCompleted(ticket)) {
+		HANDLE event = CreateEvent(nullptr, false, false, nullptr);
+		fence_->SetEventOnCompletion(ticket, event);
+		WaitForSingleObject(event, INFINITE);
+		CloseHandle(event);
+	}
+
+	Update();
+}
+
+void CopyQueue::Update() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	Retire();
+}
+
+CopyQueue::Submission CopyQueue::BeginSubmission(size_t uploadSize) {
+	HRESULT result = S_FALSE;
+
+	Submission submission;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		Retire();
+		if (!freeSubmissions_.empty()) {
+			// 中間バッファが足りるもののうち最小のもの（無ければ最大のもの）を使う
+			auto fits = [uploadSize](const Submission& s) {
+				return s.uploadBuffer && uploadSize <= s.uploadBuffer->GetDesc().Width;
+			};
+			auto size = [](const Submission& s) {
+				return s.uploadBuffer ? s.uploadBuffer->GetDesc().Width : 0;
+			};
+			auto best = freeSubmissions_.begin();
+			for (auto it = freeSubmissions_.begin(); it != freeSubmissions_.end(); ++it) {
+				bool isBetter = fits(*best) ? fits(*it) && size(*it) < size(*best)
+				                            : fits(*it) || size(*best) < size(*it);
+				if (isBetter) {
+					best = it;
+				}
+			}
+			submission = std::move(*best);
+			*best = std::move(freeSubmissions_.back());
+			freeSubmissions_.pop_back();
+		}
+	}
+
+	if (!submission.commandAllocator) {
+		// 足りなければ生成
+		result = device_->CreateCommandAllocator(
+		    D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&submission.commandAllocator));
+		assert(SUCCEEDED(result));
+		result = device_->CreateCommandList(
+		    0, D3D12_COMMAND_LIST_TYPE_COPY, submission.commandAllocator.Get(), nullptr,
+		    IID_PPV_ARGS(&submission.commandList));
+		assert(SUCCEEDED(result));
+	} else {
+		// 回収済みなのでGPUの実行は完了している
+		submission.commandAllocator->Reset();
+		submission.commandList->Reset(submission.commandAllocator.Get(), nullptr);
+	}
+
+	// 使い回す中間バッファが足りなければ作り直す
+	if (!submission.uploadBuffer || submission.uploadBuffer->GetDesc().Width < uploadSize) {
+		// 少しずつ大きさの違う転送でも使い回せるよう切り上げる
+		UINT64 bufferSize = (UINT64(uploadSize) + kUploadBufferAlignment - 1) &
+		                    ~UINT64(kUploadBufferAlignment - 1);
+		CD3DX12_HEAP_PROPERTIES heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+		CD3DX12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(bufferSize);
+		submission.uploadBuffer.Reset();
+		result = device_->CreateCommittedResource(
+		    &heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ,
+		    nullptr, IID_PPV_ARGS(&submission.uploadBuffer));
+		assert(SUCCEEDED(result));
+	}
+
+	return submission;
+}
+
+CopyQueue::Ticket CopyQueue::EndSubmission(Submission&& submission) {
+	// 命令のクローズ
+	submission.commandList->Close();
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	// チケットの順序とシグナルの順序を揃えるためロック中に実行する
+	ID3D12CommandList* cmdLists[] = {submission.commandList.Get()};
+	commandQueue_->ExecuteCommandLists(1, cmdLists);
+	submission.ticket = ++lastTicket_;
+	commandQueue_->Signal(fence_.Get(), submission.ticket);
+
+	Ticket ticket = submission.ticket;
+	inFlight_.push_back(std::move(submission));
+	return ticket;
+}
+
+void CopyQueue::Retire() {
+	UINT64 completedValue = fence_->GetCompletedValue();
+	// チケットは発行順なので先頭から見ればよい
+	while (!inFlight_.empty() && inFlight_.front().ticket <= completedValue) {
+		Submission& submission = inFlight_.front();
+		// 大きな中間バッファは持ち続けると無駄なので解放する
+		if (submission.uploadBuffer &&
+		    kMaxPooledUploadBufferSize < submission.uploadBuffer->GetDesc().Width) {
+			submission.uploadBuffer.Reset();
+		}
+		freeSubmissions_.push_back(std::move(submission));
+		inFlight_.pop_front();
+	}
+}
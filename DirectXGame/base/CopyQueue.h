@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <d3d12.h>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <vector>
+#include <wrl.h>
+
+/// <summary>
+/// コピー専用キューによる非同期アップロード
+/// </summary>
+/// <remarks>
+/// 転送先はDEFAULTヒープのCOMMON状態のリソースとする。コピー完了後はCOMMONに戻るため、
+/// 描画キューでは暗黙の状態昇格で頂点・インデックス・シェーダリソースとして読める。
+/// 転送が完了するまで（IsCompletedがtrueになるまで）そのリソースを描画に使わないこと。
+/// </remarks>
+class CopyQueue {
+public:
+	/// <summary>
+	/// 転送完了の目印（フェンス値）。0は完了済みを表す
+	/// </summary>
+	using Ticket = uint64_t;
+
+	/// <summary>
+	/// シングルトンインスタンスの取得
+	/// </summary>
+	/// <returns>シングルトンインスタンス</returns>
+	static CopyQueue* GetInstance();
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="device">デバイス</param>
+	void Initialize(ID3D12Device* device);
+
+	/// <summary>
+	/// 終了処理。全ての転送の完了を待つ
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// 転送先バッファの生成（DEFAULTヒープ、COMMON状態）
+	/// </summary>
+	/// <param name="size">サイズ</param>
+	/// <returns>バッファ</returns>
+	Microsoft::WRL::ComPtr<ID3D12Resource> CreateBuffer(size_t size);
+
+	/// <summary>
+	/// バッファへの転送（スレッドセーフ）。データはこの関数内で複製される
+	/// </summary>
+	/// <param name="destination">転送先（COMMON状態）</param>
+	/// <param name="data">データ</param>
+	/// <param name="size">サイズ</param>
+	/// <returns>チケット</returns>
+	Ticket UploadBuffer(ID3D12Resource* destination, const void* data, size_t size);
+
+	/// <summary>
+	/// バッファの一部への転送（スレッドセーフ）。データはこの関数内で複製される
+	/// </summary>
+	/// <param name="destination">転送先（COMMON状態）</param>
+	/// <param name="destinationOffset">転送先の先頭からのオフセット</param>
+	/// <param name="data">データ</param>
+	/// <param name="size">サイズ</param>
+	/// <returns>チケット</returns>
+	Ticket UploadBuffer(
+	    ID3D12Resource* destination, uint64_t destinationOffset, const void* data, size_t size);
+
+	/// <summary>
+	/// テクスチャへの転送（スレッドセーフ）。データはこの関数内で複製される
+	/// </summary>
+	/// <param name="destination">転送先（COMMON状態）</param>
+	/// <param name="subresources">サブリソースごとのデータ</param>
+	/// <returns>チケット</returns>
+	Ticket UploadTexture(
+	    ID3D12Resource* destination, std::span<const D3D12_SUBRESOURCE_DATA> subresources);
+
+	/// <summary>
+	/// 転送が完了したか
+	/// </summary>
+	/// <param name="ticket">チケット</param>
+	/// <returns>完了していればtrue</returns>
+	bool IsCompleted(Ticket ticket) const;
+
+	/// <summary>
+	/// 転送の完了を待つ
+	/// </summary>
+	/// <param name="ticket">チケット</param>
+	void Wait(Ticket ticket);
+
+	/// <summary>
+	/// 毎フレーム処理。完了した転送のコマンドリストと中間バッファを回収して使い回す
+	/// </summary>
+	void Update();
+
+private:
+	/// <summary>
+	/// 1回分の転送
+	/// </summary>
+	struct Submission {
+		// コマンドアロケータ
+		Microsoft::WRL::ComPtr<ID3D12CommandAllocator> commandAllocator;
+		// コマンドリスト
+		Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList;
+		// 中間バッファ（UPLOADヒープ、回収後も使い回す）
+		Microsoft::WRL::ComPtr<ID3D12Resource> uploadBuffer;
+		// 完了時のフェンス値
+		Ticket ticket = 0;
+	};
+
+	// 中間バッファのサイズの切り上げ単位
+	static constexpr size_t kUploadBufferAlignment = 64 * 1024;
+	// 使い回す中間バッファの最大サイズ（大きなテクスチャ用のものは回収時に解放する）
+	static constexpr UINT64 kMaxPooledUploadBufferSize = 16 * 1024 * 1024;
+
+	CopyQueue() = default;
+	~CopyQueue() = default;
+	CopyQueue(const CopyQueue&) = delete;
+	CopyQueue& operator=(const CopyQueue&) = delete;
+
+	/// <summary>
+	/// 記録可能な転送を取り出す
+	/// </summary>
+	Submission BeginSubmission(size_t uploadSize);
+
+	/// <summary>
+	/// 記録した転送をキューに積む
+	/// </summary>
+	Ticket EndSubmission(Submission&& submission);
+
+	/// <summary>
+	/// 完了した転送を回収する（要ロック）
+	/// </summary>
+	void Retire();
+
+	// デバイス
+	ID3D12Device* device_ = nullptr;
+	// コピーキュー
+	Microsoft::WRL::ComPtr<ID3D12CommandQueue> commandQueue_;
+	// フェンス
+	Microsoft::WRL::ComPtr<ID3D12Fence> fence_;
+	// 最後に発行したチケット
+	Ticket lastTicket_ = 0;
+	// 転送中
+	std::deque<Submission> inFlight_;
+	// 再利用待ち
+	std::vector<Submission> freeSubmissions_;
+	// 排他制御
+	std::mutex mutex_;
+};
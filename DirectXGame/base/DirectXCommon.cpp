@@ -157,6 +157,16 @@ void DirectXCommon::PostDraw() {
 
 	commandAllocator_->Reset();
 	commandList_->Reset(commandAllocator_.Get(), nullptr);
+
+	// 並列記録で使ったアロケータも実行完了しているのでリセット
+	for (size_t i = 0; i < parallelCommandListUsed_; i++) {
+		parallelCommandAllocators_[i]->Reset();
+	}
+	for (size_t i = 0; i < resumeCommandAllocatorUsed_; i++) {
+		resumeCommandAllocators_[i]->Reset();
+	}
+	parallelCommandListUsed_ = 0;
+	resumeCommandAllocatorUsed_ = 0;
 }
 
 void DirectXCommon::ClearRenderTarget() {
@@ -185,6 +195,8 @@ int32_t DirectXCommon::GetBackBufferWidth() const { return backBufferWidth_; }
 int32_t DirectXCommon::GetBackBufferHeight() const { return backBufferHeight_; }
 
 void DirectXCommon::SetRenderTargets(bool sRGB) {
+	isSRGBRenderTarget_ = sRGB;
+
 	// バックバッファの番号を取得（2つなので0番か1番）
 	UINT bbIndex = swapChain_->GetCurrentBackBufferIndex();
 	UINT rtvIndex = sRGB ? bbIndex : bbIndex + kLinearRTVStart;
@@ -200,6 +212,100 @@ void DirectXCommon::SetRenderTargets(bool sRGB) {
 	commandList_->OMSetRenderTargets(1, &rtvH, false, &dsvH);
 }
 
+std::span<ID3D12GraphicsCommandList* const>
+    DirectXCommon::BeginParallelRecording(uint32_t count) {
+	// 入れ子にはできない
+	assert(recordingCommandLists_.empty());
+	assert(0 < count);
+
+	HRESULT result = S_FALSE;
+
+	// 足りない分のコマンドアロケータとコマンドリストを生成
+	while (parallelCommandLists_.size() < parallelCommandListUsed_ + count) {
+		ComPtr<ID3D12CommandAllocator> commandAllocator;
+		result = device_->CreateCommandAllocator(
+		    D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&commandAllocator));
+		assert(SUCCEEDED(result));
+
+		ComPtr<ID3D12GraphicsCommandList> commandList;
+		result = device_->CreateCommandList(
+		    0, D3D12_COMMAND_LIST_TYPE_DIRECT, commandAllocator.Get(), nullptr,
+		    IID_PPV_ARGS(&commandList));
+		assert(SUCCEEDED(result));
+		// 生成直後は記録状態なので一旦閉じる
+		commandList->Close();
+
+		parallelCommandAllocators_.push_back(commandAllocator);
+		parallelCommandLists_.push_back(commandList);
+	}
+
+	// 記録開始
+	for (uint32_t i = 0; i < count; i++) {
+		size_t index = parallelCommandListUsed_ + i;
+		ID3D12GraphicsCommandList* commandList = parallelCommandLists_[index].Get();
+		commandList->Reset(parallelCommandAllocators_[index].Get(), nullptr);
+		RestoreRenderState(commandList);
+		recordingCommandLists_.push_back(commandList);
+	}
+	parallelCommandListUsed_ += count;
+
+	return recordingCommandLists_;
+}
+
+void DirectXCommon::EndParallelRecording() {
+	// BeginParallelRecordingと対で呼ぶこと
+	assert(!recordingCommandLists_.empty());
+
+	HRESULT result = S_FALSE;
+
+	// メインのコマンドリストはここまでで閉じる
+	commandList_->Close();
+	for (ID3D12GraphicsCommandList* commandList : recordingCommandLists_) {
+		commandList->Close();
+	}
+
+	// メイン→並列記録分の順に1回で実行
+	std::vector<ID3D12CommandList*> cmdLists;
+	cmdLists.reserve(recordingCommandLists_.size() + 1);
+	cmdLists.push_back(commandList_.Get());
+	cmdLists.insert(cmdLists.end(), recordingCommandLists_.begin(), recordingCommandLists_.end());
+	commandQueue_->ExecuteCommandLists(static_cast<UINT>(cmdLists.size()), cmdLists.data());
+	recordingCommandLists_.clear();
+
+	// 実行中のアロケータは使えないので、別のアロケータでメインの記録を再開する
+	if (resumeCommandAllocators_.size() <= resumeCommandAllocatorUsed_) {
+		ComPtr<ID3D12CommandAllocator> commandAllocator;
+		result = device_->CreateCommandAllocator(
+		    D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&commandAllocator));
+		assert(SUCCEEDED(result));
+		resumeCommandAllocators_.push_back(commandAllocator);
+	}
+	commandList_->Reset(resumeCommandAllocators_[resumeCommandAllocatorUsed_++].Get(), nullptr);
+	RestoreRenderState(commandList_.Get());
+}
+
+void DirectXCommon::RestoreRenderState(ID3D12GraphicsCommandList* commandList) {
+	// バックバッファの番号を取得（2つなので0番か1番）
+	UINT bbIndex = swapChain_->GetCurrentBackBufferIndex();
+	UINT rtvIndex = isSRGBRenderTarget_ ? bbIndex : bbIndex + kLinearRTVStart;
+
+	// レンダーターゲットをセット
+	CD3DX12_CPU_DESCRIPTOR_HANDLE rtvH = CD3DX12_CPU_DESCRIPTOR_HANDLE(
+	    rtvHeap_->GetCPUDescriptorHandleForHeapStart(), rtvIndex,
+	    device_->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV));
+	CD3DX12_CPU_DESCRIPTOR_HANDLE dsvH =
+	    CD3DX12_CPU_DESCRIPTOR_HANDLE(dsvHeap_->GetCPUDescriptorHandleForHeapStart());
+	commandList->OMSetRenderTargets(1, &rtvH, false, &dsvH);
+
+	// ビューポートの設定
+	CD3DX12_VIEWPORT viewport =
+	    CD3DX12_VIEWPORT(0.0f, 0.0f, float(backBufferWidth_), float(backBufferHeight_));
+	commandList->RSSetViewports(1, &viewport);
+	// シザリング矩形の設定
+	CD3DX12_RECT rect = CD3DX12_RECT(0, 0, backBufferWidth_, backBufferHeight_);
+	commandList->RSSetScissorRects(1, &rect);
+}
+
 void DirectXCommon::InitializeDXGIDevice([[maybe_unused]] bool enableDebugLayer) {
 	HRESULT result = S_FALSE;
 
@@ -6,6 +6,8 @@
 #include <d3d12.h>
 #include <d3dx12.h>
 #include <dxgi1_6.h>
+#include <span>
+#include <vector>
 #include <wrl.h>
 
 #include "WinApp.h"
@@ -77,6 +79,27 @@ public: // メンバ関数
 
 	void SetRenderTargets(bool sRGB);
 
+	/// <summary>
+	/// 並列記録の開始。ワーカースレッド用のコマンドリストを用意する
+	/// </summary>
+	/// <param name="count">コマンドリストの数</param>
+	/// <returns>記録可能状態のコマンドリスト（レンダーターゲット・ビューポート設定済み）</returns>
+	/// <remarks>
+	/// 各コマンドリストへの記録は別スレッドから並行して行ってよい。
+	/// EndParallelRecordingまでメインのコマンドリストには記録しないこと
+	/// </remarks>
+	std::span<ID3D12GraphicsCommandList* const> BeginParallelRecording(uint32_t count);
+
+	/// <summary>
+	/// 並列記録の終了。それまでのメインのコマンドリストに続けて、
+	/// 並列記録したコマンドリストを番号順に1回のExecuteCommandListsで実行する
+	/// </summary>
+	/// <remarks>
+	/// メインのコマンドリストは別のアロケータで記録を再開する。
+	/// レンダーターゲット・ビューポート以外のステートは引き継がれないので、描画前処理からやり直すこと
+	/// </remarks>
+	void EndParallelRecording();
+
 private: // メンバ変数
 	// ウィンドウズアプリケーション管理
 	WinApp* winApp_;
@@ -99,6 +122,19 @@ private: // メンバ変数
 	HANDLE frameLatencyWaitableObject_;
 	std::chrono::steady_clock::time_point reference_;
 	int32_t refreshRate_ = 0;
+	// 現在のレンダーターゲットがSRGBか
+	bool isSRGBRenderTarget_ = true;
+	// 並列記録用コマンドアロケータ・コマンドリスト（フレーム内で使った分だけ先頭から消費）
+	std::vector<Microsoft::WRL::ComPtr<ID3D12CommandAllocator>> parallelCommandAllocators_;
+	std::vector<Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList>> parallelCommandLists_;
+	// 記録中の並列コマンドリスト
+	std::vector<ID3D12GraphicsCommandList*> recordingCommandLists_;
+	// 今フレームで使った並列コマンドリストの数
+	size_t parallelCommandListUsed_ = 0;
+	// メインのコマンドリスト再開用アロケータ（並列記録1回につき1つ）
+	std::vector<Microsoft::WRL::ComPtr<ID3D12CommandAllocator>> resumeCommandAllocators_;
+	// 今フレームで使った再開用アロケータの数
+	size_t resumeCommandAllocatorUsed_ = 0;
 
 private: // メンバ関数
 	DirectXCommon() = default;
@@ -135,4 +171,10 @@ private: // メンバ関数
 	/// フェンス生成
 	/// </summary>
 	void CreateFence();
+
+	/// <summary>
+	/// レンダーターゲット・ビューポート・シザー矩形を設定し直す
+	/// </summary>
+	/// <param name="commandList">コマンドリスト</param>
+	void RestoreRenderState(ID3D12GraphicsCommandList* commandList);
 };
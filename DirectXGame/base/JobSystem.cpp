@@ -0,0 +1,126 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+JobSystem* JobSystem::GetInstance() {
+	static JobSystem instance;
+	return &instance;
+}
+
+void JobSystem::Initialize(uint32_t workerCount) {
+	// 多重初期化禁止
+	assert(workers_.empty());
+
+	if (workerCount == 0) {
+		uint32_t hardwareConcurrency = std::thread::hardware_concurrency();
+		workerCount = hardwareConcurrency > 1 ? hardwareConcurrency - 1 : 0;
+	}
+
+	isExit_ = false;
+	workers_.reserve(workerCount);
+	for (uint32_t i = 0; i < workerCount; i++) {
+		workers_.emplace_back(&JobSystem::WorkerMain, this);
+	}
+}
+
+void JobSystem::Finalize() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		isExit_ = true;
+	}
+	condition_.notify_all();
+	for (std::thread& worker : workers_) {
+		worker.join();
+	}
+	workers_.clear();
+}
+
+void JobSystem::ParallelFor(
+    size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& func) {
+	if (count == 0) {
+		return;
+	}
+	grainSize = std::max<size_t>(grainSize, 1);
+	size_t chunkCount = (count + grainSize - 1) / grainSize;
+
+	// 1チャンクしかない、またはワーカーがいなければその場で処理
+	if (chunkCount == 1 || workers_.empty()) {
+		for (size_t begin = 0; begin < count; begin += grainSize) {
+			func(begin, std::min(begin + grainSize, count));
+		}
+		return;
+	}
+
+	// 手伝いに来たワーカーが呼び出し元より長生きしても良いように共有する
+	struct Context {
+		std::atomic<size_t> nextChunk = 0;
+		std::atomic<size_t> finishedChunk = 0;
+		size_t chunkCount = 0;
+		size_t count = 0;
+		size_t grainSize = 0;
+		const std::function<void(size_t, size_t)>* func = nullptr;
+		std::mutex mutex;
+		std::condition_variable condition;
+	};
+	auto context = std::make_shared<Context>();
+	context->chunkCount = chunkCount;
+	context->count = count;
+	context->grainSize = grainSize;
+	context->func = &func;
+
+	// 空いているチャンクを取り合って処理する
+	auto work = [](Context& ctx) {
+		size_t finished = 0;
+		for (;;) {
+			size_t chunk = ctx.nextChunk.fetch_add(1);
+			if (ctx.chunkCount <= chunk) {
+				break;
+			}
+			size_t begin = chunk * ctx.grainSize;
+			(*ctx.func)(begin, std::min(begin + ctx.grainSize, ctx.count));
+			finished++;
+		}
+		if (finished != 0 && ctx.finishedChunk.fetch_add(finished) + finished == ctx.chunkCount) {
+			std::lock_guard<std::mutex> lock(ctx.mutex);
+			ctx.condition.notify_all();
+		}
+	};
+
+	size_t helperCount = std::min(workers_.size(), chunkCount - 1);
+	for (size_t i = 0; i < helperCount; i++) {
+		Enqueue([context, work]() { work(*context); });
+	}
+
+	// 呼び出し元も処理に参加する
+	work(*context);
+
+	std::unique_lock<std::mutex> lock(context->mutex);
+	context->condition.wait(
+	    lock, [&context]() { return context->finishedChunk.load() == context->chunkCount; });
+}
+
+void JobSystem::Enqueue(std::function<void()> job) {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		jobs_.push_back(std::move(job));
+	}
+	condition_.notify_one();
+}
+
+void JobSystem::WorkerMain() {
+	for (;;) {
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			condition_.wait(lock, [this]() { return isExit_ || !jobs_.empty(); });
+			if (jobs_.empty()) {
+				// 終了要求かつキューが空
+				return;
+			}
+			job = std::move(jobs_.front());
+			jobs_.pop_front();
+		}
+		job();
+	}
+}
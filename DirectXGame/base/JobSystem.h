@@ -0,0 +1,95 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/// <summary>
+/// ワーカースレッドによるジョブ実行
+/// </summary>
+class JobSystem {
+public:
+	/// <summary>
+	/// シングルトンインスタンスの取得
+	/// </summary>
+	/// <returns>シングルトンインスタンス</returns>
+	static JobSystem* GetInstance();
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="workerCount">ワーカースレッド数（0なら論理コア数-1）</param>
+	void Initialize(uint32_t workerCount = 0);
+
+	/// <summary>
+	/// 終了処理。キューに残ったジョブを実行してからスレッドを止める
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// 並列実行に参加するスレッド数（ワーカー＋呼び出し元）
+	/// </summary>
+	/// <returns>スレッド数</returns>
+	uint32_t GetConcurrency() const { return static_cast<uint32_t>(workers_.size()) + 1; }
+
+	/// <summary>
+	/// [0, count)をgrainSize個ずつに分けて並列に処理する。全て終わるまで戻らない
+	/// </summary>
+	/// <param name="count">要素数</param>
+	/// <param name="grainSize">1回の呼び出しで処理する最大要素数</param>
+	/// <param name="func">処理 func(begin, end)</param>
+	void ParallelFor(
+	    size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& func);
+
+	/// <summary>
+	/// ジョブを非同期に実行する
+	/// </summary>
+	/// <param name="func">処理</param>
+	/// <returns>結果を受け取るfuture</returns>
+	template<class F> std::future<std::invoke_result_t<F>> Submit(F&& func) {
+		using Result = std::invoke_result_t<F>;
+		auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(func));
+		std::future<Result> future = task->get_future();
+		if (workers_.empty()) {
+			// ワーカーがいなければその場で実行
+			(*task)();
+		} else {
+			Enqueue([task]() { (*task)(); });
+		}
+		return future;
+	}
+
+private:
+	JobSystem() = default;
+	~JobSystem() { Finalize(); }
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	/// <summary>
+	/// ジョブをキューに積む
+	/// </summary>
+	void Enqueue(std::function<void()> job);
+
+	/// <summary>
+	/// ワーカースレッドの処理
+	/// </summary>
+	void WorkerMain();
+
+	// ワーカースレッド
+	std::vector<std::thread> workers_;
+	// ジョブキュー
+	std::deque<std::function<void()>> jobs_;
+	// キューの排他制御
+	std::mutex mutex_;
+	// ジョブ到着通知
+	std::condition_variable condition_;
+	// 終了要求
+	bool isExit_ = false;
+};
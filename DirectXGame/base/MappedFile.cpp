@@ -0,0 +1,109 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include "StringUtility.h"
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& filePath) {
+	Close();
+
+	HANDLE file = CreateFileW(
+	    ConvertStringMultiByteToWide(filePath).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+	    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	file_ = file;
+	isOpen_ = true;
+
+	LARGE_INTEGER size{};
+	if (!GetFileSizeEx(file, &size)) {
+		Close();
+		return false;
+	}
+	size_ = static_cast<size_t>(size.QuadPart);
+	// 空のファイルはマッピングを作れないので、開いただけにする
+	if (size_ == 0) {
+		return true;
+	}
+
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr) {
+		Close();
+		return false;
+	}
+	mapping_ = mapping;
+
+	data_ = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (data_ == nullptr) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void MappedFile::Close() {
+	if (data_) {
+		UnmapViewOfFile(data_);
+	}
+	if (mapping_) {
+		CloseHandle(mapping_);
+	}
+	if (file_) {
+		CloseHandle(file_);
+	}
+	data_ = nullptr;
+	mapping_ = nullptr;
+	file_ = nullptr;
+	size_ = 0;
+	isOpen_ = false;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& filePath) {
+	Close();
+
+	int file = open(filePath.c_str(), O_RDONLY);
+	if (file < 0) {
+		return false;
+	}
+	struct stat status {};
+	if (fstat(file, &status) != 0) {
+		close(file);
+		return false;
+	}
+	size_ = static_cast<size_t>(status.st_size);
+	if (0 < size_) {
+		void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file, 0);
+		if (data == MAP_FAILED) {
+			close(file);
+			size_ = 0;
+			return false;
+		}
+		data_ = static_cast<const char*>(data);
+	}
+	// 割り当て後はファイル記述子が不要
+	close(file);
+	isOpen_ = true;
+	return true;
+}
+
+void MappedFile::Close() {
+	if (data_) {
+		munmap(const_cast<char*>(data_), size_);
+	}
+	data_ = nullptr;
+	size_ = 0;
+	isOpen_ = false;
+}
+
+#endif
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/// <summary>
+/// 読み取り専用のメモリマップトファイル
+/// </summary>
+/// <remarks>
+/// ファイルの内容をコピーせずにアドレス空間へ割り当てる。閉じるまでGetDataの指す内容は有効。
+/// </remarks>
+class MappedFile {
+public: // メンバ関数
+	MappedFile() = default;
+	~MappedFile() { Close(); }
+
+	/// <summary>
+	/// ファイルを開いて割り当てる
+	/// </summary>
+	/// <param name="filePath">ファイルパス</param>
+	/// <returns>成否</returns>
+	bool Open(const std::string& filePath);
+
+	/// <summary>
+	/// 割り当てを解除して閉じる
+	/// </summary>
+	void Close();
+
+	/// <summary>
+	/// 開いているか
+	/// </summary>
+	bool IsOpen() const { return isOpen_; }
+
+	/// <summary>
+	/// 先頭アドレスの取得（空のファイルならnullptr）
+	/// </summary>
+	const char* GetData() const { return data_; }
+
+	/// <summary>
+	/// バイト数の取得
+	/// </summary>
+	size_t GetSize() const { return size_; }
+
+	/// <summary>
+	/// 内容を文字列として取得
+	/// </summary>
+	std::string_view GetText() const { return {data_, size_}; }
+
+private: // メンバ変数
+	// 先頭アドレス
+	const char* data_ = nullptr;
+	// バイト数
+	size_t size_ = 0;
+	// 開いているか
+	bool isOpen_ = false;
+#ifdef _WIN32
+	// ファイルハンドル
+	void* file_ = nullptr;
+	// ファイルマッピングハンドル
+	void* mapping_ = nullptr;
+#endif
+
+	// コピー禁止
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+};
@@ -0,0 +1,201 @@
+#include "TextureLoader.h"
+#include "StringUtility.h"
+#include <DirectXTex.h>
+#include <algorithm>
+#include <cassert>
+#include <format>
+
+using namespace DirectX;
+
+uint32_t TextureLoader::LoadAsync(const std::string& fileName) {
+	return TextureLoader::GetInstance()->LoadInternal(fileName);
+}
+
+bool TextureLoader::Unload(uint32_t textureHandle) {
+	return TextureLoader::GetInstance()->UnloadInternal(textureHandle);
+}
+
+TextureLoader* TextureLoader::GetInstance() {
+	static TextureLoader instance;
+	return &instance;
+}
+
+void TextureLoader::Initialize(ID3D12Device* device, std::string directoryPath) {
+	assert(device);
+
+	device_ = device;
+	directoryPath_ = directoryPath;
+
+	// デスクリプタサイズを取得
+	descriptorHandleIncrementSize_ =
+	    device_->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+	// TextureManagerとは別のデスクリプタヒープを生成
+	D3D12_DESCRIPTOR_HEAP_DESC descHeapDesc = {};
+	descHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+	descHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+	descHeapDesc.NumDescriptors = kNumDescriptors;
+	HRESULT result = device_->CreateDescriptorHeap(&descHeapDesc, IID_PPV_ARGS(&descriptorHeap_));
+	assert(SUCCEEDED(result));
+
+	textures_.assign(kNumDescriptors, {});
+}
+
+void TextureLoader::Finalize() {
+	for (uint32_t i = 0; i < textures_.size(); i++) {
+		if (!textures_[i].name.empty()) {
+			UnloadInternal(i);
+		}
+	}
+	textures_.clear();
+	descriptorHeap_.Reset();
+}
+
+bool TextureLoader::IsLoaded(uint32_t textureHandle) const {
+	assert(textureHandle < textures_.size());
+	return CopyQueue::GetInstance()->IsCompleted(textures_[textureHandle].ticket);
+}
+
+void TextureLoader::WaitLoaded(uint32_t textureHandle) {
+	assert(textureHandle < textures_.size());
+	CopyQueue::GetInstance()->Wait(textures_[textureHandle].ticket);
+}
+
+const D3D12_RESOURCE_DESC TextureLoader::GetResoureDesc(uint32_t textureHandle) {
+	assert(textureHandle < textures_.size());
+	return textures_[textureHandle].resource->GetDesc();
+}
+
+void TextureLoader::SetGraphicsRootDescriptorTable(
+    ID3D12GraphicsCommandList* commandList, UINT rootParamIndex, uint32_t textureHandle) {
+	assert(textureHandle < textures_.size());
+	// 転送が終わっていないテクスチャは読めない
+	assert(IsLoaded(textureHandle));
+
+	ID3D12DescriptorHeap* ppHeaps[] = {descriptorHeap_.Get()};
+	commandList->SetDescriptorHeaps(_countof(ppHeaps), ppHeaps);
+
+	// シェーダリソースビューをセット
+	commandList->SetGraphicsRootDescriptorTable(
+	    rootParamIndex, textures_[textureHandle].gpuDescHandleSRV);
+}
+
+uint32_t TextureLoader::LoadInternal(const std::string& fileName) {
+	// 読み込み済みテクスチャを検索
+	uint32_t handle = Find(fileName);
+	if (handle < kNumDescriptors) {
+		return handle;
+	}
+
+	ScratchImage scratchImg{};
+	Decode(fileName, scratchImg);
+	return Create(fileName, scratchImg);
+}
+
+bool TextureLoader::UnloadInternal(uint32_t textureHandle) {
+	// 範囲外
+	if (textures_.size() <= textureHandle) {
+		return false;
+	}
+
+	Texture& texture = textures_[textureHandle];
+	// 範囲内だけど読んでない場所
+	assert(!texture.name.empty());
+
+	// 転送中のリソースは解放できない
+	CopyQueue::GetInstance()->Wait(texture.ticket);
+
+	texture = {};
+	return true;
+}
+
+uint32_t TextureLoader::Find(const std::string& fileName) const {
+	auto it = std::find_if(textures_.begin(), textures_.end(), [&](const Texture& texture) {
+		return texture.name == fileName;
+	});
+	return it == textures_.end() ? uint32_t(kNumDescriptors)
+	                             : static_cast<uint32_t>(std::distance(textures_.begin(), it));
+}
+
+void TextureLoader::Decode(const std::string& fileName, ScratchImage& scratchImg) const {
+	// ディレクトリパスとファイル名を連結してフルパスを得る
+	bool currentRelative = false;
+	if (2 < fileName.size()) {
+		currentRelative = (fileName[0] == '.') && (fileName[1] == '/');
+	}
+	std::string fullPath = currentRelative ? fileName : directoryPath_ + fileName;
+
+	// WICテクスチャのロード
+	TexMetadata metadata{};
+	HRESULT result = LoadFromWICFile(
+	    ConvertStringMultiByteToWide(fullPath).c_str(), WIC_FLAGS_NONE, &metadata, scratchImg);
+	if (FAILED(result)) {
+		auto message = std::format(
+		    L"テクスチャ「{0}」"
+		    "の読み込みに失敗しました。\n指定したパスが正しいか、必須リソースのコピー"
+		    "を忘れていないか確認してください。",
+		    ConvertStringMultiByteToWide(fileName));
+		MessageBoxW(nullptr, message.c_str(), L"Not found texture", 0);
+		assert(false);
+		exit(1);
+	}
+
+	// ミップマップ生成
+	ScratchImage mipChain{};
+	result = GenerateMipMaps(
+	    scratchImg.GetImages(), scratchImg.GetImageCount(), scratchImg.GetMetadata(),
+	    TEX_FILTER_DEFAULT, 0, mipChain);
+	if (SUCCEEDED(result)) {
+		scratchImg = std::move(mipChain);
+	}
+}
+
+uint32_t TextureLoader::Create(const std::string& fileName, const ScratchImage& scratchImg) {
+	// 空いているテクスチャの参照
+	uint32_t handle = Find({});
+	assert(handle < kNumDescriptors);
+
+	Texture& texture = textures_[handle];
+	texture.name = fileName;
+
+	// 読み込んだディフューズテクスチャをSRGBとして扱う
+	TexMetadata metadata = scratchImg.GetMetadata();
+	metadata.format = MakeSRGB(metadata.format);
+
+	// DEFAULTヒープにCOMMON状態で生成し、コピーキューで転送する
+	CD3DX12_HEAP_PROPERTIES heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+	CD3DX12_RESOURCE_DESC texresDesc = CD3DX12_RESOURCE_DESC::Tex2D(
+	    metadata.format, metadata.width, (UINT)metadata.height, (UINT16)metadata.arraySize,
+	    (UINT16)metadata.mipLevels);
+	HRESULT result = device_->CreateCommittedResource(
+	    &heapProps, D3D12_HEAP_FLAG_NONE, &texresDesc, D3D12_RESOURCE_STATE_COMMON, nullptr,
+	    IID_PPV_ARGS(&texture.resource));
+	assert(SUCCEEDED(result));
+
+	std::vector<D3D12_SUBRESOURCE_DATA> subresources(metadata.mipLevels);
+	for (size_t i = 0; i < metadata.mipLevels; i++) {
+		const Image* img = scratchImg.GetImage(i, 0, 0); // 生データ抽出
+		subresources[i].pData = img->pixels;
+		subresources[i].RowPitch = static_cast<LONG_PTR>(img->rowPitch);
+		subresources[i].SlicePitch = static_cast<LONG_PTR>(img->slicePitch);
+	}
+	// 画像はUploadTexture内で中間バッファへ複製される
+	texture.ticket = CopyQueue::GetInstance()->UploadTexture(texture.resource.Get(), subresources);
+
+	// シェーダリソースビュー作成
+	texture.cpuDescHandleSRV = CD3DX12_CPU_DESCRIPTOR_HANDLE(
+	    descriptorHeap_->GetCPUDescriptorHandleForHeapStart(), handle,
+	    descriptorHandleIncrementSize_);
+	texture.gpuDescHandleSRV = CD3DX12_GPU_DESCRIPTOR_HANDLE(
+	    descriptorHeap_->GetGPUDescriptorHandleForHeapStart(), handle,
+	    descriptorHandleIncrementSize_);
+
+	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+	srvDesc.Format = metadata.format;
+	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+	srvDesc.Texture2D.MipLevels = (UINT)metadata.mipLevels;
+	device_->CreateShaderResourceView(texture.resource.Get(), &srvDesc, texture.cpuDescHandleSRV);
+
+	return handle;
+}
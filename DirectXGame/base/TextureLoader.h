@@ -0,0 +1,151 @@
+#pragma once
+
+#include "CopyQueue.h"
+#include <d3dx12.h>
+#include <string>
+#include <vector>
+#include <wrl.h>
+
+namespace DirectX {
+class ScratchImage;
+}
+
+/// <summary>
+/// コピーキューを使う非同期テクスチャローダー
+/// </summary>
+/// <remarks>
+/// TextureManagerとは別のデスクリプタヒープを持ち、ハンドルも別の番号になる。
+/// テクスチャはDEFAULTヒープに置き、コピーキューで転送する。
+/// 転送が完了するまで（IsLoadedがtrueになるまで）描画に使わないこと。
+/// </remarks>
+class TextureLoader {
+public:
+	// デスクリプターの数
+	static const size_t kNumDescriptors = 256;
+
+	/// <summary>
+	/// テクスチャ
+	/// </summary>
+	struct Texture {
+		// テクスチャリソース
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+		// シェーダリソースビューのハンドル(CPU)
+		CD3DX12_CPU_DESCRIPTOR_HANDLE cpuDescHandleSRV;
+		// シェーダリソースビューのハンドル(GPU)
+		CD3DX12_GPU_DESCRIPTOR_HANDLE gpuDescHandleSRV;
+		// 名前
+		std::string name;
+		// 転送完了のチケット
+		CopyQueue::Ticket ticket = 0;
+	};
+
+	/// <summary>
+	/// 非同期読み込み。デコードは呼び出し元のスレッドで行い、転送だけを非同期にする
+	/// </summary>
+	/// <param name="fileName">ファイル名</param>
+	/// <returns>テクスチャハンドル</returns>
+	static uint32_t LoadAsync(const std::string& fileName);
+
+	/// <summary>
+	/// 読み込み解除。転送中なら完了を待つ
+	/// </summary>
+	/// <param name="textureHandle">テクスチャハンドル</param>
+	static bool Unload(uint32_t textureHandle);
+
+	/// <summary>
+	/// シングルトンインスタンスの取得
+	/// </summary>
+	/// <returns>シングルトンインスタンス</returns>
+	static TextureLoader* GetInstance();
+
+	/// <summary>
+	/// システム初期化
+	/// </summary>
+	/// <param name="device">デバイス</param>
+	void Initialize(ID3D12Device* device, std::string directoryPath = "Resources/");
+
+	/// <summary>
+	/// 終了処理。転送の完了を待って全テクスチャを解放する
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// 転送が完了したか
+	/// </summary>
+	/// <param name="textureHandle">テクスチャハンドル</param>
+	/// <returns>描画に使えるならtrue</returns>
+	bool IsLoaded(uint32_t textureHandle) const;
+
+	/// <summary>
+	/// 転送の完了を待つ
+	/// </summary>
+	/// <param name="textureHandle">テクスチャハンドル</param>
+	void WaitLoaded(uint32_t textureHandle);
+
+	/// <summary>
+	/// リソース情報取得
+	/// </summary>
+	/// <param name="textureHandle">テクスチャハンドル</param>
+	/// <returns>リソース情報</returns>
+	const D3D12_RESOURCE_DESC GetResoureDesc(uint32_t textureHandle);
+
+	/// <summary>
+	/// デスクリプタテーブルをセット（このローダーのデスクリプタヒープもセットする）
+	/// </summary>
+	/// <param name="commandList">コマンドリスト</param>
+	/// <param name="rootParamIndex">ルートパラメータ番号</param>
+	/// <param name="textureHandle">テクスチャハンドル</param>
+	void SetGraphicsRootDescriptorTable(
+	    ID3D12GraphicsCommandList* commandList, UINT rootParamIndex, uint32_t textureHandle);
+
+private:
+	TextureLoader() = default;
+	~TextureLoader() = default;
+	TextureLoader(const TextureLoader&) = delete;
+	TextureLoader& operator=(const TextureLoader&) = delete;
+
+	/// <summary>
+	/// 読み込み
+	/// </summary>
+	/// <param name="fileName">ファイル名</param>
+	uint32_t LoadInternal(const std::string& fileName);
+
+	/// <summary>
+	/// 読み込み解除
+	/// </summary>
+	/// <param name="textureHandle">テクスチャハンドル</param>
+	bool UnloadInternal(uint32_t textureHandle);
+
+	/// <summary>
+	/// 読み込み済みテクスチャの検索
+	/// </summary>
+	/// <param name="fileName">ファイル名</param>
+	/// <returns>テクスチャハンドル。無ければkNumDescriptors</returns>
+	uint32_t Find(const std::string& fileName) const;
+
+	/// <summary>
+	/// 画像のデコードとミップマップ生成（スレッドセーフ）
+	/// </summary>
+	/// <param name="fileName">ファイル名</param>
+	/// <param name="scratchImg">画像</param>
+	void Decode(const std::string& fileName, DirectX::ScratchImage& scratchImg) const;
+
+	/// <summary>
+	/// リソースとシェーダリソースビューの生成、転送の発行
+	/// </summary>
+	/// <param name="fileName">ファイル名</param>
+	/// <param name="scratchImg">画像（転送の発行後は不要）</param>
+	/// <returns>テクスチャハンドル</returns>
+	uint32_t Create(const std::string& fileName, const DirectX::ScratchImage& scratchImg);
+
+	// デバイス
+	ID3D12Device* device_ = nullptr;
+	// デスクリプタサイズ
+	UINT descriptorHandleIncrementSize_ = 0u;
+	// ディレクトリパス
+	std::string directoryPath_;
+	// デスクリプタヒープ
+	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> descriptorHeap_;
+	// テクスチャコンテナ（名前が空なら未使用）
+	std::vector<Texture> textures_;
+};
@@ -1,9 +1,16 @@
 #include "Audio.h"
 #include "AxisIndicator.h"
+#include "ConstBufferAllocator.h"
+#include "CopyQueue.h"
 #include "DirectXCommon.h"
+#include "GeometryArena.h"
 #include "GameScene.h"
 #include "ImGuiManager.h"
+#include "JobSystem.h"
+#include "ModelInstancing.h"
 #include "PrimitiveDrawer.h"
+#include "TerrainGrid.h"
+#include "TextureLoader.h"
 #include "TextureManager.h"
 #include "WinApp.h"
 
@@ -26,6 +33,10 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 	dxCommon = DirectXCommon::GetInstance();
 	dxCommon->Initialize(win);
 
+	// ジョブシステム初期化
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	jobSystem->Initialize();
+
 #pragma region 汎用機能初期化
 	// ImGuiの初期化
 	ImGuiManager* imguiManager = ImGuiManager::GetInstance();
@@ -39,15 +50,33 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 	audio = Audio::GetInstance();
 	audio->Initialize();
 
+	// コピーキューの初期化
+	CopyQueue* copyQueue = CopyQueue::GetInstance();
+	copyQueue->Initialize(dxCommon->GetDevice());
+
+	// ジオメトリアリーナの初期化
+	GeometryArena* geometryArena = GeometryArena::GetInstance();
+	geometryArena->Initialize();
+
 	// テクスチャマネージャの初期化
 	TextureManager::GetInstance()->Initialize(dxCommon->GetDevice());
 	TextureManager::Load("white1x1.png");
+	// 非同期テクスチャローダーの初期化
+	TextureLoader* textureLoader = TextureLoader::GetInstance();
+	textureLoader->Initialize(dxCommon->GetDevice());
+
+	// フレーム用定数バッファの初期化
+	ConstBufferAllocator* constBufferAllocator = ConstBufferAllocator::GetInstance();
+	constBufferAllocator->Initialize(dxCommon->GetDevice(), dxCommon->GetBackBufferCount());
 
 	// スプライト静的初期化
 	Sprite::StaticInitialize(dxCommon->GetDevice(), WinApp::kWindowWidth, WinApp::kWindowHeight);
 
 	// 3Dモデル静的初期化
 	Model::StaticInitialize();
+	ModelInstancingCommon::GetInstance()->Initialize();
+	// 地形静的初期化
+	TerrainGrid::StaticInitialize();
 
 	// 軸方向表示初期化
 	axisIndicator = AxisIndicator::GetInstance();
@@ -68,6 +97,10 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 			break;
 		}
 
+		// フレーム用定数バッファのリセット
+		constBufferAllocator->BeginFrame();
+		// 転送済みの中間バッファを回収
+		copyQueue->Update();
 		// ImGui受付開始
 		imguiManager->Begin();
 		// 入力関連の毎フレーム処理
@@ -93,13 +126,20 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 		dxCommon->PostDraw();
 	}
 
+	// 転送の完了待ち
+	copyQueue->Finalize();
 	// 各種解放
 	delete gameScene;
 	// 3Dモデル解放
 	Model::StaticFinalize();
+	TerrainGrid::StaticFinalize();
+	textureLoader->Finalize();
+	geometryArena->Finalize();
 	audio->Finalize();
 	// ImGui解放
 	imguiManager->Finalize();
+	// ワーカースレッド停止
+	jobSystem->Finalize();
 
 	// ゲームウィンドウの破棄
 	win->TerminateGameWindow();
@@ -0,0 +1,263 @@
+#include "BatchTransform.h"
+#include "MathUtility.h"
+#include <cassert>
+
+// AVX2カーネルを含めるか。/arch指定に関わらず関数単位で有効にし、実行時に切り替える
+#if !defined(MATH_DISABLE_SIMD) &&                                                               \
+    (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__))
+#define MATH_BATCH_AVX2 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(MATH_BATCH_AVX2) && (defined(__GNUC__) || defined(__clang__))
+#define MATH_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define MATH_TARGET_AVX2
+#endif
+
+namespace MathUtility {
+
+namespace {
+
+// SoA形式の変換カーネル
+using TransformKernel = void (*)(
+    const Matrix4x4& m, const float* x, const float* y, const float* z, float* outX,
+    float* outY, float* outZ, size_t count);
+
+/// <summary>
+/// スカラー版カーネル
+/// </summary>
+void TransformKernelScalar(
+    const Matrix4x4& m, const float* x, const float* y, const float* z, float* outX,
+    float* outY, float* outZ, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		Vector3 point = Transform(Vector3{x[i], y[i], z[i]}, m);
+		outX[i] = point.x;
+		outY[i] = point.y;
+		outZ[i] = point.z;
+	}
+}
+
+// AoS形式の変換カーネル
+using TransformKernelAoS =
+    void (*)(const Matrix4x4& m, const Vector3* points, Vector3* result, size_t count);
+
+/// <summary>
+/// スカラー版カーネル（AoS形式）
+/// </summary>
+void TransformKernelAoSScalar(
+    const Matrix4x4& m, const Vector3* points, Vector3* result, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		result[i] = Transform(points[i], m);
+	}
+}
+
+#if defined(MATH_BATCH_AVX2)
+/// <summary>
+/// 行列の各要素を8レーンに展開する
+/// </summary>
+MATH_TARGET_AVX2 inline void BroadcastMatrixAVX2(const Matrix4x4& m, __m256 (&broadcast)[4][4]) {
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			broadcast[i][j] = _mm256_set1_ps(m.m[i][j]);
+		}
+	}
+}
+
+/// <summary>
+/// 8点の座標変換（w=1として変換し、wで除算する）
+/// </summary>
+MATH_TARGET_AVX2 inline void
+    TransformAVX2(const __m256 (&m)[4][4], __m256& x, __m256& y, __m256& z) {
+	__m256 rx = _mm256_fmadd_ps(z, m[2][0], m[3][0]);
+	rx = _mm256_fmadd_ps(y, m[1][0], rx);
+	rx = _mm256_fmadd_ps(x, m[0][0], rx);
+	__m256 ry = _mm256_fmadd_ps(z, m[2][1], m[3][1]);
+	ry = _mm256_fmadd_ps(y, m[1][1], ry);
+	ry = _mm256_fmadd_ps(x, m[0][1], ry);
+	__m256 rz = _mm256_fmadd_ps(z, m[2][2], m[3][2]);
+	rz = _mm256_fmadd_ps(y, m[1][2], rz);
+	rz = _mm256_fmadd_ps(x, m[0][2], rz);
+	__m256 rw = _mm256_fmadd_ps(z, m[2][3], m[3][3]);
+	rw = _mm256_fmadd_ps(y, m[1][3], rw);
+	rw = _mm256_fmadd_ps(x, m[0][3], rw);
+
+	// 精度を保つため逆数近似(rcp)は使わない
+	__m256 invW = _mm256_div_ps(_mm256_set1_ps(1.0f), rw);
+	x = _mm256_mul_ps(rx, invW);
+	y = _mm256_mul_ps(ry, invW);
+	z = _mm256_mul_ps(rz, invW);
+}
+
+/// <summary>
+/// AVX2版カーネル（8点ずつ処理）
+/// </summary>
+MATH_TARGET_AVX2 void TransformKernelAVX2(
+    const Matrix4x4& m, const float* x, const float* y, const float* z, float* outX,
+    float* outY, float* outZ, size_t count) {
+	__m256 broadcast[4][4];
+	BroadcastMatrixAVX2(m, broadcast);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256 px = _mm256_loadu_ps(x + i);
+		__m256 py = _mm256_loadu_ps(y + i);
+		__m256 pz = _mm256_loadu_ps(z + i);
+		TransformAVX2(broadcast, px, py, pz);
+		_mm256_storeu_ps(outX + i, px);
+		_mm256_storeu_ps(outY + i, py);
+		_mm256_storeu_ps(outZ + i, pz);
+	}
+
+	// 端数
+	TransformKernelScalar(m, x + i, y + i, z + i, outX + i, outY + i, outZ + i, count - i);
+}
+
+/// <summary>
+/// AVX2版カーネル（AoS形式、8点ずつレジスタ内でSoAに並べ替えて処理）
+/// </summary>
+MATH_TARGET_AVX2 void TransformKernelAoSAVX2(
+    const Matrix4x4& m, const Vector3* points, Vector3* result, size_t count) {
+	__m256 broadcast[4][4];
+	BroadcastMatrixAVX2(m, broadcast);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		// 8点 = 24要素を128bit単位で読み、下位に0～3番目、上位に4～7番目の点を置く
+		const float* in = &points[i].x;
+		__m256 m03 = _mm256_castps128_ps256(_mm_loadu_ps(in + 0));
+		__m256 m14 = _mm256_castps128_ps256(_mm_loadu_ps(in + 4));
+		__m256 m25 = _mm256_castps128_ps256(_mm_loadu_ps(in + 8));
+		m03 = _mm256_insertf128_ps(m03, _mm_loadu_ps(in + 12), 1);
+		m14 = _mm256_insertf128_ps(m14, _mm_loadu_ps(in + 16), 1);
+		m25 = _mm256_insertf128_ps(m25, _mm_loadu_ps(in + 20), 1);
+
+		// xyzxyzxyzxyz を xxxx, yyyy, zzzz に並べ替える
+		__m256 xy = _mm256_shuffle_ps(m14, m25, _MM_SHUFFLE(2, 1, 3, 2));
+		__m256 yz = _mm256_shuffle_ps(m03, m14, _MM_SHUFFLE(1, 0, 2, 1));
+		__m256 px = _mm256_shuffle_ps(m03, xy, _MM_SHUFFLE(2, 0, 3, 0));
+		__m256 py = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+		__m256 pz = _mm256_shuffle_ps(yz, m25, _MM_SHUFFLE(3, 0, 3, 1));
+
+		TransformAVX2(broadcast, px, py, pz);
+
+		// 逆の並べ替えで xyzxyzxyzxyz に戻す
+		__m256 rxy = _mm256_shuffle_ps(px, py, _MM_SHUFFLE(2, 0, 2, 0));
+		__m256 ryz = _mm256_shuffle_ps(py, pz, _MM_SHUFFLE(3, 1, 3, 1));
+		__m256 rzx = _mm256_shuffle_ps(pz, px, _MM_SHUFFLE(3, 1, 2, 0));
+		__m256 r03 = _mm256_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0));
+		__m256 r14 = _mm256_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0));
+		__m256 r25 = _mm256_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1));
+
+		float* out = &result[i].x;
+		_mm_storeu_ps(out + 0, _mm256_castps256_ps128(r03));
+		_mm_storeu_ps(out + 4, _mm256_castps256_ps128(r14));
+		_mm_storeu_ps(out + 8, _mm256_castps256_ps128(r25));
+		_mm_storeu_ps(out + 12, _mm256_extractf128_ps(r03, 1));
+		_mm_storeu_ps(out + 16, _mm256_extractf128_ps(r14, 1));
+		_mm_storeu_ps(out + 20, _mm256_extractf128_ps(r25, 1));
+	}
+
+	// 端数
+	TransformKernelAoSScalar(m, points + i, result + i, count - i);
+}
+#endif
+
+#if defined(MATH_BATCH_AVX2)
+/// <summary>
+/// CPUとOSのAVX2・FMA対応を調べる
+/// </summary>
+bool DetectAVX2() {
+#if defined(_MSC_VER)
+	int info[4] = {};
+	__cpuid(info, 0);
+	if (info[0] < 7) {
+		return false;
+	}
+	__cpuid(info, 1);
+	bool hasOSXSAVE = (info[2] & (1 << 27)) != 0;
+	bool hasFMA = (info[2] & (1 << 12)) != 0;
+	if (!hasOSXSAVE || !hasFMA) {
+		return false;
+	}
+	// OSがYMMレジスタを保存するか
+	if ((_xgetbv(0) & 0x6) != 0x6) {
+		return false;
+	}
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+#endif
+
+/// <summary>
+/// 使用するカーネルの取得（初回に判定）
+/// </summary>
+TransformKernel GetTransformKernel() {
+	static const TransformKernel kernel = []() -> TransformKernel {
+#if defined(MATH_BATCH_AVX2)
+		if (DetectAVX2()) {
+			return TransformKernelAVX2;
+		}
+#endif
+		return TransformKernelScalar;
+	}();
+	return kernel;
+}
+
+/// <summary>
+/// 使用するAoS形式のカーネルの取得（初回に判定）
+/// </summary>
+TransformKernelAoS GetTransformKernelAoS() {
+	static const TransformKernelAoS kernel = []() -> TransformKernelAoS {
+#if defined(MATH_BATCH_AVX2)
+		if (DetectAVX2()) {
+			return TransformKernelAoSAVX2;
+		}
+#endif
+		return TransformKernelAoSScalar;
+	}();
+	return kernel;
+}
+
+} // namespace
+
+void ToSoA(std::span<const Vector3> points, Vector3SoA& soa) {
+	soa.resize(points.size());
+	for (size_t i = 0; i < points.size(); i++) {
+		soa.x[i] = points[i].x;
+		soa.y[i] = points[i].y;
+		soa.z[i] = points[i].z;
+	}
+}
+
+void ToAoS(const Vector3SoA& soa, std::span<Vector3> points) {
+	assert(soa.size() == points.size());
+	for (size_t i = 0; i < points.size(); i++) {
+		points[i] = {soa.x[i], soa.y[i], soa.z[i]};
+	}
+}
+
+void TransformPoints(
+    const Matrix4x4& m, std::span<const Vector3> points, std::span<Vector3> result) {
+	assert(points.size() == result.size());
+	GetTransformKernelAoS()(m, points.data(), result.data(), points.size());
+}
+
+void TransformPoints(const Matrix4x4& m, const Vector3SoA& points, Vector3SoA& result) {
+	assert(points.x.size() == points.y.size() && points.x.size() == points.z.size());
+	result.resize(points.size());
+	GetTransformKernel()(
+	    m, points.x.data(), points.y.data(), points.z.data(), result.x.data(), result.y.data(),
+	    result.z.data(), points.size());
+}
+
+bool IsAVX2Supported() { return GetTransformKernel() != TransformKernelScalar; }
+
+} // namespace MathUtility
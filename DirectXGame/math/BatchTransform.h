@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Matrix4x4.h"
+#include "Vector3.h"
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace MathUtility {
+
+/// <summary>
+/// 座標配列（SoA形式）
+/// </summary>
+struct Vector3SoA {
+	std::vector<float> x;
+	std::vector<float> y;
+	std::vector<float> z;
+
+	/// <summary>
+	/// 要素数の取得
+	/// </summary>
+	size_t size() const { return x.size(); }
+
+	/// <summary>
+	/// 要素数の変更
+	/// </summary>
+	void resize(size_t count) {
+		x.resize(count);
+		y.resize(count);
+		z.resize(count);
+	}
+};
+
+/// <summary>
+/// AoS形式からSoA形式への変換
+/// </summary>
+/// <param name="points">座標配列</param>
+/// <param name="soa">変換先（要素数は合わせられる）</param>
+void ToSoA(std::span<const Vector3> points, Vector3SoA& soa);
+
+/// <summary>
+/// SoA形式からAoS形式への変換
+/// </summary>
+/// <param name="soa">座標配列</param>
+/// <param name="points">変換先（soaと同じ要素数）</param>
+void ToAoS(const Vector3SoA& soa, std::span<Vector3> points);
+
+/// <summary>
+/// 座標配列の一括変換（Transformと同じくw=1として変換し、wで除算する）
+/// </summary>
+/// <param name="m">変換行列</param>
+/// <param name="points">変換する座標</param>
+/// <param name="result">変換結果（pointsと同じ要素数。pointsと同じ配列でもよい）</param>
+void TransformPoints(
+    const Matrix4x4& m, std::span<const Vector3> points, std::span<Vector3> result);
+
+/// <summary>
+/// 座標配列の一括変換（SoA形式）
+/// </summary>
+/// <param name="m">変換行列</param>
+/// <param name="points">変換する座標</param>
+/// <param name="result">変換結果（要素数は合わせられる。pointsと同じでもよい）</param>
+void TransformPoints(const Matrix4x4& m, const Vector3SoA& points, Vector3SoA& result);
+
+/// <summary>
+/// 一括変換でAVX2が使われるか
+/// </summary>
+/// <returns>実行中のCPUとOSがAVX2・FMAに対応していればtrue</returns>
+bool IsAVX2Supported();
+
+} // namespace MathUtility
@@ -0,0 +1,197 @@
+#include "BroadPhase.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+/// <summary>
+/// 2つのセル座標を1つの番号にまとめる
+/// </summary>
+uint64_t PackCell(int32_t x, int32_t y) {
+	return (uint64_t(uint32_t(x)) << 32) | uint64_t(uint32_t(y));
+}
+
+// セル座標の絶対値の上限（これを超える物体はセルに登録しない）
+constexpr float kMaxCell = float(1 << 30);
+
+/// <summary>
+/// AABBのxy平面上の重なり
+/// </summary>
+bool IsOverlap2D(const AABB& a, const AABB& b) {
+	return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y && b.min.y <= a.max.y;
+}
+
+} // namespace
+
+#pragma region SweepAndPrune
+
+SweepAndPrune::SweepAndPrune(int axis) : axis_(axis) { assert(0 <= axis && axis < 3); }
+
+void SweepAndPrune::FindPairs(std::span<const AABB> bounds, std::vector<CollisionPair>& pairs) {
+	pairs.clear();
+
+	uint32_t count = static_cast<uint32_t>(bounds.size());
+	sortedMin_.resize(count);
+	sortedMax_.resize(count);
+
+	auto minOf = [&](uint32_t object) { return (&bounds[object].min.x)[axis_]; };
+
+	auto sortAll = [&]() {
+		std::sort(order_.begin(), order_.end(), [&](uint32_t a, uint32_t b) {
+			return minOf(a) < minOf(b);
+		});
+	};
+	if (order_.size() != count) {
+		// 並びを作り直す。挿入ソートは整列していない配列では2乗の時間がかかるので使わない
+		order_.resize(count);
+		std::iota(order_.begin(), order_.end(), 0);
+		sortAll();
+	} else {
+		// 前フレームの並びからの挿入ソート（ほぼ整列済みなら線形時間）
+		// 並びが大きく崩れていたら（瞬間移動や全体の反転など）途中でやめて全体をソートする
+		const size_t maxShifts = size_t(count) * kMaxShiftsPerObject;
+		size_t shifts = 0;
+		for (uint32_t i = 1; i < count && shifts <= maxShifts; i++) {
+			uint32_t object = order_[i];
+			float key = minOf(object);
+			uint32_t j = i;
+			while (j > 0 && key < minOf(order_[j - 1])) {
+				order_[j] = order_[j - 1];
+				j--;
+			}
+			order_[j] = object;
+			shifts += i - j;
+		}
+		if (maxShifts < shifts) {
+			sortAll();
+		}
+	}
+
+	// 走査用に軸方向の範囲を連続した配列へ
+	for (uint32_t i = 0; i < count; i++) {
+		const AABB& aabb = bounds[order_[i]];
+		sortedMin_[i] = (&aabb.min.x)[axis_];
+		sortedMax_[i] = (&aabb.max.x)[axis_];
+	}
+
+	// 他の2軸
+	int axis1 = (axis_ + 1) % 3;
+	int axis2 = (axis_ + 2) % 3;
+
+	for (uint32_t i = 0; i < count; i++) {
+		float max = sortedMax_[i];
+		const AABB& a = bounds[order_[i]];
+		// 最小値がiの最大値を超えたら、それ以降は重ならない
+		for (uint32_t j = i + 1; j < count && sortedMin_[j] <= max; j++) {
+			const AABB& b = bounds[order_[j]];
+			if ((&a.min.x)[axis1] <= (&b.max.x)[axis1] && (&b.min.x)[axis1] <= (&a.max.x)[axis1] &&
+			    (&a.min.x)[axis2] <= (&b.max.x)[axis2] && (&b.min.x)[axis2] <= (&a.max.x)[axis2]) {
+				uint32_t first = order_[i];
+				uint32_t second = order_[j];
+				pairs.push_back({std::min(first, second), std::max(first, second)});
+			}
+		}
+	}
+}
+
+#pragma endregion
+
+#pragma region SpatialHashGrid
+
+SpatialHashGrid::SpatialHashGrid(float cellSize)
+    : cellSize_(cellSize), inverseCellSize_(1.0f / cellSize) {
+	assert(0.0f < cellSize);
+}
+
+void SpatialHashGrid::FindPairs(std::span<const AABB> bounds, std::vector<CollisionPair>& pairs) {
+	pairs.clear();
+	entries_.clear();
+	overflow_.clear();
+	isOverflow_.assign(bounds.size(), 0);
+
+	// 掛かる全セルへ登録
+	for (uint32_t object = 0; object < bounds.size(); object++) {
+		const AABB& aabb = bounds[object];
+		// セル数は整数へ変換する前に浮動小数点数で数える（巨大な値の変換は未定義動作）
+		float cellMinX = std::floor(aabb.min.x * inverseCellSize_);
+		float cellMaxX = std::floor(aabb.max.x * inverseCellSize_);
+		float cellMinY = std::floor(aabb.min.y * inverseCellSize_);
+		float cellMaxY = std::floor(aabb.max.y * inverseCellSize_);
+		float cellCount = (cellMaxX - cellMinX + 1.0f) * (cellMaxY - cellMinY + 1.0f);
+		bool isInRange = -kMaxCell <= cellMinX && cellMaxX <= kMaxCell && -kMaxCell <= cellMinY &&
+		                 cellMaxY <= kMaxCell;
+		// NaNや逆転したAABBもここで弾かれる
+		if (!(cellCount <= float(kMaxCellsPerObject)) || !isInRange) {
+			overflow_.push_back(object);
+			isOverflow_[object] = 1;
+			continue;
+		}
+		int32_t minX = static_cast<int32_t>(cellMinX), maxX = static_cast<int32_t>(cellMaxX);
+		int32_t minY = static_cast<int32_t>(cellMinY), maxY = static_cast<int32_t>(cellMaxY);
+		for (int32_t y = minY; y <= maxY; y++) {
+			for (int32_t x = minX; x <= maxX; x++) {
+				entries_.push_back({PackCell(x, y), object});
+			}
+		}
+	}
+
+	std::sort(entries_.begin(), entries_.end(), [](const Entry& a, const Entry& b) {
+		return a.cell < b.cell;
+	});
+
+	// 同じセルの物体同士を判定
+	for (size_t begin = 0; begin < entries_.size();) {
+		uint64_t cell = entries_[begin].cell;
+		size_t end = begin + 1;
+		while (end < entries_.size() && entries_[end].cell == cell) {
+			end++;
+		}
+
+		for (size_t i = begin; i < end; i++) {
+			const AABB& a = bounds[entries_[i].object];
+			for (size_t j = i + 1; j < end; j++) {
+				const AABB& b = bounds[entries_[j].object];
+				if (!IsOverlap2D(a, b)) {
+					continue;
+				}
+				// 重なり領域の最小点を含むセルでだけ報告し、重複をなくす
+				int32_t x = ToCell(std::max(a.min.x, b.min.x));
+				int32_t y = ToCell(std::max(a.min.y, b.min.y));
+				if (PackCell(x, y) != cell) {
+					continue;
+				}
+				uint32_t first = entries_[i].object;
+				uint32_t second = entries_[j].object;
+				pairs.push_back({std::min(first, second), std::max(first, second)});
+			}
+		}
+
+		begin = end;
+	}
+
+	// セルに登録しなかった物体は全ての物体と判定する（登録しなかった物体同士は1度だけ）
+	for (size_t i = 0; i < overflow_.size(); i++) {
+		uint32_t first = overflow_[i];
+		const AABB& a = bounds[first];
+		for (uint32_t second = 0; second < bounds.size(); second++) {
+			if (isOverflow_[second] || !IsOverlap2D(a, bounds[second])) {
+				continue;
+			}
+			pairs.push_back({std::min(first, second), std::max(first, second)});
+		}
+		for (size_t j = i + 1; j < overflow_.size(); j++) {
+			uint32_t second = overflow_[j];
+			if (IsOverlap2D(a, bounds[second])) {
+				pairs.push_back({std::min(first, second), std::max(first, second)});
+			}
+		}
+	}
+}
+
+int32_t SpatialHashGrid::ToCell(float value) const {
+	return static_cast<int32_t>(std::floor(value * inverseCellSize_));
+}
+
+#pragma endregion
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Shapes.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/// <summary>
+/// 衝突候補の組（first < second）
+/// </summary>
+struct CollisionPair {
+	uint32_t first;
+	uint32_t second;
+};
+
+/// <summary>
+/// スイープ・アンド・プルーン
+/// </summary>
+/// <remarks>
+/// 1軸でAABBを並べ、その軸で重なる範囲だけを残りの軸で判定する。
+/// 並びは前フレームのものを挿入ソートで直すため、少しずつ動く物体ではほぼ線形時間になる。
+/// 物体数が変わったとき（初回を含む）や並びが大きく崩れていたときは全体をソートする。
+/// SpatialHashGridとFindPairsの形を揃えてあり、差し替えて使える。
+/// </remarks>
+class SweepAndPrune {
+public: // 定数
+	// 挿入ソートで許す物体あたりの平均の移動数（超えたら全体をソートする）
+	static constexpr uint32_t kMaxShiftsPerObject = 16;
+
+public: // メンバ関数
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	/// <param name="axis">並べる軸（0:x 1:y 2:z）。物体が最も散らばっている軸がよい</param>
+	explicit SweepAndPrune(int axis = 0);
+
+	/// <summary>
+	/// 衝突候補の組を求める
+	/// </summary>
+	/// <param name="bounds">物体のAABB（物体数が変わると並びを作り直す）</param>
+	/// <param name="pairs">衝突候補の組（クリアしてから追加する）</param>
+	void FindPairs(std::span<const AABB> bounds, std::vector<CollisionPair>& pairs);
+
+private: // メンバ変数
+	// 並べる軸
+	int axis_;
+	// 軸方向の最小値の昇順に並べた物体の番号
+	std::vector<uint32_t> order_;
+	// 並べた順の軸方向の最小値・最大値
+	std::vector<float> sortedMin_;
+	std::vector<float> sortedMax_;
+};
+
+/// <summary>
+/// 一様格子による空間ハッシュ（2D）
+/// </summary>
+/// <remarks>
+/// AABBのxy平面上の範囲が掛かるセルに物体を登録し、同じセルの物体同士を判定する。z成分は無視する。
+/// 登録はセル番号でソートした配列で行い、配列の容量は使い回すので毎フレームの動的確保はない。
+/// 同じ組が複数のセルで見つかる場合は、2つの最小点の大きい方を含むセルだけで報告する。
+/// 掛かるセルがkMaxCellsPerObjectを超える物体（地形や巨大な敵など）はセルに登録せず、
+/// 全ての物体と総当たりで判定する。
+/// </remarks>
+class SpatialHashGrid {
+public: // 定数
+	// 1つの物体を登録するセルの上限（超えた物体は総当たりで判定する）
+	static constexpr uint32_t kMaxCellsPerObject = 64;
+
+public: // メンバ関数
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	/// <param name="cellSize">セルの大きさ。物体の典型的な大きさ程度がよい</param>
+	explicit SpatialHashGrid(float cellSize);
+
+	/// <summary>
+	/// 衝突候補の組を求める
+	/// </summary>
+	/// <param name="bounds">物体のAABB（xyのみ使用）</param>
+	/// <param name="pairs">衝突候補の組（クリアしてから追加する）</param>
+	void FindPairs(std::span<const AABB> bounds, std::vector<CollisionPair>& pairs);
+
+	/// <summary>
+	/// セルの大きさの取得
+	/// </summary>
+	float GetCellSize() const { return cellSize_; }
+
+private: // サブクラス
+	// セルへの登録
+	struct Entry {
+		uint64_t cell;
+		uint32_t object;
+	};
+
+private: // メンバ関数
+	/// <summary>
+	/// 座標をセル番号に変換
+	/// </summary>
+	int32_t ToCell(float value) const;
+
+private: // メンバ変数
+	// セルの大きさ
+	float cellSize_;
+	// セルの大きさの逆数
+	float inverseCellSize_;
+	// セルへの登録（セル番号順）
+	std::vector<Entry> entries_;
+	// セルに登録しなかった物体
+	std::vector<uint32_t> overflow_;
+	// 物体ごとのセルに登録しなかったかどうか
+	std::vector<uint8_t> isOverflow_;
+};
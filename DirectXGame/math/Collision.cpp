@@ -0,0 +1,356 @@
+#include "Collision.h"
+#include <cmath>
+
+namespace MathUtility {
+
+namespace {
+
+// 平行判定などに使う許容誤差
+const float kEpsilon = 1.0e-6f;
+
+#if defined(MATH_ENABLE_SSE)
+/// <summary>
+/// ビットの立っているレーンの番号を追加
+/// </summary>
+size_t PushHits(int mask, size_t base, std::vector<uint32_t>& hits) {
+	size_t count = 0;
+	for (int i = 0; i < 4; i++) {
+		if (mask & (1 << i)) {
+			hits.push_back(static_cast<uint32_t>(base + i));
+			count++;
+		}
+	}
+	return count;
+}
+
+/// <summary>
+/// 4個のAABBを成分ごとに読み込む
+/// </summary>
+void LoadAABB4(const AABB* aabbs, __m128 (&min)[3], __m128 (&max)[3]) {
+	for (int axis = 0; axis < 3; axis++) {
+		min[axis] = _mm_setr_ps(
+		    (&aabbs[0].min.x)[axis], (&aabbs[1].min.x)[axis], (&aabbs[2].min.x)[axis],
+		    (&aabbs[3].min.x)[axis]);
+		max[axis] = _mm_setr_ps(
+		    (&aabbs[0].max.x)[axis], (&aabbs[1].max.x)[axis], (&aabbs[2].max.x)[axis],
+		    (&aabbs[3].max.x)[axis]);
+	}
+}
+#endif
+
+/// <summary>
+/// 配列の各要素を1つずつ判定する
+/// </summary>
+template<class Shape, class Element>
+size_t CollectScalar(
+    const Shape& shape, std::span<const Element> elements, size_t begin,
+    std::vector<uint32_t>& hits) {
+	size_t count = 0;
+	for (size_t i = begin; i < elements.size(); i++) {
+		if (IsIntersect(shape, elements[i])) {
+			hits.push_back(static_cast<uint32_t>(i));
+			count++;
+		}
+	}
+	return count;
+}
+
+} // namespace
+
+#pragma region 最近接点
+
+Vector3 ClosestPoint(const Triangle& triangle, const Vector3& point) {
+	const Vector3& a = triangle.vertices[0];
+	const Vector3& b = triangle.vertices[1];
+	const Vector3& c = triangle.vertices[2];
+	Vector3 ab = Subtract(b, a);
+	Vector3 ac = Subtract(c, a);
+
+	// 頂点aの領域
+	Vector3 ap = Subtract(point, a);
+	float d1 = Dot(ab, ap);
+	float d2 = Dot(ac, ap);
+	if (d1 <= 0.0f && d2 <= 0.0f) {
+		return a;
+	}
+
+	// 頂点bの領域
+	Vector3 bp = Subtract(point, b);
+	float d3 = Dot(ab, bp);
+	float d4 = Dot(ac, bp);
+	if (d3 >= 0.0f && d4 <= d3) {
+		return b;
+	}
+
+	// 辺abの領域
+	float vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+		return Add(a, Multiply(d1 / (d1 - d3), ab));
+	}
+
+	// 頂点cの領域
+	Vector3 cp = Subtract(point, c);
+	float d5 = Dot(ab, cp);
+	float d6 = Dot(ac, cp);
+	if (d6 >= 0.0f && d5 <= d6) {
+		return c;
+	}
+
+	// 辺acの領域
+	float vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+		return Add(a, Multiply(d2 / (d2 - d6), ac));
+	}
+
+	// 辺bcの領域
+	float va = d3 * d6 - d5 * d4;
+	if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+		float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+		return Add(b, Multiply(w, Subtract(c, b)));
+	}
+
+	// 面の内側（重心座標）
+	float denom = 1.0f / (va + vb + vc);
+	return Add(a, Add(Multiply(vb * denom, ab), Multiply(vc * denom, ac)));
+}
+
+float ClosestPoints(
+    const Segment& segment1, const Segment& segment2, Vector3& closest1, Vector3& closest2) {
+	const Vector3& d1 = segment1.diff;
+	const Vector3& d2 = segment2.diff;
+	Vector3 r = Subtract(segment1.origin, segment2.origin);
+	float a = Dot(d1, d1);
+	float e = Dot(d2, d2);
+	float f = Dot(d2, r);
+
+	float s = 0.0f;
+	float t = 0.0f;
+	if (a <= kEpsilon && e <= kEpsilon) {
+		// 両方とも点
+	} else if (a <= kEpsilon) {
+		// segment1が点
+		t = std::clamp(f / e, 0.0f, 1.0f);
+	} else {
+		float c = Dot(d1, r);
+		if (e <= kEpsilon) {
+			// segment2が点
+			s = std::clamp(-c / a, 0.0f, 1.0f);
+		} else {
+			float b = Dot(d1, d2);
+			float denom = a * e - b * b;
+			// 平行なら任意の点から始める
+			if (denom != 0.0f) {
+				s = std::clamp((b * f - c * e) / denom, 0.0f, 1.0f);
+			}
+			t = (b * s + f) / e;
+			// tが範囲外ならtを端に固定してsを求め直す
+			if (t < 0.0f) {
+				t = 0.0f;
+				s = std::clamp(-c / a, 0.0f, 1.0f);
+			} else if (t > 1.0f) {
+				t = 1.0f;
+				s = std::clamp((b - c) / a, 0.0f, 1.0f);
+			}
+		}
+	}
+
+	closest1 = Add(segment1.origin, Multiply(s, d1));
+	closest2 = Add(segment2.origin, Multiply(t, d2));
+	Vector3 diff = Subtract(closest1, closest2);
+	return Dot(diff, diff);
+}
+
+#pragma endregion
+
+#pragma region 交差判定
+
+bool IsIntersect(const Segment& segment, const Plane& plane, float& t) {
+	float denom = Dot(plane.normal, segment.diff);
+	// 平行
+	if (denom == 0.0f) {
+		return false;
+	}
+	t = (plane.distance - Dot(plane.normal, segment.origin)) / denom;
+	return 0.0f <= t && t <= 1.0f;
+}
+
+bool IsIntersect(const Segment& segment, const Triangle& triangle, float& t) {
+	// Moller-Trumbore法
+	Vector3 edge1 = Subtract(triangle.vertices[1], triangle.vertices[0]);
+	Vector3 edge2 = Subtract(triangle.vertices[2], triangle.vertices[0]);
+	Vector3 p = Cross(segment.diff, edge2);
+	float det = Dot(edge1, p);
+	// 三角形と平行
+	if (std::abs(det) < kEpsilon) {
+		return false;
+	}
+
+	float invDet = 1.0f / det;
+	Vector3 s = Subtract(segment.origin, triangle.vertices[0]);
+	float u = Dot(s, p) * invDet;
+	if (u < 0.0f || 1.0f < u) {
+		return false;
+	}
+	Vector3 q = Cross(s, edge1);
+	float v = Dot(segment.diff, q) * invDet;
+	if (v < 0.0f || 1.0f < u + v) {
+		return false;
+	}
+
+	t = Dot(edge2, q) * invDet;
+	return 0.0f <= t && t <= 1.0f;
+}
+
+bool IsIntersect(const OBB& obb1, const OBB& obb2) {
+	const float* size1 = &obb1.size.x;
+	const float* size2 = &obb2.size.x;
+
+	// obb2の軸をobb1の座標系で表した回転行列と、その絶対値
+	float r[3][3];
+	float absR[3][3];
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			r[i][j] = Dot(obb1.orientations[i], obb2.orientations[j]);
+			// 辺が平行な場合に外積が0になっても誤判定しないよう誤差を足す
+			absR[i][j] = std::abs(r[i][j]) + kEpsilon;
+		}
+	}
+
+	// 中心間のベクトル（obb1の座標系）
+	Vector3 diff = Subtract(obb2.center, obb1.center);
+	float t[3] = {
+	    Dot(diff, obb1.orientations[0]), Dot(diff, obb1.orientations[1]),
+	    Dot(diff, obb1.orientations[2])};
+
+	// obb1の軸
+	for (int i = 0; i < 3; i++) {
+		float ra = size1[i];
+		float rb = size2[0] * absR[i][0] + size2[1] * absR[i][1] + size2[2] * absR[i][2];
+		if (std::abs(t[i]) > ra + rb) {
+			return false;
+		}
+	}
+
+	// obb2の軸
+	for (int j = 0; j < 3; j++) {
+		float ra = size1[0] * absR[0][j] + size1[1] * absR[1][j] + size1[2] * absR[2][j];
+		float rb = size2[j];
+		float distance = t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j];
+		if (std::abs(distance) > ra + rb) {
+			return false;
+		}
+	}
+
+	// 各軸同士の外積
+	for (int i = 0; i < 3; i++) {
+		int i1 = (i + 1) % 3;
+		int i2 = (i + 2) % 3;
+		for (int j = 0; j < 3; j++) {
+			int j1 = (j + 1) % 3;
+			int j2 = (j + 2) % 3;
+			float ra = size1[i1] * absR[i2][j] + size1[i2] * absR[i1][j];
+			float rb = size2[j1] * absR[i][j2] + size2[j2] * absR[i][j1];
+			float distance = t[i2] * r[i1][j] - t[i1] * r[i2][j];
+			if (std::abs(distance) > ra + rb) {
+				return false;
+			}
+		}
+	}
+
+	// 分離軸が見つからなかった
+	return true;
+}
+
+#pragma endregion
+
+#pragma region 一括判定
+
+size_t CollectIntersections(
+    const Sphere& sphere, std::span<const Sphere> spheres, std::vector<uint32_t>& hits) {
+	size_t count = 0;
+	size_t i = 0;
+#if defined(MATH_ENABLE_SSE)
+	__m128 centerX = _mm_set1_ps(sphere.center.x);
+	__m128 centerY = _mm_set1_ps(sphere.center.y);
+	__m128 centerZ = _mm_set1_ps(sphere.center.z);
+	__m128 radius = _mm_set1_ps(sphere.radius);
+	for (; i + 4 <= spheres.size(); i += 4) {
+		// 4個の球を転置して x, y, z, 半径 の並びにする
+		__m128 x = _mm_loadu_ps(&spheres[i].center.x);
+		__m128 y = _mm_loadu_ps(&spheres[i + 1].center.x);
+		__m128 z = _mm_loadu_ps(&spheres[i + 2].center.x);
+		__m128 r = _mm_loadu_ps(&spheres[i + 3].center.x);
+		_MM_TRANSPOSE4_PS(x, y, z, r);
+		__m128 dx = _mm_sub_ps(x, centerX);
+		__m128 dy = _mm_sub_ps(y, centerY);
+		__m128 dz = _mm_sub_ps(z, centerZ);
+		__m128 distanceSq = _mm_add_ps(
+		    _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+		__m128 radiusSum = _mm_add_ps(r, radius);
+		int mask = _mm_movemask_ps(_mm_cmple_ps(distanceSq, _mm_mul_ps(radiusSum, radiusSum)));
+		count += PushHits(mask, i, hits);
+	}
+#endif
+	// 端数
+	return count + CollectScalar(sphere, spheres, i, hits);
+}
+
+size_t CollectIntersections(
+    const AABB& aabb, std::span<const AABB> aabbs, std::vector<uint32_t>& hits) {
+	size_t count = 0;
+	size_t i = 0;
+#if defined(MATH_ENABLE_SSE)
+	__m128 selfMin[3] = {
+	    _mm_set1_ps(aabb.min.x), _mm_set1_ps(aabb.min.y), _mm_set1_ps(aabb.min.z)};
+	__m128 selfMax[3] = {
+	    _mm_set1_ps(aabb.max.x), _mm_set1_ps(aabb.max.y), _mm_set1_ps(aabb.max.z)};
+	for (; i + 4 <= aabbs.size(); i += 4) {
+		__m128 min[3], max[3];
+		LoadAABB4(&aabbs[i], min, max);
+		__m128 overlap = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (int axis = 0; axis < 3; axis++) {
+			overlap = _mm_and_ps(overlap, _mm_cmple_ps(selfMin[axis], max[axis]));
+			overlap = _mm_and_ps(overlap, _mm_cmple_ps(min[axis], selfMax[axis]));
+		}
+		count += PushHits(_mm_movemask_ps(overlap), i, hits);
+	}
+#endif
+	// 端数
+	return count + CollectScalar(aabb, aabbs, i, hits);
+}
+
+size_t CollectIntersections(
+    const Sphere& sphere, std::span<const AABB> aabbs, std::vector<uint32_t>& hits) {
+	size_t count = 0;
+	size_t i = 0;
+#if defined(MATH_ENABLE_SSE)
+	__m128 center[3] = {
+	    _mm_set1_ps(sphere.center.x), _mm_set1_ps(sphere.center.y),
+	    _mm_set1_ps(sphere.center.z)};
+	__m128 radiusSq = _mm_set1_ps(sphere.radius * sphere.radius);
+	for (; i + 4 <= aabbs.size(); i += 4) {
+		__m128 min[3], max[3];
+		LoadAABB4(&aabbs[i], min, max);
+		// AABB上の最近接点までの距離
+		__m128 distanceSq = _mm_setzero_ps();
+		for (int axis = 0; axis < 3; axis++) {
+			__m128 closest = _mm_min_ps(_mm_max_ps(center[axis], min[axis]), max[axis]);
+			__m128 diff = _mm_sub_ps(closest, center[axis]);
+			distanceSq = _mm_add_ps(distanceSq, _mm_mul_ps(diff, diff));
+		}
+		count += PushHits(_mm_movemask_ps(_mm_cmple_ps(distanceSq, radiusSq)), i, hits);
+	}
+#endif
+	// 端数
+	return count + CollectScalar(sphere, aabbs, i, hits);
+}
+
+size_t CollectIntersections(
+    const OBB& obb, std::span<const OBB> obbs, std::vector<uint32_t>& hits) {
+	// 分離軸判定は早期に打ち切れることが多いため1つずつ判定する
+	return CollectScalar(obb, obbs, 0, hits);
+}
+
+#pragma endregion
+
+} // namespace MathUtility
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "Shapes.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/// <summary>
+/// 衝突判定関数
+/// </summary>
+/// <remarks>
+/// 交差判定はIsIntersect、最近接点はClosestPointに統一する。
+/// 1つの図形と配列の判定はCollectIntersectionsで、交差した要素の番号を返す。
+/// </remarks>
+namespace MathUtility {
+
+#pragma region 最近接点
+
+/// <summary>
+/// 線分上の最近接点
+/// </summary>
+inline Vector3 ClosestPoint(const Segment& segment, const Vector3& point) {
+	float lengthSq = Dot(segment.diff, segment.diff);
+	if (lengthSq == 0.0f) {
+		return segment.origin;
+	}
+	float t = std::clamp(Dot(Subtract(point, segment.origin), segment.diff) / lengthSq, 0.0f, 1.0f);
+	return Add(segment.origin, Multiply(t, segment.diff));
+}
+
+/// <summary>
+/// AABB上（内部を含む）の最近接点
+/// </summary>
+constexpr Vector3 ClosestPoint(const AABB& aabb, const Vector3& point) {
+	return {
+	    std::clamp(point.x, aabb.min.x, aabb.max.x), std::clamp(point.y, aabb.min.y, aabb.max.y),
+	    std::clamp(point.z, aabb.min.z, aabb.max.z)};
+}
+
+/// <summary>
+/// OBB上（内部を含む）の最近接点
+/// </summary>
+constexpr Vector3 ClosestPoint(const OBB& obb, const Vector3& point) {
+	Vector3 diff = Subtract(point, obb.center);
+	Vector3 result = obb.center;
+	const float* size = &obb.size.x;
+	for (int i = 0; i < 3; i++) {
+		float distance = std::clamp(Dot(diff, obb.orientations[i]), -size[i], size[i]);
+		result = Add(result, Multiply(distance, obb.orientations[i]));
+	}
+	return result;
+}
+
+/// <summary>
+/// 平面上の最近接点
+/// </summary>
+constexpr Vector3 ClosestPoint(const Plane& plane, const Vector3& point) {
+	return Subtract(point, Multiply(SignedDistance(plane, point), plane.normal));
+}
+
+/// <summary>
+/// 三角形上の最近接点
+/// </summary>
+Vector3 ClosestPoint(const Triangle& triangle, const Vector3& point);
+
+/// <summary>
+/// 2つの線分の最近接点
+/// </summary>
+/// <param name="closest1">segment1上の最近接点</param>
+/// <param name="closest2">segment2上の最近接点</param>
+/// <returns>最近接点間の距離の2乗</returns>
+float ClosestPoints(
+    const Segment& segment1, const Segment& segment2, Vector3& closest1, Vector3& closest2);
+
+#pragma endregion
+
+#pragma region 交差判定
+
+/// <summary>
+/// 球と球
+/// </summary>
+constexpr bool IsIntersect(const Sphere& sphere1, const Sphere& sphere2) {
+	Vector3 diff = Subtract(sphere2.center, sphere1.center);
+	float radius = sphere1.radius + sphere2.radius;
+	return Dot(diff, diff) <= radius * radius;
+}
+
+/// <summary>
+/// 球と平面
+/// </summary>
+constexpr bool IsIntersect(const Sphere& sphere, const Plane& plane) {
+	float distance = SignedDistance(plane, sphere.center);
+	return -sphere.radius <= distance && distance <= sphere.radius;
+}
+
+/// <summary>
+/// AABBとAABB
+/// </summary>
+constexpr bool IsIntersect(const AABB& aabb1, const AABB& aabb2) {
+	return aabb1.min.x <= aabb2.max.x && aabb2.min.x <= aabb1.max.x &&
+	       aabb1.min.y <= aabb2.max.y && aabb2.min.y <= aabb1.max.y &&
+	       aabb1.min.z <= aabb2.max.z && aabb2.min.z <= aabb1.max.z;
+}
+
+/// <summary>
+/// 球とOBB
+/// </summary>
+constexpr bool IsIntersect(const Sphere& sphere, const OBB& obb) {
+	Vector3 diff = Subtract(ClosestPoint(obb, sphere.center), sphere.center);
+	return Dot(diff, diff) <= sphere.radius * sphere.radius;
+}
+
+/// <summary>
+/// 球とカプセル
+/// </summary>
+inline bool IsIntersect(const Sphere& sphere, const Capsule& capsule) {
+	Vector3 diff = Subtract(ClosestPoint(capsule.segment, sphere.center), sphere.center);
+	float radius = sphere.radius + capsule.radius;
+	return Dot(diff, diff) <= radius * radius;
+}
+
+/// <summary>
+/// カプセルとカプセル
+/// </summary>
+inline bool IsIntersect(const Capsule& capsule1, const Capsule& capsule2) {
+	Vector3 closest1, closest2;
+	float distanceSq = ClosestPoints(capsule1.segment, capsule2.segment, closest1, closest2);
+	float radius = capsule1.radius + capsule2.radius;
+	return distanceSq <= radius * radius;
+}
+
+/// <summary>
+/// 線分と平面
+/// </summary>
+/// <param name="t">交点の媒介変数（origin + t * diff）</param>
+bool IsIntersect(const Segment& segment, const Plane& plane, float& t);
+
+/// <summary>
+/// 線分と三角形（両面）
+/// </summary>
+/// <param name="t">交点の媒介変数（origin + t * diff）</param>
+bool IsIntersect(const Segment& segment, const Triangle& triangle, float& t);
+
+/// <summary>
+/// OBBとOBB（分離軸判定。分離軸が見つかった時点で打ち切る）
+/// </summary>
+bool IsIntersect(const OBB& obb1, const OBB& obb2);
+
+#pragma endregion
+
+#pragma region 一括判定
+
+/// <summary>
+/// 球と球の配列
+/// </summary>
+/// <param name="sphere">球</param>
+/// <param name="spheres">判定する球の配列</param>
+/// <param name="hits">交差した要素の番号（末尾に追加する）</param>
+/// <returns>交差した数</returns>
+size_t CollectIntersections(
+    const Sphere& sphere, std::span<const Sphere> spheres, std::vector<uint32_t>& hits);
+
+/// <summary>
+/// AABBとAABBの配列
+/// </summary>
+/// <param name="aabb">AABB</param>
+/// <param name="aabbs">判定するAABBの配列</param>
+/// <param name="hits">交差した要素の番号（末尾に追加する）</param>
+/// <returns>交差した数</returns>
+size_t CollectIntersections(
+    const AABB& aabb, std::span<const AABB> aabbs, std::vector<uint32_t>& hits);
+
+/// <summary>
+/// 球とAABBの配列
+/// </summary>
+/// <param name="sphere">球</param>
+/// <param name="aabbs">判定するAABBの配列</param>
+/// <param name="hits">交差した要素の番号（末尾に追加する）</param>
+/// <returns>交差した数</returns>
+size_t CollectIntersections(
+    const Sphere& sphere, std::span<const AABB> aabbs, std::vector<uint32_t>& hits);
+
+/// <summary>
+/// OBBとOBBの配列
+/// </summary>
+/// <param name="obb">OBB</param>
+/// <param name="obbs">判定するOBBの配列</param>
+/// <param name="hits">交差した要素の番号（末尾に追加する）</param>
+/// <returns>交差した数</returns>
+size_t CollectIntersections(
+    const OBB& obb, std::span<const OBB> obbs, std::vector<uint32_t>& hits);
+
+#pragma endregion
+
+} // namespace MathUtility
@@ -0,0 +1,531 @@
+#pragma once
+
+#include "Matrix4x4.h"
+#include "Vector2.h"
+#include "Vector3.h"
+#include "Vector4.h"
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+// SIMD命令の選択。MATH_DISABLE_SIMDを定義するとスカラー実装のみになる
+#if !defined(MATH_DISABLE_SIMD)
+#if defined(__AVX2__) || defined(__AVX__)
+#define MATH_ENABLE_AVX 1
+#endif
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATH_ENABLE_SSE 1
+#endif
+#endif
+
+#if defined(MATH_ENABLE_SSE) || defined(MATH_ENABLE_AVX)
+#include <immintrin.h>
+#endif
+
+// HLSLのrow_major定数バッファとそのまま共有するため、並びと大きさを固定する
+static_assert(sizeof(Vector2) == sizeof(float) * 2);
+static_assert(sizeof(Vector3) == sizeof(float) * 3);
+static_assert(sizeof(Vector4) == sizeof(float) * 4);
+static_assert(sizeof(Matrix4x4) == sizeof(float) * 16);
+static_assert(std::is_standard_layout_v<Vector3> && std::is_trivially_copyable_v<Vector3>);
+static_assert(std::is_standard_layout_v<Vector4> && std::is_trivially_copyable_v<Vector4>);
+static_assert(std::is_standard_layout_v<Matrix4x4> && std::is_trivially_copyable_v<Matrix4x4>);
+static_assert(offsetof(Vector3, z) == sizeof(float) * 2);
+static_assert(offsetof(Vector4, w) == sizeof(float) * 3);
+
+/// <summary>
+/// 数学関数
+/// </summary>
+/// <remarks>
+/// 行ベクトル（v * M）の規約。平行移動は m[3][0..2] に入る。
+/// 行列演算のうちSIMDの方が速いもの（逆行列、転置、AVXでの積）はSSE/AVXが使える場合は
+/// そちらで計算し、それ以外はスカラーで計算する。
+/// 三角関数・平方根を使わない関数はconstexprで、コンパイル時評価ではスカラー実装を通る。
+/// </remarks>
+namespace MathUtility {
+
+#pragma region ベクトル
+
+/// <summary>
+/// 加算
+/// </summary>
+constexpr Vector3 Add(const Vector3& v1, const Vector3& v2) {
+	return {v1.x + v2.x, v1.y + v2.y, v1.z + v2.z};
+}
+
+/// <summary>
+/// 減算
+/// </summary>
+constexpr Vector3 Subtract(const Vector3& v1, const Vector3& v2) {
+	return {v1.x - v2.x, v1.y - v2.y, v1.z - v2.z};
+}
+
+/// <summary>
+/// スカラー倍
+/// </summary>
+constexpr Vector3 Multiply(float scalar, const Vector3& v) {
+	return {scalar * v.x, scalar * v.y, scalar * v.z};
+}
+
+/// <summary>
+/// 内積
+/// </summary>
+constexpr float Dot(const Vector3& v1, const Vector3& v2) {
+	return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z;
+}
+
+/// <summary>
+/// 長さ（ノルム）
+/// </summary>
+inline float Length(const Vector3& v) { return std::sqrt(Dot(v, v)); }
+
+/// <summary>
+/// 正規化。長さ0のベクトルはそのまま返す
+/// </summary>
+inline Vector3 Normalize(const Vector3& v) {
+	float length = Length(v);
+	if (length == 0.0f) {
+		return v;
+	}
+	return Multiply(1.0f / length, v);
+}
+
+/// <summary>
+/// クロス積
+/// </summary>
+constexpr Vector3 Cross(const Vector3& v1, const Vector3& v2) {
+	return {v1.y * v2.z - v1.z * v2.y, v1.z * v2.x - v1.x * v2.z, v1.x * v2.y - v1.y * v2.x};
+}
+
+#pragma endregion
+
+#pragma region 行列
+
+/// <summary>
+/// 単位行列の作成
+/// </summary>
+constexpr Matrix4x4 MakeIdentity4x4() {
+	return {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+	        0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+}
+
+/// <summary>
+/// 行列の積 m1 * m2
+/// </summary>
+/// <remarks>
+/// AVXでは2行ずつ処理する。SSEだけの場合は4要素ずつのブロードキャストの手間で
+/// スカラー（コンパイラーの自動ベクトル化）と差が出ないので、スカラーで計算する。
+/// </remarks>
+constexpr Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2) {
+	Matrix4x4 result{};
+	if (!std::is_constant_evaluated()) {
+#if defined(MATH_ENABLE_AVX)
+		// 2行ずつ処理する。各レーンで自分の行の要素をブロードキャストして m2 の行と掛ける
+		__m256 row0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[0]));
+		__m256 row1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[1]));
+		__m256 row2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[2]));
+		__m256 row3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[3]));
+		for (int i = 0; i < 4; i += 2) {
+			__m256 a = _mm256_loadu_ps(m1.m[i]);
+			__m256 r = _mm256_mul_ps(_mm256_shuffle_ps(a, a, 0x00), row0);
+#if defined(__AVX2__)
+			r = _mm256_fmadd_ps(_mm256_shuffle_ps(a, a, 0x55), row1, r);
+			r = _mm256_fmadd_ps(_mm256_shuffle_ps(a, a, 0xaa), row2, r);
+			r = _mm256_fmadd_ps(_mm256_shuffle_ps(a, a, 0xff), row3, r);
+#else
+			r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(a, a, 0x55), row1));
+			r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(a, a, 0xaa), row2));
+			r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(a, a, 0xff), row3));
+#endif
+			_mm256_storeu_ps(result.m[i], r);
+		}
+		return result;
+#endif
+	}
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			result.m[i][j] = m1.m[i][0] * m2.m[0][j] + m1.m[i][1] * m2.m[1][j] +
+			                 m1.m[i][2] * m2.m[2][j] + m1.m[i][3] * m2.m[3][j];
+		}
+	}
+	return result;
+}
+
+/// <summary>
+/// 転置行列
+/// </summary>
+constexpr Matrix4x4 Transpose(const Matrix4x4& m) {
+	Matrix4x4 result{};
+	if (!std::is_constant_evaluated()) {
+#if defined(MATH_ENABLE_SSE)
+		__m128 row0 = _mm_loadu_ps(m.m[0]);
+		__m128 row1 = _mm_loadu_ps(m.m[1]);
+		__m128 row2 = _mm_loadu_ps(m.m[2]);
+		__m128 row3 = _mm_loadu_ps(m.m[3]);
+		_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+		_mm_storeu_ps(result.m[0], row0);
+		_mm_storeu_ps(result.m[1], row1);
+		_mm_storeu_ps(result.m[2], row2);
+		_mm_storeu_ps(result.m[3], row3);
+		return result;
+#endif
+	}
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			result.m[i][j] = m.m[j][i];
+		}
+	}
+	return result;
+}
+
+#if defined(MATH_ENABLE_SSE)
+namespace Internal {
+
+// _mm_shuffle_ps用のマスク（x, y, z, w の順に指定）
+#define MATH_SHUFFLE_MASK(x, y, z, w) ((x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
+
+// 2x2行列（行優先で xyzw = 00,01,10,11）の積 a * b
+inline __m128 Mat2Mul(__m128 a, __m128 b) {
+	return _mm_add_ps(
+	    _mm_mul_ps(a, _mm_shuffle_ps(b, b, MATH_SHUFFLE_MASK(0, 3, 0, 3))),
+	    _mm_mul_ps(
+	        _mm_shuffle_ps(a, a, MATH_SHUFFLE_MASK(1, 0, 3, 2)),
+	        _mm_shuffle_ps(b, b, MATH_SHUFFLE_MASK(2, 1, 2, 1))));
+}
+
+// 2x2行列の余因子行列との積 adj(a) * b
+inline __m128 Mat2AdjMul(__m128 a, __m128 b) {
+	return _mm_sub_ps(
+	    _mm_mul_ps(_mm_shuffle_ps(a, a, MATH_SHUFFLE_MASK(3, 3, 0, 0)), b),
+	    _mm_mul_ps(
+	        _mm_shuffle_ps(a, a, MATH_SHUFFLE_MASK(1, 1, 2, 2)),
+	        _mm_shuffle_ps(b, b, MATH_SHUFFLE_MASK(2, 3, 0, 1))));
+}
+
+// 2x2行列と余因子行列の積 a * adj(b)
+inline __m128 Mat2MulAdj(__m128 a, __m128 b) {
+	return _mm_sub_ps(
+	    _mm_mul_ps(a, _mm_shuffle_ps(b, b, MATH_SHUFFLE_MASK(3, 0, 3, 0))),
+	    _mm_mul_ps(
+	        _mm_shuffle_ps(a, a, MATH_SHUFFLE_MASK(1, 0, 3, 2)),
+	        _mm_shuffle_ps(b, b, MATH_SHUFFLE_MASK(2, 1, 2, 1))));
+}
+
+} // namespace Internal
+#endif
+
+/// <summary>
+/// 逆行列。正則でない行列を渡さないこと
+/// </summary>
+constexpr Matrix4x4 Inverse(const Matrix4x4& m) {
+	Matrix4x4 result{};
+	if (!std::is_constant_evaluated()) {
+#if defined(MATH_ENABLE_SSE)
+		using namespace Internal;
+		// 2x2のブロック行列 | A B | に分けて計算する
+		//                   | C D |
+		__m128 row0 = _mm_loadu_ps(m.m[0]);
+		__m128 row1 = _mm_loadu_ps(m.m[1]);
+		__m128 row2 = _mm_loadu_ps(m.m[2]);
+		__m128 row3 = _mm_loadu_ps(m.m[3]);
+
+		__m128 a = _mm_movelh_ps(row0, row1);
+		__m128 b = _mm_movehl_ps(row1, row0);
+		__m128 c = _mm_movelh_ps(row2, row3);
+		__m128 d = _mm_movehl_ps(row3, row2);
+
+		// 各ブロックの行列式 (|A|, |B|, |C|, |D|)
+		__m128 detSub = _mm_sub_ps(
+		    _mm_mul_ps(
+		        _mm_shuffle_ps(row0, row2, MATH_SHUFFLE_MASK(0, 2, 0, 2)),
+		        _mm_shuffle_ps(row1, row3, MATH_SHUFFLE_MASK(1, 3, 1, 3))),
+		    _mm_mul_ps(
+		        _mm_shuffle_ps(row0, row2, MATH_SHUFFLE_MASK(1, 3, 1, 3)),
+		        _mm_shuffle_ps(row1, row3, MATH_SHUFFLE_MASK(0, 2, 0, 2))));
+		__m128 detA = _mm_shuffle_ps(detSub, detSub, MATH_SHUFFLE_MASK(0, 0, 0, 0));
+		__m128 detB = _mm_shuffle_ps(detSub, detSub, MATH_SHUFFLE_MASK(1, 1, 1, 1));
+		__m128 detC = _mm_shuffle_ps(detSub, detSub, MATH_SHUFFLE_MASK(2, 2, 2, 2));
+		__m128 detD = _mm_shuffle_ps(detSub, detSub, MATH_SHUFFLE_MASK(3, 3, 3, 3));
+
+		__m128 dc = Mat2AdjMul(d, c);
+		__m128 ab = Mat2AdjMul(a, b);
+		// 逆行列の各ブロック（の余因子行列）
+		__m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), Mat2Mul(b, dc));
+		__m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), Mat2Mul(c, ab));
+		__m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), Mat2MulAdj(d, ab));
+		__m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), Mat2MulAdj(a, dc));
+
+		// |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+		__m128 det = _mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC));
+		__m128 tr = _mm_mul_ps(ab, _mm_shuffle_ps(dc, dc, MATH_SHUFFLE_MASK(0, 2, 1, 3)));
+		tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, MATH_SHUFFLE_MASK(2, 3, 0, 1)));
+		tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, MATH_SHUFFLE_MASK(1, 0, 3, 2)));
+		det = _mm_sub_ps(det, tr);
+		assert(_mm_cvtss_f32(det) != 0.0f);
+
+		// 余因子行列の符号を含めた 1/|M|
+		__m128 invDet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+		x = _mm_mul_ps(x, invDet);
+		y = _mm_mul_ps(y, invDet);
+		z = _mm_mul_ps(z, invDet);
+		w = _mm_mul_ps(w, invDet);
+
+		// 余因子行列の並べ替えと書き戻しを同時に行う
+		_mm_storeu_ps(result.m[0], _mm_shuffle_ps(x, y, MATH_SHUFFLE_MASK(3, 1, 3, 1)));
+		_mm_storeu_ps(result.m[1], _mm_shuffle_ps(x, y, MATH_SHUFFLE_MASK(2, 0, 2, 0)));
+		_mm_storeu_ps(result.m[2], _mm_shuffle_ps(z, w, MATH_SHUFFLE_MASK(3, 1, 3, 1)));
+		_mm_storeu_ps(result.m[3], _mm_shuffle_ps(z, w, MATH_SHUFFLE_MASK(2, 0, 2, 0)));
+		return result;
+#endif
+	}
+	const float(*a)[4] = m.m;
+	// 上2行と下2行の2x2小行列式
+	float s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+	float s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+	float s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+	float s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+	float s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+	float s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+	float c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+	float c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+	float c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+	float c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+	float c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+	float c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+
+	float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+	assert(det != 0.0f);
+	float invDet = 1.0f / det;
+
+	result.m[0][0] = (a[1][1] * c5 - a[1][2] * c4 + a[1][3] * c3) * invDet;
+	result.m[0][1] = (-a[0][1] * c5 + a[0][2] * c4 - a[0][3] * c3) * invDet;
+	result.m[0][2] = (a[3][1] * s5 - a[3][2] * s4 + a[3][3] * s3) * invDet;
+	result.m[0][3] = (-a[2][1] * s5 + a[2][2] * s4 - a[2][3] * s3) * invDet;
+	result.m[1][0] = (-a[1][0] * c5 + a[1][2] * c2 - a[1][3] * c1) * invDet;
+	result.m[1][1] = (a[0][0] * c5 - a[0][2] * c2 + a[0][3] * c1) * invDet;
+	result.m[1][2] = (-a[3][0] * s5 + a[3][2] * s2 - a[3][3] * s1) * invDet;
+	result.m[1][3] = (a[2][0] * s5 - a[2][2] * s2 + a[2][3] * s1) * invDet;
+	result.m[2][0] = (a[1][0] * c4 - a[1][1] * c2 + a[1][3] * c0) * invDet;
+	result.m[2][1] = (-a[0][0] * c4 + a[0][1] * c2 - a[0][3] * c0) * invDet;
+	result.m[2][2] = (a[3][0] * s4 - a[3][1] * s2 + a[3][3] * s0) * invDet;
+	result.m[2][3] = (-a[2][0] * s4 + a[2][1] * s2 - a[2][3] * s0) * invDet;
+	result.m[3][0] = (-a[1][0] * c3 + a[1][1] * c1 - a[1][2] * c0) * invDet;
+	result.m[3][1] = (a[0][0] * c3 - a[0][1] * c1 + a[0][2] * c0) * invDet;
+	result.m[3][2] = (-a[3][0] * s3 + a[3][1] * s1 - a[3][2] * s0) * invDet;
+	result.m[3][3] = (a[2][0] * s3 - a[2][1] * s1 + a[2][2] * s0) * invDet;
+	return result;
+}
+
+/// <summary>
+/// 平行移動行列の作成
+/// </summary>
+constexpr Matrix4x4 MakeTranslateMatrix(const Vector3& translate) {
+	return {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+	        0.0f, 0.0f, 1.0f, 0.0f, translate.x, translate.y, translate.z, 1.0f};
+}
+
+/// <summary>
+/// 拡大縮小行列の作成
+/// </summary>
+constexpr Matrix4x4 MakeScaleMatrix(const Vector3& scale) {
+	return {scale.x, 0.0f, 0.0f, 0.0f, 0.0f, scale.y, 0.0f, 0.0f,
+	        0.0f, 0.0f, scale.z, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+}
+
+/// <summary>
+/// X軸回転行列の作成（計算済みのsin, cosから）
+/// </summary>
+constexpr Matrix4x4 MakeRotateXMatrix(float s, float c) {
+	return {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, c, s, 0.0f, 0.0f, -s, c, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+}
+
+/// <summary>
+/// X軸回転行列の作成
+/// </summary>
+inline Matrix4x4 MakeRotateXMatrix(float radian) {
+	return MakeRotateXMatrix(std::sin(radian), std::cos(radian));
+}
+
+/// <summary>
+/// Y軸回転行列の作成（計算済みのsin, cosから）
+/// </summary>
+constexpr Matrix4x4 MakeRotateYMatrix(float s, float c) {
+	return {c, 0.0f, -s, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, s, 0.0f, c, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+}
+
+/// <summary>
+/// Y軸回転行列の作成
+/// </summary>
+inline Matrix4x4 MakeRotateYMatrix(float radian) {
+	return MakeRotateYMatrix(std::sin(radian), std::cos(radian));
+}
+
+/// <summary>
+/// Z軸回転行列の作成（計算済みのsin, cosから）
+/// </summary>
+constexpr Matrix4x4 MakeRotateZMatrix(float s, float c) {
+	return {c, s, 0.0f, 0.0f, -s, c, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+}
+
+/// <summary>
+/// Z軸回転行列の作成
+/// </summary>
+inline Matrix4x4 MakeRotateZMatrix(float radian) {
+	return MakeRotateZMatrix(std::sin(radian), std::cos(radian));
+}
+
+/// <summary>
+/// アフィン変換行列の作成 S * (Rx * Ry * Rz) * T
+/// </summary>
+/// <param name="scale">拡大縮小</param>
+/// <param name="rotate">回転（オイラー角、ラジアン）</param>
+/// <param name="translate">平行移動</param>
+inline Matrix4x4
+    MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
+	float sx = std::sin(rotate.x), cx = std::cos(rotate.x);
+	float sy = std::sin(rotate.y), cy = std::cos(rotate.y);
+	float sz = std::sin(rotate.z), cz = std::cos(rotate.z);
+
+	// Rx * Ry * Rz を展開したもの
+	Matrix4x4 result;
+	result.m[0][0] = scale.x * (cy * cz);
+	result.m[0][1] = scale.x * (cy * sz);
+	result.m[0][2] = scale.x * (-sy);
+	result.m[0][3] = 0.0f;
+	result.m[1][0] = scale.y * (sx * sy * cz - cx * sz);
+	result.m[1][1] = scale.y * (sx * sy * sz + cx * cz);
+	result.m[1][2] = scale.y * (sx * cy);
+	result.m[1][3] = 0.0f;
+	result.m[2][0] = scale.z * (cx * sy * cz + sx * sz);
+	result.m[2][1] = scale.z * (cx * sy * sz - sx * cz);
+	result.m[2][2] = scale.z * (cx * cy);
+	result.m[2][3] = 0.0f;
+	result.m[3][0] = translate.x;
+	result.m[3][1] = translate.y;
+	result.m[3][2] = translate.z;
+	result.m[3][3] = 1.0f;
+	return result;
+}
+
+/// <summary>
+/// 正射影行列の作成（深度は0～1）
+/// </summary>
+constexpr Matrix4x4 MakeOrthographicMatrix(
+    float left, float top, float right, float bottom, float nearClip, float farClip) {
+	assert(right != left && top != bottom && farClip != nearClip);
+	float width = right - left;
+	float height = top - bottom;
+	float depth = farClip - nearClip;
+	return {2.0f / width, 0.0f, 0.0f, 0.0f, 0.0f, 2.0f / height, 0.0f, 0.0f,
+	        0.0f, 0.0f, 1.0f / depth, 0.0f, -(left + right) / width, -(top + bottom) / height,
+	        -nearClip / depth, 1.0f};
+}
+
+/// <summary>
+/// 透視投影行列の作成（計算済みの縦方向スケールから、深度は0～1）
+/// </summary>
+/// <param name="scaleY">1 / tan(縦画角 / 2)</param>
+/// <param name="aspectRatio">アスペクト比（幅 / 高さ）</param>
+/// <param name="nearClip">近平面</param>
+/// <param name="farClip">遠平面</param>
+constexpr Matrix4x4
+    MakePerspectiveMatrix(float scaleY, float aspectRatio, float nearClip, float farClip) {
+	assert(aspectRatio != 0.0f && farClip != nearClip);
+	float depth = farClip - nearClip;
+	return {scaleY / aspectRatio, 0.0f, 0.0f, 0.0f, 0.0f, scaleY, 0.0f, 0.0f,
+	        0.0f, 0.0f, farClip / depth, 1.0f, 0.0f, 0.0f, -nearClip * farClip / depth, 0.0f};
+}
+
+/// <summary>
+/// 透視投影行列の作成（深度は0～1）
+/// </summary>
+/// <param name="fovY">縦画角（ラジアン）</param>
+/// <param name="aspectRatio">アスペクト比（幅 / 高さ）</param>
+/// <param name="nearClip">近平面</param>
+/// <param name="farClip">遠平面</param>
+inline Matrix4x4
+    MakePerspectiveFovMatrix(float fovY, float aspectRatio, float nearClip, float farClip) {
+	return MakePerspectiveMatrix(1.0f / std::tan(fovY * 0.5f), aspectRatio, nearClip, farClip);
+}
+
+#pragma endregion
+
+#pragma region 変換
+
+/// <summary>
+/// 4次元ベクトルの変換 v * m
+/// </summary>
+/// <remarks>
+/// SIMDにはしない。1つのベクトルでは成分のブロードキャストと結果の格納・再読み込みが
+/// 計算より重く、スカラーの方が速い（多数の点はBatchTransformでまとめて変換する）。
+/// </remarks>
+constexpr Vector4 Transform(const Vector4& v, const Matrix4x4& m) {
+	Vector4 result{};
+	result.x = v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0] + v.w * m.m[3][0];
+	result.y = v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1] + v.w * m.m[3][1];
+	result.z = v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2] + v.w * m.m[3][2];
+	result.w = v.x * m.m[0][3] + v.y * m.m[1][3] + v.z * m.m[2][3] + v.w * m.m[3][3];
+	return result;
+}
+
+/// <summary>
+/// 座標変換（w=1として変換し、wで除算する）
+/// </summary>
+constexpr Vector3 Transform(const Vector3& v, const Matrix4x4& m) {
+	Vector4 r = Transform(Vector4{v.x, v.y, v.z, 1.0f}, m);
+	assert(r.w != 0.0f);
+	float invW = 1.0f / r.w;
+	return {r.x * invW, r.y * invW, r.z * invW};
+}
+
+/// <summary>
+/// 方向ベクトルの変換（平行移動を含まない）
+/// </summary>
+constexpr Vector3 TransformNormal(const Vector3& v, const Matrix4x4& m) {
+	return {
+	    v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0],
+	    v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1],
+	    v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2]};
+}
+
+#pragma endregion
+
+#pragma region コンパイル時評価の確認
+
+namespace Internal {
+
+// 行列の全要素が許容誤差内で等しいか
+constexpr bool NearlyEqual(const Matrix4x4& m1, const Matrix4x4& m2, float epsilon = 1.0e-5f) {
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			float diff = m1.m[i][j] - m2.m[i][j];
+			if (diff < -epsilon || epsilon < diff) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+} // namespace Internal
+
+static_assert(Internal::NearlyEqual(
+    Multiply(MakeTranslateMatrix({1.0f, 2.0f, 3.0f}), MakeTranslateMatrix({-1.0f, 0.0f, 1.0f})),
+    MakeTranslateMatrix({0.0f, 2.0f, 4.0f})));
+static_assert(Internal::NearlyEqual(
+    Inverse(MakeScaleMatrix({2.0f, 4.0f, 0.5f})), MakeScaleMatrix({0.5f, 0.25f, 2.0f})));
+static_assert(Internal::NearlyEqual(
+    Multiply(MakeRotateZMatrix(1.0f, 0.0f), Transpose(MakeRotateZMatrix(1.0f, 0.0f))),
+    MakeIdentity4x4()));
+static_assert(
+    Transform(Vector3{1.0f, 2.0f, 3.0f}, MakeTranslateMatrix({1.0f, 1.0f, 1.0f})).z == 4.0f);
+static_assert(Cross(Vector3{1.0f, 0.0f, 0.0f}, Vector3{0.0f, 1.0f, 0.0f}).z == 1.0f);
+static_assert(
+    Transform(Vector3{0.0f, 0.0f, 1.0f}, MakeOrthographicMatrix(-1, 1, 1, -1, 0, 1)).z == 1.0f);
+
+#pragma endregion
+
+} // namespace MathUtility
+
+#undef MATH_SHUFFLE_MASK
@@ -0,0 +1,244 @@
+#include "PerlinNoise.h"
+#include "BatchTransform.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+// AVX2カーネルを含めるか。BatchTransformと同じく関数単位で有効にし、実行時に切り替える
+#if !defined(MATH_DISABLE_SIMD) &&                                                               \
+    (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__))
+#define MATH_NOISE_AVX2 1
+#include <immintrin.h>
+#endif
+
+#if defined(MATH_NOISE_AVX2) && (defined(__GNUC__) || defined(__clang__))
+#define MATH_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define MATH_TARGET_AVX2
+#endif
+
+namespace {
+
+// 出力を[-1,1]に収める係数（係数を掛ける前の絶対値の最大は約1.51）
+const float kScale = 0.66f;
+// オクターブごとに格子をずらす量（格子点で全オクターブが0になるのを避ける）
+const float kOctaveOffsetX = 19.19f;
+const float kOctaveOffsetY = 7.37f;
+
+// 1行分のノイズに振幅を掛けて加算するカーネル
+using NoiseRowKernel = void (*)(
+    const int32_t* permutation, float x0, float dx, float y, float amplitude, float* result,
+    size_t count);
+
+/// <summary>
+/// フェード関数 6t^5 - 15t^4 + 10t^3
+/// </summary>
+float Fade(float t) { return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f); }
+
+float Lerp(float t, float a, float b) { return a + t * (b - a); }
+
+/// <summary>
+/// ハッシュの下位3bitで選んだ勾配と、格子点からの距離の内積
+/// </summary>
+float Grad(int32_t hash, float x, float y) {
+	int32_t h = hash & 7;
+	float u = h < 4 ? x : y;
+	float v = h < 4 ? y : x;
+	return ((h & 1) ? -u : u) + ((h & 2) ? -2.0f * v : 2.0f * v);
+}
+
+/// <summary>
+/// スカラー版のノイズ（係数を掛ける前）
+/// </summary>
+float NoiseScalar(const int32_t* permutation, float x, float y) {
+	float xFloor = std::floor(x);
+	float yFloor = std::floor(y);
+	int32_t xi = static_cast<int32_t>(xFloor) & (PerlinNoise::kPermutationSize - 1);
+	int32_t yi = static_cast<int32_t>(yFloor) & (PerlinNoise::kPermutationSize - 1);
+	float xf = x - xFloor;
+	float yf = y - yFloor;
+	float u = Fade(xf);
+	float v = Fade(yf);
+
+	int32_t a = permutation[xi] + yi;
+	int32_t b = permutation[xi + 1] + yi;
+	float x1 = Lerp(u, Grad(permutation[a], xf, yf), Grad(permutation[b], xf - 1.0f, yf));
+	float x2 = Lerp(
+	    u, Grad(permutation[a + 1], xf, yf - 1.0f), Grad(permutation[b + 1], xf - 1.0f, yf - 1.0f));
+	return Lerp(v, x1, x2);
+}
+
+/// <summary>
+/// スカラー版カーネル
+/// </summary>
+void NoiseRowScalar(
+    const int32_t* permutation, float x0, float dx, float y, float amplitude, float* result,
+    size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		result[i] += amplitude * NoiseScalar(permutation, x0 + float(i) * dx, y);
+	}
+}
+
+#if defined(MATH_NOISE_AVX2)
+/// <summary>
+/// AVX2版の勾配と距離の内積（Gradと同じ選び方を符号ビットの操作で行う）
+/// </summary>
+MATH_TARGET_AVX2 __m256 GradAVX2(__m256i hash, __m256 x, __m256 y) {
+	__m256i h = _mm256_and_si256(hash, _mm256_set1_epi32(7));
+	__m256 isLow = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(4), h));
+	__m256 u = _mm256_blendv_ps(y, x, isLow);
+	__m256 v = _mm256_blendv_ps(x, y, isLow);
+	// bit0をuの符号、bit1をvの符号にする
+	__m256i bit0 = _mm256_and_si256(h, _mm256_set1_epi32(1));
+	__m256i bit1 = _mm256_and_si256(h, _mm256_set1_epi32(2));
+	__m256 signU = _mm256_castsi256_ps(_mm256_slli_epi32(bit0, 31));
+	__m256 signV = _mm256_castsi256_ps(_mm256_slli_epi32(bit1, 30));
+	u = _mm256_xor_ps(u, signU);
+	v = _mm256_xor_ps(_mm256_add_ps(v, v), signV);
+	return _mm256_add_ps(u, v);
+}
+
+/// <summary>
+/// AVX2版カーネル（8点ずつ処理）
+/// </summary>
+MATH_TARGET_AVX2 void NoiseRowAVX2(
+    const int32_t* permutation, float x0, float dx, float y, float amplitude, float* result,
+    size_t count) {
+	// yは行内で一定なので先に求めておく
+	float yFloor = std::floor(y);
+	int32_t yi = static_cast<int32_t>(yFloor) & (PerlinNoise::kPermutationSize - 1);
+	float yf = y - yFloor;
+	__m256 yf0 = _mm256_set1_ps(yf);
+	__m256 yf1 = _mm256_set1_ps(yf - 1.0f);
+	__m256 v = _mm256_set1_ps(Fade(yf));
+	__m256i yIndex = _mm256_set1_epi32(yi);
+
+	__m256i mask = _mm256_set1_epi32(PerlinNoise::kPermutationSize - 1);
+	__m256i oneI = _mm256_set1_epi32(1);
+	__m256 one = _mm256_set1_ps(1.0f);
+	__m256 six = _mm256_set1_ps(6.0f);
+	__m256 fifteen = _mm256_set1_ps(15.0f);
+	__m256 ten = _mm256_set1_ps(10.0f);
+	__m256 lane = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+	__m256 start = _mm256_set1_ps(x0);
+	__m256 step = _mm256_set1_ps(dx);
+	__m256 scale = _mm256_set1_ps(amplitude);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256 index = _mm256_add_ps(_mm256_set1_ps(float(i)), lane);
+		__m256 x = _mm256_add_ps(start, _mm256_mul_ps(index, step));
+		__m256 xFloor = _mm256_floor_ps(x);
+		__m256 xf = _mm256_sub_ps(x, xFloor);
+		__m256i xi = _mm256_and_si256(_mm256_cvttps_epi32(xFloor), mask);
+
+		// u = Fade(xf)
+		__m256 u = _mm256_fmsub_ps(xf, six, fifteen);
+		u = _mm256_fmadd_ps(xf, u, ten);
+		u = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(xf, xf), xf), u);
+
+		// 4隅のハッシュ
+		__m256i a = _mm256_add_epi32(_mm256_i32gather_epi32(permutation, xi, 4), yIndex);
+		__m256i b = _mm256_add_epi32(
+		    _mm256_i32gather_epi32(permutation, _mm256_add_epi32(xi, oneI), 4), yIndex);
+		__m256i aa = _mm256_i32gather_epi32(permutation, a, 4);
+		__m256i ba = _mm256_i32gather_epi32(permutation, b, 4);
+		__m256i ab = _mm256_i32gather_epi32(permutation, _mm256_add_epi32(a, oneI), 4);
+		__m256i bb = _mm256_i32gather_epi32(permutation, _mm256_add_epi32(b, oneI), 4);
+
+		__m256 xf1 = _mm256_sub_ps(xf, one);
+		__m256 gaa = GradAVX2(aa, xf, yf0);
+		__m256 gba = GradAVX2(ba, xf1, yf0);
+		__m256 gab = GradAVX2(ab, xf, yf1);
+		__m256 gbb = GradAVX2(bb, xf1, yf1);
+		__m256 x1 = _mm256_fmadd_ps(u, _mm256_sub_ps(gba, gaa), gaa);
+		__m256 x2 = _mm256_fmadd_ps(u, _mm256_sub_ps(gbb, gab), gab);
+		__m256 noise = _mm256_fmadd_ps(v, _mm256_sub_ps(x2, x1), x1);
+
+		__m256 sum = _mm256_fmadd_ps(scale, noise, _mm256_loadu_ps(result + i));
+		_mm256_storeu_ps(result + i, sum);
+	}
+
+	// 端数
+	NoiseRowScalar(permutation, x0 + float(i) * dx, dx, y, amplitude, result + i, count - i);
+}
+#endif
+
+/// <summary>
+/// 使用するカーネルの取得（初回に判定）
+/// </summary>
+NoiseRowKernel GetNoiseRowKernel() {
+	static const NoiseRowKernel kernel = []() -> NoiseRowKernel {
+#if defined(MATH_NOISE_AVX2)
+		if (MathUtility::IsAVX2Supported()) {
+			return NoiseRowAVX2;
+		}
+#endif
+		return NoiseRowScalar;
+	}();
+	return kernel;
+}
+
+} // namespace
+
+void PerlinNoise::SetSeed(uint32_t seed) {
+	// 処理系によって結果が変わらないよう、std::shuffleは使わずに並べ替える
+	std::array<int32_t, kPermutationSize> table;
+	std::iota(table.begin(), table.end(), 0);
+	std::mt19937 random(seed);
+	for (uint32_t i = kPermutationSize - 1; 0 < i; i--) {
+		std::swap(table[i], table[random() % (i + 1)]);
+	}
+	for (uint32_t i = 0; i < kPermutationSize * 2; i++) {
+		permutation_[i] = table[i % kPermutationSize];
+	}
+}
+
+float PerlinNoise::Noise(float x, float y) const {
+	return kScale * NoiseScalar(permutation_.data(), x, y);
+}
+
+float PerlinNoise::Fbm(float x, float y, const Fractal& fractal) const {
+	float sum = 0.0f;
+	float amplitudeSum = 0.0f;
+	float frequency = 1.0f;
+	float amplitude = 1.0f;
+	for (uint32_t octave = 0; octave < fractal.octaveCount; octave++) {
+		float offsetX = kOctaveOffsetX * float(octave);
+		float offsetY = kOctaveOffsetY * float(octave);
+		sum += amplitude *
+		       NoiseScalar(permutation_.data(), x * frequency + offsetX, y * frequency + offsetY);
+		amplitudeSum += amplitude;
+		frequency *= fractal.lacunarity;
+		amplitude *= fractal.gain;
+	}
+	return 0.0f < amplitudeSum ? kScale * sum / amplitudeSum : 0.0f;
+}
+
+void PerlinNoise::FbmRow(
+    float x0, float dx, float y, const Fractal& fractal, std::span<float> result) const {
+	std::fill(result.begin(), result.end(), 0.0f);
+	NoiseRowKernel kernel = GetNoiseRowKernel();
+
+	float amplitudeSum = 0.0f;
+	float frequency = 1.0f;
+	float amplitude = 1.0f;
+	for (uint32_t octave = 0; octave < fractal.octaveCount; octave++) {
+		float offsetX = kOctaveOffsetX * float(octave);
+		float offsetY = kOctaveOffsetY * float(octave);
+		kernel(
+		    permutation_.data(), x0 * frequency + offsetX, dx * frequency,
+		    y * frequency + offsetY, amplitude, result.data(), result.size());
+		amplitudeSum += amplitude;
+		frequency *= fractal.lacunarity;
+		amplitude *= fractal.gain;
+	}
+
+	if (0.0f < amplitudeSum) {
+		float normalize = kScale / amplitudeSum;
+		for (float& value : result) {
+			value *= normalize;
+		}
+	}
+}
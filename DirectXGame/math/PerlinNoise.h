@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+/// <summary>
+/// 2次元の改良パーリンノイズ
+/// </summary>
+/// <remarks>
+/// 1行分（yが同じでxが等間隔）をまとめて評価する関数を持ち、AVX2が使えれば8点ずつ処理する。
+/// 格子の勾配は順列表から引くので、同じシードなら同じ値になる。
+/// </remarks>
+class PerlinNoise {
+public: // サブクラス
+	/// <summary>
+	/// 複数オクターブの重ね合わせ（fBm）の設定
+	/// </summary>
+	struct Fractal {
+		uint32_t octaveCount = 4; // オクターブ数
+		float lacunarity = 2.0f;  // オクターブごとの周波数の倍率
+		float gain = 0.5f;        // オクターブごとの振幅の倍率
+	};
+
+	// 順列表の大きさ（格子はこの周期で繰り返す）
+	static constexpr uint32_t kPermutationSize = 256;
+
+public: // メンバ関数
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	/// <param name="seed">シード</param>
+	explicit PerlinNoise(uint32_t seed = 0) { SetSeed(seed); }
+
+	/// <summary>
+	/// シードの設定（順列表を作り直す）
+	/// </summary>
+	/// <param name="seed">シード</param>
+	void SetSeed(uint32_t seed);
+
+	/// <summary>
+	/// ノイズ
+	/// </summary>
+	/// <param name="x">X座標</param>
+	/// <param name="y">Y座標</param>
+	/// <returns>[-1,1]の値（格子点では0）</returns>
+	float Noise(float x, float y) const;
+
+	/// <summary>
+	/// 複数オクターブのノイズ（振幅の合計で割って[-1,1]に収める）
+	/// </summary>
+	/// <param name="x">X座標</param>
+	/// <param name="y">Y座標</param>
+	/// <param name="fractal">設定</param>
+	/// <returns>[-1,1]の値</returns>
+	float Fbm(float x, float y, const Fractal& fractal) const;
+
+	/// <summary>
+	/// 1行分の複数オクターブのノイズ。result[i] = Fbm(x0 + i * dx, y)
+	/// </summary>
+	/// <param name="x0">先頭のX座標</param>
+	/// <param name="dx">X座標の間隔</param>
+	/// <param name="y">Y座標</param>
+	/// <param name="fractal">設定</param>
+	/// <param name="result">結果</param>
+	void FbmRow(
+	    float x0, float dx, float y, const Fractal& fractal, std::span<float> result) const;
+
+private: // メンバ変数
+	// 順列表（添字の折り返しを省くため2周分）
+	std::array<int32_t, kPermutationSize * 2> permutation_;
+};
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "MathUtility.h"
+#include <cmath>
+#include <type_traits>
+
+/// <summary>
+/// クォータニオン
+/// </summary>
+struct Quaternion final {
+	float x;
+	float y;
+	float z;
+	float w;
+};
+
+static_assert(sizeof(Quaternion) == sizeof(float) * 4);
+static_assert(std::is_standard_layout_v<Quaternion> && std::is_trivially_copyable_v<Quaternion>);
+
+/// <summary>
+/// クォータニオン関数
+/// </summary>
+/// <remarks>
+/// 積 q1 * q2 は q2 の回転の後に q1 の回転を行う。行ベクトル規約の行列では
+/// MakeRotateMatrix(q1 * q2) == MakeRotateMatrix(q2) * MakeRotateMatrix(q1) となる。
+/// </remarks>
+namespace MathUtility {
+
+/// <summary>
+/// 単位クォータニオン
+/// </summary>
+constexpr Quaternion IdentityQuaternion() { return {0.0f, 0.0f, 0.0f, 1.0f}; }
+
+/// <summary>
+/// 積 q1 * q2
+/// </summary>
+constexpr Quaternion Multiply(const Quaternion& q1, const Quaternion& q2) {
+	if (!std::is_constant_evaluated()) {
+#if defined(MATH_ENABLE_SSE)
+		// 各成分の係数を q2 の並べ替えと符号で表して4回の積和にする
+		__m128 b = _mm_loadu_ps(&q2.x);
+		__m128 r = _mm_mul_ps(_mm_set1_ps(q1.w), b);
+		r = _mm_add_ps(
+		    r, _mm_mul_ps(
+		           _mm_set1_ps(q1.x), _mm_mul_ps(
+		                                  _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3)),
+		                                  _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f))));
+		r = _mm_add_ps(
+		    r, _mm_mul_ps(
+		           _mm_set1_ps(q1.y), _mm_mul_ps(
+		                                  _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)),
+		                                  _mm_setr_ps(1.0f, 1.0f, -1.0f, -1.0f))));
+		r = _mm_add_ps(
+		    r, _mm_mul_ps(
+		           _mm_set1_ps(q1.z), _mm_mul_ps(
+		                                  _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)),
+		                                  _mm_setr_ps(-1.0f, 1.0f, 1.0f, -1.0f))));
+		Quaternion result;
+		_mm_storeu_ps(&result.x, r);
+		return result;
+#endif
+	}
+	return {
+	    q1.w * q2.x + q1.x * q2.w + q1.y * q2.z - q1.z * q2.y,
+	    q1.w * q2.y - q1.x * q2.z + q1.y * q2.w + q1.z * q2.x,
+	    q1.w * q2.z + q1.x * q2.y - q1.y * q2.x + q1.z * q2.w,
+	    q1.w * q2.w - q1.x * q2.x - q1.y * q2.y - q1.z * q2.z};
+}
+
+/// <summary>
+/// 内積
+/// </summary>
+constexpr float Dot(const Quaternion& q1, const Quaternion& q2) {
+	return q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w;
+}
+
+/// <summary>
+/// 共役
+/// </summary>
+constexpr Quaternion Conjugate(const Quaternion& q) { return {-q.x, -q.y, -q.z, q.w}; }
+
+/// <summary>
+/// ノルム
+/// </summary>
+inline float Norm(const Quaternion& q) { return std::sqrt(Dot(q, q)); }
+
+/// <summary>
+/// 正規化。ノルム0のクォータニオンは単位クォータニオンにする
+/// </summary>
+inline Quaternion Normalize(const Quaternion& q) {
+#if defined(MATH_ENABLE_SSE)
+	__m128 v = _mm_loadu_ps(&q.x);
+	// 全レーンに内積を行き渡らせる
+	__m128 dot = _mm_mul_ps(v, v);
+	dot = _mm_add_ps(dot, _mm_shuffle_ps(dot, dot, _MM_SHUFFLE(2, 3, 0, 1)));
+	dot = _mm_add_ps(dot, _mm_shuffle_ps(dot, dot, _MM_SHUFFLE(1, 0, 3, 2)));
+	if (_mm_cvtss_f32(dot) == 0.0f) {
+		return IdentityQuaternion();
+	}
+	Quaternion result;
+	_mm_storeu_ps(&result.x, _mm_div_ps(v, _mm_sqrt_ps(dot)));
+	return result;
+#else
+	float norm = Norm(q);
+	if (norm == 0.0f) {
+		return IdentityQuaternion();
+	}
+	float inv = 1.0f / norm;
+	return {q.x * inv, q.y * inv, q.z * inv, q.w * inv};
+#endif
+}
+
+/// <summary>
+/// 逆クォータニオン
+/// </summary>
+constexpr Quaternion Inverse(const Quaternion& q) {
+	float normSq = Dot(q, q);
+	assert(normSq != 0.0f);
+	Quaternion c = Conjugate(q);
+	return {c.x / normSq, c.y / normSq, c.z / normSq, c.w / normSq};
+}
+
+/// <summary>
+/// 任意軸回転を表すクォータニオンの作成
+/// </summary>
+/// <param name="axis">回転軸（正規化済み）</param>
+/// <param name="angle">回転角（ラジアン）</param>
+inline Quaternion MakeRotateAxisAngleQuaternion(const Vector3& axis, float angle) {
+	float s = std::sin(angle * 0.5f);
+	return {axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f)};
+}
+
+/// <summary>
+/// オイラー角からクォータニオンを作成。MakeAffineMatrixと同じくX→Y→Zの順に回転する
+/// </summary>
+/// <param name="rotate">回転（オイラー角、ラジアン）</param>
+inline Quaternion MakeRotateQuaternion(const Vector3& rotate) {
+	float sx = std::sin(rotate.x * 0.5f), cx = std::cos(rotate.x * 0.5f);
+	float sy = std::sin(rotate.y * 0.5f), cy = std::cos(rotate.y * 0.5f);
+	float sz = std::sin(rotate.z * 0.5f), cz = std::cos(rotate.z * 0.5f);
+	// qz * qy * qx を展開したもの
+	return {
+	    sx * cy * cz - cx * sy * sz,
+	    cx * sy * cz + sx * cy * sz,
+	    cx * cy * sz - sx * sy * cz,
+	    cx * cy * cz + sx * sy * sz};
+}
+
+/// <summary>
+/// ベクトルの回転
+/// </summary>
+constexpr Vector3 RotateVector(const Vector3& v, const Quaternion& q) {
+	// v' = v + 2w(u×v) + 2u×(u×v)
+	Vector3 u = {q.x, q.y, q.z};
+	Vector3 t = Multiply(2.0f, Cross(u, v));
+	return Add(Add(v, Multiply(q.w, t)), Cross(u, t));
+}
+
+/// <summary>
+/// 回転行列の作成（単位クォータニオンを渡すこと）
+/// </summary>
+constexpr Matrix4x4 MakeRotateMatrix(const Quaternion& q) {
+	float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+	float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+	float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+	return {1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f,
+	        2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f,
+	        2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f,
+	        0.0f, 0.0f, 0.0f, 1.0f};
+}
+
+/// <summary>
+/// アフィン変換行列の作成 S * R * T（回転はクォータニオン）
+/// </summary>
+/// <param name="scale">拡大縮小</param>
+/// <param name="rotate">回転（単位クォータニオン）</param>
+/// <param name="translate">平行移動</param>
+constexpr Matrix4x4
+    MakeAffineMatrix(const Vector3& scale, const Quaternion& rotate, const Vector3& translate) {
+	Matrix4x4 result = MakeRotateMatrix(rotate);
+	for (int j = 0; j < 3; j++) {
+		result.m[0][j] *= scale.x;
+		result.m[1][j] *= scale.y;
+		result.m[2][j] *= scale.z;
+	}
+	result.m[3][0] = translate.x;
+	result.m[3][1] = translate.y;
+	result.m[3][2] = translate.z;
+	return result;
+}
+
+/// <summary>
+/// 正規化線形補間（tに対して角速度は一定でないが、Slerpより軽い）
+/// </summary>
+inline Quaternion Nlerp(const Quaternion& q0, const Quaternion& q1, float t) {
+	// 遠回りしないよう符号を揃える
+	float sign = Dot(q0, q1) < 0.0f ? -1.0f : 1.0f;
+	float t0 = 1.0f - t;
+	float t1 = t * sign;
+	return Normalize(
+	    {q0.x * t0 + q1.x * t1, q0.y * t0 + q1.y * t1, q0.z * t0 + q1.z * t1,
+	     q0.w * t0 + q1.w * t1});
+}
+
+/// <summary>
+/// 球面線形補間
+/// </summary>
+inline Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t) {
+	float dot = Dot(q0, q1);
+	// 遠回りしないよう符号を揃える
+	float sign = 1.0f;
+	if (dot < 0.0f) {
+		dot = -dot;
+		sign = -1.0f;
+	}
+
+	// ほぼ同じ向きならsinθが0に近く不安定なので線形補間
+	const float kNlerpThreshold = 0.9995f;
+	if (kNlerpThreshold < dot) {
+		return Nlerp(q0, q1, t);
+	}
+
+	float theta = std::acos(dot);
+	float invSin = 1.0f / std::sin(theta);
+	float t0 = std::sin((1.0f - t) * theta) * invSin;
+	float t1 = std::sin(t * theta) * invSin * sign;
+	return {
+	    q0.x * t0 + q1.x * t1, q0.y * t0 + q1.y * t1, q0.z * t0 + q1.z * t1,
+	    q0.w * t0 + q1.w * t1};
+}
+
+} // namespace MathUtility
@@ -0,0 +1,339 @@
+#pragma once
+
+#include "MathUtility.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <type_traits>
+
+/// <summary>
+/// 球
+/// </summary>
+struct Sphere final {
+	Vector3 center; // 中心
+	float radius;   // 半径
+};
+
+/// <summary>
+/// 軸平行境界箱
+/// </summary>
+struct AABB final {
+	Vector3 min; // 最小点
+	Vector3 max; // 最大点
+};
+
+/// <summary>
+/// 平面（dot(normal, p) == distance を満たす点 p の集合。法線側を表とする）
+/// </summary>
+struct Plane final {
+	Vector3 normal; // 法線（正規化済み）
+	float distance; // 原点からの距離
+};
+
+/// <summary>
+/// 半直線
+/// </summary>
+struct Ray final {
+	Vector3 origin;    // 始点
+	Vector3 direction; // 方向（正規化済み）
+};
+
+/// <summary>
+/// 線分（origin から origin + diff まで）
+/// </summary>
+struct Segment final {
+	Vector3 origin; // 始点
+	Vector3 diff;   // 終点への差分ベクトル
+};
+
+/// <summary>
+/// カプセル（線分から半径以内の領域）
+/// </summary>
+struct Capsule final {
+	Segment segment; // 中心線
+	float radius;    // 半径
+};
+
+/// <summary>
+/// 三角形
+/// </summary>
+struct Triangle final {
+	Vector3 vertices[3]; // 頂点
+};
+
+/// <summary>
+/// 有向境界箱
+/// </summary>
+struct OBB final {
+	Vector3 center;          // 中心
+	Vector3 orientations[3]; // 座標軸（正規化・直交済み）
+	Vector3 size;            // 中心から各面までの距離
+};
+
+/// <summary>
+/// 視錐台（法線は内側を向く）
+/// </summary>
+struct Frustum final {
+	// 平面の並び
+	enum PlaneIndex {
+		kLeft,
+		kRight,
+		kBottom,
+		kTop,
+		kNear,
+		kFar,
+		kPlaneCount,
+	};
+	Plane planes[kPlaneCount];
+};
+
+// SIMDでまとめて読み込むため、球と平面は4要素ちょうどにする
+static_assert(sizeof(Sphere) == sizeof(float) * 4);
+static_assert(sizeof(Plane) == sizeof(float) * 4);
+static_assert(sizeof(AABB) == sizeof(float) * 6);
+static_assert(std::is_trivially_copyable_v<Sphere> && std::is_trivially_copyable_v<AABB>);
+
+/// <summary>
+/// 図形関数
+/// </summary>
+namespace MathUtility {
+
+/// <summary>
+/// 点の集合を囲むAABBの作成の初期値（Mergeで広げていく）
+/// </summary>
+constexpr AABB MakeEmptyAABB() {
+	return {{FLT_MAX, FLT_MAX, FLT_MAX}, {-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+}
+
+/// <summary>
+/// AABBが空か
+/// </summary>
+constexpr bool IsEmpty(const AABB& aabb) {
+	return aabb.max.x < aabb.min.x || aabb.max.y < aabb.min.y || aabb.max.z < aabb.min.z;
+}
+
+/// <summary>
+/// AABBに点を含める
+/// </summary>
+constexpr AABB Merge(const AABB& aabb, const Vector3& point) {
+	return {
+	    {std::min(aabb.min.x, point.x), std::min(aabb.min.y, point.y),
+	     std::min(aabb.min.z, point.z)},
+	    {std::max(aabb.max.x, point.x), std::max(aabb.max.y, point.y),
+	     std::max(aabb.max.z, point.z)}};
+}
+
+/// <summary>
+/// 2つのAABBを囲むAABB
+/// </summary>
+constexpr AABB Merge(const AABB& a, const AABB& b) {
+	return {
+	    {std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z)},
+	    {std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z)}};
+}
+
+/// <summary>
+/// AABBの中心
+/// </summary>
+constexpr Vector3 GetCenter(const AABB& aabb) {
+	return Multiply(0.5f, Add(aabb.min, aabb.max));
+}
+
+/// <summary>
+/// AABBの中心から各面までの距離
+/// </summary>
+constexpr Vector3 GetExtents(const AABB& aabb) {
+	return Multiply(0.5f, Subtract(aabb.max, aabb.min));
+}
+
+/// <summary>
+/// AABBの表面積（SAHの評価用）
+/// </summary>
+constexpr float GetSurfaceArea(const AABB& aabb) {
+	Vector3 size = Subtract(aabb.max, aabb.min);
+	return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+/// <summary>
+/// AABBを囲む球
+/// </summary>
+inline Sphere MakeBoundingSphere(const AABB& aabb) {
+	return {GetCenter(aabb), Length(GetExtents(aabb))};
+}
+
+/// <summary>
+/// AABBの変換。変換後の8頂点を囲むAABBを返す
+/// </summary>
+constexpr AABB Transform(const AABB& aabb, const Matrix4x4& m) {
+	// 行列の各要素と最小・最大の積のうち小さい方と大きい方を足し合わせる
+	AABB result = {{m.m[3][0], m.m[3][1], m.m[3][2]}, {m.m[3][0], m.m[3][1], m.m[3][2]}};
+	const float* minValues = &aabb.min.x;
+	const float* maxValues = &aabb.max.x;
+	float* resultMin = &result.min.x;
+	float* resultMax = &result.max.x;
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			float a = m.m[i][j] * minValues[i];
+			float b = m.m[i][j] * maxValues[i];
+			resultMin[j] += std::min(a, b);
+			resultMax[j] += std::max(a, b);
+		}
+	}
+	return result;
+}
+
+/// <summary>
+/// 球の変換。拡大率が軸ごとに異なる場合は最大の拡大率で半径を広げる
+/// </summary>
+inline Sphere Transform(const Sphere& sphere, const Matrix4x4& m) {
+	float scaleSq = std::max(
+	    {Dot(Vector3{m.m[0][0], m.m[0][1], m.m[0][2]}, Vector3{m.m[0][0], m.m[0][1], m.m[0][2]}),
+	     Dot(Vector3{m.m[1][0], m.m[1][1], m.m[1][2]}, Vector3{m.m[1][0], m.m[1][1], m.m[1][2]}),
+	     Dot(Vector3{m.m[2][0], m.m[2][1], m.m[2][2]}, Vector3{m.m[2][0], m.m[2][1], m.m[2][2]})});
+	return {Transform(sphere.center, m), sphere.radius * std::sqrt(scaleSq)};
+}
+
+/// <summary>
+/// 点と平面の符号付き距離（法線側が正）
+/// </summary>
+constexpr float SignedDistance(const Plane& plane, const Vector3& point) {
+	return Dot(plane.normal, point) - plane.distance;
+}
+
+/// <summary>
+/// ビュープロジェクション行列から視錐台を作成（深度0～1の射影を想定）
+/// </summary>
+/// <param name="viewProjection">ビュー行列 * 射影行列</param>
+inline Frustum MakeFrustum(const Matrix4x4& viewProjection) {
+	const Matrix4x4& m = viewProjection;
+	// クリップ座標は v * m なので、各成分は行列の列との内積になる
+	auto column = [&m](int j) { return Vector4{m.m[0][j], m.m[1][j], m.m[2][j], m.m[3][j]}; };
+	Vector4 x = column(0), y = column(1), z = column(2), w = column(3);
+	// -w <= x <= w, -w <= y <= w, 0 <= z <= w
+	Vector4 coefficients[Frustum::kPlaneCount] = {
+	    {w.x + x.x, w.y + x.y, w.z + x.z, w.w + x.w},
+	    {w.x - x.x, w.y - x.y, w.z - x.z, w.w - x.w},
+	    {w.x + y.x, w.y + y.y, w.z + y.z, w.w + y.w},
+	    {w.x - y.x, w.y - y.y, w.z - y.z, w.w - y.w},
+	    z,
+	    {w.x - z.x, w.y - z.y, w.z - z.z, w.w - z.w},
+	};
+
+	Frustum frustum;
+	for (int i = 0; i < Frustum::kPlaneCount; i++) {
+		const Vector4& c = coefficients[i];
+		Vector3 normal = {c.x, c.y, c.z};
+		float inv = 1.0f / Length(normal);
+		frustum.planes[i] = {Multiply(inv, normal), -c.w * inv};
+	}
+	return frustum;
+}
+
+/// <summary>
+/// 球が視錐台と交差するか（保守的に判定するため、角付近の一部は交差扱いになる）
+/// </summary>
+constexpr bool IsIntersect(const Frustum& frustum, const Sphere& sphere) {
+	for (const Plane& plane : frustum.planes) {
+		if (SignedDistance(plane, sphere.center) < -sphere.radius) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/// <summary>
+/// AABBが視錐台と交差するか（保守的に判定するため、角付近の一部は交差扱いになる）
+/// </summary>
+inline bool IsIntersect(const Frustum& frustum, const AABB& aabb) {
+	Vector3 center = GetCenter(aabb);
+	Vector3 extents = GetExtents(aabb);
+	for (const Plane& plane : frustum.planes) {
+		// 法線方向へのAABBの投影半径
+		float radius = extents.x * std::abs(plane.normal.x) +
+		               extents.y * std::abs(plane.normal.y) +
+		               extents.z * std::abs(plane.normal.z);
+		if (SignedDistance(plane, center) < -radius) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/// <summary>
+/// スラブ法で使う方向の逆数
+/// </summary>
+/// <remarks>
+/// 0（と非正規化数）の成分は 1 / 0 にせず0を返す。その軸は交差判定でスラブの内外だけを調べるので
+/// 逆数は使わない（無限大を使うと、始点がスラブの面上にあるとき 0 * 無限大 がNaNになる）。
+/// </remarks>
+inline Vector3 MakeInverseDirection(const Vector3& direction) {
+	auto inverse = [](float value) { return std::abs(value) < FLT_MIN ? 0.0f : 1.0f / value; };
+	return {inverse(direction.x), inverse(direction.y), inverse(direction.z)};
+}
+
+/// <summary>
+/// 半直線とAABBの交差判定（スラブ法）
+/// </summary>
+/// <param name="ray">半直線</param>
+/// <param name="inverseDirection">方向の各成分の逆数（MakeInverseDirectionで求めること）</param>
+/// <param name="aabb">AABB</param>
+/// <param name="maxDistance">判定する最大距離</param>
+/// <param name="distance">交差する場合、入る点までの距離（始点が内側なら0）</param>
+/// <remarks>面上の点は内側として扱う</remarks>
+inline bool IsIntersect(
+    const Ray& ray, const Vector3& inverseDirection, const AABB& aabb, float maxDistance,
+    float& distance) {
+	float tNear = 0.0f;
+	float tFar = maxDistance;
+	for (int axis = 0; axis < 3; axis++) {
+		float origin = (&ray.origin.x)[axis];
+		float min = (&aabb.min.x)[axis];
+		float max = (&aabb.max.x)[axis];
+		// 軸に平行なら、始点がスラブの内側にあるかだけで決まる
+		if (std::abs((&ray.direction.x)[axis]) < FLT_MIN) {
+			if (origin < min || max < origin) {
+				return false;
+			}
+			continue;
+		}
+		float t1 = (min - origin) * (&inverseDirection.x)[axis];
+		float t2 = (max - origin) * (&inverseDirection.x)[axis];
+		tNear = std::max(tNear, std::min(t1, t2));
+		tFar = std::min(tFar, std::max(t1, t2));
+	}
+	distance = tNear;
+	return tNear <= tFar;
+}
+
+/// <summary>
+/// 球とAABBの交差判定
+/// </summary>
+constexpr bool IsIntersect(const Sphere& sphere, const AABB& aabb) {
+	// AABB上の最近接点までの距離で判定
+	Vector3 closest = {
+	    std::clamp(sphere.center.x, aabb.min.x, aabb.max.x),
+	    std::clamp(sphere.center.y, aabb.min.y, aabb.max.y),
+	    std::clamp(sphere.center.z, aabb.min.z, aabb.max.z)};
+	Vector3 diff = Subtract(closest, sphere.center);
+	return Dot(diff, diff) <= sphere.radius * sphere.radius;
+}
+
+/// <summary>
+/// スクリーン座標を通る半直線の作成
+/// </summary>
+/// <param name="screenPosition">スクリーン座標（左上原点、ピクセル単位）</param>
+/// <param name="viewProjection">ビュー行列 * 射影行列</param>
+/// <param name="width">スクリーンの幅</param>
+/// <param name="height">スクリーンの高さ</param>
+/// <returns>近平面上の点から奥へ向かう半直線</returns>
+inline Ray MakeScreenRay(
+    const Vector2& screenPosition, const Matrix4x4& viewProjection, float width, float height) {
+	float ndcX = screenPosition.x / width * 2.0f - 1.0f;
+	float ndcY = 1.0f - screenPosition.y / height * 2.0f;
+	Matrix4x4 inverse = Inverse(viewProjection);
+	Vector3 nearPoint = Transform(Vector3{ndcX, ndcY, 0.0f}, inverse);
+	Vector3 farPoint = Transform(Vector3{ndcX, ndcY, 1.0f}, inverse);
+	return {nearPoint, Normalize(Subtract(farPoint, nearPoint))};
+}
+
+} // namespace MathUtility
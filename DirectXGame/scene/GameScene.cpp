@@ -1,6 +1,12 @@
 #include "GameScene.h"
+#include "DebugText.h"
+#include "JobSystem.h"
 #include "TextureManager.h"
 #include <cassert>
+#include <chrono>
+#include <format>
+#include <span>
+#include <string>
 
 GameScene::GameScene() {}
 
@@ -11,6 +17,22 @@ void GameScene::Initialize() {
 	dxCommon_ = DirectXCommon::GetInstance();
 	input_ = Input::GetInstance();
 	audio_ = Audio::GetInstance();
+
+	// 並列記録の計測用に、格子状に並べた立方体を用意する
+	model_.reset(Model::Create());
+	worldTransforms_.resize(kBenchmarkModelCount);
+	const uint32_t columnCount = 64;
+	for (uint32_t i = 0; i < kBenchmarkModelCount; i++) {
+		WorldTransform& worldTransform = worldTransforms_[i];
+		worldTransform.Initialize();
+		worldTransform.scale_ = {0.4f, 0.4f, 0.4f};
+		worldTransform.translation_ = {
+		    float(i % columnCount) - columnCount * 0.5f,
+		    float(i / columnCount) - kBenchmarkModelCount / columnCount * 0.5f, 0.0f};
+		worldTransform.UpdateMatrix();
+	}
+	viewProjection_.translation_ = {0.0f, 0.0f, -80.0f};
+	viewProjection_.Initialize();
 }
 
 void GameScene::Update() {}
@@ -35,6 +57,9 @@ void GameScene::Draw() {
 #pragma endregion
 
 #pragma region 3Dオブジェクト描画
+	// 並列記録の計測（メインのコマンドリストへの記録より前に行う）
+	DrawParallelRecordingBenchmark();
+
 	// 3Dオブジェクト描画前処理
 	Model::PreDraw(commandList);
 
@@ -59,3 +84,48 @@ void GameScene::Draw() {
 
 #pragma endregion
 }
+
+void GameScene::DrawParallelRecordingBenchmark() {
+	const uint32_t workerCount = kWorkerCounts[workerCountIndex_];
+
+	// コマンドリストの用意から全モデルの記録までを測る（実行は含まない）
+	auto start = std::chrono::steady_clock::now();
+	std::span<ID3D12GraphicsCommandList* const> commandLists =
+	    dxCommon_->BeginParallelRecording(workerCount);
+	Model::PreDrawParallel(commandLists);
+	// モデルをコマンドリストの数に等分し、チャンク番号のコマンドリストへ記録する
+	const size_t grainSize = (worldTransforms_.size() + workerCount - 1) / workerCount;
+	JobSystem::GetInstance()->ParallelFor(
+	    worldTransforms_.size(), grainSize, [&](size_t begin, size_t end) {
+		    ID3D12GraphicsCommandList* commandList = commandLists[begin / grainSize];
+		    for (size_t i = begin; i < end; i++) {
+			    model_->Draw(commandList, worldTransforms_[i], viewProjection_);
+		    }
+	    });
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+	dxCommon_->EndParallelRecording();
+	recordingMilliseconds_[workerCountIndex_] += elapsed.count();
+
+	// 次のコマンドリスト数へ
+	if (++measureFrame_ < kMeasureFrameCount) {
+		return;
+	}
+	measureFrame_ = 0;
+	if (++workerCountIndex_ < std::size(kWorkerCounts)) {
+		return;
+	}
+	workerCountIndex_ = 0;
+
+	// 1フレームあたりの平均を出力して測り直す
+	// ワーカースレッドより多いコマンドリストは同時には記録されない
+	std::string message = std::format(
+	    "Parallel recording ({} draws, {} threads):", worldTransforms_.size(),
+	    JobSystem::GetInstance()->GetConcurrency());
+	for (size_t i = 0; i < std::size(kWorkerCounts); i++) {
+		message += std::format(
+		    " {}: {:.3f} ms", kWorkerCounts[i], recordingMilliseconds_[i] / kMeasureFrameCount);
+		recordingMilliseconds_[i] = 0.0;
+	}
+	message += "\n";
+	DebugText::GetInstance()->ConsolePrintf("%s", message.c_str());
+}
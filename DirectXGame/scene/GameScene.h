@@ -7,6 +7,9 @@
 #include "Sprite.h"
 #include "ViewProjection.h"
 #include "WorldTransform.h"
+#include <iterator>
+#include <memory>
+#include <vector>
 
 /// <summary>
 /// ゲームシーン
@@ -39,6 +42,16 @@ public: // メンバ関数
 	/// </summary>
 	void Draw();
 
+private: // メンバ関数
+	/// <summary>
+	/// 多数のモデルの描画を並列記録し、CPUでの記録時間を測る
+	/// </summary>
+	/// <remarks>
+	/// kMeasureFrameCountフレームごとにコマンドリスト（ワーカー）の数を切り替え、
+	/// 全ての数を測り終えたら平均の記録時間を出力する
+	/// </remarks>
+	void DrawParallelRecordingBenchmark();
+
 private: // メンバ変数
 	DirectXCommon* dxCommon_ = nullptr;
 	Input* input_ = nullptr;
@@ -47,4 +60,24 @@ private: // メンバ変数
 	/// <summary>
 	/// ゲームシーン用
 	/// </summary>
+
+	// 並列記録の計測で描画するモデルの数
+	static const uint32_t kBenchmarkModelCount = 4096;
+	// 並列記録するコマンドリストの数
+	static inline const uint32_t kWorkerCounts[] = {1, 2, 4, 8};
+	// 1つのコマンドリスト数で計測するフレーム数
+	static const uint32_t kMeasureFrameCount = 120;
+
+	// 計測用のモデル
+	std::unique_ptr<Model> model_;
+	// 計測用のワールドトランスフォーム
+	std::vector<WorldTransform> worldTransforms_;
+	// ビュープロジェクション
+	ViewProjection viewProjection_;
+	// 計測中のコマンドリスト数の番号
+	uint32_t workerCountIndex_ = 0;
+	// 計測中のコマンドリスト数での経過フレーム
+	uint32_t measureFrame_ = 0;
+	// コマンドリスト数ごとの記録時間の合計（ミリ秒）
+	double recordingMilliseconds_[std::size(kWorkerCounts)] = {};
 };
@@ -0,0 +1,92 @@
+#include "BVH.h"
+#include "Benchmark.h"
+#include "JobSystem.h"
+#include <random>
+#include <vector>
+
+using namespace MathUtility;
+
+int main() {
+	// 箱の数
+	const size_t kCount = 100000;
+	// 半直線・球の数
+	const size_t kQueryCount = 10000;
+	// 総当たりで比べる半直線の数
+	const size_t kBruteForceCount = 100;
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	jobSystem->Initialize();
+	std::printf("JobSystem: %u threads\n", jobSystem->GetConcurrency());
+
+	std::mt19937 engine(1);
+	std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+	std::uniform_real_distribution<float> size(0.5f, 4.0f);
+	std::vector<AABB> bounds(kCount);
+	for (AABB& aabb : bounds) {
+		aabb.min = {position(engine), position(engine), position(engine)};
+		aabb.max = Add(aabb.min, {size(engine), size(engine), size(engine)});
+	}
+	std::vector<Ray> rays(kQueryCount);
+	for (Ray& ray : rays) {
+		ray.origin = {position(engine), position(engine), position(engine)};
+		ray.direction = Normalize({position(engine), position(engine), position(engine)});
+	}
+
+	BVH bvh;
+	double seconds = Benchmark::Measure([&] { bvh.Build(bounds); });
+	Benchmark::Report("Build (100k boxes)", kCount, seconds, "boxes");
+	std::printf("  nodes: %zu\n", bvh.GetNodeCount());
+
+	// 1%の物体を動かしてRefit
+	std::uniform_int_distribution<uint32_t> index(0, uint32_t(kCount - 1));
+	seconds = Benchmark::Measure([&] {
+		for (size_t i = 0; i < kCount / 100; i++) {
+			uint32_t object = index(engine);
+			bvh.UpdateBounds(object, bounds[object]);
+		}
+		bvh.Refit();
+	});
+	Benchmark::Report("UpdateBounds + Refit (1%)", kCount / 100, seconds, "boxes");
+
+	size_t hitCount = 0;
+	seconds = Benchmark::Measure([&] {
+		hitCount = 0;
+		for (const Ray& ray : rays) {
+			BVH::RaycastHit hit;
+			hitCount += bvh.Raycast(ray, hit) ? 1 : 0;
+		}
+	});
+	Benchmark::Report("Raycast", kQueryCount, seconds, "rays");
+	std::printf("  hits: %zu / %zu\n", hitCount, kQueryCount);
+
+	// 比較対象の総当たり
+	seconds = Benchmark::Measure(
+	    [&] {
+		    for (size_t i = 0; i < kBruteForceCount; i++) {
+			    const Ray& ray = rays[i];
+			    Vector3 inverseDirection = MakeInverseDirection(ray.direction);
+			    float nearest = FLT_MAX;
+			    for (const AABB& aabb : bounds) {
+				    float distance = 0.0f;
+				    if (IsIntersect(ray, inverseDirection, aabb, nearest, distance)) {
+					    nearest = distance;
+				    }
+			    }
+			    Benchmark::DoNotOptimize(nearest);
+		    }
+	    },
+	    1);
+	Benchmark::Report("Raycast (brute force)", kBruteForceCount, seconds, "rays");
+
+	std::vector<uint32_t> result;
+	seconds = Benchmark::Measure([&] {
+		result.clear();
+		for (const Ray& ray : rays) {
+			bvh.Query(Sphere{ray.origin, 10.0f}, result);
+		}
+	});
+	Benchmark::Report("Query (sphere r=10)", kQueryCount, seconds, "queries");
+
+	jobSystem->Finalize();
+	return 0;
+}
@@ -0,0 +1,153 @@
+#include "BVH.h"
+#include "TestFramework.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace MathUtility;
+
+namespace {
+
+// 比較用: 全ての物体との半直線判定
+BVH::RaycastHit ReferenceRaycast(const std::vector<AABB>& bounds, const Ray& ray) {
+	Vector3 inverseDirection = MakeInverseDirection(ray.direction);
+	BVH::RaycastHit hit;
+	for (uint32_t i = 0; i < bounds.size(); i++) {
+		float distance = 0.0f;
+		if (IsIntersect(ray, inverseDirection, bounds[i], hit.distance, distance) &&
+		    distance < hit.distance) {
+			hit.index = i;
+			hit.distance = distance;
+		}
+	}
+	return hit;
+}
+
+// 比較用: 全ての物体との球判定
+std::vector<uint32_t> ReferenceQuery(const std::vector<AABB>& bounds, const Sphere& sphere) {
+	std::vector<uint32_t> result;
+	for (uint32_t i = 0; i < bounds.size(); i++) {
+		if (IsIntersect(sphere, bounds[i])) {
+			result.push_back(i);
+		}
+	}
+	return result;
+}
+
+// 格子点上に置いた箱（面が同じ平面に並び、半直線の始点が面上に来やすい）
+std::vector<AABB> MakeGridBoxes(size_t count, uint32_t seed) {
+	std::mt19937 engine(seed);
+	std::uniform_int_distribution<int> position(-20, 20);
+	std::uniform_int_distribution<int> size(1, 3);
+	std::vector<AABB> bounds(count);
+	for (AABB& aabb : bounds) {
+		aabb.min = {float(position(engine)), float(position(engine)), float(position(engine))};
+		aabb.max = Add(aabb.min, {float(size(engine)), float(size(engine)), float(size(engine))});
+	}
+	return bounds;
+}
+
+} // namespace
+
+TEST(SlabTestWithZeroDirection) {
+	AABB aabb{{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}};
+	Ray ray{{-5.0f, 0.5f, 1.0f}, {1.0f, 0.0f, 0.0f}};
+	float distance = -1.0f;
+
+	// 始点がz = max.zの面上にある（0 * 無限大のNaNにならないこと）
+	EXPECT_TRUE(IsIntersect(ray, MakeInverseDirection(ray.direction), aabb, FLT_MAX, distance));
+	EXPECT_NEAR(distance, 4.0f, 0.0f);
+	// 面の外側
+	ray.origin.z = 1.001f;
+	EXPECT_FALSE(IsIntersect(ray, MakeInverseDirection(ray.direction), aabb, FLT_MAX, distance));
+	// 面の内側
+	ray.origin.z = 0.999f;
+	EXPECT_TRUE(IsIntersect(ray, MakeInverseDirection(ray.direction), aabb, FLT_MAX, distance));
+	// 負の0
+	ray = {{-5.0f, -1.0f, -1.0f}, {1.0f, -0.0f, -0.0f}};
+	EXPECT_TRUE(IsIntersect(ray, MakeInverseDirection(ray.direction), aabb, FLT_MAX, distance));
+	EXPECT_NEAR(distance, 4.0f, 0.0f);
+	// 始点がx = min.xの面上にあり、その面に沿って進む
+	ray = {{-1.0f, -5.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+	EXPECT_TRUE(IsIntersect(ray, MakeInverseDirection(ray.direction), aabb, FLT_MAX, distance));
+	EXPECT_NEAR(distance, 4.0f, 0.0f);
+	// 非正規化数の方向成分
+	ray = {{-5.0f, 1.0f, 0.0f}, {1.0f, 1.0e-40f, 0.0f}};
+	EXPECT_TRUE(IsIntersect(ray, MakeInverseDirection(ray.direction), aabb, FLT_MAX, distance));
+	// 後ろ向き・届かない
+	ray = {{-5.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}};
+	EXPECT_FALSE(IsIntersect(ray, MakeInverseDirection(ray.direction), aabb, FLT_MAX, distance));
+	ray = {{-5.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}};
+	EXPECT_FALSE(IsIntersect(ray, MakeInverseDirection(ray.direction), aabb, 3.9f, distance));
+}
+
+TEST(RaycastAxisAlignedOnFaces) {
+	// 軸方向の半直線を格子点から飛ばし、始点が箱の面上にある場合を多く含める
+	std::vector<AABB> bounds = MakeGridBoxes(2000, 1);
+	BVH bvh;
+	bvh.Build(bounds);
+
+	std::mt19937 engine(2);
+	std::uniform_int_distribution<int> position(-25, 25);
+	std::uniform_int_distribution<int> axis(0, 5);
+	for (int i = 0; i < 2000; i++) {
+		Vector3 direction{};
+		(&direction.x)[axis(engine) % 3] = axis(engine) < 3 ? 1.0f : -1.0f;
+		Ray ray{{float(position(engine)), float(position(engine)), float(position(engine))},
+		        direction};
+		BVH::RaycastHit hit;
+		bool isHit = bvh.Raycast(ray, hit);
+		BVH::RaycastHit expected = ReferenceRaycast(bounds, ray);
+		EXPECT_EQ(isHit, expected.index != UINT32_MAX);
+		EXPECT_NEAR(hit.distance, expected.distance, 0.0f);
+	}
+}
+
+TEST(RaycastMatchesBruteForce) {
+	std::vector<AABB> bounds = MakeGridBoxes(5000, 3);
+	BVH bvh;
+	bvh.Build(bounds);
+
+	std::mt19937 engine(4);
+	std::uniform_real_distribution<float> distribution(-30.0f, 30.0f);
+	for (int i = 0; i < 2000; i++) {
+		Ray ray{
+		    {distribution(engine), distribution(engine), distribution(engine)},
+		    Normalize({distribution(engine), distribution(engine), distribution(engine)})};
+		BVH::RaycastHit hit;
+		bool isHit = bvh.Raycast(ray, hit, 40.0f);
+		BVH::RaycastHit expected = ReferenceRaycast(bounds, ray);
+		bool expectedHit = expected.index != UINT32_MAX && expected.distance <= 40.0f;
+		EXPECT_EQ(isHit, expectedHit);
+		if (isHit && expectedHit) {
+			EXPECT_NEAR(hit.distance, expected.distance, 1.0e-4f);
+		}
+	}
+}
+
+TEST(QueryAfterRefit) {
+	std::vector<AABB> bounds = MakeGridBoxes(3000, 5);
+	BVH bvh;
+	bvh.Build(bounds);
+
+	// 一部の物体を動かしてRefitする
+	std::mt19937 engine(6);
+	std::uniform_int_distribution<uint32_t> index(0, uint32_t(bounds.size() - 1));
+	std::uniform_real_distribution<float> offset(-10.0f, 10.0f);
+	for (int i = 0; i < 100; i++) {
+		uint32_t object = index(engine);
+		Vector3 move{offset(engine), offset(engine), offset(engine)};
+		bounds[object] = {Add(bounds[object].min, move), Add(bounds[object].max, move)};
+		bvh.UpdateBounds(object, bounds[object]);
+	}
+	bvh.Refit();
+
+	std::uniform_real_distribution<float> position(-25.0f, 25.0f);
+	for (int i = 0; i < 200; i++) {
+		Sphere sphere{{position(engine), position(engine), position(engine)}, 4.0f};
+		std::vector<uint32_t> result;
+		bvh.Query(sphere, result);
+		std::sort(result.begin(), result.end());
+		EXPECT_TRUE(result == ReferenceQuery(bounds, sphere));
+	}
+}
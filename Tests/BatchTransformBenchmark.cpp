@@ -0,0 +1,49 @@
+#include "BatchTransform.h"
+#include "Benchmark.h"
+#include "MathUtility.h"
+#include <random>
+#include <vector>
+
+using namespace MathUtility;
+
+int main() {
+	// 点の数
+	const size_t kCount = 1 << 20;
+
+	std::printf("BatchTransform: %s\n", IsAVX2Supported() ? "AVX2" : "scalar");
+
+	std::mt19937 engine(1);
+	std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+	std::vector<Vector3> points(kCount);
+	for (Vector3& point : points) {
+		point = {distribution(engine), distribution(engine), distribution(engine)};
+	}
+	std::vector<Vector3> result(kCount);
+	Matrix4x4 m = MakeAffineMatrix({1.5f, 0.5f, 2.0f}, {0.3f, -1.2f, 2.1f}, {4.0f, -5.0f, 6.0f});
+
+	// 比較対象の1点ずつの変換
+	double seconds = Benchmark::Measure([&] {
+		for (size_t i = 0; i < kCount; i++) {
+			result[i] = Transform(points[i], m);
+		}
+		Benchmark::DoNotOptimize(result);
+	});
+	Benchmark::Report("Transform (scalar loop)", kCount, seconds, "points");
+
+	seconds = Benchmark::Measure([&] {
+		TransformPoints(m, points, result);
+		Benchmark::DoNotOptimize(result);
+	});
+	Benchmark::Report("TransformPoints (AoS)", kCount, seconds, "points");
+
+	Vector3SoA soa;
+	ToSoA(points, soa);
+	Vector3SoA soaResult;
+	soaResult.resize(kCount);
+	seconds = Benchmark::Measure([&] {
+		TransformPoints(m, soa, soaResult);
+		Benchmark::DoNotOptimize(soaResult);
+	});
+	Benchmark::Report("TransformPoints (SoA)", kCount, seconds, "points");
+	return 0;
+}
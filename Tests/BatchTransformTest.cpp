@@ -0,0 +1,67 @@
+#include "BatchTransform.h"
+#include "MathUtility.h"
+#include "TestFramework.h"
+#include <random>
+#include <vector>
+
+using namespace MathUtility;
+
+namespace {
+
+// 乱数で作った座標配列
+std::vector<Vector3> RandomPoints(size_t count, uint32_t seed) {
+	std::mt19937 engine(seed);
+	std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+	std::vector<Vector3> points(count);
+	for (Vector3& point : points) {
+		point = {distribution(engine), distribution(engine), distribution(engine)};
+	}
+	return points;
+}
+
+// 1点ずつ変換した結果と比べる
+void ExpectMatchesTransform(
+    const Matrix4x4& m, const std::vector<Vector3>& points, const std::vector<Vector3>& result) {
+	for (size_t i = 0; i < points.size(); i++) {
+		Vector3 expected = Transform(points[i], m);
+		EXPECT_NEAR(result[i].x, expected.x, 1.0e-3f);
+		EXPECT_NEAR(result[i].y, expected.y, 1.0e-3f);
+		EXPECT_NEAR(result[i].z, expected.z, 1.0e-3f);
+	}
+}
+
+} // namespace
+
+TEST(TransformPointsMatchesTransform) {
+	Matrix4x4 m = MakeAffineMatrix({1.5f, 0.5f, 2.0f}, {0.3f, -1.2f, 2.1f}, {4.0f, -5.0f, 6.0f});
+	// ブロックとSIMD幅の端数を含む要素数
+	for (size_t count : {size_t(0), size_t(1), size_t(7), size_t(8), size_t(255), size_t(1000)}) {
+		std::vector<Vector3> points = RandomPoints(count, uint32_t(count));
+		std::vector<Vector3> result(count);
+		TransformPoints(m, points, result);
+		ExpectMatchesTransform(m, points, result);
+	}
+}
+
+TEST(TransformPointsInPlace) {
+	Matrix4x4 m = MakeAffineMatrix({1.0f, 1.0f, 1.0f}, {0.0f, 0.5f, 0.0f}, {1.0f, 2.0f, 3.0f});
+	std::vector<Vector3> points = RandomPoints(300, 1);
+	std::vector<Vector3> result = points;
+	TransformPoints(m, result, result);
+	ExpectMatchesTransform(m, points, result);
+}
+
+TEST(TransformPointsSoAMatchesAoS) {
+	// 射影変換（wでの除算を含む）
+	Matrix4x4 m = Multiply(
+	    MakeTranslateMatrix({0.0f, 0.0f, 300.0f}),
+	    MakePerspectiveFovMatrix(0.8f, 16.0f / 9.0f, 0.1f, 1000.0f));
+	std::vector<Vector3> points = RandomPoints(1003, 2);
+	Vector3SoA soa;
+	ToSoA(points, soa);
+	Vector3SoA soaResult;
+	TransformPoints(m, soa, soaResult);
+	std::vector<Vector3> result(points.size());
+	ToAoS(soaResult, result);
+	ExpectMatchesTransform(m, points, result);
+}
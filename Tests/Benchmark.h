@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+/// <summary>
+/// 最小限のベンチマーク基盤
+/// </summary>
+/// <remarks>
+/// 同じ処理を何度か計測して最短時間を採り、1秒あたりの処理数を表示する。
+/// </remarks>
+namespace Benchmark {
+
+/// <summary>
+/// 最適化で計算が消されないようにする
+/// </summary>
+template<typename T> inline void DoNotOptimize(const T& value) {
+	asm volatile("" : : "g"(&value) : "memory");
+}
+
+/// <summary>
+/// 最短の実行時間を計測する
+/// </summary>
+/// <param name="func">計測する処理</param>
+/// <param name="repeat">計測回数</param>
+/// <returns>秒</returns>
+template<typename Func> inline double Measure(Func&& func, int repeat = 5) {
+	double best = 1.0e30;
+	for (int i = 0; i < repeat; i++) {
+		auto begin = std::chrono::steady_clock::now();
+		func();
+		auto end = std::chrono::steady_clock::now();
+		best = std::min(best, std::chrono::duration<double>(end - begin).count());
+	}
+	return best;
+}
+
+/// <summary>
+/// 結果の表示（1秒あたりの処理数はk, M, Gの接頭辞を付けて表示する）
+/// </summary>
+/// <param name="name">名前</param>
+/// <param name="items">1回の処理数</param>
+/// <param name="seconds">1回の時間（秒）</param>
+/// <param name="unit">処理数の単位</param>
+inline void Report(const char* name, size_t items, double seconds, const char* unit = "items") {
+	double perSecond = double(items) / seconds;
+	const char* prefix = "";
+	if (1.0e9 <= perSecond) {
+		perSecond *= 1.0e-9;
+		prefix = "G";
+	} else if (1.0e6 <= perSecond) {
+		perSecond *= 1.0e-6;
+		prefix = "M";
+	} else if (1.0e3 <= perSecond) {
+		perSecond *= 1.0e-3;
+		prefix = "k";
+	}
+	std::printf("%-44s %10.3f ms %10.2f %s%s/s\n", name, seconds * 1.0e3, perSecond, prefix, unit);
+}
+
+} // namespace Benchmark
@@ -0,0 +1,133 @@
+#include "Benchmark.h"
+#include "BroadPhase.h"
+#include "Collision.h"
+#include <random>
+#include <vector>
+
+using namespace MathUtility;
+
+namespace {
+
+// 計測するフレーム数
+const int kFrameCount = 5;
+
+// 1フレームで動く最大距離
+const float kStep = 0.1f;
+
+/// <summary>
+/// 物体の配置（密度が一定になるよう、物体数に合わせて広さを決める）
+/// </summary>
+/// <remarks>
+/// z方向は全物体が重なる範囲に置き、3軸で判定するSweepAndPruneと
+/// xyだけで判定するSpatialHashGridの組の数が一致するようにする
+/// </remarks>
+std::vector<std::vector<AABB>> MakeFrames(size_t count) {
+	float worldSize = std::sqrt(float(count)) * 3.0f;
+	std::mt19937 engine(static_cast<uint32_t>(count));
+	std::uniform_real_distribution<float> position(0.0f, worldSize);
+	std::uniform_real_distribution<float> extent(0.25f, 1.0f);
+	std::uniform_real_distribution<float> step(-kStep, kStep);
+
+	std::vector<Vector3> centers(count);
+	std::vector<Vector3> extents(count);
+	for (size_t i = 0; i < count; i++) {
+		centers[i] = {position(engine), position(engine), 0.0f};
+		extents[i] = {extent(engine), extent(engine), 1.0f};
+	}
+
+	// 最初のフレームと、少しずつ動かした計測用のフレーム
+	std::vector<std::vector<AABB>> frames(kFrameCount + 1, std::vector<AABB>(count));
+	for (std::vector<AABB>& bounds : frames) {
+		for (size_t i = 0; i < count; i++) {
+			centers[i].x += step(engine);
+			centers[i].y += step(engine);
+			bounds[i] = {Subtract(centers[i], extents[i]), Add(centers[i], extents[i])};
+		}
+	}
+	return frames;
+}
+
+/// <summary>
+/// 総当たり
+/// </summary>
+void FindPairsBruteForce(std::span<const AABB> bounds, std::vector<CollisionPair>& pairs) {
+	pairs.clear();
+	for (uint32_t i = 0; i < bounds.size(); i++) {
+		for (uint32_t j = i + 1; j < bounds.size(); j++) {
+			if (IsIntersect(bounds[i], bounds[j])) {
+				pairs.push_back({i, j});
+			}
+		}
+	}
+}
+
+/// <summary>
+/// フレームを順に処理する時間の計測（1フレームあたりの最短時間）
+/// </summary>
+template<typename Func>
+double MeasureFrames(const std::vector<std::vector<AABB>>& frames, Func&& findPairs) {
+	int frame = 1;
+	return Benchmark::Measure(
+	    [&] {
+		    findPairs(frames[frame]);
+		    frame = frame % kFrameCount + 1;
+	    },
+	    kFrameCount);
+}
+
+} // namespace
+
+int main() {
+	for (size_t count : {size_t(1000), size_t(10000), size_t(100000)}) {
+		std::vector<std::vector<AABB>> frames = MakeFrames(count);
+		std::vector<CollisionPair> pairs;
+		char label[64];
+		std::printf("--- %zu objects\n", count);
+
+		// 並びが無い状態からの1回目
+		double seconds = Benchmark::Measure(
+		    [&] {
+			    SweepAndPrune sweepAndPrune;
+			    sweepAndPrune.FindPairs(frames[0], pairs);
+		    },
+		    1);
+		std::snprintf(label, sizeof(label), "SweepAndPrune (first frame)");
+		Benchmark::Report(label, count, seconds, "objects");
+		size_t expectedPairs = pairs.size();
+
+		// 前フレームの並びを使い回す
+		SweepAndPrune sweepAndPrune;
+		sweepAndPrune.FindPairs(frames[0], pairs);
+		seconds = MeasureFrames(frames, [&](const std::vector<AABB>& bounds) {
+			sweepAndPrune.FindPairs(bounds, pairs);
+		});
+		Benchmark::Report("SweepAndPrune (coherent frames)", count, seconds, "objects");
+
+		SpatialHashGrid grid(2.0f);
+		seconds = MeasureFrames(frames, [&](const std::vector<AABB>& bounds) {
+			grid.FindPairs(bounds, pairs);
+		});
+		Benchmark::Report("SpatialHashGrid", count, seconds, "objects");
+
+		// 結果が一致するか（z方向は全て重なるように配置している）
+		sweepAndPrune.FindPairs(frames[0], pairs);
+		size_t sweepPairs = pairs.size();
+		grid.FindPairs(frames[0], pairs);
+		std::printf("  pairs: %zu (grid %zu)\n", sweepPairs, pairs.size());
+		if (sweepPairs != expectedPairs || pairs.size() != expectedPairs) {
+			std::printf("pair count mismatch\n");
+			return 1;
+		}
+
+		// 総当たりは比較のため10000個まで
+		if (count <= 10000) {
+			seconds = Benchmark::Measure([&] { FindPairsBruteForce(frames[0], pairs); }, 1);
+			Benchmark::Report("Brute force", count, seconds, "objects");
+			if (pairs.size() != expectedPairs) {
+				std::printf("pair count mismatch\n");
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,186 @@
+#include "BroadPhase.h"
+#include "TestFramework.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+/// <summary>
+/// 並べ替えた組の集合（報告順に依らない比較用）
+/// </summary>
+std::vector<std::pair<uint32_t, uint32_t>> Sorted(const std::vector<CollisionPair>& pairs) {
+	std::vector<std::pair<uint32_t, uint32_t>> result;
+	for (const CollisionPair& pair : pairs) {
+		result.push_back({pair.first, pair.second});
+	}
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+// 比較用: 全ての組を判定する（xyzまたはxyの重なり）
+std::vector<std::pair<uint32_t, uint32_t>> BruteForce(const std::vector<AABB>& bounds, bool is3D) {
+	std::vector<std::pair<uint32_t, uint32_t>> result;
+	for (uint32_t i = 0; i < bounds.size(); i++) {
+		for (uint32_t j = i + 1; j < bounds.size(); j++) {
+			const AABB& a = bounds[i];
+			const AABB& b = bounds[j];
+			bool isOverlap = a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y &&
+			                 b.min.y <= a.max.y;
+			if (is3D) {
+				isOverlap = isOverlap && a.min.z <= b.max.z && b.min.z <= a.max.z;
+			}
+			if (isOverlap) {
+				result.push_back({i, j});
+			}
+		}
+	}
+	return result;
+}
+
+AABB MakeBox(float x, float y, float z, float size) {
+	return {{x, y, z}, {x + size, y + size, z + size}};
+}
+
+/// <summary>
+/// 原点をまたいで散らばる、大きさがばらばらな箱
+/// </summary>
+std::vector<AABB> MakeRandomBoxes(uint32_t count, float range, float maxSize, uint32_t seed) {
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<float> position(-range, range);
+	std::uniform_real_distribution<float> size(0.1f, maxSize);
+	std::vector<AABB> bounds;
+	for (uint32_t i = 0; i < count; i++) {
+		Vector3 min = {position(random), position(random), position(random)};
+		Vector3 extent = {size(random), size(random), size(random)};
+		bounds.push_back({min, {min.x + extent.x, min.y + extent.y, min.z + extent.z}});
+	}
+	return bounds;
+}
+
+/// <summary>
+/// 空間ハッシュの結果が総当たりと同じか（重複があれば個数が合わない）
+/// </summary>
+bool IsSameAsBruteForce(SpatialHashGrid& grid, const std::vector<AABB>& bounds) {
+	std::vector<CollisionPair> pairs;
+	grid.FindPairs(bounds, pairs);
+	return Sorted(pairs) == BruteForce(bounds, false);
+}
+
+bool IsSameAsBruteForce(SweepAndPrune& sweepAndPrune, const std::vector<AABB>& bounds) {
+	std::vector<CollisionPair> pairs;
+	sweepAndPrune.FindPairs(bounds, pairs);
+	return Sorted(pairs) == BruteForce(bounds, true);
+}
+
+} // namespace
+
+TEST(EmptyAndSingleObject) {
+	std::vector<AABB> bounds;
+	std::vector<CollisionPair> pairs = {{0, 1}};
+	SpatialHashGrid grid(1.0f);
+	grid.FindPairs(bounds, pairs);
+	EXPECT_TRUE(pairs.empty());
+	SweepAndPrune sweepAndPrune;
+	pairs = {{0, 1}};
+	sweepAndPrune.FindPairs(bounds, pairs);
+	EXPECT_TRUE(pairs.empty());
+
+	bounds.push_back(MakeBox(-0.5f, -0.5f, -0.5f, 3.0f));
+	grid.FindPairs(bounds, pairs);
+	EXPECT_TRUE(pairs.empty());
+	sweepAndPrune.FindPairs(bounds, pairs);
+	EXPECT_TRUE(pairs.empty());
+	// 1つだけの巨大な物体
+	bounds[0] = MakeBox(-1000.0f, -1000.0f, 0.0f, 2000.0f);
+	grid.FindPairs(bounds, pairs);
+	EXPECT_TRUE(pairs.empty());
+}
+
+TEST(GridDeduplicatesMultiCellBoxes) {
+	SpatialHashGrid grid(1.0f);
+	// 負の座標を含む、それぞれ複数のセルに掛かる箱（2x2〜4x4セル）
+	std::vector<AABB> bounds = {
+	    MakeBox(-2.5f, -2.5f, 0.0f, 3.0f), MakeBox(-1.5f, -1.5f, 0.0f, 2.0f),
+	    MakeBox(-3.2f, -0.2f, 0.0f, 3.5f), MakeBox(0.2f, -3.9f, 0.0f, 1.5f)};
+	EXPECT_TRUE(IsSameAsBruteForce(grid, bounds));
+	std::vector<CollisionPair> pairs;
+	grid.FindPairs(bounds, pairs);
+	// 0-1, 0-2, 0-3, 1-2（各組1度だけ）
+	EXPECT_EQ(pairs.size(), size_t(4));
+
+	// セルより大きい箱がたくさん重なる場合
+	EXPECT_TRUE(IsSameAsBruteForce(grid, MakeRandomBoxes(300, 10.0f, 4.0f, 1)));
+	SpatialHashGrid smallGrid(0.5f);
+	EXPECT_TRUE(IsSameAsBruteForce(smallGrid, MakeRandomBoxes(300, 10.0f, 3.0f, 2)));
+}
+
+TEST(BoxesOnCellBoundaries) {
+	SpatialHashGrid grid(1.0f);
+	// 面や角がちょうどセルの境界にある箱。接している箱も重なりとして扱う
+	std::vector<AABB> bounds = {
+	    MakeBox(0.0f, 0.0f, 0.0f, 1.0f),   MakeBox(1.0f, 0.0f, 0.0f, 1.0f),
+	    MakeBox(1.0f, 1.0f, 0.0f, 1.0f),   MakeBox(-1.0f, -1.0f, 0.0f, 1.0f),
+	    MakeBox(-2.0f, 0.0f, 0.0f, 1.0f),  MakeBox(2.0f, 2.0f, 0.0f, 0.0f),
+	    MakeBox(-1.0f, -1.0f, 0.0f, 0.0f), MakeBox(0.0f, -2.0f, 0.0f, 2.0f)};
+	EXPECT_TRUE(IsSameAsBruteForce(grid, bounds));
+
+	// 格子上に並べた、境界で接する箱
+	std::vector<AABB> lattice;
+	for (int y = -4; y < 4; y++) {
+		for (int x = -4; x < 4; x++) {
+			lattice.push_back(MakeBox(float(x), float(y), 0.0f, 1.0f));
+		}
+	}
+	EXPECT_TRUE(IsSameAsBruteForce(grid, lattice));
+	SweepAndPrune sweepAndPrune;
+	EXPECT_TRUE(IsSameAsBruteForce(sweepAndPrune, lattice));
+}
+
+TEST(GridOverflowObjects) {
+	SpatialHashGrid grid(1.0f);
+	std::vector<AABB> bounds = MakeRandomBoxes(200, 20.0f, 2.0f, 3);
+	// 上限を超えるセルに掛かる物体（地形のような巨大な箱、細長い箱、範囲外の座標）
+	bounds.push_back(MakeBox(-50.0f, -50.0f, 0.0f, 100.0f));
+	bounds.push_back({{-30.0f, 0.0f, 0.0f}, {30.0f, 0.5f, 1.0f}});
+	bounds.push_back(MakeBox(1.0e12f, 1.0e12f, 0.0f, 1.0f));
+	bounds.push_back({{-1.0e12f, -1.0e12f, 0.0f}, {1.0e12f, 1.0e12f, 0.0f}});
+	EXPECT_TRUE(IsSameAsBruteForce(grid, bounds));
+	// 巨大な箱が先頭にある場合
+	std::rotate(bounds.rbegin(), bounds.rbegin() + 4, bounds.rend());
+	EXPECT_TRUE(IsSameAsBruteForce(grid, bounds));
+}
+
+TEST(SweepAndPruneAfterReversedOrder) {
+	SweepAndPrune sweepAndPrune;
+	std::vector<AABB> bounds = MakeRandomBoxes(500, 20.0f, 3.0f, 4);
+	EXPECT_TRUE(IsSameAsBruteForce(sweepAndPrune, bounds));
+
+	// 同じ物体数のまま、軸方向の並びを完全に逆にする（挿入ソートの最悪の場合）
+	for (AABB& aabb : bounds) {
+		float min = aabb.min.x;
+		aabb.min.x = -aabb.max.x;
+		aabb.max.x = -min;
+	}
+	EXPECT_TRUE(IsSameAsBruteForce(sweepAndPrune, bounds));
+
+	// 少しずつ動かす（前フレームの並びが使われる）
+	std::mt19937 random(5);
+	std::uniform_real_distribution<float> step(-0.3f, 0.3f);
+	bool isSame = true;
+	for (int frame = 0; frame < 10; frame++) {
+		for (AABB& aabb : bounds) {
+			float dx = step(random);
+			aabb.min.x += dx;
+			aabb.max.x += dx;
+		}
+		isSame = isSame && IsSameAsBruteForce(sweepAndPrune, bounds);
+	}
+	EXPECT_TRUE(isSame);
+
+	// 物体数が変わると作り直す
+	bounds.resize(100);
+	EXPECT_TRUE(IsSameAsBruteForce(sweepAndPrune, bounds));
+	SweepAndPrune sweepAndPruneZ(2);
+	EXPECT_TRUE(IsSameAsBruteForce(sweepAndPruneZ, bounds));
+}
@@ -0,0 +1,86 @@
+#include "Benchmark.h"
+#include "Collision.h"
+#include <random>
+#include <vector>
+
+using namespace MathUtility;
+
+namespace {
+
+// 要素数
+const size_t kCount = 1 << 16;
+
+// 回転行列の各行を座標軸にしたOBB
+OBB MakeOBB(const Vector3& center, const Vector3& rotate, const Vector3& size) {
+	Matrix4x4 m = MakeAffineMatrix({1.0f, 1.0f, 1.0f}, rotate, {0.0f, 0.0f, 0.0f});
+	OBB obb{};
+	obb.center = center;
+	for (int i = 0; i < 3; i++) {
+		obb.orientations[i] = {m.m[i][0], m.m[i][1], m.m[i][2]};
+	}
+	obb.size = size;
+	return obb;
+}
+
+// 比較対象の1つずつの判定
+template<class Shape, class Element>
+size_t CollectLoop(
+    const Shape& shape, const std::vector<Element>& elements, std::vector<uint32_t>& hits) {
+	size_t count = 0;
+	for (size_t i = 0; i < elements.size(); i++) {
+		if (IsIntersect(shape, elements[i])) {
+			hits.push_back(uint32_t(i));
+			count++;
+		}
+	}
+	return count;
+}
+
+// 一括判定と1つずつの判定を計測する
+template<class Shape, class Element>
+void Run(const char* name, const Shape& shape, const std::vector<Element>& elements) {
+	std::vector<uint32_t> hits;
+	hits.reserve(elements.size());
+	char label[64];
+	double seconds = Benchmark::Measure([&] {
+		hits.clear();
+		Benchmark::DoNotOptimize(CollectIntersections(shape, std::span(elements), hits));
+	});
+	std::snprintf(label, sizeof(label), "%s CollectIntersections", name);
+	Benchmark::Report(label, elements.size(), seconds, "tests");
+	seconds = Benchmark::Measure([&] {
+		hits.clear();
+		Benchmark::DoNotOptimize(CollectLoop(shape, elements, hits));
+	});
+	std::snprintf(label, sizeof(label), "%s IsIntersect loop", name);
+	Benchmark::Report(label, elements.size(), seconds, "tests");
+	std::printf("  (%zu hits)\n", hits.size());
+}
+
+} // namespace
+
+int main() {
+	std::mt19937 engine(1);
+	std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> size(0.5f, 5.0f);
+	std::uniform_real_distribution<float> angle(-3.14f, 3.14f);
+	std::vector<Sphere> spheres(kCount);
+	std::vector<AABB> aabbs(kCount);
+	std::vector<OBB> obbs(kCount);
+	for (size_t i = 0; i < kCount; i++) {
+		Vector3 center{position(engine), position(engine), position(engine)};
+		Vector3 extents{size(engine), size(engine), size(engine)};
+		spheres[i] = {center, size(engine)};
+		aabbs[i] = {Subtract(center, extents), Add(center, extents)};
+		obbs[i] = MakeOBB(center, {angle(engine), angle(engine), angle(engine)}, extents);
+	}
+
+	Sphere sphere{{0.0f, 0.0f, 0.0f}, 30.0f};
+	AABB aabb{{-30.0f, -30.0f, -30.0f}, {30.0f, 30.0f, 30.0f}};
+	OBB obb = MakeOBB({0.0f, 0.0f, 0.0f}, {0.3f, 0.2f, 0.1f}, {30.0f, 30.0f, 30.0f});
+	Run("Sphere-Sphere", sphere, spheres);
+	Run("AABB-AABB", aabb, aabbs);
+	Run("Sphere-AABB", sphere, aabbs);
+	Run("OBB-OBB", obb, obbs);
+	return 0;
+}
@@ -0,0 +1,361 @@
+#include "Collision.h"
+#include "TestFramework.h"
+#include <random>
+#include <vector>
+
+using namespace MathUtility;
+
+namespace {
+
+// 回転行列の各行を座標軸にしたOBB
+OBB MakeOBB(const Vector3& center, const Vector3& rotate, const Vector3& size) {
+	Matrix4x4 m = MakeAffineMatrix({1.0f, 1.0f, 1.0f}, rotate, {0.0f, 0.0f, 0.0f});
+	OBB obb{};
+	obb.center = center;
+	for (int i = 0; i < 3; i++) {
+		obb.orientations[i] = {m.m[i][0], m.m[i][1], m.m[i][2]};
+	}
+	obb.size = size;
+	return obb;
+}
+
+// 軸に射影した区間
+void Project(const OBB& obb, const Vector3& axis, float& min, float& max) {
+	float center = Dot(obb.center, axis);
+	float radius = 0.0f;
+	const float* size = &obb.size.x;
+	for (int i = 0; i < 3; i++) {
+		radius += size[i] * std::abs(Dot(obb.orientations[i], axis));
+	}
+	min = center - radius;
+	max = center + radius;
+}
+
+// 分離軸の候補15本（外積が0になる組は除き、正規化する）
+std::vector<Vector3> SeparatingAxes(const OBB& obb1, const OBB& obb2) {
+	std::vector<Vector3> axes;
+	for (int i = 0; i < 3; i++) {
+		axes.push_back(obb1.orientations[i]);
+		axes.push_back(obb2.orientations[i]);
+		for (int j = 0; j < 3; j++) {
+			Vector3 axis = Cross(obb1.orientations[i], obb2.orientations[j]);
+			if (1.0e-6f <= Dot(axis, axis)) {
+				axes.push_back(Normalize(axis));
+			}
+		}
+	}
+	return axes;
+}
+
+// 比較用: 15軸すべてに射影する素朴な分離軸判定
+bool ReferenceIsIntersect(const OBB& obb1, const OBB& obb2) {
+	for (const Vector3& axis : SeparatingAxes(obb1, obb2)) {
+		float min1, max1, min2, max2;
+		Project(obb1, axis, min1, max1);
+		Project(obb2, axis, min2, max2);
+		if (max1 < min2 || max2 < min1) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// 射影した区間の端同士の最小距離（境界ぎりぎりの乱数ケースを除くため）
+float MinimumGap(const OBB& obb1, const OBB& obb2) {
+	float gap = 1.0e30f;
+	for (const Vector3& axis : SeparatingAxes(obb1, obb2)) {
+		float min1, max1, min2, max2;
+		Project(obb1, axis, min1, max1);
+		Project(obb2, axis, min2, max2);
+		gap = std::min({gap, std::abs(max1 - min2), std::abs(max2 - min1)});
+	}
+	return gap;
+}
+
+// 線分上の点
+Vector3 PointOnSegment(const Segment& segment, float t) {
+	return Add(segment.origin, Multiply(t, segment.diff));
+}
+
+// 比較用: 線分を細かく分割して求めた最近接距離の2乗
+float ReferenceDistanceSq(const Segment& segment1, const Segment& segment2) {
+	const int kDivision = 400;
+	float best = 1.0e30f;
+	for (int i = 0; i <= kDivision; i++) {
+		Vector3 point = PointOnSegment(segment1, float(i) / kDivision);
+		Vector3 diff = Subtract(ClosestPoint(segment2, point), point);
+		best = std::min(best, Dot(diff, diff));
+	}
+	return best;
+}
+
+} // namespace
+
+#pragma region OBB
+
+TEST(OBBSeparatedOnFaceAxes) {
+	OBB a = MakeOBB({0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f});
+	// obb1の各面の軸で分離
+	EXPECT_FALSE(IsIntersect(a, MakeOBB({2.1f, 0.0f, 0.0f}, {}, {1.0f, 1.0f, 1.0f})));
+	EXPECT_FALSE(IsIntersect(a, MakeOBB({0.0f, -2.1f, 0.0f}, {}, {1.0f, 1.0f, 1.0f})));
+	EXPECT_FALSE(IsIntersect(a, MakeOBB({0.0f, 0.0f, 2.1f}, {}, {1.0f, 1.0f, 1.0f})));
+	// 少しでも重なれば交差
+	EXPECT_TRUE(IsIntersect(a, MakeOBB({1.9f, 0.0f, 0.0f}, {}, {1.0f, 1.0f, 1.0f})));
+	// 同じ向き（外積が0になる）で面が接している
+	EXPECT_TRUE(IsIntersect(a, MakeOBB({2.0f, 2.0f, 0.0f}, {}, {1.0f, 1.0f, 1.0f})));
+}
+
+TEST(OBBSeparatedOnOtherAxes) {
+	// obb2の軸でしか分離できない: 対角線上に、対角線と直交する向きの薄い板を置く
+	OBB a = MakeOBB({0.0f, 0.0f, 0.0f}, {}, {1.0f, 1.0f, 1.0f});
+	OBB b = MakeOBB({1.2f, 1.2f, 0.0f}, {0.0f, 0.0f, 0.785398f}, {0.1f, 2.0f, 1.0f});
+	EXPECT_FALSE(IsIntersect(a, b));
+	EXPECT_FALSE(IsIntersect(b, a));
+	EXPECT_FALSE(ReferenceIsIntersect(a, b));
+	// 板を近づけると交差する
+	b.center = {1.0f, 1.0f, 0.0f};
+	EXPECT_TRUE(IsIntersect(a, b));
+	EXPECT_TRUE(ReferenceIsIntersect(a, b));
+}
+
+TEST(OBBSeparatedOnEdgeAxis) {
+	// 辺同士の外積の軸でしか分離できない: x軸回りに45度回した箱の上の辺（x方向）と、
+	// y軸回りに45度回した箱の下の辺（y方向）がねじれの位置で向かい合う。
+	// 分離軸はz（x方向とy方向の外積）で、辺の高さはそれぞれ√2と D - √2
+	OBB a = MakeOBB({0.0f, 0.0f, 0.0f}, {0.785398f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f});
+	OBB b = MakeOBB({0.0f, 0.0f, 3.0f}, {0.0f, 0.785398f, 0.0f}, {1.0f, 1.0f, 1.0f});
+	// 面の軸では重なって見える
+	for (const OBB* obb : {&a, &b}) {
+		for (int i = 0; i < 3; i++) {
+			float min1, max1, min2, max2;
+			Project(a, obb->orientations[i], min1, max1);
+			Project(b, obb->orientations[i], min2, max2);
+			EXPECT_TRUE(min2 <= max1 && min1 <= max2);
+		}
+	}
+	EXPECT_FALSE(IsIntersect(a, b));
+	EXPECT_FALSE(IsIntersect(b, a));
+	EXPECT_FALSE(ReferenceIsIntersect(a, b));
+	// 2√2より近づけると交差する
+	b.center.z = 2.7f;
+	EXPECT_TRUE(IsIntersect(a, b));
+	EXPECT_TRUE(ReferenceIsIntersect(a, b));
+}
+
+TEST(OBBMatchesReference) {
+	std::mt19937 engine(1);
+	std::uniform_real_distribution<float> position(-3.0f, 3.0f);
+	std::uniform_real_distribution<float> angle(-3.14f, 3.14f);
+	std::uniform_real_distribution<float> size(0.2f, 2.0f);
+	int tested = 0;
+	int hits = 0;
+	while (tested < 5000) {
+		OBB a = MakeOBB(
+		    {position(engine), position(engine), position(engine)},
+		    {angle(engine), angle(engine), angle(engine)},
+		    {size(engine), size(engine), size(engine)});
+		OBB b = MakeOBB(
+		    {position(engine), position(engine), position(engine)},
+		    {angle(engine), angle(engine), angle(engine)},
+		    {size(engine), size(engine), size(engine)});
+		// 境界ぎりぎりの配置は誤差で結果が変わるので除く
+		if (MinimumGap(a, b) < 1.0e-3f) {
+			continue;
+		}
+		bool expected = ReferenceIsIntersect(a, b);
+		EXPECT_EQ(IsIntersect(a, b), expected);
+		EXPECT_EQ(IsIntersect(b, a), expected);
+		hits += expected ? 1 : 0;
+		tested++;
+	}
+	// 交差・非交差の両方を十分に含むこと
+	EXPECT_TRUE(500 < hits && hits < 4500);
+}
+
+TEST(OBBMatchesAABBWhenAxisAligned) {
+	std::mt19937 engine(2);
+	std::uniform_real_distribution<float> position(-3.0f, 3.0f);
+	std::uniform_real_distribution<float> size(0.2f, 2.0f);
+	for (int i = 0; i < 1000; i++) {
+		Vector3 center1{position(engine), position(engine), position(engine)};
+		Vector3 center2{position(engine), position(engine), position(engine)};
+		Vector3 size1{size(engine), size(engine), size(engine)};
+		Vector3 size2{size(engine), size(engine), size(engine)};
+		AABB aabb1{Subtract(center1, size1), Add(center1, size1)};
+		AABB aabb2{Subtract(center2, size2), Add(center2, size2)};
+		EXPECT_EQ(
+		    IsIntersect(MakeOBB(center1, {}, size1), MakeOBB(center2, {}, size2)),
+		    IsIntersect(aabb1, aabb2));
+	}
+}
+
+#pragma endregion
+
+#pragma region 線分と三角形
+
+TEST(SegmentTriangle) {
+	Triangle triangle{{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}}};
+	float t = -1.0f;
+
+	// 表から貫通
+	EXPECT_TRUE(IsIntersect(Segment{{0.25f, 0.25f, 1.0f}, {0.0f, 0.0f, -2.0f}}, triangle, t));
+	EXPECT_NEAR(t, 0.5f, 1.0e-6f);
+	// 裏から貫通（両面）
+	EXPECT_TRUE(IsIntersect(Segment{{0.25f, 0.25f, -1.0f}, {0.0f, 0.0f, 4.0f}}, triangle, t));
+	EXPECT_NEAR(t, 0.25f, 1.0e-6f);
+	// 三角形の外側
+	EXPECT_FALSE(IsIntersect(Segment{{0.75f, 0.75f, 1.0f}, {0.0f, 0.0f, -2.0f}}, triangle, t));
+	EXPECT_FALSE(IsIntersect(Segment{{-0.1f, 0.5f, 1.0f}, {0.0f, 0.0f, -2.0f}}, triangle, t));
+	// 届かない・通り過ぎた（t が [0, 1] の外）
+	EXPECT_FALSE(IsIntersect(Segment{{0.25f, 0.25f, 2.0f}, {0.0f, 0.0f, -1.0f}}, triangle, t));
+	EXPECT_FALSE(IsIntersect(Segment{{0.25f, 0.25f, -0.5f}, {0.0f, 0.0f, -1.0f}}, triangle, t));
+	// 平行
+	EXPECT_FALSE(IsIntersect(Segment{{0.25f, 0.25f, 0.0f}, {1.0f, 0.0f, 0.0f}}, triangle, t));
+	// 斜めに貫通
+	EXPECT_TRUE(IsIntersect(Segment{{0.0f, 0.0f, 1.0f}, {0.4f, 0.4f, -2.0f}}, triangle, t));
+	EXPECT_NEAR(t, 0.5f, 1.0e-6f);
+}
+
+TEST(SegmentTriangleMatchesPlane) {
+	// 三角形の内側を通る線分は、三角形を含む平面との交点と同じ t になる
+	std::mt19937 engine(3);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> barycentric(0.05f, 0.45f);
+	for (int i = 0; i < 1000; i++) {
+		Triangle triangle{};
+		for (Vector3& vertex : triangle.vertices) {
+			vertex = {distribution(engine), distribution(engine), distribution(engine)};
+		}
+		Vector3 normal = Cross(
+		    Subtract(triangle.vertices[1], triangle.vertices[0]),
+		    Subtract(triangle.vertices[2], triangle.vertices[0]));
+		if (Length(normal) < 0.1f) {
+			continue;
+		}
+		normal = Normalize(normal);
+		float u = barycentric(engine), v = barycentric(engine);
+		Vector3 inside = Add(
+		    triangle.vertices[0],
+		    Add(Multiply(u, Subtract(triangle.vertices[1], triangle.vertices[0])),
+		        Multiply(v, Subtract(triangle.vertices[2], triangle.vertices[0]))));
+		Vector3 offset = Add(normal, Multiply(0.3f, {distribution(engine), 0.0f, 0.0f}));
+		Segment segment{Add(inside, offset), Multiply(-2.0f, offset)};
+
+		float t = -1.0f;
+		EXPECT_TRUE(IsIntersect(segment, triangle, t));
+		float planeT = -1.0f;
+		Plane plane{normal, Dot(normal, triangle.vertices[0])};
+		EXPECT_TRUE(IsIntersect(segment, plane, planeT));
+		EXPECT_NEAR(t, planeT, 1.0e-4f);
+	}
+}
+
+#pragma endregion
+
+#pragma region カプセル
+
+TEST(CapsuleCapsule) {
+	Capsule a{{{0.0f, 0.0f, 0.0f}, {0.0f, 2.0f, 0.0f}}, 0.5f};
+	// 平行で離れている／接している
+	EXPECT_FALSE(IsIntersect(a, Capsule{{{1.1f, 0.0f, 0.0f}, {0.0f, 2.0f, 0.0f}}, 0.5f}));
+	EXPECT_TRUE(IsIntersect(a, Capsule{{{0.9f, 0.5f, 0.0f}, {0.0f, 2.0f, 0.0f}}, 0.5f}));
+	// ねじれの位置で交差する
+	EXPECT_TRUE(IsIntersect(a, Capsule{{{-1.0f, 1.0f, 0.9f}, {2.0f, 0.0f, 0.0f}}, 0.5f}));
+	EXPECT_FALSE(IsIntersect(a, Capsule{{{-1.0f, 1.0f, 1.1f}, {2.0f, 0.0f, 0.0f}}, 0.5f}));
+	// 端の半球同士
+	EXPECT_TRUE(IsIntersect(a, Capsule{{{0.0f, 2.9f, 0.0f}, {0.0f, 1.0f, 0.0f}}, 0.5f}));
+	EXPECT_FALSE(IsIntersect(a, Capsule{{{0.0f, 3.1f, 0.0f}, {0.0f, 1.0f, 0.0f}}, 0.5f}));
+	// 長さ0（球）
+	EXPECT_TRUE(IsIntersect(a, Capsule{{{0.9f, 1.0f, 0.0f}, {0.0f, 0.0f, 0.0f}}, 0.5f}));
+	EXPECT_FALSE(IsIntersect(
+	    Capsule{{{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}}, 0.5f},
+	    Capsule{{{1.1f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}}, 0.5f}));
+}
+
+TEST(ClosestPointsMatchesSampling) {
+	std::mt19937 engine(4);
+	std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+	for (int i = 0; i < 300; i++) {
+		Segment segment1{
+		    {distribution(engine), distribution(engine), distribution(engine)},
+		    {distribution(engine), distribution(engine), distribution(engine)}};
+		Segment segment2{
+		    {distribution(engine), distribution(engine), distribution(engine)},
+		    {distribution(engine), distribution(engine), distribution(engine)}};
+		// 平行な線分も混ぜる
+		if (i % 10 == 0) {
+			segment2.diff = Multiply(-0.5f, segment1.diff);
+		}
+		Vector3 closest1, closest2;
+		float distanceSq = ClosestPoints(segment1, segment2, closest1, closest2);
+		// 標本点より遠くなることはない
+		EXPECT_TRUE(distanceSq <= ReferenceDistanceSq(segment1, segment2) + 1.0e-4f);
+		Vector3 diff = Subtract(closest1, closest2);
+		EXPECT_NEAR(Dot(diff, diff), distanceSq, 1.0e-4f);
+	}
+}
+
+#pragma endregion
+
+#pragma region 一括判定
+
+namespace {
+
+// 比較用: 1つずつIsIntersectで判定した結果
+template<class Shape, class Element>
+std::vector<uint32_t> ReferenceCollect(const Shape& shape, const std::vector<Element>& elements) {
+	std::vector<uint32_t> hits;
+	for (size_t i = 0; i < elements.size(); i++) {
+		if (IsIntersect(shape, elements[i])) {
+			hits.push_back(uint32_t(i));
+		}
+	}
+	return hits;
+}
+
+} // namespace
+
+TEST(CollectIntersectionsMatchesScalar) {
+	std::mt19937 engine(5);
+	std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> size(0.1f, 2.0f);
+	std::uniform_real_distribution<float> angle(-3.14f, 3.14f);
+	// SIMDの4個単位の端数を含む要素数
+	for (size_t count : {size_t(0), size_t(3), size_t(4), size_t(101)}) {
+		std::vector<Sphere> spheres(count);
+		std::vector<AABB> aabbs(count);
+		std::vector<OBB> obbs(count);
+		for (size_t i = 0; i < count; i++) {
+			Vector3 center{position(engine), position(engine), position(engine)};
+			Vector3 extents{size(engine), size(engine), size(engine)};
+			spheres[i] = {center, size(engine)};
+			aabbs[i] = {Subtract(center, extents), Add(center, extents)};
+			obbs[i] = MakeOBB(center, {angle(engine), angle(engine), angle(engine)}, extents);
+		}
+		Sphere sphere{{1.0f, -2.0f, 0.5f}, 5.0f};
+		AABB aabb{{-4.0f, -3.0f, -5.0f}, {3.0f, 6.0f, 2.0f}};
+		OBB obb = MakeOBB({0.5f, 0.5f, 0.5f}, {0.3f, 0.2f, 0.1f}, {4.0f, 2.0f, 3.0f});
+
+		// 既存の要素の後ろに追加されること
+		std::vector<uint32_t> hits = {9999};
+		size_t hitCount = CollectIntersections(sphere, spheres, hits);
+		std::vector<uint32_t> expected = ReferenceCollect(sphere, spheres);
+		expected.insert(expected.begin(), 9999);
+		EXPECT_EQ(hitCount + 1, hits.size());
+		EXPECT_TRUE(hits == expected);
+
+		hits.clear();
+		EXPECT_EQ(CollectIntersections(aabb, aabbs, hits), hits.size());
+		EXPECT_TRUE(hits == ReferenceCollect(aabb, aabbs));
+
+		hits.clear();
+		EXPECT_EQ(CollectIntersections(sphere, aabbs, hits), hits.size());
+		EXPECT_TRUE(hits == ReferenceCollect(sphere, aabbs));
+
+		hits.clear();
+		EXPECT_EQ(CollectIntersections(obb, obbs, hits), hits.size());
+		EXPECT_TRUE(hits == ReferenceCollect(obb, obbs));
+	}
+}
+
+#pragma endregion
@@ -0,0 +1,187 @@
+#include "FrustumCuller.h"
+#include "TestFramework.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace MathUtility;
+
+namespace {
+
+// 平面の法線と距離が許容誤差内で等しいか
+// （遠平面は w - z の引き算で桁落ちするので、距離は相対誤差で比べる）
+void ExpectPlaneNear(const Plane& actual, const Vector3& normal, float distance) {
+	EXPECT_NEAR(actual.normal.x, normal.x, 1.0e-5f);
+	EXPECT_NEAR(actual.normal.y, normal.y, 1.0e-5f);
+	EXPECT_NEAR(actual.normal.z, normal.z, 1.0e-5f);
+	EXPECT_NEAR(actual.distance, distance, 1.0e-5f * (1.0f + std::abs(distance)));
+}
+
+// 原点からz+を向く、90度の透視投影（アスペクト比1、近平面1、遠平面100）
+Matrix4x4 MakeTestPerspective() { return MakePerspectiveMatrix(1.0f, 1.0f, 1.0f, 100.0f); }
+
+// 幅20、高さ10、奥行き0～50の正射影
+Matrix4x4 MakeTestOrthographic() {
+	return MakeOrthographicMatrix(-10.0f, 5.0f, 10.0f, -5.0f, 0.0f, 50.0f);
+}
+
+/// <summary>
+/// 行列を設定したビュープロジェクション（定数バッファは作らない）
+/// </summary>
+void SetMatrices(
+    ViewProjection& viewProjection, const Matrix4x4& view, const Matrix4x4& projection) {
+	viewProjection.matView = view;
+	viewProjection.matProjection = projection;
+}
+
+// 比較用: 1個ずつ判定した見えている番号
+template<class Shape>
+std::vector<uint32_t> ReferenceCull(const Frustum& frustum, const std::vector<Shape>& shapes) {
+	std::vector<uint32_t> result;
+	for (uint32_t i = 0; i < shapes.size(); i++) {
+		if (IsIntersect(frustum, shapes[i])) {
+			result.push_back(i);
+		}
+	}
+	return result;
+}
+
+} // namespace
+
+TEST(MakeFrustumFromPerspective) {
+	const float s = 1.0f / std::sqrt(2.0f);
+	Frustum frustum = MakeFrustum(MakeTestPerspective());
+	// 法線は内側を向く。側面は原点を通る45度の面
+	ExpectPlaneNear(frustum.planes[Frustum::kLeft], {s, 0.0f, s}, 0.0f);
+	ExpectPlaneNear(frustum.planes[Frustum::kRight], {-s, 0.0f, s}, 0.0f);
+	ExpectPlaneNear(frustum.planes[Frustum::kBottom], {0.0f, s, s}, 0.0f);
+	ExpectPlaneNear(frustum.planes[Frustum::kTop], {0.0f, -s, s}, 0.0f);
+	ExpectPlaneNear(frustum.planes[Frustum::kNear], {0.0f, 0.0f, 1.0f}, 1.0f);
+	ExpectPlaneNear(frustum.planes[Frustum::kFar], {0.0f, 0.0f, -1.0f}, -100.0f);
+
+	// カメラをz-10へ動かすと、近平面と遠平面がずれ、側面は視点を通る
+	Matrix4x4 view = Inverse(MakeTranslateMatrix({0.0f, 0.0f, -10.0f}));
+	frustum = MakeFrustum(Multiply(view, MakeTestPerspective()));
+	ExpectPlaneNear(frustum.planes[Frustum::kLeft], {s, 0.0f, s}, -10.0f * s);
+	ExpectPlaneNear(frustum.planes[Frustum::kNear], {0.0f, 0.0f, 1.0f}, -9.0f);
+	ExpectPlaneNear(frustum.planes[Frustum::kFar], {0.0f, 0.0f, -1.0f}, -90.0f);
+
+	// ViewProjection::GetFrustumも同じ行列から求める
+	ViewProjection viewProjection;
+	SetMatrices(viewProjection, view, MakeTestPerspective());
+	Frustum fromViewProjection = viewProjection.GetFrustum();
+	ExpectPlaneNear(fromViewProjection.planes[Frustum::kNear], {0.0f, 0.0f, 1.0f}, -9.0f);
+}
+
+TEST(MakeFrustumFromOrthographic) {
+	Frustum frustum = MakeFrustum(MakeTestOrthographic());
+	ExpectPlaneNear(frustum.planes[Frustum::kLeft], {1.0f, 0.0f, 0.0f}, -10.0f);
+	ExpectPlaneNear(frustum.planes[Frustum::kRight], {-1.0f, 0.0f, 0.0f}, -10.0f);
+	ExpectPlaneNear(frustum.planes[Frustum::kBottom], {0.0f, 1.0f, 0.0f}, -5.0f);
+	ExpectPlaneNear(frustum.planes[Frustum::kTop], {0.0f, -1.0f, 0.0f}, -5.0f);
+	ExpectPlaneNear(frustum.planes[Frustum::kNear], {0.0f, 0.0f, 1.0f}, 0.0f);
+	ExpectPlaneNear(frustum.planes[Frustum::kFar], {0.0f, 0.0f, -1.0f}, -50.0f);
+}
+
+TEST(SphereInsideOutsideAndStraddling) {
+	Frustum frustum = MakeFrustum(MakeTestPerspective());
+	// 内側
+	EXPECT_TRUE(IsIntersect(frustum, Sphere{{0.0f, 0.0f, 50.0f}, 1.0f}));
+	EXPECT_TRUE(IsIntersect(frustum, Sphere{{5.0f, -5.0f, 20.0f}, 0.5f}));
+	// 外側（近平面の手前、遠平面の奥、側面の外）
+	EXPECT_FALSE(IsIntersect(frustum, Sphere{{0.0f, 0.0f, 0.0f}, 0.5f}));
+	EXPECT_FALSE(IsIntersect(frustum, Sphere{{0.0f, 0.0f, 102.0f}, 1.0f}));
+	EXPECT_FALSE(IsIntersect(frustum, Sphere{{-30.0f, 0.0f, 20.0f}, 1.0f}));
+	EXPECT_FALSE(IsIntersect(frustum, Sphere{{0.0f, 30.0f, 20.0f}, 1.0f}));
+	// 平面をまたぐ
+	EXPECT_TRUE(IsIntersect(frustum, Sphere{{0.0f, 0.0f, 0.5f}, 1.0f}));
+	EXPECT_TRUE(IsIntersect(frustum, Sphere{{0.0f, 0.0f, 100.5f}, 1.0f}));
+	EXPECT_TRUE(IsIntersect(frustum, Sphere{{-21.0f, 0.0f, 20.0f}, 1.0f}));
+	// 視錐台全体を含む
+	EXPECT_TRUE(IsIntersect(frustum, Sphere{{0.0f, 0.0f, 0.0f}, 1000.0f}));
+
+	// 正射影。面にちょうど接する球も交差扱い
+	frustum = MakeFrustum(MakeTestOrthographic());
+	EXPECT_TRUE(IsIntersect(frustum, Sphere{{11.0f, 0.0f, 10.0f}, 1.0f}));
+	EXPECT_FALSE(IsIntersect(frustum, Sphere{{11.5f, 0.0f, 10.0f}, 1.0f}));
+	EXPECT_FALSE(IsIntersect(frustum, Sphere{{0.0f, 0.0f, 60.0f}, 5.0f}));
+	// 保守的な判定なので、2つの面の外側にわずかずつはみ出た角付近の球は交差扱いになる
+	EXPECT_TRUE(IsIntersect(frustum, Sphere{{10.8f, 5.8f, 10.0f}, 1.0f}));
+}
+
+TEST(AABBInsideOutsideAndStraddling) {
+	Frustum frustum = MakeFrustum(MakeTestPerspective());
+	EXPECT_TRUE(IsIntersect(frustum, AABB{{-1.0f, -1.0f, 10.0f}, {1.0f, 1.0f, 12.0f}}));
+	EXPECT_FALSE(IsIntersect(frustum, AABB{{-1.0f, -1.0f, -5.0f}, {1.0f, 1.0f, 0.5f}}));
+	EXPECT_FALSE(IsIntersect(frustum, AABB{{-1.0f, -1.0f, 101.0f}, {1.0f, 1.0f, 105.0f}}));
+	EXPECT_FALSE(IsIntersect(frustum, AABB{{30.0f, -1.0f, 10.0f}, {32.0f, 1.0f, 12.0f}}));
+	// 近平面・右の面・遠平面をまたぐ
+	EXPECT_TRUE(IsIntersect(frustum, AABB{{-1.0f, -1.0f, -5.0f}, {1.0f, 1.0f, 2.0f}}));
+	EXPECT_TRUE(IsIntersect(frustum, AABB{{9.0f, -1.0f, 10.0f}, {12.0f, 1.0f, 12.0f}}));
+	EXPECT_TRUE(IsIntersect(frustum, AABB{{-1.0f, -1.0f, 90.0f}, {1.0f, 1.0f, 200.0f}}));
+	// 視錐台全体を含む
+	AABB everything = {{-500.0f, -500.0f, -500.0f}, {500.0f, 500.0f, 500.0f}};
+	EXPECT_TRUE(IsIntersect(frustum, everything));
+
+	frustum = MakeFrustum(MakeTestOrthographic());
+	// 面にちょうど接する箱は交差扱い
+	EXPECT_TRUE(IsIntersect(frustum, AABB{{10.0f, 0.0f, 1.0f}, {12.0f, 1.0f, 2.0f}}));
+	EXPECT_FALSE(IsIntersect(frustum, AABB{{10.5f, 0.0f, 1.0f}, {12.0f, 1.0f, 2.0f}}));
+	EXPECT_FALSE(IsIntersect(frustum, AABB{{0.0f, -9.0f, 1.0f}, {1.0f, -6.0f, 2.0f}}));
+	EXPECT_TRUE(IsIntersect(frustum, AABB{{0.0f, -9.0f, 1.0f}, {1.0f, -4.0f, 2.0f}}));
+}
+
+TEST(CullMatchesScalarTest) {
+	std::mt19937 engine(1);
+	std::uniform_real_distribution<float> position(-60.0f, 60.0f);
+	std::uniform_real_distribution<float> depth(-20.0f, 130.0f);
+	std::uniform_real_distribution<float> size(0.1f, 8.0f);
+
+	// 原点で少し傾けたカメラ
+	Matrix4x4 camera = MakeAffineMatrix({1.0f, 1.0f, 1.0f}, Vector3{0.2f, -0.4f, 0.0f}, {});
+	Vector3 forward = {camera.m[2][0], camera.m[2][1], camera.m[2][2]};
+	ViewProjection viewProjection;
+	for (const Matrix4x4& projection : {MakeTestPerspective(), MakeTestOrthographic()}) {
+		SetMatrices(viewProjection, Inverse(camera), projection);
+		FrustumCuller culler;
+		culler.BeginFrame(viewProjection);
+		const Frustum& frustum = culler.GetFrustum();
+
+		// 4の倍数でない数も含め、端数の処理と4個ずつの処理を両方通す
+		for (uint32_t count : {0u, 1u, 3u, 4u, 5u, 7u, 8u, 13u, 1001u}) {
+			std::vector<Sphere> spheres;
+			std::vector<AABB> aabbs;
+			for (uint32_t i = 0; i < count; i++) {
+				Vector3 center = {position(engine), position(engine), depth(engine)};
+				Vector3 extents = {size(engine), size(engine), size(engine)};
+				spheres.push_back({center, extents.x});
+				aabbs.push_back({Subtract(center, extents), Add(center, extents)});
+			}
+			// 近平面の手前で接する球と、カメラを囲む箱も入れる
+			if (count == 13) {
+				float nearDistance = frustum.planes[Frustum::kNear].distance;
+				spheres[12] = {Multiply(nearDistance - 1.0f, forward), 1.0f};
+				aabbs[12] = {{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}};
+			}
+
+			std::vector<uint32_t> visible = {12345};
+			size_t visibleCount = culler.Cull(std::span<const Sphere>(spheres), visible);
+			// 末尾に追加する
+			EXPECT_EQ(visible[0], 12345u);
+			visible.erase(visible.begin());
+			EXPECT_EQ(visibleCount, visible.size());
+			EXPECT_TRUE(visible == ReferenceCull(frustum, spheres));
+
+			visible.clear();
+			visibleCount = culler.Cull(std::span<const AABB>(aabbs), visible);
+			EXPECT_EQ(visibleCount, visible.size());
+			EXPECT_TRUE(visible == ReferenceCull(frustum, aabbs));
+		}
+
+		// 統計は判定した全ての数の合計
+		const FrustumCuller::Statistics& statistics = culler.GetStatistics();
+		EXPECT_EQ(statistics.tested, (0u + 1 + 3 + 4 + 5 + 7 + 8 + 13 + 1001) * 2);
+		EXPECT_EQ(statistics.visible + statistics.culled, statistics.tested);
+		EXPECT_TRUE(0u < statistics.visible && 0u < statistics.culled);
+	}
+}
@@ -0,0 +1,113 @@
+#include "Benchmark.h"
+#include "MathUtility.h"
+#include <random>
+#include <vector>
+
+using namespace MathUtility;
+
+namespace {
+
+// 要素数
+const size_t kCount = 1 << 16;
+// 1回の計測で配列を処理する回数（1回分は0.1ms程度で、そのままでは誤差に埋もれる）
+const int kRepeat = 50;
+
+} // namespace
+
+// スカラー実装と比べるときはMathUtilityBenchmarkScalar（MATH_DISABLE_SIMD）を実行する。
+// 手書きのスカラーのループと比べると、コンパイラーが配列全体をまたいで自動ベクトル化して
+// 行列をレジスタに置いたままにするので、1回ずつの呼び出しの比較にならない
+// （配列をまとめて変換するならBatchTransformを使う）。
+int main() {
+#if defined(MATH_ENABLE_AVX)
+	std::printf("MathUtility: AVX\n");
+#elif defined(MATH_ENABLE_SSE)
+	std::printf("MathUtility: SSE\n");
+#else
+	std::printf("MathUtility: scalar\n");
+#endif
+
+	std::mt19937 engine(1);
+	std::uniform_real_distribution<float> angle(-3.14f, 3.14f);
+	std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+	std::vector<Matrix4x4> matrices(kCount);
+	std::vector<Vector4> vectors(kCount);
+	for (size_t i = 0; i < kCount; i++) {
+		matrices[i] = MakeAffineMatrix(
+		    {1.0f, 1.0f, 1.0f}, {angle(engine), angle(engine), angle(engine)},
+		    {distribution(engine), distribution(engine), distribution(engine)});
+		vectors[i] = {distribution(engine), distribution(engine), distribution(engine), 1.0f};
+	}
+	std::vector<Matrix4x4> matrixResults(kCount);
+	std::vector<Vector4> vectorResults(kCount);
+	const size_t items = kCount * kRepeat;
+
+	// 独立した積（スループット）と、前の結果に掛けていく積（親子関係の合成のような待ち時間）
+	double seconds = Benchmark::Measure([&] {
+		for (int repeat = 0; repeat < kRepeat; repeat++) {
+			for (size_t i = 0; i + 1 < kCount; i++) {
+				matrixResults[i] = Multiply(matrices[i], matrices[i + 1]);
+			}
+			Benchmark::DoNotOptimize(matrixResults);
+		}
+	});
+	Benchmark::Report("Multiply (independent)", items, seconds, "mul");
+	seconds = Benchmark::Measure([&] {
+		Matrix4x4 m = matrices[0];
+		for (size_t i = 0; i < items; i++) {
+			m = Multiply(m, matrices[i % 256]);
+		}
+		Benchmark::DoNotOptimize(m);
+	});
+	Benchmark::Report("Multiply (dependent chain)", items, seconds, "mul");
+
+	seconds = Benchmark::Measure([&] {
+		for (int repeat = 0; repeat < kRepeat; repeat++) {
+			for (size_t i = 0; i < kCount; i++) {
+				matrixResults[i] = Inverse(matrices[i]);
+			}
+			Benchmark::DoNotOptimize(matrixResults);
+		}
+	});
+	Benchmark::Report("Inverse", items, seconds, "inv");
+
+	seconds = Benchmark::Measure([&] {
+		for (int repeat = 0; repeat < kRepeat; repeat++) {
+			for (size_t i = 0; i < kCount; i++) {
+				matrixResults[i] = Transpose(matrices[i]);
+			}
+			Benchmark::DoNotOptimize(matrixResults);
+		}
+	});
+	Benchmark::Report("Transpose", items, seconds, "mat");
+
+	// 物体ごとの行列での変換、同じ行列での変換、前の結果を続けて変換する場合
+	seconds = Benchmark::Measure([&] {
+		for (int repeat = 0; repeat < kRepeat; repeat++) {
+			for (size_t i = 0; i < kCount; i++) {
+				vectorResults[i] = Transform(vectors[i], matrices[i]);
+			}
+			Benchmark::DoNotOptimize(vectorResults);
+		}
+	});
+	Benchmark::Report("Transform (per-object matrix)", items, seconds, "vec");
+	const Matrix4x4& m = matrices[0];
+	seconds = Benchmark::Measure([&] {
+		for (int repeat = 0; repeat < kRepeat; repeat++) {
+			for (size_t i = 0; i < kCount; i++) {
+				vectorResults[i] = Transform(vectors[i], m);
+			}
+			Benchmark::DoNotOptimize(vectorResults);
+		}
+	});
+	Benchmark::Report("Transform (same matrix)", items, seconds, "vec");
+	seconds = Benchmark::Measure([&] {
+		Vector4 v = vectors[0];
+		for (size_t i = 0; i < items; i++) {
+			v = Transform(v, matrices[i % 256]);
+		}
+		Benchmark::DoNotOptimize(v);
+	});
+	Benchmark::Report("Transform (dependent chain)", items, seconds, "vec");
+	return 0;
+}
@@ -0,0 +1,277 @@
+#include "MathUtility.h"
+#include "TestFramework.h"
+#include <cstring>
+#include <random>
+
+using namespace MathUtility;
+
+#pragma region 定数バッファとのレイアウト
+
+// Resources/shaders/Obj.hlsli・Terrain.hlsliのcbufferと同じ並びで数学型を並べ、
+// HLSLのパッキング規則（16バイトのレジスタ単位、要素はレジスタをまたがない）と
+// 同じオフセットになることを確かめる。C++側の構造体はd3d12.hに依存するので、
+// 実物の構造体に対する同じ確認は各ヘッダーのstatic_assertで行っている
+
+// HLSLの定数レジスタの大きさ
+const size_t kRegisterSize = 16;
+
+// 数学型が余計なアラインメントを持たないこと（float単位で詰められること）
+static_assert(alignof(Vector3) == alignof(float));
+static_assert(alignof(Vector4) == alignof(float));
+static_assert(alignof(Matrix4x4) == alignof(float));
+
+// matrix（row_major）は4レジスタ
+static_assert(sizeof(Matrix4x4) == kRegisterSize * 4);
+static_assert(offsetof(Matrix4x4, m[1][0]) == kRegisterSize);
+static_assert(offsetof(Matrix4x4, m[3][0]) == kRegisterSize * 3);
+
+// cbuffer ViewProjection { matrix view; matrix projection; float3 cameraPos; }
+struct ViewProjectionLayout {
+	Matrix4x4 view;
+	Matrix4x4 projection;
+	Vector3 cameraPos;
+};
+static_assert(offsetof(ViewProjectionLayout, projection) == kRegisterSize * 4);
+static_assert(offsetof(ViewProjectionLayout, cameraPos) == kRegisterSize * 8);
+
+// cbuffer Material { float3 m_specular : packoffset(c2); float m_alpha : packoffset(c2.w); }
+// のようにfloat3の直後のfloatは同じレジスタの.wに入る
+struct Float3FloatLayout {
+	Vector3 v;
+	float w;
+};
+static_assert(offsetof(Float3FloatLayout, w) == sizeof(float) * 3);
+static_assert(sizeof(Float3FloatLayout) == kRegisterSize);
+
+// cbuffer ObjectColor { float4 color; }、StructuredBuffer<InstanceData> { matrix; float4; }
+struct InstanceDataLayout {
+	Matrix4x4 world;
+	Vector4 color;
+};
+static_assert(offsetof(InstanceDataLayout, color) == kRegisterSize * 4);
+static_assert(sizeof(InstanceDataLayout) == kRegisterSize * 5);
+
+#pragma endregion
+
+namespace {
+
+// 比較用のスカラー実装
+Matrix4x4 ReferenceMultiply(const Matrix4x4& m1, const Matrix4x4& m2) {
+	Matrix4x4 result{};
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			double sum = 0.0;
+			for (int k = 0; k < 4; k++) {
+				sum += double(m1.m[i][k]) * double(m2.m[k][j]);
+			}
+			result.m[i][j] = float(sum);
+		}
+	}
+	return result;
+}
+
+Vector4 ReferenceTransform(const Vector4& v, const Matrix4x4& m) {
+	const float in[4] = {v.x, v.y, v.z, v.w};
+	float out[4] = {};
+	for (int j = 0; j < 4; j++) {
+		double sum = 0.0;
+		for (int k = 0; k < 4; k++) {
+			sum += double(in[k]) * double(m.m[k][j]);
+		}
+		out[j] = float(sum);
+	}
+	return {out[0], out[1], out[2], out[3]};
+}
+
+// 行列の全要素が許容誤差内で等しいか
+void ExpectMatrixNear(const Matrix4x4& actual, const Matrix4x4& expected, float epsilon) {
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			EXPECT_NEAR(actual.m[i][j], expected.m[i][j], epsilon);
+		}
+	}
+}
+
+// 乱数で作った行列
+Matrix4x4 RandomMatrix(std::mt19937& engine) {
+	std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+	Matrix4x4 m{};
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			m.m[i][j] = distribution(engine);
+		}
+	}
+	return m;
+}
+
+// 乱数で作ったアフィン変換行列（常に正則）
+Matrix4x4 RandomAffine(std::mt19937& engine) {
+	std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+	std::uniform_real_distribution<float> angle(-3.14f, 3.14f);
+	std::uniform_real_distribution<float> translate(-10.0f, 10.0f);
+	return MakeAffineMatrix(
+	    {scale(engine), scale(engine), scale(engine)},
+	    {angle(engine), angle(engine), angle(engine)},
+	    {translate(engine), translate(engine), translate(engine)});
+}
+
+// 定数畳み込みされないように実行時の値にする
+template<typename T> T Launder(const T& value) {
+	volatile unsigned char bytes[sizeof(T)];
+	std::memcpy(const_cast<unsigned char*>(bytes), &value, sizeof(T));
+	T result;
+	std::memcpy(&result, const_cast<unsigned char*>(bytes), sizeof(T));
+	return result;
+}
+
+} // namespace
+
+TEST(MultiplyMatchesReference) {
+	std::mt19937 engine(1);
+	for (int i = 0; i < 1000; i++) {
+		Matrix4x4 a = RandomMatrix(engine);
+		Matrix4x4 b = RandomMatrix(engine);
+		ExpectMatrixNear(Multiply(a, b), ReferenceMultiply(a, b), 1.0e-5f);
+	}
+}
+
+TEST(MultiplyIdentity) {
+	std::mt19937 engine(2);
+	Matrix4x4 a = RandomMatrix(engine);
+	ExpectMatrixNear(Multiply(a, MakeIdentity4x4()), a, 0.0f);
+	ExpectMatrixNear(Multiply(MakeIdentity4x4(), a), a, 0.0f);
+}
+
+TEST(MultiplyUnalignedOperands) {
+	// SIMD実装はアラインされていない読み書きをすること
+	std::mt19937 engine(3);
+	alignas(32) unsigned char buffer[sizeof(Matrix4x4) * 3 + sizeof(float)];
+	Matrix4x4 a = RandomMatrix(engine);
+	Matrix4x4 b = RandomMatrix(engine);
+	unsigned char* base = buffer + sizeof(float);
+	std::memcpy(base, &a, sizeof(a));
+	std::memcpy(base + sizeof(Matrix4x4), &b, sizeof(b));
+	Matrix4x4 result = Multiply(
+	    *reinterpret_cast<const Matrix4x4*>(base),
+	    *reinterpret_cast<const Matrix4x4*>(base + sizeof(Matrix4x4)));
+	ExpectMatrixNear(result, ReferenceMultiply(a, b), 1.0e-5f);
+}
+
+TEST(TransposeSwapsElements) {
+	std::mt19937 engine(4);
+	Matrix4x4 a = RandomMatrix(engine);
+	Matrix4x4 t = Transpose(a);
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			EXPECT_EQ(t.m[i][j], a.m[j][i]);
+		}
+	}
+}
+
+TEST(InverseOfAffine) {
+	std::mt19937 engine(5);
+	for (int i = 0; i < 1000; i++) {
+		Matrix4x4 m = RandomAffine(engine);
+		Matrix4x4 inverse = Inverse(m);
+		ExpectMatrixNear(Multiply(m, inverse), MakeIdentity4x4(), 1.0e-4f);
+		ExpectMatrixNear(Multiply(inverse, m), MakeIdentity4x4(), 1.0e-4f);
+	}
+}
+
+TEST(InverseOfGeneral) {
+	// 射影成分を含む一般の行列（条件数の悪いものは除く）
+	std::mt19937 engine(6);
+	int tested = 0;
+	while (tested < 1000) {
+		Matrix4x4 m = RandomMatrix(engine);
+		Matrix4x4 inverse = Inverse(m);
+		float maxElement = 0.0f;
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 4; j++) {
+				maxElement = std::max(maxElement, std::abs(inverse.m[i][j]));
+			}
+		}
+		if (10.0f < maxElement) {
+			continue;
+		}
+		ExpectMatrixNear(Multiply(m, inverse), MakeIdentity4x4(), 1.0e-3f);
+		tested++;
+	}
+}
+
+TEST(InversePerspective) {
+	Matrix4x4 m = MakePerspectiveFovMatrix(0.8f, 16.0f / 9.0f, 0.1f, 1000.0f);
+	ExpectMatrixNear(Multiply(m, Inverse(m)), MakeIdentity4x4(), 1.0e-4f);
+}
+
+TEST(TransformMatchesReference) {
+	std::mt19937 engine(7);
+	std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+	for (int i = 0; i < 1000; i++) {
+		Matrix4x4 m = RandomMatrix(engine);
+		Vector4 v{distribution(engine), distribution(engine), distribution(engine), 1.0f};
+		Vector4 actual = Transform(v, m);
+		Vector4 expected = ReferenceTransform(v, m);
+		EXPECT_NEAR(actual.x, expected.x, 1.0e-3f);
+		EXPECT_NEAR(actual.y, expected.y, 1.0e-3f);
+		EXPECT_NEAR(actual.z, expected.z, 1.0e-3f);
+		EXPECT_NEAR(actual.w, expected.w, 1.0e-3f);
+	}
+}
+
+TEST(TransformPointAndNormal) {
+	Matrix4x4 m = MakeAffineMatrix({2.0f, 2.0f, 2.0f}, {0.0f, 0.0f, 0.0f}, {1.0f, 2.0f, 3.0f});
+	Vector3 point = Transform(Vector3{1.0f, 1.0f, 1.0f}, m);
+	EXPECT_NEAR(point.x, 3.0f, 1.0e-6f);
+	EXPECT_NEAR(point.y, 4.0f, 1.0e-6f);
+	EXPECT_NEAR(point.z, 5.0f, 1.0e-6f);
+	Vector3 normal = TransformNormal(Vector3{1.0f, 0.0f, 0.0f}, m);
+	EXPECT_NEAR(normal.x, 2.0f, 1.0e-6f);
+	EXPECT_NEAR(normal.y, 0.0f, 1.0e-6f);
+	EXPECT_NEAR(normal.z, 0.0f, 1.0e-6f);
+}
+
+TEST(AffineMatchesComposition) {
+	Vector3 scale{1.5f, 0.5f, 2.0f};
+	Vector3 rotate{0.3f, -1.2f, 2.1f};
+	Vector3 translate{4.0f, -5.0f, 6.0f};
+	Matrix4x4 expected = Multiply(
+	    Multiply(
+	        Multiply(
+	            Multiply(MakeScaleMatrix(scale), MakeRotateXMatrix(rotate.x)),
+	            MakeRotateYMatrix(rotate.y)),
+	        MakeRotateZMatrix(rotate.z)),
+	    MakeTranslateMatrix(translate));
+	ExpectMatrixNear(MakeAffineMatrix(scale, rotate, translate), expected, 1.0e-5f);
+}
+
+TEST(ConstantEvaluationMatchesRuntime) {
+	// コンパイル時評価（スカラー実装）と実行時（SIMD実装）が同じ結果になること
+	constexpr Matrix4x4 kA = {1.0f, 2.0f, 0.0f, 0.0f, 0.5f, 3.0f, 1.0f, 0.0f,
+	                          0.0f, 0.0f, 2.0f, 0.0f, 4.0f, 5.0f, 6.0f, 1.0f};
+	constexpr Matrix4x4 kB = {0.0f, 1.0f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f, 0.0f,
+	                          0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 2.0f, 3.0f, 1.0f};
+	constexpr Matrix4x4 kProduct = Multiply(kA, kB);
+	constexpr Matrix4x4 kTranspose = Transpose(kA);
+	constexpr Matrix4x4 kInverse = Inverse(kA);
+	constexpr Vector4 kTransformed = Transform(Vector4{1.0f, 2.0f, 3.0f, 1.0f}, kA);
+
+	Matrix4x4 a = Launder(kA);
+	Matrix4x4 b = Launder(kB);
+	ExpectMatrixNear(Multiply(a, b), kProduct, 1.0e-6f);
+	ExpectMatrixNear(Transpose(a), kTranspose, 0.0f);
+	ExpectMatrixNear(Inverse(a), kInverse, 1.0e-5f);
+	Vector4 transformed = Transform(Launder(Vector4{1.0f, 2.0f, 3.0f, 1.0f}), a);
+	EXPECT_NEAR(transformed.x, kTransformed.x, 1.0e-6f);
+	EXPECT_NEAR(transformed.y, kTransformed.y, 1.0e-6f);
+	EXPECT_NEAR(transformed.z, kTransformed.z, 1.0e-6f);
+	EXPECT_NEAR(transformed.w, kTransformed.w, 1.0e-6f);
+}
+
+TEST(NormalizeZeroVector) {
+	Vector3 zero = Normalize(Vector3{0.0f, 0.0f, 0.0f});
+	EXPECT_EQ(zero.x, 0.0f);
+	EXPECT_EQ(zero.y, 0.0f);
+	EXPECT_EQ(zero.z, 0.0f);
+	EXPECT_NEAR(Length(Normalize(Vector3{3.0f, -4.0f, 12.0f})), 1.0f, 1.0e-6f);
+}
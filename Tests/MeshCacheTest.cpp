@@ -0,0 +1,143 @@
+#include "MeshCache.h"
+#include "TestFramework.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+using Vertex = Mesh::VertexPosNormalUv;
+
+/// <summary>
+/// プロセスごとに別の一時ディレクトリを作る
+/// </summary>
+/// <returns>末尾に区切りの付いたディレクトリパス</returns>
+std::string MakeTempDirectory(const char* name) {
+	std::filesystem::path path = std::filesystem::temp_directory_path() /
+	                             ("MeshCacheTest_" + std::to_string(getpid()) + "_" + name);
+	std::filesystem::remove_all(path);
+	std::filesystem::create_directories(path);
+	return path.string() + "/";
+}
+
+void WriteText(const std::string& filePath, const std::string& text) {
+	std::ofstream(filePath, std::ios::binary) << text;
+}
+
+const std::vector<Vertex> kVertices = {
+    {{0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f}},
+    {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f}},
+    {{0.0f, 0.0f, 1.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 1.0f}},
+    {{1.0f, 0.0f, 1.0f}, {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f}}};
+
+/// <summary>
+/// 1つのサブメッシュのキャッシュを書き込む
+/// </summary>
+bool WriteCache(
+    const std::string& directoryPath, std::span<const uint32_t> indices,
+    const MeshOptimizer::Statistics& statistics = {}) {
+	MeshCache::SubmeshData submesh{"quad", "", kVertices, indices};
+	std::vector<std::string> sources = {"model.obj"};
+	return MeshCache::Write(
+	    directoryPath + "model.meshcache", directoryPath, 1, {&submesh, 1}, {}, sources,
+	    statistics);
+}
+
+} // namespace
+
+TEST(RoundTripAndStatistics) {
+	std::string directory = MakeTempDirectory("RoundTrip");
+	WriteText(directory + "model.obj", "v 0 0 0\n");
+	std::vector<uint32_t> indices = {0, 2, 1, 1, 2, 3};
+	EXPECT_TRUE(WriteCache(directory, indices, {6, 4, 2, 3.0f, 2.0f}));
+
+	MeshCache cache;
+	EXPECT_TRUE(cache.Open(directory + "model.meshcache"));
+	EXPECT_EQ(cache.GetSubmeshCount(), 1u);
+	MeshCache::Submesh submesh = cache.GetSubmesh(0);
+	EXPECT_TRUE(submesh.name == "quad");
+	EXPECT_EQ(submesh.vertexCount, 4u);
+	EXPECT_EQ(submesh.indexCount, 6u);
+	EXPECT_EQ(cache.GetIndices()[3], 1u);
+	EXPECT_EQ(cache.GetVertices()[3].pos.z, 1.0f);
+	EXPECT_EQ(cache.GetStatistics().triangleCount, 2u);
+	EXPECT_EQ(cache.GetStatistics().acmrAfter, 2.0f);
+	std::vector<MeshCache::FileStamp> staleStamps;
+	EXPECT_TRUE(cache.IsUpToDate(directory, 1, &staleStamps));
+	EXPECT_TRUE(staleStamps.empty());
+	// 読み込み設定が違う
+	EXPECT_FALSE(cache.IsUpToDate(directory, 2));
+	cache.Close();
+	std::filesystem::remove_all(directory);
+}
+
+TEST(TouchedSourceRefreshesStamps) {
+	std::string directory = MakeTempDirectory("Touched");
+	const std::string objPath = directory + "model.obj";
+	const std::string cachePath = directory + "model.meshcache";
+	WriteText(objPath, "v 0 0 0\n");
+	std::vector<uint32_t> indices = {0, 2, 1};
+	EXPECT_TRUE(WriteCache(directory, indices));
+
+	// 内容は同じで更新日時だけが変わる
+	std::filesystem::last_write_time(
+	    objPath, std::filesystem::last_write_time(objPath) + std::chrono::hours(1));
+	MeshCache cache;
+	EXPECT_TRUE(cache.Open(cachePath));
+	std::vector<MeshCache::FileStamp> staleStamps;
+	EXPECT_TRUE(cache.IsUpToDate(directory, 1, &staleStamps));
+	EXPECT_EQ(staleStamps.size(), size_t(1));
+	cache.Close();
+	EXPECT_TRUE(MeshCache::UpdateStamps(cachePath, staleStamps));
+
+	// 書き換えた後は日時が一致するのでハッシュを比べない
+	EXPECT_TRUE(cache.Open(cachePath));
+	EXPECT_TRUE(cache.IsUpToDate(directory, 1, &staleStamps));
+	EXPECT_TRUE(staleStamps.empty());
+	cache.Close();
+
+	// 元ファイルの数が違う書き換えは行わない
+	EXPECT_FALSE(MeshCache::UpdateStamps(cachePath, {}));
+
+	// 内容が変わればfalseで、日時も返さない
+	WriteText(objPath, "v 1 0 0\n");
+	EXPECT_TRUE(cache.Open(cachePath));
+	EXPECT_FALSE(cache.IsUpToDate(directory, 1, &staleStamps));
+	EXPECT_TRUE(staleStamps.empty());
+	cache.Close();
+	std::filesystem::remove_all(directory);
+}
+
+TEST(OpenRejectsInvalidIndices) {
+	std::string directory = MakeTempDirectory("Invalid");
+	WriteText(directory + "model.obj", "v 0 0 0\n");
+	const std::string cachePath = directory + "model.meshcache";
+	MeshCache cache;
+
+	// サブメッシュの頂点数以上のインデックス
+	std::vector<uint32_t> outOfRange = {0, 1, 4};
+	EXPECT_TRUE(WriteCache(directory, outOfRange));
+	EXPECT_FALSE(cache.Open(cachePath));
+
+	// 三角形リストにならない数
+	std::vector<uint32_t> partial = {0, 1, 2, 3};
+	EXPECT_TRUE(WriteCache(directory, partial));
+	EXPECT_FALSE(cache.Open(cachePath));
+
+	// 最後の頂点を指すのは正しい。インデックスなしも開ける
+	std::vector<uint32_t> last = {3, 2, 1};
+	EXPECT_TRUE(WriteCache(directory, last));
+	EXPECT_TRUE(cache.Open(cachePath));
+	cache.Close();
+	EXPECT_TRUE(WriteCache(directory, {}));
+	EXPECT_TRUE(cache.Open(cachePath));
+	cache.Close();
+
+	// 途中で切れたファイル
+	std::filesystem::resize_file(cachePath, std::filesystem::file_size(cachePath) - 1);
+	EXPECT_FALSE(cache.Open(cachePath));
+	std::filesystem::remove_all(directory);
+}
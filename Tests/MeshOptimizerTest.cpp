@@ -0,0 +1,229 @@
+#include "JobSystem.h"
+#include "MeshOptimizer.h"
+#include "TestFramework.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+using Vertex = Mesh::VertexPosNormalUv;
+using Face = std::array<uint32_t, 3>;
+
+/// <summary>
+/// 格子状のメッシュのインデックス（三角形の順序はばらばら）
+/// </summary>
+std::vector<uint32_t> MakeShuffledGrid(uint32_t size) {
+	std::vector<Face> triangles;
+	for (uint32_t y = 0; y + 1 < size; y++) {
+		for (uint32_t x = 0; x + 1 < size; x++) {
+			uint32_t i = y * size + x;
+			triangles.push_back({i, i + size, i + 1});
+			triangles.push_back({i + 1, i + size, i + size + 1});
+		}
+	}
+	std::shuffle(triangles.begin(), triangles.end(), std::mt19937(7));
+	std::vector<uint32_t> indices;
+	for (const Face& triangle : triangles) {
+		indices.insert(indices.end(), triangle.begin(), triangle.end());
+	}
+	return indices;
+}
+
+/// <summary>
+/// 三角形の集合（向きを保ったまま最小の頂点が先頭になるよう回してから並べ替える）
+/// </summary>
+std::vector<Face> TriangleSet(const std::vector<uint32_t>& indices) {
+	std::vector<Face> triangles;
+	for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+		Face triangle = {indices[i], indices[i + 1], indices[i + 2]};
+		std::rotate(
+		    triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+		triangles.push_back(triangle);
+	}
+	std::sort(triangles.begin(), triangles.end());
+	return triangles;
+}
+
+Vertex MakeVertex(float x, float y, float z) { return {{x, y, z}, {0.0f, 1.0f, 0.0f}, {x, z}}; }
+
+// 比較用: 座標ごとに頂点番号のリストを持つ、以前の実装（Mesh::AddSmoothData）と同じ計算
+void ReferenceSmoothedNormals(
+    std::vector<Vertex>& vertices, const std::vector<uint32_t>& positionIndices,
+    uint32_t positionCount) {
+	std::vector<std::vector<uint32_t>> smoothData(positionCount);
+	for (uint32_t vertex = 0; vertex < vertices.size(); vertex++) {
+		smoothData[positionIndices[vertex]].push_back(vertex);
+	}
+	for (const std::vector<uint32_t>& sharedVertices : smoothData) {
+		float x = 0.0f, y = 0.0f, z = 0.0f;
+		for (uint32_t vertex : sharedVertices) {
+			x += vertices[vertex].normal.x;
+			y += vertices[vertex].normal.y;
+			z += vertices[vertex].normal.z;
+		}
+		float length = std::sqrt(x * x + y * y + z * z);
+		if (0.0f < length) {
+			x /= length;
+			y /= length;
+			z /= length;
+		}
+		for (uint32_t vertex : sharedVertices) {
+			vertices[vertex].normal = {x, y, z};
+		}
+	}
+}
+
+/// <summary>
+/// 座標を共有する面ごとの頂点（法線は面ごとにばらばら）
+/// </summary>
+void MakeFacetedVertices(
+    uint32_t positionCount, uint32_t vertexCount, std::vector<Vertex>& vertices,
+    std::vector<uint32_t>& positionIndices) {
+	std::mt19937 random(11);
+	std::uniform_int_distribution<uint32_t> position(0, positionCount - 1);
+	std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+	vertices.clear();
+	positionIndices.clear();
+	for (uint32_t i = 0; i < vertexCount; i++) {
+		Vertex vertex = MakeVertex(float(i), 0.0f, 0.0f);
+		vertex.normal = {component(random), component(random), component(random)};
+		vertices.push_back(vertex);
+		positionIndices.push_back(position(random));
+	}
+}
+
+} // namespace
+
+TEST(WeldVerticesMergesBitwiseEqualVertices) {
+	std::vector<Vertex> vertices = {
+	    MakeVertex(0.0f, 0.0f, 0.0f), MakeVertex(1.0f, 0.0f, 0.0f), MakeVertex(0.0f, 0.0f, 1.0f),
+	    MakeVertex(1.0f, 0.0f, 0.0f), MakeVertex(0.0f, 0.0f, 1.0f), MakeVertex(1.0f, 0.0f, 1.0f)};
+	// -0と0はビットが違うのでまとめない
+	vertices.push_back(MakeVertex(-0.0f, 0.0f, 0.0f));
+	std::vector<uint32_t> indices = {0, 2, 1, 3, 4, 5, 6, 2, 1};
+	const std::vector<Vertex> original = vertices;
+	const std::vector<uint32_t> originalIndices = indices;
+
+	uint32_t vertexCount = MeshOptimizer::WeldVertices(vertices, indices);
+	EXPECT_EQ(vertexCount, 5u);
+	EXPECT_EQ(vertices.size(), size_t(5));
+	// 最初に現れた順に詰める
+	EXPECT_EQ(indices[3], 1u);
+	EXPECT_EQ(indices[4], 2u);
+	EXPECT_EQ(indices[5], 3u);
+	EXPECT_EQ(indices[6], 4u);
+	// どのインデックスも元と同じ内容の頂点を指す
+	bool isSame = true;
+	for (size_t i = 0; i < indices.size(); i++) {
+		const Vertex& a = vertices[indices[i]];
+		const Vertex& b = original[originalIndices[i]];
+		isSame = isSame && std::memcmp(&a, &b, sizeof(Vertex)) == 0;
+	}
+	EXPECT_TRUE(isSame);
+}
+
+TEST(CalculateACMRKnownValues) {
+	// 三角形なし
+	EXPECT_EQ(MeshOptimizer::CalculateACMR({}, 0), 0.0f);
+	// 1つの三角形は3ミス
+	std::vector<uint32_t> one = {0, 1, 2};
+	EXPECT_EQ(MeshOptimizer::CalculateACMR(one, 3), 3.0f);
+	// 辺を共有する2つの三角形は4ミス
+	std::vector<uint32_t> strip = {0, 1, 2, 2, 1, 3};
+	EXPECT_EQ(MeshOptimizer::CalculateACMR(strip, 4), 2.0f);
+	// キャッシュに残っていればミスしない。大きさ3のキャッシュでは追い出される
+	std::vector<uint32_t> revisit = {0, 1, 2, 3, 4, 5, 0, 1, 2};
+	EXPECT_EQ(MeshOptimizer::CalculateACMR(revisit, 6, 16), 2.0f);
+	EXPECT_EQ(MeshOptimizer::CalculateACMR(revisit, 6, 3), 3.0f);
+}
+
+TEST(OptimizeVertexCacheKeepsTrianglesAndLowersACMR) {
+	const uint32_t size = 64;
+	std::vector<uint32_t> indices = MakeShuffledGrid(size);
+	const std::vector<Face> expected = TriangleSet(indices);
+	float acmrBefore = MeshOptimizer::CalculateACMR(indices, size * size);
+
+	MeshOptimizer::OptimizeVertexCache(indices, size * size);
+	float acmrAfter = MeshOptimizer::CalculateACMR(indices, size * size);
+	std::printf("grid ACMR: %.3f -> %.3f\n", acmrBefore, acmrAfter);
+
+	// 同じ三角形（向きも同じ）が並べ替わっただけ
+	EXPECT_TRUE(TriangleSet(indices) == expected);
+	EXPECT_TRUE(acmrAfter <= acmrBefore);
+	// 格子は頂点あたり約2三角形なので、最良は0.5。ばらばらの順序（約3）から大きく下がる
+	EXPECT_TRUE(acmrAfter < 1.0f);
+
+	// 並べ替え済みなら悪くならない
+	MeshOptimizer::OptimizeVertexCache(indices, size * size);
+	EXPECT_TRUE(MeshOptimizer::CalculateACMR(indices, size * size) <= acmrAfter + 0.01f);
+}
+
+TEST(OptimizeReportsStatistics) {
+	const uint32_t size = 16;
+	std::vector<uint32_t> indices = MakeShuffledGrid(size);
+	// 面ごとに頂点を作った状態（統合前）にする
+	std::vector<Vertex> vertices;
+	for (uint32_t& index : indices) {
+		vertices.push_back(MakeVertex(float(index % size), 0.0f, float(index / size)));
+		index = static_cast<uint32_t>(vertices.size() - 1);
+	}
+	MeshOptimizer::Statistics statistics = MeshOptimizer::Optimize(vertices, indices);
+	EXPECT_EQ(statistics.vertexCountBefore, (size - 1) * (size - 1) * 6);
+	EXPECT_EQ(statistics.vertexCountAfter, size * size);
+	EXPECT_EQ(statistics.triangleCount, (size - 1) * (size - 1) * 2);
+	EXPECT_EQ(statistics.acmrBefore, 3.0f);
+	EXPECT_TRUE(statistics.acmrAfter < 1.0f);
+	EXPECT_EQ(vertices.size(), size_t(size * size));
+
+	// 合計は三角形数で重み付けした平均
+	MeshOptimizer::Statistics total{};
+	MeshOptimizer::Accumulate(total, {3, 3, 1, 3.0f, 3.0f});
+	MeshOptimizer::Accumulate(total, {30, 10, 3, 2.0f, 1.0f});
+	EXPECT_EQ(total.vertexCountBefore, 33u);
+	EXPECT_EQ(total.vertexCountAfter, 13u);
+	EXPECT_EQ(total.triangleCount, 4u);
+	EXPECT_NEAR(total.acmrBefore, 2.25, 1.0e-6);
+	EXPECT_NEAR(total.acmrAfter, 1.5, 1.0e-6);
+	// 空のメッシュを足しても変わらない
+	MeshOptimizer::Accumulate(total, {});
+	EXPECT_NEAR(total.acmrAfter, 1.5, 1.0e-6);
+}
+
+TEST(SmoothedNormalsMatchPerPositionLists) {
+	// 並列処理の区切り（kSmoothingGrainSize）をまたぎ、4個ずつのSIMDの端数も出る数
+	const uint32_t positionCount = MeshOptimizer::kSmoothingGrainSize * 2 + 3;
+	std::vector<Vertex> vertices;
+	std::vector<uint32_t> positionIndices;
+	MakeFacetedVertices(positionCount, positionCount * 5, vertices, positionIndices);
+	// 座標0は法線が打ち消し合って長さ0になる2頂点だけ、最後の座標はどの頂点も参照しない
+	for (uint32_t& position : positionIndices) {
+		if (position == 0 || position == positionCount - 1) {
+			position = 1;
+		}
+	}
+	positionIndices[0] = 0;
+	positionIndices[1] = 0;
+	vertices[0].normal = {0.0f, 1.0f, 0.0f};
+	vertices[1].normal = {0.0f, -1.0f, 0.0f};
+
+	std::vector<Vertex> expected = vertices;
+	ReferenceSmoothedNormals(expected, positionIndices, positionCount);
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	jobSystem->Initialize(3);
+	MeshOptimizer::CalculateSmoothedNormals(vertices, positionIndices, positionCount);
+	jobSystem->Finalize();
+
+	// 和の順序も同じなのでビット単位で一致する
+	bool isSame = true;
+	for (size_t i = 0; i < vertices.size(); i++) {
+		isSame = isSame && std::memcmp(&vertices[i], &expected[i], sizeof(Vertex)) == 0;
+	}
+	EXPECT_TRUE(isSame);
+	EXPECT_EQ(vertices[0].normal.x, 0.0f);
+	EXPECT_EQ(vertices[0].normal.y, 0.0f);
+	EXPECT_NEAR(MathUtility::Length(vertices[2].normal), 1.0, 1.0e-6);
+}
@@ -0,0 +1,133 @@
+#include "Benchmark.h"
+#include "JobSystem.h"
+#include "ObjMeshBuilder.h"
+#include "ObjParser.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+/// <summary>
+/// 格子状のメッシュを4つのグループに分けたOBJテキストを作る
+/// </summary>
+std::string MakeGridObj(uint32_t size) {
+	std::string text = "mtllib model.mtl\n";
+	char line[256];
+	for (uint32_t y = 0; y < size; y++) {
+		for (uint32_t x = 0; x < size; x++) {
+			std::snprintf(
+			    line, sizeof(line), "v %.4f %.4f %.4f\nvt %.4f %.4f\n", float(x) * 0.1f,
+			    float((x * 7 + y * 13) % 17) * 0.01f, float(y) * 0.1f, float(x) / float(size),
+			    float(y) / float(size));
+			text += line;
+		}
+	}
+	const uint32_t groupRows = (size - 1 + 3) / 4;
+	for (uint32_t y = 0; y + 1 < size; y++) {
+		if (y % groupRows == 0) {
+			uint32_t part = y / groupRows;
+			std::snprintf(line, sizeof(line), "g part%u\nusemtl m%u\n", part, part);
+			text += line;
+		}
+		for (uint32_t x = 0; x + 1 < size; x++) {
+			uint32_t i = y * size + x + 1;
+			uint32_t j = i + size;
+			std::snprintf(
+			    line, sizeof(line), "f %u/%u %u/%u %u/%u %u/%u\n", i, i, j, j, j + 1, j + 1, i + 1,
+			    i + 1);
+			text += line;
+		}
+	}
+	return text;
+}
+
+/// <summary>
+/// Model::LoadModelFastのうちGPUとライブラリのクラスに依存しない部分
+/// （OBJ/MTLの解析、グループごとの頂点作成、平滑化、最適化）
+/// </summary>
+/// <returns>全メッシュの最適化の結果</returns>
+MeshOptimizer::Statistics LoadModel(const std::string& directoryPath) {
+	ObjParser::ObjData obj;
+	ObjParser::ParseObjFile(directoryPath + "model.obj", obj);
+	std::vector<ObjParser::MaterialData> materials;
+	for (const std::string& library : obj.materialLibraries) {
+		ObjParser::ParseMtlFile(directoryPath + library, materials);
+	}
+	MeshOptimizer::Statistics statistics{};
+	ObjMeshBuilder builder(obj, true);
+	for (const ObjParser::Group& group : obj.groups) {
+		if (0 < group.faceCount) {
+			MeshOptimizer::Accumulate(statistics, builder.Build(group));
+		}
+	}
+	return statistics;
+}
+
+} // namespace
+
+int main() {
+	// 大きさの違うモデル（一辺の頂点数）
+	const std::vector<uint32_t> kModelSizes = {400, 350, 300, 300, 250, 250, 200, 200,
+	                                           150, 150, 150, 100, 100, 100, 100, 100};
+	// 計測する総スレッド数（呼び出し元＋ワーカー）
+	const uint32_t kThreadCounts[] = {1, 2, 4, 8};
+
+	std::filesystem::path root = std::filesystem::temp_directory_path() /
+	                             ("ModelLoadBenchmark_" + std::to_string(getpid()));
+	std::vector<std::string> directories;
+	size_t totalBytes = 0;
+	for (size_t i = 0; i < kModelSizes.size(); i++) {
+		std::filesystem::path directory = root / ("model" + std::to_string(i));
+		std::filesystem::create_directories(directory);
+		std::string text = MakeGridObj(kModelSizes[i]);
+		totalBytes += text.size();
+		std::ofstream(directory / "model.obj", std::ios::binary) << text;
+		std::ofstream(directory / "model.mtl", std::ios::binary)
+		    << "newmtl m0\nKd 1 0 0\nnewmtl m1\nnewmtl m2\nnewmtl m3\nmap_Kd tex.png\n";
+		directories.push_back(directory.string() + "/");
+	}
+	std::printf(
+	    "%zu models, %.1f MB OBJ, %u hardware threads\n", directories.size(),
+	    double(totalBytes) * 1.0e-6, std::thread::hardware_concurrency());
+
+	// Model::CreateFromOBJBatchと同じく、大きいモデルから1つずつワーカーへ割り当てる
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	double baseSeconds = 0.0;
+	std::vector<MeshOptimizer::Statistics> statistics(directories.size());
+	for (uint32_t threadCount : kThreadCounts) {
+		jobSystem->Initialize(threadCount - 1);
+		double seconds = Benchmark::Measure(
+		    [&] {
+			    jobSystem->ParallelFor(directories.size(), 1, [&](size_t begin, size_t end) {
+				    for (size_t i = begin; i < end; i++) {
+					    statistics[i] = LoadModel(directories[i]);
+				    }
+			    });
+		    },
+		    3);
+		jobSystem->Finalize();
+		baseSeconds = threadCount == 1 ? seconds : baseSeconds;
+
+		char name[64];
+		std::snprintf(name, sizeof(name), "parse + build (%u threads)", threadCount);
+		Benchmark::Report(name, directories.size(), seconds, "models");
+		std::printf("  speedup: %.2fx\n", baseSeconds / seconds);
+		Benchmark::DoNotOptimize(statistics);
+	}
+
+	// 最適化の結果（Model::CreateFromOBJBatchが返すものと同じ）
+	MeshOptimizer::Statistics total{};
+	for (const MeshOptimizer::Statistics& model : statistics) {
+		MeshOptimizer::Accumulate(total, model);
+	}
+	std::printf(
+	    "vertices %u -> %u, ACMR %.3f -> %.3f (%u triangles)\n", total.vertexCountBefore,
+	    total.vertexCountAfter, total.acmrBefore, total.acmrAfter, total.triangleCount);
+
+	std::filesystem::remove_all(root);
+	return 0;
+}
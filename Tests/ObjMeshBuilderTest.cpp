@@ -0,0 +1,126 @@
+#include "ObjMeshBuilder.h"
+#include "TestFramework.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+using Vertex = Mesh::VertexPosNormalUv;
+
+/// <summary>
+/// 座標が一致する頂点を探す（最適化で並びが変わるため）
+/// </summary>
+const Vertex* FindVertex(const ObjMeshBuilder& builder, float x, float y, float z) {
+	for (const Vertex& vertex : builder.GetVertices()) {
+		if (vertex.pos.x == x && vertex.pos.y == y && vertex.pos.z == z) {
+			return &vertex;
+		}
+	}
+	return nullptr;
+}
+
+/// <summary>
+/// 三角形ごとの座標のx成分を並べ替えた集合（頂点の並びと三角形の順序に依らない比較用）
+/// </summary>
+std::vector<std::array<float, 3>> TriangleSet(const ObjMeshBuilder& builder) {
+	const std::vector<Vertex>& vertices = builder.GetVertices();
+	const std::vector<uint32_t>& indices = builder.GetIndices();
+	std::vector<std::array<float, 3>> triangles;
+	for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+		std::array<float, 3> triangle = {
+		    vertices[indices[i]].pos.x + vertices[indices[i]].pos.y * 10.0f,
+		    vertices[indices[i + 1]].pos.x + vertices[indices[i + 1]].pos.y * 10.0f,
+		    vertices[indices[i + 2]].pos.x + vertices[indices[i + 2]].pos.y * 10.0f};
+		std::sort(triangle.begin(), triangle.end());
+		triangles.push_back(triangle);
+	}
+	std::sort(triangles.begin(), triangles.end());
+	return triangles;
+}
+
+} // namespace
+
+TEST(QuadIsSplitIntoTwoTriangles) {
+	ObjParser::ObjData obj;
+	EXPECT_TRUE(ObjParser::ParseObj(
+	    "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+	    "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+	    "vn 0 0 1\n"
+	    "f 1/1/1 2/2/1 3/3/1 4/4/1\n",
+	    obj));
+	ObjMeshBuilder builder(obj, false);
+	MeshOptimizer::Statistics statistics = builder.Build(obj.groups[0]);
+
+	EXPECT_EQ(builder.GetIndices().size(), size_t(6));
+	EXPECT_EQ(builder.GetVertices().size(), size_t(4));
+	EXPECT_EQ(statistics.vertexCountBefore, 4u);
+	EXPECT_EQ(statistics.vertexCountAfter, 4u);
+	// 扇状の分割（0,1,2）（0,2,3）
+	std::vector<std::array<float, 3>> expected = {{0.0f, 1.0f, 11.0f}, {0.0f, 10.0f, 11.0f}};
+	EXPECT_TRUE(TriangleSet(builder) == expected);
+
+	// vは反転する
+	const Vertex* vertex = FindVertex(builder, 1.0f, 0.0f, 0.0f);
+	EXPECT_TRUE(vertex != nullptr);
+	EXPECT_EQ(vertex->uv.x, 1.0f);
+	EXPECT_EQ(vertex->uv.y, 1.0f);
+	EXPECT_EQ(vertex->normal.z, 1.0f);
+}
+
+TEST(MissingTexcoordAndNormalAreZero) {
+	ObjParser::ObjData obj;
+	EXPECT_TRUE(ObjParser::ParseObj("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n", obj));
+	ObjMeshBuilder builder(obj, false);
+	builder.Build(obj.groups[0]);
+
+	EXPECT_EQ(builder.GetVertices().size(), size_t(3));
+	bool isZero = true;
+	for (const Vertex& vertex : builder.GetVertices()) {
+		isZero = isZero && vertex.uv.x == 0.0f && vertex.uv.y == 0.0f;
+		isZero = isZero && vertex.normal.x == 0.0f && vertex.normal.y == 0.0f &&
+		         vertex.normal.z == 0.0f;
+	}
+	EXPECT_TRUE(isZero);
+}
+
+TEST(SmoothingStaysInsideGroup) {
+	// 座標2と3を共有する2つの面。同じグループなら法線が平均され、別グループなら平均されない
+	const char* faces = "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv 2 0 0\n"
+	                    "vn 0 0 1\nvn 1 0 0\n"
+	                    "g first\n"
+	                    "f 1//1 2//1 3//1\n"
+	                    "%s"
+	                    "f 2//2 5//2 3//2\n";
+	const float half = 1.0f / std::sqrt(2.0f);
+
+	char text[256];
+	std::snprintf(text, sizeof(text), faces, "");
+	ObjParser::ObjData sameGroup;
+	EXPECT_TRUE(ObjParser::ParseObj(text, sameGroup));
+	ObjMeshBuilder builder(sameGroup, true);
+	builder.Build(sameGroup.groups[0]);
+	const Vertex* shared = FindVertex(builder, 1.0f, 0.0f, 0.0f);
+	EXPECT_TRUE(shared != nullptr);
+	EXPECT_NEAR(shared->normal.x, half, 1.0e-6);
+	EXPECT_NEAR(shared->normal.z, half, 1.0e-6);
+	// 法線が揃ったので共有する座標の頂点は1つに統合される（6頂点 → 使う4座標分）
+	EXPECT_EQ(builder.GetVertices().size(), size_t(4));
+	// 共有しない座標はそのまま
+	EXPECT_EQ(FindVertex(builder, 0.0f, 0.0f, 0.0f)->normal.z, 1.0f);
+
+	std::snprintf(text, sizeof(text), faces, "g second\n");
+	ObjParser::ObjData twoGroups;
+	EXPECT_TRUE(ObjParser::ParseObj(text, twoGroups));
+	EXPECT_EQ(twoGroups.groups.size(), size_t(2));
+	ObjMeshBuilder groupBuilder(twoGroups, true);
+	for (int repeat = 0; repeat < 2; repeat++) {
+		// 2回目は作業領域が戻されていることを確かめる
+		groupBuilder.Build(twoGroups.groups[0]);
+		EXPECT_EQ(FindVertex(groupBuilder, 1.0f, 0.0f, 0.0f)->normal.z, 1.0f);
+		groupBuilder.Build(twoGroups.groups[1]);
+		EXPECT_EQ(FindVertex(groupBuilder, 1.0f, 0.0f, 0.0f)->normal.x, 1.0f);
+		EXPECT_EQ(groupBuilder.GetVertices().size(), size_t(3));
+	}
+}
@@ -0,0 +1,139 @@
+#include "Benchmark.h"
+#include "JobSystem.h"
+#include "ObjParser.h"
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+// 比較用: 既存のModel::LoadModelと同じストリームによる読み込み
+// （1行ずつgetlineし、istringstreamで数値と"v/vt/vn"を区切る）
+struct StreamObjData {
+	std::vector<Vector3> positions;
+	std::vector<Vector3> normals;
+	std::vector<Vector2> texcoords;
+	std::vector<ObjParser::Corner> corners;
+};
+
+bool LoadWithStream(const std::string& filePath, StreamObjData& data) {
+	data = {};
+	std::ifstream file(filePath);
+	if (file.fail()) {
+		return false;
+	}
+	std::string line;
+	while (std::getline(file, line)) {
+		std::istringstream line_stream(line);
+		std::string key;
+		std::getline(line_stream, key, ' ');
+		if (key == "v") {
+			Vector3& position = data.positions.emplace_back();
+			line_stream >> position.x >> position.y >> position.z;
+		} else if (key == "vt") {
+			Vector2& texcoord = data.texcoords.emplace_back();
+			line_stream >> texcoord.x >> texcoord.y;
+		} else if (key == "vn") {
+			Vector3& normal = data.normals.emplace_back();
+			line_stream >> normal.x >> normal.y >> normal.z;
+		} else if (key == "f") {
+			std::string index_string;
+			while (std::getline(line_stream, index_string, ' ')) {
+				std::istringstream index_stream(index_string);
+				uint32_t indexPosition = 0, indexTexcoord = 0, indexNormal = 0;
+				index_stream >> indexPosition;
+				index_stream.seekg(1, std::ios_base::cur);
+				index_stream >> indexTexcoord;
+				index_stream.seekg(1, std::ios_base::cur);
+				index_stream >> indexNormal;
+				data.corners.push_back({indexPosition - 1, indexTexcoord - 1, indexNormal - 1});
+			}
+		}
+	}
+	return true;
+}
+
+/// <summary>
+/// 格子状のメッシュ（スキャンデータ相当）のOBJテキストを作る
+/// </summary>
+std::string MakeGridObj(uint32_t width, uint32_t height) {
+	std::mt19937 engine(1);
+	std::uniform_real_distribution<float> noise(-0.01f, 0.01f);
+	std::string text = "mtllib grid.mtl\no Grid\nusemtl Material\n";
+	char line[256];
+	for (uint32_t y = 0; y < height; y++) {
+		for (uint32_t x = 0; x < width; x++) {
+			std::snprintf(
+			    line, sizeof(line), "v %.6f %.6f %.6f\nvt %.6f %.6f\nvn %.6f %.6f 1.000000\n",
+			    float(x) * 0.01f, float(y) * 0.01f, noise(engine), float(x) / float(width),
+			    float(y) / float(height), noise(engine), noise(engine));
+			text += line;
+		}
+	}
+	for (uint32_t y = 0; y + 1 < height; y++) {
+		for (uint32_t x = 0; x + 1 < width; x++) {
+			uint32_t i = y * width + x + 1;
+			uint32_t j = i + width;
+			std::snprintf(
+			    line, sizeof(line), "f %u/%u/%u %u/%u/%u %u/%u/%u\nf %u/%u/%u %u/%u/%u %u/%u/%u\n",
+			    i, i, i, j, j, j, i + 1, i + 1, i + 1, i + 1, i + 1, i + 1, j, j, j, j + 1, j + 1,
+			    j + 1);
+			text += line;
+		}
+	}
+	return text;
+}
+
+} // namespace
+
+int main() {
+	// 約60万頂点、120万三角形
+	const uint32_t kWidth = 800;
+	const uint32_t kHeight = 800;
+
+	std::string text = MakeGridObj(kWidth, kHeight);
+	std::string path = (std::filesystem::temp_directory_path() /
+	                    ("ObjParserBenchmark_" + std::to_string(getpid()) + ".obj"))
+	                       .string();
+	std::ofstream(path, std::ios::binary) << text;
+	const size_t kBytes = text.size();
+	std::printf("OBJ: %.1f MB, %u vertices\n", double(kBytes) * 1.0e-6, kWidth * kHeight);
+
+	StreamObjData streamData;
+	double seconds = Benchmark::Measure([&] { LoadWithStream(path, streamData); }, 3);
+	Benchmark::Report("stream (LoadModel)", kBytes, seconds, "B");
+
+	ObjParser::ObjData data;
+	seconds = Benchmark::Measure([&] { ObjParser::ParseObjFile(path, data); }, 3);
+	Benchmark::Report("ObjParser (no JobSystem)", kBytes, seconds, "B");
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	jobSystem->Initialize();
+	seconds = Benchmark::Measure([&] { ObjParser::ParseObjFile(path, data); }, 3);
+	char name[64];
+	std::snprintf(
+	    name, sizeof(name), "ObjParser (JobSystem, %u threads)", jobSystem->GetConcurrency());
+	Benchmark::Report(name, kBytes, seconds, "B");
+	jobSystem->Finalize();
+
+	// 結果が一致しているか（一致しなければ比較の意味がない）
+	bool isSame = streamData.positions.size() == data.positions.size() &&
+	              streamData.corners.size() == data.corners.size();
+	for (size_t i = 0; isSame && i < data.corners.size(); i++) {
+		isSame = streamData.corners[i].position == data.corners[i].position &&
+		         streamData.corners[i].texcoord == data.corners[i].texcoord &&
+		         streamData.corners[i].normal == data.corners[i].normal;
+	}
+	for (size_t i = 0; isSame && i < data.positions.size(); i++) {
+		isSame = streamData.positions[i].x == data.positions[i].x &&
+		         streamData.positions[i].z == data.positions[i].z;
+	}
+	std::printf("  results match: %s\n", isSame ? "yes" : "NO");
+
+	std::filesystem::remove(path);
+	return isSame ? 0 : 1;
+}
@@ -0,0 +1,262 @@
+#include "JobSystem.h"
+#include "MappedFile.h"
+#include "ObjParser.h"
+#include "TestFramework.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+/// <summary>
+/// 一時ディレクトリにファイルを書き出す（プロセスごとに別名にする）
+/// </summary>
+/// <returns>ファイルパス</returns>
+std::string WriteTempFile(const char* name, const std::string& text) {
+	std::filesystem::path path = std::filesystem::temp_directory_path() /
+	                             ("ObjParserTest_" + std::to_string(getpid()) + "_" + name);
+	std::ofstream file(path, std::ios::binary);
+	file << text;
+	return path.string();
+}
+
+bool IsEqual(const Vector3& a, float x, float y, float z) {
+	return a.x == x && a.y == y && a.z == z;
+}
+
+} // namespace
+
+TEST(ParseFullCorners) {
+	ObjParser::ObjData data;
+	EXPECT_TRUE(ObjParser::ParseObj(
+	    "# comment\n"
+	    "v 1 2 3\n"
+	    "v -1.5 +2e1 0\n"
+	    "v\t0.25\t0.5\t0.75\n"
+	    "vt 0 1\n"
+	    "vt 1 0\n"
+	    "vn 0 0 1\n"
+	    "f 1/1/1 2/2/1 3/1/1\n",
+	    data));
+	EXPECT_EQ(data.positions.size(), size_t(3));
+	EXPECT_TRUE(IsEqual(data.positions[1], -1.5f, 20.0f, 0.0f));
+	EXPECT_TRUE(IsEqual(data.positions[2], 0.25f, 0.5f, 0.75f));
+	EXPECT_EQ(data.texcoords.size(), size_t(2));
+	// vは反転しない
+	EXPECT_EQ(data.texcoords[0].y, 1.0f);
+	EXPECT_EQ(data.normals.size(), size_t(1));
+	EXPECT_EQ(data.GetFaceCount(), 1u);
+	EXPECT_EQ(data.corners.size(), size_t(3));
+	EXPECT_EQ(data.corners[1].position, 1u);
+	EXPECT_EQ(data.corners[1].texcoord, 1u);
+	EXPECT_EQ(data.corners[1].normal, 0u);
+}
+
+TEST(ParseCrlfAndMissingTrailingNewline) {
+	ObjParser::ObjData data;
+	EXPECT_TRUE(ObjParser::ParseObj("v 0 0 0\r\nv 1 0 0\r\nv 0 1 0\r\nf 1 2 3", data));
+	EXPECT_EQ(data.positions.size(), size_t(3));
+	EXPECT_TRUE(IsEqual(data.positions[2], 0.0f, 1.0f, 0.0f));
+	EXPECT_EQ(data.GetFaceCount(), 1u);
+	EXPECT_EQ(data.corners[2].position, 2u);
+}
+
+TEST(ParseNegativeIndices) {
+	ObjParser::ObjData data;
+	EXPECT_TRUE(ObjParser::ParseObj(
+	    "v 0 0 0\n"
+	    "v 1 0 0\n"
+	    "v 0 1 0\n"
+	    "vt 0 0\n"
+	    "vn 0 0 1\n"
+	    "f -3/-1/-1 -2/-1/-1 -1/-1/-1\n"
+	    "v 1 1 0\n"
+	    "vn 0 1 0\n"
+	    // 相対指定はその行までに出現した要素が基準になる
+	    "f -3//-1 -2//-2 -1//-1\n",
+	    data));
+	EXPECT_EQ(data.GetFaceCount(), 2u);
+	EXPECT_EQ(data.corners[0].position, 0u);
+	EXPECT_EQ(data.corners[2].position, 2u);
+	EXPECT_EQ(data.corners[2].texcoord, 0u);
+	EXPECT_EQ(data.corners[2].normal, 0u);
+	EXPECT_EQ(data.corners[3].position, 1u);
+	EXPECT_EQ(data.corners[5].position, 3u);
+	EXPECT_EQ(data.corners[3].normal, 1u);
+	EXPECT_EQ(data.corners[4].normal, 0u);
+	EXPECT_EQ(data.corners[3].texcoord, ObjParser::kNone);
+}
+
+TEST(ParseMissingNormalsAndTexcoords) {
+	ObjParser::ObjData data;
+	EXPECT_TRUE(ObjParser::ParseObj(
+	    "v 0 0 0\n"
+	    "v 1 0 0\n"
+	    "v 0 1 0\n"
+	    "v 1 1 0\n"
+	    "vt 0 0\n"
+	    "vn 0 0 1\n"
+	    "f 1 2 3\n"
+	    "f 1/1 2/1 3/1\n"
+	    "f 1//1 2//1 3//1\n"
+	    "f 1 2 4 3\n",
+	    data));
+	EXPECT_EQ(data.GetFaceCount(), 4u);
+	// v
+	EXPECT_EQ(data.corners[0].texcoord, ObjParser::kNone);
+	EXPECT_EQ(data.corners[0].normal, ObjParser::kNone);
+	// v/vt
+	EXPECT_EQ(data.corners[3].texcoord, 0u);
+	EXPECT_EQ(data.corners[3].normal, ObjParser::kNone);
+	// v//vn
+	EXPECT_EQ(data.corners[6].texcoord, ObjParser::kNone);
+	EXPECT_EQ(data.corners[6].normal, 0u);
+	// 四角形は分割せずに4頂点のまま返す
+	EXPECT_EQ(data.faceOffsets[3], 9u);
+	EXPECT_EQ(data.faceOffsets[4], 13u);
+	EXPECT_EQ(data.corners[11].position, 3u);
+}
+
+TEST(ParseMultipleGroups) {
+	ObjParser::ObjData data;
+	EXPECT_TRUE(ObjParser::ParseObj(
+	    "mtllib a.mtl\n"
+	    "v 0 0 0\n"
+	    "v 1 0 0\n"
+	    "v 0 1 0\n"
+	    "o First\n"
+	    "usemtl Red\n"
+	    "f 1 2 3\n"
+	    "f 1 2 3\n"
+	    "usemtl Blue\n"
+	    "g Second\n"
+	    "usemtl Green\n"
+	    "f 1 2 3\n"
+	    "g Third\n"
+	    "f 1 2 3\n"
+	    "mtllib b.mtl\n",
+	    data));
+	EXPECT_EQ(data.materialLibraries.size(), size_t(2));
+	EXPECT_TRUE(data.materialLibraries[1] == "b.mtl");
+	// 面より前のoは先頭の名前のないグループに名前を付けるだけ
+	EXPECT_EQ(data.groups.size(), size_t(3));
+	EXPECT_TRUE(data.groups[0].name == "First");
+	// グループ内で最初のusemtlだけを採る
+	EXPECT_TRUE(data.groups[0].material == "Red");
+	EXPECT_EQ(data.groups[0].firstFace, 0u);
+	EXPECT_EQ(data.groups[0].faceCount, 2u);
+	EXPECT_TRUE(data.groups[1].name == "Second");
+	EXPECT_TRUE(data.groups[1].material == "Green");
+	EXPECT_EQ(data.groups[1].firstFace, 2u);
+	EXPECT_EQ(data.groups[1].faceCount, 1u);
+	EXPECT_TRUE(data.groups[2].name == "Third");
+	EXPECT_TRUE(data.groups[2].material.empty());
+	EXPECT_EQ(data.groups[2].faceCount, 1u);
+}
+
+TEST(RejectInvalidIndices) {
+	ObjParser::ObjData data;
+	EXPECT_FALSE(ObjParser::ParseObj("v 0 0 0\nf 1 2 1\n", data));
+	EXPECT_FALSE(ObjParser::ParseObj("v 0 0 0\nf 0 1 1\n", data));
+	EXPECT_FALSE(ObjParser::ParseObj("v 0 0 0\nf -2 1 1\n", data));
+	EXPECT_FALSE(ObjParser::ParseObj("v 0 0 0\nf 1/1 1/1 1/1\n", data));
+	EXPECT_FALSE(ObjParser::ParseObj("v 0 0 0\nf 1//x 1 1\n", data));
+	// 空のテキストは面のないデータになる
+	EXPECT_TRUE(ObjParser::ParseObj("", data));
+	EXPECT_EQ(data.GetFaceCount(), 0u);
+	EXPECT_EQ(data.groups.size(), size_t(1));
+}
+
+TEST(ParseMtl) {
+	std::vector<ObjParser::MaterialData> materials;
+	ObjParser::ParseMtl(
+	    "Kd 1 1 1\n"
+	    "newmtl Red\n"
+	    "Ka 0.1 0.2 0.3\n"
+	    "Kd 1 0 0\n"
+	    "d 0.5\n"
+	    "map_Kd red.png\n"
+	    "newmtl Plain\n",
+	    materials);
+	EXPECT_EQ(materials.size(), size_t(2));
+	EXPECT_TRUE(materials[0].name == "Red");
+	EXPECT_TRUE(IsEqual(materials[0].ambient, 0.1f, 0.2f, 0.3f));
+	EXPECT_TRUE(IsEqual(materials[0].diffuse, 1.0f, 0.0f, 0.0f));
+	EXPECT_EQ(materials[0].alpha, 0.5f);
+	EXPECT_TRUE(materials[0].textureFilename == "red.png");
+	// 指定のない値は既定値のまま
+	EXPECT_TRUE(IsEqual(materials[1].diffuse, 0.8f, 0.8f, 0.8f));
+	EXPECT_TRUE(materials[1].textureFilename.empty());
+}
+
+TEST(MappedFileOpen) {
+	std::string path = WriteTempFile("mapped.txt", "hello\nworld\n");
+	MappedFile file;
+	EXPECT_TRUE(file.Open(path));
+	EXPECT_TRUE(file.IsOpen());
+	EXPECT_EQ(file.GetSize(), size_t(12));
+	EXPECT_TRUE(file.GetText() == "hello\nworld\n");
+	file.Close();
+	EXPECT_FALSE(file.IsOpen());
+	EXPECT_TRUE(file.GetData() == nullptr);
+	std::filesystem::remove(path);
+
+	// 空のファイルは開けるが割り当てはない
+	path = WriteTempFile("empty.txt", "");
+	EXPECT_TRUE(file.Open(path));
+	EXPECT_EQ(file.GetSize(), size_t(0));
+	EXPECT_TRUE(file.GetData() == nullptr);
+	file.Close();
+	std::filesystem::remove(path);
+
+	EXPECT_FALSE(file.Open(path));
+	EXPECT_FALSE(file.IsOpen());
+}
+
+TEST(ParseObjFileInParallelChunks) {
+	// 区間の境界をまたいで相対指定とグループが正しく解決されることを確かめる
+	const uint32_t kQuadCount = 60000;
+	std::string text = "mtllib grid.mtl\n";
+	for (uint32_t i = 0; i < kQuadCount; i++) {
+		if (i % 20000 == 0) {
+			text += "g part" + std::to_string(i / 20000) + "\nusemtl m\n";
+		}
+		std::string x = std::to_string(i);
+		text += "v " + x + " 0 0\nv " + x + " 1 0\nv " + x + " 0 1\nv " + x + " 1 1\n";
+		text += "vt 0.5 0.5\nvn 0 0 1\n";
+		text += "f -4/-1/-1 -3/-1/-1 -1/-1/-1 -2/-1/-1\n";
+	}
+	EXPECT_TRUE(ObjParser::kChunkSize * 2 < text.size());
+	std::string path = WriteTempFile("grid.obj", text);
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	jobSystem->Initialize(3);
+	ObjParser::ObjData data;
+	EXPECT_TRUE(ObjParser::ParseObjFile(path, data));
+	jobSystem->Finalize();
+	std::filesystem::remove(path);
+
+	EXPECT_EQ(data.positions.size(), size_t(kQuadCount * 4));
+	EXPECT_EQ(data.texcoords.size(), size_t(kQuadCount));
+	EXPECT_EQ(data.normals.size(), size_t(kQuadCount));
+	EXPECT_EQ(data.GetFaceCount(), kQuadCount);
+	EXPECT_EQ(data.corners.size(), size_t(kQuadCount * 4));
+	bool isResolved = true;
+	for (uint32_t i = 0; i < kQuadCount; i++) {
+		const ObjParser::Corner* corner = &data.corners[data.faceOffsets[i]];
+		isResolved = isResolved && data.faceOffsets[i] == i * 4 &&
+		             corner[0].position == i * 4 && corner[1].position == i * 4 + 1 &&
+		             corner[2].position == i * 4 + 3 && corner[3].position == i * 4 + 2 &&
+		             corner[0].texcoord == i && corner[3].normal == i &&
+		             data.positions[i * 4 + 3].x == float(i);
+	}
+	EXPECT_TRUE(isResolved);
+	EXPECT_EQ(data.groups.size(), size_t(3));
+	EXPECT_TRUE(data.groups[2].name == "part2");
+	EXPECT_EQ(data.groups[2].firstFace, 40000u);
+	EXPECT_EQ(data.groups[2].faceCount, 20000u);
+	EXPECT_EQ(data.materialLibraries.size(), size_t(1));
+
+	EXPECT_FALSE(ObjParser::ParseObjFile(path, data));
+}
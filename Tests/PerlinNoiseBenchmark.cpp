@@ -0,0 +1,98 @@
+#include "BatchTransform.h"
+#include "Benchmark.h"
+#include "JobSystem.h"
+#include "MathUtility.h"
+#include "PerlinNoise.h"
+#include <algorithm>
+#include <span>
+#include <vector>
+
+namespace {
+
+// Terrain::DeformNoiseと同じ1回の並列処理が受け持つ行数
+const size_t kGrainRows = 32;
+
+/// <summary>
+/// Terrain::DeformNoiseと同じ処理（高さと中央差分の法線）を配列に対して行う
+/// </summary>
+/// <param name="useRow">FbmRowで1行ずつ求めるか（falseなら1点ずつFbm）</param>
+void Deform(
+    const PerlinNoise& noise, const PerlinNoise::Fractal& fractal, size_t size, bool useRow,
+    std::vector<float>& heights, std::vector<Vector3>& normals) {
+	const float scale = 1.0f / 64.0f;
+	const float modelHeight = 10.0f;
+	JobSystem::GetInstance()->ParallelFor(size, kGrainRows, [&](size_t begin, size_t end) {
+		for (size_t z = begin; z < end; z++) {
+			std::span<float> row(heights.data() + z * size, size);
+			if (useRow) {
+				noise.FbmRow(0.0f, scale, float(z) * scale, fractal, row);
+			} else {
+				for (size_t x = 0; x < size; x++) {
+					row[x] = noise.Fbm(float(x) * scale, float(z) * scale, fractal);
+				}
+			}
+			for (float& height : row) {
+				height = (height * 0.5f + 0.5f) * modelHeight;
+			}
+		}
+	});
+	// 法線は全ての高さが出てから求める（DeformNoiseは前後1行を重複して求めている）
+	JobSystem::GetInstance()->ParallelFor(size, kGrainRows, [&](size_t begin, size_t end) {
+		for (size_t z = begin; z < end; z++) {
+			size_t z0 = z == 0 ? 0 : z - 1;
+			size_t z1 = std::min(z + 1, size - 1);
+			for (size_t x = 0; x < size; x++) {
+				size_t x0 = x == 0 ? 0 : x - 1;
+				size_t x1 = std::min(x + 1, size - 1);
+				float slopeX = (heights[z * size + x1] - heights[z * size + x0]) / float(x1 - x0);
+				float slopeZ = (heights[z1 * size + x] - heights[z0 * size + x]) / float(z1 - z0);
+				normals[z * size + x] = MathUtility::Normalize(Vector3{-slopeX, 1.0f, -slopeZ});
+			}
+		}
+	});
+}
+
+} // namespace
+
+int main() {
+	PerlinNoise noise(1);
+	PerlinNoise::Fractal fractal{6, 2.0f, 0.5f};
+	JobSystem* jobSystem = JobSystem::GetInstance();
+
+#if defined(MATH_DISABLE_SIMD)
+	std::printf("FbmRow kernel: scalar (MATH_DISABLE_SIMD)\n");
+#else
+	std::printf("FbmRow kernel: %s\n", MathUtility::IsAVX2Supported() ? "AVX2" : "scalar");
+#endif
+
+	for (size_t size : {size_t(1024), size_t(4096)}) {
+		const size_t count = size * size;
+		std::vector<float> heights(count);
+		std::vector<Vector3> normals(count);
+		// 4k×4kは時間がかかるので計測回数を減らす
+		const int repeat = size <= 1024 ? 5 : 2;
+		char name[128];
+
+		std::snprintf(name, sizeof(name), "%zux%zu Fbm per vertex (no JobSystem)", size, size);
+		double seconds = Benchmark::Measure(
+		    [&] { Deform(noise, fractal, size, false, heights, normals); }, repeat);
+		Benchmark::Report(name, count, seconds, "vertices");
+
+		std::snprintf(name, sizeof(name), "%zux%zu FbmRow (no JobSystem)", size, size);
+		seconds = Benchmark::Measure(
+		    [&] { Deform(noise, fractal, size, true, heights, normals); }, repeat);
+		Benchmark::Report(name, count, seconds, "vertices");
+
+		jobSystem->Initialize();
+		std::snprintf(
+		    name, sizeof(name), "%zux%zu FbmRow (JobSystem, %u threads)", size, size,
+		    jobSystem->GetConcurrency());
+		seconds = Benchmark::Measure(
+		    [&] { Deform(noise, fractal, size, true, heights, normals); }, repeat);
+		Benchmark::Report(name, count, seconds, "vertices");
+		jobSystem->Finalize();
+
+		Benchmark::DoNotOptimize(normals);
+	}
+	return 0;
+}
@@ -0,0 +1,109 @@
+#include "BatchTransform.h"
+#include "PerlinNoise.h"
+#include "TestFramework.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// 1行分の評価と1点ずつの評価の許容誤差（座標の丸め方とFMAの有無の差）
+const float kRowEpsilon = 2.0e-4f;
+
+/// <summary>
+/// FbmRowとFbmの最大の差
+/// </summary>
+float MaxRowError(
+    const PerlinNoise& noise, float x0, float dx, float y, const PerlinNoise::Fractal& fractal,
+    size_t count) {
+	std::vector<float> row(count);
+	noise.FbmRow(x0, dx, y, fractal, row);
+	float maxError = 0.0f;
+	for (size_t i = 0; i < count; i++) {
+		float expected = noise.Fbm(x0 + float(i) * dx, y, fractal);
+		maxError = std::max(maxError, std::abs(row[i] - expected));
+	}
+	return maxError;
+}
+
+} // namespace
+
+TEST(NoiseIsZeroOnLattice) {
+	PerlinNoise noise(1);
+	for (int y = -3; y <= 3; y++) {
+		for (int x = -3; x <= 3; x++) {
+			EXPECT_EQ(noise.Noise(float(x), float(y)), 0.0f);
+		}
+	}
+}
+
+TEST(NoiseRangeAndSeed) {
+	PerlinNoise noise(7);
+	PerlinNoise same(7);
+	PerlinNoise other(8);
+	float minValue = 1.0f;
+	float maxValue = -1.0f;
+	bool isSame = true;
+	bool isDifferent = false;
+	for (int y = 0; y < 200; y++) {
+		for (int x = 0; x < 200; x++) {
+			float px = float(x) * 0.173f;
+			float py = float(y) * 0.191f;
+			float value = noise.Noise(px, py);
+			minValue = std::min(minValue, value);
+			maxValue = std::max(maxValue, value);
+			isSame = isSame && value == same.Noise(px, py);
+			isDifferent = isDifferent || value != other.Noise(px, py);
+		}
+	}
+	EXPECT_TRUE(-1.0f <= minValue && maxValue <= 1.0f);
+	// 値が偏っていない
+	EXPECT_TRUE(minValue < -0.5f && 0.5f < maxValue);
+	EXPECT_TRUE(isSame);
+	EXPECT_TRUE(isDifferent);
+}
+
+TEST(NoiseIsPeriodic) {
+	PerlinNoise noise(3);
+	const float period = float(PerlinNoise::kPermutationSize);
+	for (int i = 0; i < 100; i++) {
+		float x = float(i) * 0.37f;
+		float y = float(i) * 0.53f;
+		EXPECT_NEAR(noise.Noise(x, y), noise.Noise(x + period, y - period), 1.0e-4);
+	}
+}
+
+TEST(FbmRange) {
+	PerlinNoise noise(5);
+	PerlinNoise::Fractal fractal{6, 2.0f, 0.5f};
+	bool isInRange = true;
+	for (int y = 0; y < 100; y++) {
+		for (int x = 0; x < 100; x++) {
+			float value = noise.Fbm(float(x) * 0.05f, float(y) * 0.05f, fractal);
+			isInRange = isInRange && -1.0f <= value && value <= 1.0f;
+		}
+	}
+	EXPECT_TRUE(isInRange);
+	// オクターブ数0は0
+	EXPECT_EQ(noise.Fbm(0.3f, 0.7f, {0, 2.0f, 0.5f}), 0.0f);
+}
+
+TEST(FbmRowMatchesFbm) {
+	// AVX2でビルドされていて対応CPUならAVX2カーネル、そうでなければスカラー版カーネルを比べる
+	std::printf("FbmRow kernel: %s\n", MathUtility::IsAVX2Supported() ? "AVX2" : "scalar");
+
+	PerlinNoise noise(42);
+	PerlinNoise::Fractal fractal{5, 2.0f, 0.5f};
+	// 8の倍数、端数あり、8未満、負の座標
+	EXPECT_NEAR(MaxRowError(noise, 0.0f, 1.0f / 64.0f, 0.25f, fractal, 1024), 0.0f, kRowEpsilon);
+	EXPECT_NEAR(MaxRowError(noise, 3.1f, 0.013f, 17.7f, fractal, 1027), 0.0f, kRowEpsilon);
+	EXPECT_NEAR(MaxRowError(noise, -5.3f, 0.21f, -2.9f, fractal, 5), 0.0f, kRowEpsilon);
+	EXPECT_NEAR(MaxRowError(noise, -40.0f, 0.07f, 8.0f, fractal, 333), 0.0f, kRowEpsilon);
+	// 格子点上（xfが0と1の境目）
+	EXPECT_NEAR(MaxRowError(noise, 0.0f, 0.5f, 2.0f, {1, 2.0f, 0.5f}, 64), 0.0f, kRowEpsilon);
+
+	// 0要素は何もしない
+	std::vector<float> empty;
+	noise.FbmRow(0.0f, 1.0f, 0.0f, fractal, empty);
+	EXPECT_TRUE(empty.empty());
+}
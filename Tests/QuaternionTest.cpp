@@ -0,0 +1,169 @@
+#include "Quaternion.h"
+#include "TestFramework.h"
+#include <cmath>
+#include <random>
+
+using namespace MathUtility;
+
+namespace {
+
+// 行列の全要素が許容誤差内で等しいか
+void ExpectMatrixNear(const Matrix4x4& actual, const Matrix4x4& expected, float epsilon) {
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			EXPECT_NEAR(actual.m[i][j], expected.m[i][j], epsilon);
+		}
+	}
+}
+
+// 全成分が許容誤差内で等しいか（符号違いの同じ回転は区別する）
+void ExpectQuaternionNear(const Quaternion& actual, const Quaternion& expected, float epsilon) {
+	EXPECT_NEAR(actual.x, expected.x, epsilon);
+	EXPECT_NEAR(actual.y, expected.y, epsilon);
+	EXPECT_NEAR(actual.z, expected.z, epsilon);
+	EXPECT_NEAR(actual.w, expected.w, epsilon);
+}
+
+Quaternion Negate(const Quaternion& q) { return {-q.x, -q.y, -q.z, -q.w}; }
+
+// 2つの単位クォータニオンが表す回転の間の角度
+float AngleBetween(const Quaternion& q0, const Quaternion& q1) {
+	return 2.0f * std::acos(std::fmin(std::fabs(Dot(q0, q1)), 1.0f));
+}
+
+// 乱数で作った単位クォータニオン
+Quaternion RandomQuaternion(std::mt19937& engine) {
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+	return Normalize(
+	    {distribution(engine), distribution(engine), distribution(engine), distribution(engine)});
+}
+
+const Vector3 kAxisX = {1.0f, 0.0f, 0.0f};
+const Vector3 kAxisY = {0.0f, 1.0f, 0.0f};
+const Vector3 kAxisZ = {0.0f, 0.0f, 1.0f};
+const float kPi = 3.14159265f;
+
+} // namespace
+
+TEST(RotateMatrixMatchesAxisMatrices) {
+	ExpectMatrixNear(MakeRotateMatrix(IdentityQuaternion()), MakeIdentity4x4(), 0.0f);
+	for (float angle : {-2.5f, -0.7f, 0.3f, 1.0f, kPi * 0.5f, 3.0f}) {
+		ExpectMatrixNear(
+		    MakeRotateMatrix(MakeRotateAxisAngleQuaternion(kAxisX, angle)),
+		    MakeRotateXMatrix(angle), 1.0e-6f);
+		ExpectMatrixNear(
+		    MakeRotateMatrix(MakeRotateAxisAngleQuaternion(kAxisY, angle)),
+		    MakeRotateYMatrix(angle), 1.0e-6f);
+		ExpectMatrixNear(
+		    MakeRotateMatrix(MakeRotateAxisAngleQuaternion(kAxisZ, angle)),
+		    MakeRotateZMatrix(angle), 1.0e-6f);
+	}
+}
+
+TEST(EulerQuaternionMatchesRotateMatrices) {
+	std::mt19937 engine(1);
+	std::uniform_real_distribution<float> angle(-3.14f, 3.14f);
+	for (int i = 0; i < 100; i++) {
+		Vector3 rotate = {angle(engine), angle(engine), angle(engine)};
+		Quaternion q = MakeRotateQuaternion(rotate);
+		EXPECT_NEAR(Norm(q), 1.0f, 1.0e-6f);
+		// オイラー角の行列 Rx * Ry * Rz と同じ回転
+		Matrix4x4 expected = Multiply(
+		    Multiply(MakeRotateXMatrix(rotate.x), MakeRotateYMatrix(rotate.y)),
+		    MakeRotateZMatrix(rotate.z));
+		ExpectMatrixNear(MakeRotateMatrix(q), expected, 1.0e-5f);
+		// アフィン変換行列もオイラー角版と一致する
+		Vector3 scale = {2.0f, 0.5f, 1.5f};
+		Vector3 translate = {1.0f, -2.0f, 3.0f};
+		ExpectMatrixNear(
+		    MakeAffineMatrix(scale, q, translate), MakeAffineMatrix(scale, rotate, translate),
+		    1.0e-5f);
+	}
+}
+
+TEST(MultiplyAndRotateVectorMatchMatrices) {
+	std::mt19937 engine(2);
+	std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+	for (int i = 0; i < 100; i++) {
+		Quaternion q1 = RandomQuaternion(engine);
+		Quaternion q2 = RandomQuaternion(engine);
+		// q1 * q2 は q2 の後に q1 の回転
+		ExpectMatrixNear(
+		    MakeRotateMatrix(Multiply(q1, q2)),
+		    Multiply(MakeRotateMatrix(q2), MakeRotateMatrix(q1)), 1.0e-5f);
+		// 逆クォータニオンで戻る
+		ExpectQuaternionNear(Multiply(q1, Inverse(q1)), IdentityQuaternion(), 1.0e-6f);
+
+		Vector3 v = {distribution(engine), distribution(engine), distribution(engine)};
+		Vector3 rotated = RotateVector(v, q1);
+		Vector3 expected = Transform(v, MakeRotateMatrix(q1));
+		EXPECT_NEAR(rotated.x, expected.x, 1.0e-4f);
+		EXPECT_NEAR(rotated.y, expected.y, 1.0e-4f);
+		EXPECT_NEAR(rotated.z, expected.z, 1.0e-4f);
+	}
+}
+
+TEST(SlerpEndpointsAndMidpoint) {
+	Quaternion q0 = MakeRotateAxisAngleQuaternion(kAxisY, 0.2f);
+	Quaternion q1 = MakeRotateAxisAngleQuaternion(kAxisY, 1.8f);
+	ExpectQuaternionNear(Slerp(q0, q1, 0.0f), q0, 1.0e-6f);
+	ExpectQuaternionNear(Slerp(q0, q1, 1.0f), q1, 1.0e-6f);
+	// 同じ軸の回転なので角度が線形に補間される
+	ExpectQuaternionNear(
+	    Slerp(q0, q1, 0.25f), MakeRotateAxisAngleQuaternion(kAxisY, 0.6f), 1.0e-6f);
+	ExpectQuaternionNear(Nlerp(q0, q1, 0.0f), q0, 1.0e-6f);
+	ExpectQuaternionNear(Nlerp(q0, q1, 1.0f), q1, 1.0e-6f);
+
+	// 別々の軸の回転でも単位クォータニオンのまま、角速度が一定
+	std::mt19937 engine(3);
+	for (int i = 0; i < 50; i++) {
+		Quaternion a = RandomQuaternion(engine);
+		Quaternion b = RandomQuaternion(engine);
+		ExpectQuaternionNear(Slerp(a, b, 0.0f), a, 1.0e-6f);
+		// 終点は b の符号を a の側に揃えたもの
+		ExpectQuaternionNear(Slerp(a, b, 1.0f), Dot(a, b) < 0.0f ? Negate(b) : b, 1.0e-5f);
+		Quaternion half = Slerp(a, b, 0.5f);
+		EXPECT_NEAR(Norm(half), 1.0f, 1.0e-5f);
+		EXPECT_NEAR(AngleBetween(a, half), AngleBetween(half, b), 1.0e-3f);
+	}
+}
+
+TEST(SlerpTakesShortestPath) {
+	// 符号を反転したクォータニオンは同じ回転を表す
+	Quaternion q0 = MakeRotateAxisAngleQuaternion(kAxisZ, 0.1f);
+	Quaternion q1 = Negate(MakeRotateAxisAngleQuaternion(kAxisZ, 0.9f));
+	EXPECT_TRUE(Dot(q0, q1) < 0.0f);
+	ExpectMatrixNear(
+	    MakeRotateMatrix(q1), MakeRotateMatrix(MakeRotateAxisAngleQuaternion(kAxisZ, 0.9f)),
+	    1.0e-6f);
+
+	// 遠回り（2π - 0.8）ではなく0.8ラジアンの側を補間する
+	Quaternion expected = MakeRotateAxisAngleQuaternion(kAxisZ, 0.5f);
+	ExpectQuaternionNear(Slerp(q0, q1, 0.5f), expected, 1.0e-6f);
+	ExpectQuaternionNear(Nlerp(q0, q1, 0.5f), expected, 1.0e-6f);
+	// 終点は q1 と同じ回転（符号は q0 の側に揃う）
+	ExpectQuaternionNear(Slerp(q0, q1, 1.0f), Negate(q1), 1.0e-6f);
+	for (float t : {0.1f, 0.3f, 0.7f, 0.9f}) {
+		EXPECT_NEAR(AngleBetween(q0, Slerp(q0, q1, t)), 0.8f * t, 1.0e-4f);
+	}
+}
+
+TEST(SlerpNearlyParallelFallsBackToNlerp) {
+	// 同じクォータニオン（sinθ = 0）でもNaNにならない
+	Quaternion q = MakeRotateQuaternion({0.3f, -1.2f, 2.0f});
+	ExpectQuaternionNear(Slerp(q, q, 0.5f), q, 1.0e-6f);
+	// 符号違いの同じ回転は内積が-1。反転して同じ向きとして扱う
+	ExpectQuaternionNear(Slerp(q, Negate(q), 0.5f), q, 1.0e-6f);
+
+	// 閾値（内積0.9995）を挟むわずかな回転の差
+	for (float angle : {1.0e-6f, 1.0e-4f, 0.01f, 0.05f, 0.07f}) {
+		Quaternion q1 = Multiply(MakeRotateAxisAngleQuaternion(kAxisX, angle), q);
+		for (float t : {0.0f, 0.25f, 0.5f, 1.0f}) {
+			Quaternion result = Slerp(q, q1, t);
+			EXPECT_TRUE(std::isfinite(result.x) && std::isfinite(result.w));
+			EXPECT_NEAR(Norm(result), 1.0f, 1.0e-6f);
+			ExpectQuaternionNear(
+			    result, Multiply(MakeRotateAxisAngleQuaternion(kAxisX, angle * t), q), 1.0e-5f);
+		}
+	}
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+/// <summary>
+/// 最小限の単体テスト基盤
+/// </summary>
+/// <remarks>
+/// TEST(名前) で関数を登録し、TestMain.cppのmainから全て実行する。
+/// EXPECT_* は失敗しても中断せずに続け、失敗があれば終了コード1を返す。
+/// </remarks>
+namespace TestFramework {
+
+// 命令セット非対応などで実行しなかったときの終了コード（ctestのSKIP_RETURN_CODE）
+const int kSkipReturnCode = 77;
+
+// テストケース
+struct TestCase {
+	const char* name; // 名前
+	void (*func)();   // 本体
+};
+
+/// <summary>
+/// 登録済みテストケースの取得
+/// </summary>
+inline std::vector<TestCase>& GetTestCases() {
+	static std::vector<TestCase> testCases;
+	return testCases;
+}
+
+/// <summary>
+/// 失敗数の取得
+/// </summary>
+inline int& GetFailureCount() {
+	static int failureCount = 0;
+	return failureCount;
+}
+
+/// <summary>
+/// 静的初期化でテストケースを登録する
+/// </summary>
+struct Registrar {
+	Registrar(const char* name, void (*func)()) { GetTestCases().push_back({name, func}); }
+};
+
+/// <summary>
+/// 失敗の報告
+/// </summary>
+inline void ReportFailure(const char* file, int line, const char* expression) {
+	std::fprintf(stderr, "%s:%d: FAILED: %s\n", file, line, expression);
+	GetFailureCount()++;
+}
+
+/// <summary>
+/// 誤差を許して等しいか
+/// </summary>
+inline bool NearlyEqual(double a, double b, double epsilon) {
+	return std::abs(a - b) <= epsilon;
+}
+
+/// <summary>
+/// 全テストの実行
+/// </summary>
+/// <returns>終了コード</returns>
+inline int RunAll() {
+	for (const TestCase& testCase : GetTestCases()) {
+		int failureCount = GetFailureCount();
+		testCase.func();
+		std::printf(
+		    "[%s] %s\n", failureCount == GetFailureCount() ? "  OK  " : " FAIL ", testCase.name);
+	}
+	std::printf("%zu tests, %d failures\n", GetTestCases().size(), GetFailureCount());
+	return GetFailureCount() == 0 ? 0 : 1;
+}
+
+} // namespace TestFramework
+
+#define TEST(name)                                                                             \
+	static void name();                                                                        \
+	static const TestFramework::Registrar name##Registrar(#name, name);                       \
+	static void name()
+
+#define EXPECT_TRUE(expression)                                                                \
+	do {                                                                                       \
+		if (!(expression)) {                                                                   \
+			TestFramework::ReportFailure(__FILE__, __LINE__, #expression);                     \
+		}                                                                                      \
+	} while (false)
+
+#define EXPECT_FALSE(expression) EXPECT_TRUE(!(expression))
+
+#define EXPECT_EQ(a, b) EXPECT_TRUE((a) == (b))
+
+#define EXPECT_NEAR(a, b, epsilon)                                                             \
+	do {                                                                                       \
+		if (!TestFramework::NearlyEqual((a), (b), (epsilon))) {                                \
+			TestFramework::ReportFailure(__FILE__, __LINE__, #a " ~= " #b);                    \
+			std::fprintf(stderr, "    %.9g vs %.9g\n", double(a), double(b));                  \
+		}                                                                                      \
+	} while (false)
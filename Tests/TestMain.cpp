@@ -0,0 +1,13 @@
+#include "TestFramework.h"
+
+int main() {
+#if defined(__AVX2__)
+	// -mavx2でビルドしたテストは対応CPUでしか実行できない
+	__builtin_cpu_init();
+	if (!__builtin_cpu_supports("avx2") || !__builtin_cpu_supports("fma")) {
+		std::printf("AVX2/FMA is not supported on this CPU\n");
+		return TestFramework::kSkipReturnCode;
+	}
+#endif
+	return TestFramework::RunAll();
+}
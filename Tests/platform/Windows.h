@@ -0,0 +1,11 @@
+#pragma once
+
+// Linux(g++)でDirectXGameのヘッダーを解析するためだけの最小限の宣言
+
+#include <cstdint>
+
+typedef unsigned int UINT;
+typedef uint64_t UINT64;
+typedef intptr_t LONG_PTR;
+typedef long HRESULT;
+typedef void* HANDLE;
@@ -0,0 +1,44 @@
+#pragma once
+
+// Linux(g++)でDirectXGameのヘッダーを解析するためだけの最小限の宣言。
+// テストからDirect3D 12の関数を呼ぶことはないので、型の名前と構造体の形だけを置く
+
+#include "Windows.h"
+
+typedef uint64_t D3D12_GPU_VIRTUAL_ADDRESS;
+
+#define D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT (256)
+
+enum DXGI_FORMAT {
+	DXGI_FORMAT_UNKNOWN = 0,
+	DXGI_FORMAT_R32_UINT = 42,
+	DXGI_FORMAT_R16_UINT = 57,
+};
+
+struct ID3D12Resource;
+struct ID3D12Device;
+struct ID3D12GraphicsCommandList;
+struct ID3D12CommandAllocator;
+struct ID3D12CommandQueue;
+struct ID3D12Fence;
+struct ID3D12DescriptorHeap;
+struct ID3D12RootSignature;
+struct ID3D12PipelineState;
+
+struct D3D12_VERTEX_BUFFER_VIEW {
+	D3D12_GPU_VIRTUAL_ADDRESS BufferLocation;
+	UINT SizeInBytes;
+	UINT StrideInBytes;
+};
+
+struct D3D12_INDEX_BUFFER_VIEW {
+	D3D12_GPU_VIRTUAL_ADDRESS BufferLocation;
+	UINT SizeInBytes;
+	DXGI_FORMAT Format;
+};
+
+struct D3D12_SUBRESOURCE_DATA {
+	const void* pData;
+	LONG_PTR RowPitch;
+	LONG_PTR SlicePitch;
+};
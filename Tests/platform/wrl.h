@@ -0,0 +1,19 @@
+#pragma once
+
+// Linux(g++)でDirectXGameのヘッダーを解析するためだけの最小限の宣言。
+// 参照カウントは持たず、テストでは常にnullptrのまま使う
+
+namespace Microsoft::WRL {
+
+template<class T> class ComPtr {
+public:
+	T* Get() const { return ptr_; }
+	T* operator->() const { return ptr_; }
+	T** operator&() { return &ptr_; }
+	void Reset() { ptr_ = nullptr; }
+
+private:
+	T* ptr_ = nullptr;
+};
+
+} // namespace Microsoft::WRL